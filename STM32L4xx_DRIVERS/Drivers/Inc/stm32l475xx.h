@@ -52,6 +52,38 @@ extern "C"
 #define	GPIO_PIN_RESET			RESET
 ///@}
 
+/** @name Placement of hot code in SRAM2 (zero wait states on the I-Code bus).
+ *  The startup copies the .ramfunc section from flash before main. Building
+ *  with NO_RAMFUNC keeps everything in flash, to compare both layouts.
+ *
+ *  Placement policy: __RAMFUNC goes on interrupt handlers and on the short
+ *  functions they call on every run (pending flag clear, work and event
+ *  posting, timestamps, profiling and logging records), so the interrupt
+ *  latency does not depend on flash wait states or on an ART cache miss.
+ *  Also on code that runs with the flash powered down. Code called from
+ *  thread mode only stays in flash.
+ */
+///@{
+#if !defined(NO_RAMFUNC) && !defined(STM32L475XX_HOST_SIM)
+#define	__RAMFUNC			__attribute__((section(".ramfunc"), noinline))
+#else
+#define	__RAMFUNC
+#endif
+
+#ifndef STM32L475XX_HOST_SIM
+/* Data kept in SRAM2, never initialized by the startup. Survives Standby
+ * when PWR_CR3 RRS is set. */
+#define	__SRAM2_NOINIT			__attribute__((section(".sram2_noinit")))
+
+/* Code placed first in flash. The functions ranked by Tools/pgo_layout.py
+ * follow, listed by name in the linker scripts */
+#define	__HOT				__attribute__((section(".text.hot")))
+#else
+#define	__SRAM2_NOINIT
+#define	__HOT
+#endif
+///@}
+
 /** @name Cortex-M4 NVIC registers addresses
  */
 ///@{
@@ -63,11 +95,156 @@ extern "C"
 #define NVIC_ICER1                      (__vo uint32_t*)0xE000E184
 #define NVIC_ICER2                      (__vo uint32_t*)0xE000E188
 
+#define NVIC_ISPR0                      (__vo uint32_t*)0xE000E200
+#define NVIC_ICPR0                      (__vo uint32_t*)0xE000E280
+#define NVIC_IABR0                      (__vo uint32_t*)0xE000E300
+
 #define NVIC_PRIORITY_BASE_ADDRESS      (__vo uint32_t*)0xE000E400
+#define NVIC_IPR_BYTE_BASE_ADDRESS      (__vo uint8_t*)0xE000E400
+
+#define NVIC_STIR                       (__vo uint32_t*)0xE000EF00
 
 #define NO_PR_BITS_IMPLEMENTED          (4)
 ///@}
 
+/** @name Cortex-M4 SysTick registers addresses
+ */
+///@{
+#define SYSTICK_CTRL                    (__vo uint32_t*)0xE000E010
+#define SYSTICK_LOAD                    (__vo uint32_t*)0xE000E014
+#define SYSTICK_VAL                     (__vo uint32_t*)0xE000E018
+#define SYSTICK_CALIB                   (__vo uint32_t*)0xE000E01C
+
+#define SYSTICK_CTRL_ENABLE             REG_BIT_0
+#define SYSTICK_CTRL_TICKINT            REG_BIT_1
+#define SYSTICK_CTRL_CLKSOURCE          REG_BIT_2
+#define SYSTICK_CTRL_COUNTFLAG          REG_BIT_16
+#define SYSTICK_LOAD_MAX                (0x00FFFFFFUL)
+///@}
+
+/** @name Cortex-M4 System Control Block registers addresses
+ */
+///@{
+#define SCB_ICSR                        (__vo uint32_t*)0xE000ED04
+#define SCB_VTOR                        (__vo uint32_t*)0xE000ED08
+#define SCB_AIRCR                       (__vo uint32_t*)0xE000ED0C
+#define SCB_SCR                         (__vo uint32_t*)0xE000ED10
+#define SCB_SHPR3                       (__vo uint32_t*)0xE000ED20
+#define FPU_FPCCR                       (__vo uint32_t*)0xE000EF34
+
+#define SCB_ICSR_PENDSTCLR              REG_BIT_25
+#define SCB_ICSR_PENDSTSET              REG_BIT_26
+#define SCB_ICSR_PENDSVSET              REG_BIT_28
+#define SCB_SHPR3_PENDSV                REG_BIT_16	/* 8 bits */
+#define SCB_SHPR3_SYSTICK               REG_BIT_24	/* 8 bits */
+#define FPU_FPCCR_LSPEN                 REG_BIT_30
+#define FPU_FPCCR_ASPEN                 REG_BIT_31
+
+#define SCB_AIRCR_PRIGROUP              REG_BIT_8	/* 3 bits */
+#define SCB_AIRCR_VECTKEY               REG_BIT_16	/* 16 bits */
+#define SCB_AIRCR_VECTKEY_VALUE         (0x05FAUL)
+
+#define SCB_SCR_SLEEPONEXIT             REG_BIT_1
+#define SCB_SCR_SLEEPDEEP               REG_BIT_2
+#define SCB_SCR_SEVONPEND               REG_BIT_4
+///@}
+
+/** @name Cortex-M4 instructions without a C equivalent.
+ *  Building with STM32L475XX_HOST_SIM compiles the drivers for a Linux host:
+ *  the register addresses stay the same and are mapped by SIM_Init() (see
+ *  stm32l475xx_host_sim.h), and these instructions become plain C.
+ */
+///@{
+#ifndef STM32L475XX_HOST_SIM
+#define	__WFI()				__asm volatile ("wfi" ::: "memory")
+#define	__WFE()				__asm volatile ("wfe" ::: "memory")
+#define	__SEV()				__asm volatile ("sev" ::: "memory")
+#define	__DMB()				__asm volatile ("dmb 0xF" ::: "memory")
+#define	__DSB()				__asm volatile ("dsb 0xF" ::: "memory")
+#define	__ISB()				__asm volatile ("isb 0xF" ::: "memory")
+#define	__disable_irq()			__asm volatile ("cpsid i" ::: "memory")
+#define	__enable_irq()			__asm volatile ("cpsie i" ::: "memory")
+#define	__get_PRIMASK()			({ uint32_t __primask; __asm volatile ("mrs %0, primask" : "=r" (__primask)); __primask; })
+#define	__set_PRIMASK(x)		__asm volatile ("msr primask, %0" :: "r" (x) : "memory")
+#define	__get_IPSR()			({ uint32_t __ipsr; __asm volatile ("mrs %0, ipsr" : "=r" (__ipsr)); __ipsr; })
+#define	__get_MSP()			({ uint32_t __msp; __asm volatile ("mrs %0, msp" : "=r" (__msp)); __msp; })
+#define	__set_PSP(x)			__asm volatile ("msr psp, %0" :: "r" (x) : "memory")
+#define	__LDREXW(p)			({ uint32_t __value; __asm volatile ("ldrex %0, [%1]" : "=r" (__value) : "r" (p) : "memory"); __value; })
+#define	__STREXW(v, p)			({ uint32_t __failed; __asm volatile ("strex %0, %2, [%1]" : "=&r" (__failed) : "r" (p), "r" (v) : "memory"); __failed; })
+#define	__CLREX()			__asm volatile ("clrex" ::: "memory")
+#else
+/* Single threaded, no interrupts: PRIMASK is only remembered */
+extern __vo uint32_t SIM_Primask;
+#define	__WFI()				((void)0)
+#define	__WFE()				((void)0)
+#define	__SEV()				((void)0)
+#define	__DMB()				__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define	__DSB()				__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define	__ISB()				__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define	__disable_irq()			(SIM_Primask = 1U)
+#define	__enable_irq()			(SIM_Primask = 0U)
+#define	__get_PRIMASK()			(SIM_Primask)
+#define	__set_PRIMASK(x)		(SIM_Primask = (x))
+#define	__get_IPSR()			(0U)
+#define	__set_PSP(x)			((void)(x))
+#define	__LDREXW(p)			(*(p))
+#define	__STREXW(v, p)			((*(p) = (v)), 0U)
+#define	__CLREX()			((void)0)
+#endif
+#define	__CLZ(x)			((uint32_t)__builtin_clz(x))	/* Undefined for 0 */
+///@}
+
+/** @name Cortex-M4 DWT and CoreDebug registers addresses
+ */
+///@{
+#define DWT_CTRL                        (__vo uint32_t*)0xE0001000
+#define DWT_CYCCNT                      (__vo uint32_t*)0xE0001004
+#define DWT_CPICNT                      (__vo uint32_t*)0xE0001008
+#define COREDEBUG_DHCSR                 (__vo uint32_t*)0xE000EDF0
+#define COREDEBUG_DEMCR                 (__vo uint32_t*)0xE000EDFC
+
+#define DWT_CTRL_CYCCNTENA              REG_BIT_0
+#define DWT_CTRL_POSTPRESET             REG_BIT_1
+#define DWT_CTRL_CYCTAP                 REG_BIT_9
+#define DWT_CTRL_PCSAMPLENA             REG_BIT_12
+#define DWT_CTRL_CPIEVTENA              REG_BIT_17
+#define COREDEBUG_DHCSR_C_DEBUGEN       REG_BIT_0
+#define COREDEBUG_DEMCR_TRCENA          REG_BIT_24
+///@}
+
+/** @name Cortex-M4 ITM, TPIU and DBGMCU registers addresses
+ */
+///@{
+#define ITM_STIM_BASE_ADDRESS           (0xE0000000UL)
+#define ITM_STIM32(port)                ((__vo uint32_t*)(ITM_STIM_BASE_ADDRESS + (4UL * (port))))
+#define ITM_STIM16(port)                ((__vo uint16_t*)(ITM_STIM_BASE_ADDRESS + (4UL * (port))))
+#define ITM_STIM8(port)                 ((__vo uint8_t*)(ITM_STIM_BASE_ADDRESS + (4UL * (port))))
+#define ITM_TER                         (__vo uint32_t*)0xE0000E00
+#define ITM_TPR                         (__vo uint32_t*)0xE0000E40
+#define ITM_TCR                         (__vo uint32_t*)0xE0000E80
+#define ITM_LAR                         (__vo uint32_t*)0xE0000FB0
+#define TPI_CSPSR                       (__vo uint32_t*)0xE0040004
+#define TPI_ACPR                        (__vo uint32_t*)0xE0040010
+#define TPI_SPPR                        (__vo uint32_t*)0xE00400F0
+#define TPI_FFCR                        (__vo uint32_t*)0xE0040304
+#define DBGMCU_CR                       (__vo uint32_t*)0xE0042004
+
+#define ITM_STIM_FIFOREADY              REG_BIT_0
+#define ITM_TCR_ITMENA                  REG_BIT_0
+#define ITM_TCR_TSENA                   REG_BIT_1
+#define ITM_TCR_SYNCENA                 REG_BIT_2
+#define ITM_TCR_TXENA                   REG_BIT_3
+#define ITM_TCR_SWOENA                  REG_BIT_4
+#define ITM_TCR_TRACEBUSID              REG_BIT_16	/* 7 bits */
+#define ITM_LAR_KEY                     (0xC5ACCE55UL)
+#define TPI_SPPR_NRZ                    (2UL)
+#define TPI_FFCR_TRIGIN                 REG_BIT_8
+#define TPI_ACPR_MAX                    (0x1FFFUL)
+#define DBGMCU_CR_DBG_STOP              REG_BIT_1
+#define DBGMCU_CR_TRACE_IOEN            REG_BIT_5
+#define DBGMCU_CR_TRACE_MODE            REG_BIT_6	/* 2 bits */
+///@}
+
 /** @name Macros for operations with registers.
  */
 ///@{
@@ -116,6 +293,7 @@ extern "C"
 /** @name IRQ numbers for STM32L475VG.
  */
 ///@{
+#define IRQ_NO_FLASH                    (4)
 #define IRQ_NO_EXTI0                    (6)
 #define IRQ_NO_EXTI1                    (7)
 #define IRQ_NO_EXTI2                    (8)
@@ -123,6 +301,14 @@ extern "C"
 #define IRQ_NO_EXTI4                    (10)
 #define IRQ_NO_EXTI9_5                  (23)
 #define IRQ_NO_EXTI15_10                (40)
+#define IRQ_NO_LPTIM1                   (65)
+#define IRQ_NO_SWPMI1                   (76)
+#define IRQ_NO_TSC                      (77)
+#define IRQ_NO_LCD                      (78)	/* No LCD on STM32L475, free vector */
+#define IRQ_NO_AES                      (79)	/* No AES on STM32L475, free vector */
+#define IRQ_NO_RNG                      (80)
+#define IRQ_NO_FPU                      (81)
+#define IRQ_NO_MAX                      IRQ_NO_FPU
 ///@}
 
 /** @name Base addresses for Flash and SRAM memories.
@@ -181,6 +367,7 @@ extern "C"
  */
 ///@{
 #define	PWR_BASE_ADDRESS		(APB1PERIPH_BASE_ADDRESS + 0x7000U)
+#define	LPTIM1_BASE_ADDRESS		(APB1PERIPH_BASE_ADDRESS + 0x7C00U)
 ///@}
 
 /*****************************************************************************/
@@ -333,6 +520,25 @@ typedef struct  /**< Peripheral register definition structure for Power Control
 #define	PWR							((PWR_RegDef_t*) PWR_BASE_ADDRESS)
 ///@}
 
+typedef struct  /**< Peripheral register definition structure for LPTIM */
+{
+  __vo uint32_t LPTIM_ISR;              /* Address offset: 0x00 */
+  __vo uint32_t LPTIM_ICR;              /* Address offset: 0x04 */
+  __vo uint32_t LPTIM_IER;              /* Address offset: 0x08 */
+  __vo uint32_t LPTIM_CFGR;             /* Address offset: 0x0C */
+  __vo uint32_t LPTIM_CR;               /* Address offset: 0x10 */
+  __vo uint32_t LPTIM_CMP;              /* Address offset: 0x14 */
+  __vo uint32_t LPTIM_ARR;              /* Address offset: 0x18 */
+  __vo uint32_t LPTIM_CNT;              /* Address offset: 0x1C */
+  __vo uint32_t LPTIM_OR;               /* Address offset: 0x20 */
+}LPTIM_RegDef_t;
+
+/** @name LPTIM registers base address.
+ */
+///@{
+#define	LPTIM1							((LPTIM_RegDef_t*) LPTIM1_BASE_ADDRESS)
+///@}
+
 typedef struct  /**< Peripheral register definition structure for EXTI */
 {
   __vo uint32_t EXTI_IMR1;              /* Address offset: 0x00 */
@@ -409,6 +615,14 @@ typedef struct  /**< Peripheral register definition structure for SYSCFG */
 #define	PWR_PCLK_DI()				(RCC->RCC_APB1ENR1 &= ~(1 << 28))
 ///@}
 
+/** @name Clock enable/disable macros for LPTIM1 peripheral.
+ */
+///@{
+#define	LPTIM1_PCLK_EN()			(RCC->RCC_APB1ENR1 |= (1UL << 31))
+
+#define	LPTIM1_PCLK_DI()			(RCC->RCC_APB1ENR1 &= ~(1UL << 31))
+///@}
+
 /** @name Clock enable/disable macros for PWR peripheral.
  */
 ///@{
@@ -2,8 +2,15 @@
  * @file    stm32l475xx_flash_driver.h
  * @brief   Header file for stm32l475xx_flash_driver.c
  *
- * This file has 1 function definition (input parameters omitted):
- *      <br>1) FLASH_SetLatency()  - Enables the GPIO peripheral clock. </br>
+ * This file has 8 function definitions (input parameters omitted):
+ *      <br>1) FLASH_SetLatency()           - Enables the GPIO peripheral clock. </br>
+ *      <br>2) FLASH_Unlock()               - Unlocks the FLASH_CR register. </br>
+ *      <br>3) FLASH_Lock()                 - Locks the FLASH_CR register. </br>
+ *      <br>4) FLASH_ErasePage()            - Erases one 2 KB page. </br>
+ *      <br>5) FLASH_ProgramDoubleWord()    - Programs a 64-bit double word. </br>
+ *      <br>6) FLASH_ConfigART()            - Configures prefetch and the ART caches. </br>
+ *      <br>7) FLASH_SetRunPowerDown()      - Powers the flash down in Run/LPRun. </br>
+ *      <br>8) FLASH_SetSleepPowerDown()    - Powers the flash down in Sleep/LPSleep. </br>
  *
  * @version 1.0.0.0
  *
@@ -52,6 +59,82 @@ extern "C"
 #define	FLASH_LATENCY_FOUR_WAITSTATE		(4)
 ///@}
 
+/** @name Flash memory organization (1 MB, dual bank).
+ */
+///@{
+#define	FLASH_PAGE_SIZE				(0x800UL)
+#define	FLASH_BANK_SIZE				(0x80000UL)
+#define	FLASH_PAGES_PER_BANK			(256UL)
+#define	FLASH_TOTAL_SIZE			(0x100000UL)
+///@}
+
+/** @name Flash unlock keys for FLASH_KEYR.
+ */
+///@{
+#define	FLASH_KEY1				(0x45670123UL)
+#define	FLASH_KEY2				(0xCDEF89ABUL)
+///@}
+
+/** @name Flash power-down keys for FLASH_PDKEYR (unlock RUN_PD).
+ */
+///@{
+#define	FLASH_PDKEY1				(0x04152637UL)
+#define	FLASH_PDKEY2				(0xFAFBFCFDUL)
+///@}
+
+/** @name FLASH_SR bits.
+ */
+///@{
+#define	FLASH_SR_EOP				REG_BIT_0
+#define	FLASH_SR_OPERR				REG_BIT_1
+#define	FLASH_SR_PROGERR			REG_BIT_3
+#define	FLASH_SR_WRPERR				REG_BIT_4
+#define	FLASH_SR_PGAERR				REG_BIT_5
+#define	FLASH_SR_SIZERR				REG_BIT_6
+#define	FLASH_SR_PGSERR				REG_BIT_7
+#define	FLASH_SR_MISERR				REG_BIT_8
+#define	FLASH_SR_FASTERR			REG_BIT_9
+#define	FLASH_SR_RDERR				REG_BIT_14
+#define	FLASH_SR_OPTVERR			REG_BIT_15
+#define	FLASH_SR_BSY				REG_BIT_16
+
+#define	FLASH_SR_ERRORS_MASK			(0x0000C3FAUL)
+///@}
+
+/** @name FLASH_CR bits.
+ */
+///@{
+#define	FLASH_CR_PG				REG_BIT_0
+#define	FLASH_CR_PER				REG_BIT_1
+#define	FLASH_CR_PNB				REG_BIT_3
+#define	FLASH_CR_BKER				REG_BIT_11
+#define	FLASH_CR_STRT				REG_BIT_16
+#define	FLASH_CR_LOCK				REG_BIT_31
+///@}
+
+/** @name FLASH_ECCR bits.
+ */
+///@{
+#define	FLASH_ECCR_ADDR_MASK			(0x0007FFFFUL)
+#define	FLASH_ECCR_BK_ECC			REG_BIT_19
+#define	FLASH_ECCR_SYSF_ECC			REG_BIT_20
+#define	FLASH_ECCR_ECCIE			REG_BIT_24
+#define	FLASH_ECCR_ECCC				REG_BIT_30
+#define	FLASH_ECCR_ECCD				REG_BIT_31
+///@}
+
+/** @name FLASH_ACR bits.
+ */
+///@{
+#define	FLASH_ACR_PRFTEN			REG_BIT_8
+#define	FLASH_ACR_ICEN				REG_BIT_9
+#define	FLASH_ACR_DCEN				REG_BIT_10
+#define	FLASH_ACR_ICRST				REG_BIT_11
+#define	FLASH_ACR_DCRST				REG_BIT_12
+#define	FLASH_ACR_RUN_PD			REG_BIT_13
+#define	FLASH_ACR_SLEEP_PD			REG_BIT_14
+///@}
+
 /*****************************************************************************/
   /* TYPEDEFS */
 /*****************************************************************************/
@@ -69,6 +152,13 @@ typedef enum
   /* FUNCTION DECLARATIONS */
 /*****************************************************************************/
 void FLASH_SetLatency(uint32_t freq_HCLK);
+FLASH_STATUS FLASH_Unlock(void);
+void FLASH_Lock(void);
+FLASH_STATUS FLASH_ErasePage(uint32_t PageAddress);
+FLASH_STATUS FLASH_ProgramDoubleWord(uint32_t Address, uint64_t Data);
+void FLASH_ConfigART(uint8_t Prefetch, uint8_t ICache, uint8_t DCache);
+void FLASH_SetRunPowerDown(uint8_t Enabler);
+void FLASH_SetSleepPowerDown(uint8_t Enabler);
 
 #ifdef __cplusplus
 }
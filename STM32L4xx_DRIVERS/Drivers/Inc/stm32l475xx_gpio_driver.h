@@ -11,7 +11,7 @@
  *      <br>6) GPIO_WritePin()          - Writes the state of a GPIO pin. </br>
  *      <br>7) GPIO_WritePort()         - Writes the state of a GPIO port. </br>
  *      <br>8) GPIO_TogglePin()         - Toggles the state of a GPIO pin. </br>
- *      <br>9) GPIO_IRQConfig()         - Not implemented yet. </br>
+ *      <br>9) GPIO_IRQConfig()         - Configures the NVIC side of an EXTI IRQ. </br>
  *      <br>10) GPIO_IRQHandling()      - Not implemented yet. </br>
  *
  * @version 1.0.0.0
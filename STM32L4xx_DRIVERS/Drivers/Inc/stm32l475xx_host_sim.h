@@ -0,0 +1,138 @@
+/**************************************************************************//**
+ * @file    stm32l475xx_host_sim.h
+ * @brief   Header file for stm32l475xx_host_sim.c
+ *
+ * This file has 8 function declarations (input parameters omitted):
+ *      <br>1) SIM_Init()                   - Maps the register ranges and installs the access traps. </br>
+ *      <br>2) SIM_Reset()                  - Puts the registers and the models in their reset state. </br>
+ *      <br>3) SIM_Run()                    - Runs a function, stopping it if it polls forever. </br>
+ *      <br>4) SIM_SetPin()                 - Drives a GPIO input, with its EXTI edge. </br>
+ *      <br>5) SIM_GetHCLK()                - HCLK given by the simulated RCC. </br>
+ *      <br>6) SIM_AddCycles()              - Advances the simulated time. </br>
+ *      <br>7) SIM_GetStats()               - Returns the access and violation counters. </br>
+ *      <br>8) SIM_ClearStats()             - Clears the counters. </br>
+ *
+ * Register simulation for host builds (STM32L475XX_HOST_SIM, x86-64 Linux).
+ * The drivers are compiled unchanged: SIM_Init() maps the peripheral range
+ * (0x40000000) and the Cortex-M4 private range (0xE0000000) at their real
+ * addresses, with no access rights. Every register access traps, runs one
+ * instruction with the page opened, and goes through the behavioral models:
+ *      - RCC ready flags follow the ON bits after a start-up time, the PLL
+ *        locks, SWS follows SW once the source is ready, and an oscillator
+ *        in use cannot be stopped.
+ *      - FLASH_ACR latency, PWR voltage range and HCLK are checked against
+ *        each other on every change (a violation, which hangs a real part).
+ *      - FLASH_CR is locked until the FLASH_KEYR sequence.
+ *      - EXTI_PRx and NVIC ISPR/ICPR are write 1 to clear, GPIO BSRR/BRR
+ *        write ODR, GPIO_IDR follows SIM_SetPin().
+ *      - Writes to a GPIO, SYSCFG, PWR or LPTIM1 with its bus clock off are
+ *        lost and reads give 0.
+ *      - DWT_CYCCNT, SysTick and LPTIM1 count simulated cycles: every
+ *        register access costs SIM_ACCESS_CYCLES.
+ * Registers without a model are plain memory.
+ *
+ * The traps make an access cost microseconds of host time, the simulated
+ * cycles and the access counts are what to compare between builds.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_STM32L475XX_HOST_SIM_H_
+#define INC_STM32L475XX_HOST_SIM_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/** @name Simulated time, in HCLK cycles.
+ */
+///@{
+#ifndef SIM_ACCESS_CYCLES
+#define	SIM_ACCESS_CYCLES		(2U)		/**< Cost of one register access */
+#endif
+#define	SIM_MSI_STARTUP_CYCLES		(24U)
+#define	SIM_HSI_STARTUP_CYCLES		(16U)
+#define	SIM_PLL_LOCK_CYCLES		(160U)
+#define	SIM_LSI_STARTUP_CYCLES		(320U)
+#define	SIM_LSE_STARTUP_CYCLES		(2000U)
+#define	SIM_LPTIM_COUNT_CYCLES		(128U)		/**< Cycles per LPTIM1 count */
+///@}
+
+/** @name Reads without any write in between after which SIM_Run() gives up.
+ */
+///@{
+#ifndef SIM_STUCK_READS
+#define	SIM_STUCK_READS			(100000UL)
+#endif
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of SIM function status */
+{
+  SIM_STATUS_OK = 0,            /**< SIM status OK */
+  SIM_STATUS_ERROR = 1,         /**< Register ranges could not be mapped */
+  SIM_STATUS_STUCK = 2          /**< The function polled a register forever */
+}SIM_STATUS;
+
+typedef struct  /**< Counters since the last SIM_ClearStats() */
+{
+  uint64_t      Reads;                  /**< Register reads, read-modify-write included */
+  uint64_t      Writes;                 /**< Register writes */
+  uint64_t      Cycles;                 /**< Simulated time */
+  uint32_t      Violations;             /**< Accesses a real part would not survive */
+  const char    *pLastViolation;        /**< Description of the last one, or 0 */
+  uintptr_t     LastViolationAddress;
+  uintptr_t     StuckAddress;           /**< Register polled when SIM_Run() gave up */
+}SIM_Stats_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+SIM_STATUS SIM_Init(void);
+void SIM_Reset(void);
+SIM_STATUS SIM_Run(void (*pFunction)(void));
+void SIM_SetPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, uint8_t Level);
+uint32_t SIM_GetHCLK(void);
+void SIM_AddCycles(uint32_t Cycles);
+void SIM_GetStats(SIM_Stats_t *pStats);
+void SIM_ClearStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_STM32L475XX_HOST_SIM_H_ */
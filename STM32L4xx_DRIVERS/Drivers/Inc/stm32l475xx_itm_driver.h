@@ -0,0 +1,118 @@
+/**************************************************************************//**
+ * @file    stm32l475xx_itm_driver.h
+ * @brief   Header file for stm32l475xx_itm_driver.c
+ *
+ * This file has 7 function declarations (input parameters omitted):
+ *      <br>1) ITM_Init()                   - Configures the SWO pin, TPIU and ITM ports. </br>
+ *      <br>2) ITM_DeInit()                 - Disables the ITM and the SWO pin. </br>
+ *      <br>3) ITM_IsPortEnabled()          - Tells if writes to a port leave the chip. </br>
+ *      <br>4) ITM_Write()                  - Sends a buffer on a stimulus port. </br>
+ *      <br>5) ITM_WriteWord()              - Sends one 32-bit word on a stimulus port. </br>
+ *      <br>6) ITM_GetDropped()             - Returns the bytes dropped on a busy FIFO. </br>
+ *      <br>7) ITM_IsDebuggerAttached()     - Tells if a debugger enabled the debug logic. </br>
+ *
+ * Trace output on the SWO pin (PB3) in NRZ mode. The TPIU divides HCLK down
+ * to the requested baudrate; a clock change callback recomputes the divider
+ * so the host keeps decoding at the same rate. If the new HCLK cannot give
+ * the baudrate within 3%, the output is off until one can.
+ *
+ * Each stimulus port is a separate channel: ITM_PORT_STDOUT, ITM_PORT_STDERR
+ * and ITM_PORT_BINLOG carry files 1, 2 and 3 of _write(), the others are
+ * free. A write
+ * costs a few cycles per word while the FIFO is free. When it is not, the
+ * write waits at most two word times on the wire and drops the rest, so a
+ * disconnected or slow probe cannot stall the code.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_STM32L475XX_ITM_DRIVER_H_
+#define INC_STM32L475XX_ITM_DRIVER_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/** @name Stimulus ports.
+ */
+///@{
+#define	ITM_PORTS			(32U)
+#define	ITM_PORT_STDOUT			(0U)
+#define	ITM_PORT_STDERR			(1U)
+#define	ITM_PORT_BINLOG			(2U)	/**< Binary logger records */
+#define	ITM_PORT_MASK(port)		(1UL << (port))
+///@}
+
+/** @name Build options. Can be overridden from the compiler command line.
+ */
+///@{
+#ifndef ITM_TRACE_IN_STOP
+#define	ITM_TRACE_IN_STOP		(0U)	/**< 1: trace in Stop without a debugger, Stop draws Sleep current */
+#endif
+///@}
+
+/** @name Usual SWO baudrates. HCLK must be a multiple, within 3%.
+ */
+///@{
+#define	ITM_BAUD_2M			(2000000UL)
+#define	ITM_BAUD_1M			(1000000UL)
+#define	ITM_BAUD_115200			(115200UL)
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of ITM function status */
+{
+  ITM_STATUS_OK = 0,            /**< ITM status OK */
+  ITM_STATUS_ERROR = 1          /**< Baudrate out of reach at the current HCLK */
+}ITM_STATUS;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+ITM_STATUS ITM_Init(uint32_t Baudrate, uint32_t PortMask);
+void ITM_DeInit(void);
+uint8_t ITM_IsPortEnabled(uint8_t Port);
+uint32_t ITM_Write(uint8_t Port, const void *pData, uint32_t Length);
+uint8_t ITM_WriteWord(uint8_t Port, uint32_t Word);
+uint32_t ITM_GetDropped(void);
+uint8_t ITM_IsDebuggerAttached(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_STM32L475XX_ITM_DRIVER_H_ */
@@ -0,0 +1,137 @@
+/**************************************************************************//**
+ * @file    stm32l475xx_lptim_driver.h
+ * @brief   Header file for stm32l475xx_lptim_driver.c
+ *
+ * This file has 8 function declarations (input parameters omitted):
+ *      <br>1) LPTIM_PeriphClkControl()     - Enables or disables the LPTIM1 bus clock. </br>
+ *      <br>2) LPTIM_Init()                 - Starts LPTIM1 as a free running 16-bit counter. </br>
+ *      <br>3) LPTIM_DeInit()               - Stops and resets LPTIM1. </br>
+ *      <br>4) LPTIM_GetFrequency()         - Returns the counting frequency. </br>
+ *      <br>5) LPTIM_GetCounter()           - Reads the counter. </br>
+ *      <br>6) LPTIM_SetCompare()           - Programs the compare match. </br>
+ *      <br>7) LPTIM_GetFlags()             - Returns the status flags. </br>
+ *      <br>8) LPTIM_ClearFlags()           - Clears status flags. </br>
+ *
+ * LPTIM1 keeps counting in Stop 0, 1 and 2 when clocked from LSI or LSE,
+ * and its compare match interrupt (EXTI line 32) wakes the device up. The
+ * driver runs it in continuous mode with ARR 0xFFFF: the counter wraps
+ * every 65536 counts and the compare match is set anywhere on that circle.
+ *
+ * The counter runs on the asynchronous kernel clock, it is read until two
+ * consecutive reads match. CMP can only be written with the timer enabled,
+ * once the previous write is done (CMPOK).
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_STM32L475XX_LPTIM_DRIVER_H_
+#define INC_STM32L475XX_LPTIM_DRIVER_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/** @name LPTIM registers bits.
+ */
+///@{
+#define	LPTIM_ISR_CMPM			REG_BIT_0
+#define	LPTIM_ISR_ARRM			REG_BIT_1
+#define	LPTIM_ISR_CMPOK			REG_BIT_3
+#define	LPTIM_ISR_ARROK			REG_BIT_4
+#define	LPTIM_IER_CMPMIE		REG_BIT_0
+#define	LPTIM_CFGR_PRESC		REG_BIT_9	/* 3 bits */
+#define	LPTIM_CR_ENABLE			REG_BIT_0
+#define	LPTIM_CR_CNTSTRT		REG_BIT_2
+#define	RCC_CCIPR_LPTIM1SEL		REG_BIT_18	/* 2 bits */
+#define	RCC_BDCR_LSERDY			REG_BIT_1
+#define	RCC_CSR_LSIRDY			REG_BIT_1
+///@}
+
+/** @name LPTIM kernel clock sources (LPTIM1SEL).
+ */
+///@{
+#define	LPTIM_CLOCK_PCLK		(0U)	/**< Stops in Stop modes */
+#define	LPTIM_CLOCK_LSI			(1U)
+#define	LPTIM_CLOCK_HSI16		(2U)	/**< Stops in Stop modes */
+#define	LPTIM_CLOCK_LSE			(3U)
+///@}
+
+/** @name LPTIM prescalers (PRESC), division by 2^n.
+ */
+///@{
+#define	LPTIM_PRESCALER_DIV1		(0U)
+#define	LPTIM_PRESCALER_DIV2		(1U)
+#define	LPTIM_PRESCALER_DIV4		(2U)
+#define	LPTIM_PRESCALER_DIV8		(3U)
+#define	LPTIM_PRESCALER_DIV16		(4U)
+#define	LPTIM_PRESCALER_DIV32		(5U)
+#define	LPTIM_PRESCALER_DIV64		(6U)
+#define	LPTIM_PRESCALER_DIV128		(7U)
+///@}
+
+/** @name Clock values and counter range.
+ */
+///@{
+#define	LPTIM_LSI_VALUE			(32000UL)
+#define	LPTIM_LSE_VALUE			(32768UL)
+#define	LPTIM_COUNTER_MASK		(0xFFFFUL)
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of LPTIM function status */
+{
+  LPTIM_STATUS_OK = 0,          /**< LPTIM status OK */
+  LPTIM_STATUS_ERROR = 1        /**< Argument error or clock not running */
+}LPTIM_STATUS;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+void LPTIM_PeriphClkControl(uint8_t EnorDi);
+LPTIM_STATUS LPTIM_Init(uint8_t ClockSource, uint8_t Prescaler);
+void LPTIM_DeInit(void);
+uint32_t LPTIM_GetFrequency(void);
+uint16_t LPTIM_GetCounter(void);
+void LPTIM_SetCompare(uint16_t Compare);
+uint32_t LPTIM_GetFlags(void);
+void LPTIM_ClearFlags(uint32_t Flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_STM32L475XX_LPTIM_DRIVER_H_ */
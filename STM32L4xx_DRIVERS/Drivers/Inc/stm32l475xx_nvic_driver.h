@@ -0,0 +1,134 @@
+/**************************************************************************//**
+ * @file    stm32l475xx_nvic_driver.h
+ * @brief   Header file for stm32l475xx_nvic_driver.c
+ *
+ * This file has 16 function declarations (input parameters omitted):
+ *      <br>1) NVIC_IRQConfig()             - Enables or disables an IRQ. </br>
+ *      <br>2) NVIC_IsEnabled()             - Tells if an IRQ is enabled. </br>
+ *      <br>3) NVIC_SetPending()            - Sets the pending state of an IRQ. </br>
+ *      <br>4) NVIC_ClearPending()          - Clears the pending state of an IRQ. </br>
+ *      <br>5) NVIC_IsPending()             - Tells if an IRQ is pending. </br>
+ *      <br>6) NVIC_IsActive()              - Tells if an IRQ is being serviced. </br>
+ *      <br>7) NVIC_TriggerIRQ()            - Pends an IRQ through the STIR register. </br>
+ *      <br>8) NVIC_SetPriority()           - Sets the priority of an IRQ. </br>
+ *      <br>9) NVIC_GetPriority()           - Returns the priority of an IRQ. </br>
+ *      <br>10) NVIC_SetPriorityGrouping()  - Splits the priority in preempt and sub-priority. </br>
+ *      <br>11) NVIC_GetPriorityGrouping()  - Returns the PRIGROUP field. </br>
+ *      <br>12) NVIC_EncodePriority()       - Builds a priority from preempt and sub-priority. </br>
+ *      <br>13) NVIC_DecodePriority()       - Splits a priority in preempt and sub-priority. </br>
+ *      <br>14) NVIC_RelocateVectorTable()  - Copies the vector table to SRAM1 and moves VTOR. </br>
+ *      <br>15) NVIC_SetVector()            - Installs the handler of an IRQ at runtime. </br>
+ *      <br>16) NVIC_GetVector()            - Returns the handler of an IRQ. </br>
+ *
+ * Priorities are the NO_PR_BITS_IMPLEMENTED (4) bits the device implements,
+ * 0 to 15, 0 being the most urgent. The priority grouping decides how many
+ * of them are the preempt priority (an IRQ only interrupts another one with
+ * a higher preempt priority) and how many are the sub-priority (order of the
+ * pending IRQs with the same preempt priority).
+ *
+ * After NVIC_RelocateVectorTable() the core fetches the vectors from SRAM1,
+ * with no flash wait states, and NVIC_SetVector() can change a handler
+ * without the weak symbols of the startup file or a dispatch layer.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_STM32L475XX_NVIC_DRIVER_H_
+#define INC_STM32L475XX_NVIC_DRIVER_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/** @name Priority groupings (PRIGROUP), as preempt bits _ sub-priority bits.
+ */
+///@{
+#define	NVIC_PRIORITYGROUP_4_0		(3U)	/**< 16 preempt levels, reset value equivalent */
+#define	NVIC_PRIORITYGROUP_3_1		(4U)	/**< 8 preempt levels, 2 sub-priorities */
+#define	NVIC_PRIORITYGROUP_2_2		(5U)	/**< 4 preempt levels, 4 sub-priorities */
+#define	NVIC_PRIORITYGROUP_1_3		(6U)	/**< 2 preempt levels, 8 sub-priorities */
+#define	NVIC_PRIORITYGROUP_0_4		(7U)	/**< No preemption, 16 sub-priorities */
+///@}
+
+/** @name IRQ numbers handled by the driver.
+ */
+///@{
+#define	NVIC_IRQ_COUNT			(IRQ_NO_MAX + 1U)
+#define	NVIC_PRIORITY_MAX		((1U << NO_PR_BITS_IMPLEMENTED) - 1U)
+///@}
+
+/** @name Vector table: 16 core exceptions followed by the IRQs.
+ */
+///@{
+#define	NVIC_VECTOR_IRQ_OFFSET		(16U)
+#define	NVIC_VECTOR_COUNT		(NVIC_VECTOR_IRQ_OFFSET + NVIC_IRQ_COUNT)
+#define	NVIC_VECTOR_TABLE_ALIGN		(512U)		/**< Table size rounded up to a power of 2 */
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum
+{
+  NVIC_STATUS_OK,
+  NVIC_STATUS_ERROR
+}NVIC_STATUS;
+
+typedef void (*NVIC_Handler_t)(void);
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+NVIC_STATUS NVIC_IRQConfig(uint8_t IRQnumber, uint8_t Enabler);
+uint8_t NVIC_IsEnabled(uint8_t IRQnumber);
+NVIC_STATUS NVIC_SetPending(uint8_t IRQnumber);
+NVIC_STATUS NVIC_ClearPending(uint8_t IRQnumber);
+uint8_t NVIC_IsPending(uint8_t IRQnumber);
+uint8_t NVIC_IsActive(uint8_t IRQnumber);
+NVIC_STATUS NVIC_TriggerIRQ(uint8_t IRQnumber);
+NVIC_STATUS NVIC_SetPriority(uint8_t IRQnumber, uint8_t Priority);
+uint8_t NVIC_GetPriority(uint8_t IRQnumber);
+NVIC_STATUS NVIC_SetPriorityGrouping(uint32_t PriorityGroup);
+uint32_t NVIC_GetPriorityGrouping(void);
+NVIC_STATUS NVIC_EncodePriority(uint8_t PreemptPriority, uint8_t SubPriority, uint8_t *pPriority);
+void NVIC_DecodePriority(uint8_t Priority, uint8_t *pPreemptPriority, uint8_t *pSubPriority);
+void NVIC_RelocateVectorTable(void);
+NVIC_STATUS NVIC_SetVector(uint8_t IRQnumber, NVIC_Handler_t pHandler);
+NVIC_Handler_t NVIC_GetVector(uint8_t IRQnumber);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_STM32L475XX_NVIC_DRIVER_H_ */
@@ -2,8 +2,17 @@
  * @file    stm32l475xx_pwr_driver.h
  * @brief   Header file for stm32l475xx_pwr_driver.c
  *
- * This file has 1 function declarations (input parameters omitted):
+ * This file has 10 function declarations (input parameters omitted):
  *      <br>1) PWR_ControlVoltageScaling()  - Enables the GPIO peripheral clock. </br>
+ *      <br>2) PWR_EnterSleepMode()         - Enters Sleep mode. </br>
+ *      <br>3) PWR_EnterStopMode()          - Enters Stop 0, 1 or 2 mode. </br>
+ *      <br>4) PWR_EnterStandbyMode()       - Enters Standby mode. </br>
+ *      <br>5) PWR_EnterShutdownMode()      - Enters Shutdown mode. </br>
+ *      <br>6) PWR_ConfigWakeupPin()        - Configures a WKUP pin. </br>
+ *      <br>7) PWR_GetWakeupFlags()         - Returns the PWR_SR1 wakeup flags. </br>
+ *      <br>8) PWR_ClearWakeupFlags()       - Clears the wakeup and standby flags. </br>
+ *      <br>9) PWR_EnableLowPowerRun()      - Puts the regulator in low-power mode (LPR). </br>
+ *      <br>10) PWR_DisableLowPowerRun()    - Puts the regulator back in main mode. </br>
  *
  * @version 1.0.0.0
  *
@@ -49,6 +58,68 @@ extern "C"
 #define	PWR_VOLTAGE_RANGE_2		(2U)
 ///@}
 
+/** @name Low-power mode entry instruction.
+ */
+///@{
+#define	PWR_ENTRY_WFI			(0U)
+#define	PWR_ENTRY_WFE			(1U)
+///@}
+
+/** @name Stop modes (PWR_CR1 LPMS values).
+ */
+///@{
+#define	PWR_LPMS_STOP0			(0UL)
+#define	PWR_LPMS_STOP1			(1UL)
+#define	PWR_LPMS_STOP2			(2UL)
+#define	PWR_LPMS_STANDBY		(3UL)
+#define	PWR_LPMS_SHUTDOWN		(4UL)
+///@}
+
+/** @name Wakeup pins and polarity.
+ */
+///@{
+#define	PWR_WAKEUP_PIN1			(1U)	/**< PA0 */
+#define	PWR_WAKEUP_PIN2			(2U)	/**< PC13 */
+#define	PWR_WAKEUP_PIN3			(3U)	/**< PE6 */
+#define	PWR_WAKEUP_PIN4			(4U)	/**< PA2 */
+#define	PWR_WAKEUP_PIN5			(5U)	/**< PC5 */
+
+#define	PWR_WAKEUP_RISING		(0U)
+#define	PWR_WAKEUP_FALLING		(1U)
+///@}
+
+/** @name WFI attempts before Standby or Shutdown entry is reported as
+ *  refused. Can be overridden from the compiler command line.
+ */
+///@{
+#ifndef PWR_DEEP_ENTRY_ATTEMPTS
+#define	PWR_DEEP_ENTRY_ATTEMPTS		(3U)
+#endif
+///@}
+
+/** @name Highest system clock allowed in Low-power run mode.
+ */
+///@{
+#define	PWR_LPRUN_MAX_FREQUENCY		(2000000UL)
+///@}
+
+/** @name PWR register bits.
+ */
+///@{
+#define	PWR_CR1_LPMS			REG_BIT_0	/* 3 bits */
+#define	PWR_CR1_VOS			REG_BIT_9	/* 2 bits */
+#define	PWR_CR1_LPR			REG_BIT_14
+#define	PWR_SR2_REGLPF			REG_BIT_9
+#define	PWR_SR2_VOSF			REG_BIT_10
+#define	PWR_CR3_RRS			REG_BIT_8
+#define	PWR_CR3_EIWUL			REG_BIT_15
+#define	PWR_SR1_WUF_MASK		(0x1FUL)
+#define	PWR_SR1_SBF			REG_BIT_8
+#define	PWR_SR1_WUFI			REG_BIT_15
+#define	PWR_SCR_CWUF_MASK		(0x1FUL)
+#define	PWR_SCR_CSBF			REG_BIT_8
+///@}
+
 /*****************************************************************************/
   /* TYPEDEFS */
 /*****************************************************************************/
@@ -66,6 +137,15 @@ typedef enum
   /* FUNCTION DECLARATIONS */
 /*****************************************************************************/
 PWR_STATUS PWR_ControlVoltageScaling(uint32_t VoltageScaling);
+void PWR_EnterSleepMode(uint8_t Entry);
+PWR_STATUS PWR_EnterStopMode(uint32_t StopMode, uint8_t Entry);
+PWR_STATUS PWR_EnterStandbyMode(void);
+PWR_STATUS PWR_EnterShutdownMode(void);
+PWR_STATUS PWR_ConfigWakeupPin(uint8_t WakeupPin, uint8_t Polarity, uint8_t Enabler);
+uint32_t PWR_GetWakeupFlags(void);
+void PWR_ClearWakeupFlags(void);
+PWR_STATUS PWR_EnableLowPowerRun(void);
+void PWR_DisableLowPowerRun(void);
 
 #ifdef __cplusplus
 }
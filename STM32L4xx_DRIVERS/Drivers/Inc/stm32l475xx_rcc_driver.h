@@ -2,7 +2,7 @@
  * @file    stm32l475xx_rcc_driver.h
  * @brief   Header file for stm32l475xx_rcc_driver.c
  *
- * This file has 8 functions definitions (input parameters omitted):
+ * This file has 11 functions definitions (input parameters omitted):
  *      <br>1) RCC_Config_MSI()         - Configures MSI as system clock. </br>
  *      <br>2) RCC_Config_HSI()         - Configures HSI as system clock. </br>
  *      <br>3) RCC_Config_PLLCLK()      - Configures PLL as system clock. </br>
@@ -11,6 +11,9 @@
  *      <br>6) RCC_GetSYSCLK()          - Gets system clock value. </br>
  *      <br>7) RCC_GetHCLK()            - Gets HCLK clock value. </br>
  *      <br>8) RCC_GetMSIfreq()         - Gets the MSI range. </br>
+ *      <br>9) RCC_GetHCLKCached()      - Gets the HCLK saved at the last clock change. </br>
+ *      <br>10) RCC_RegisterClockChangeCallback() - Calls a function on every HCLK change. </br>
+ *      <br>11) RCC_NotifyClockChange() - Updates the saved HCLK and calls the callbacks. </br>
  *
  * @version 1.0.0.0
  *
@@ -50,6 +53,23 @@ extern "C"
   /* DEFINES */
 /******************************************************************************/
 
+/** @name RCC_CR and RCC_CFGR bits.
+ */
+///@{
+#define	RCC_CR_MSION			REG_BIT_0
+#define	RCC_CR_MSIRDY			REG_BIT_1
+#define	RCC_CR_HSION			REG_BIT_8
+#define	RCC_CR_HSIRDY			REG_BIT_10
+#define	RCC_CR_HSEON			REG_BIT_16
+#define	RCC_CR_HSERDY			REG_BIT_17
+#define	RCC_CR_PLLON			REG_BIT_24
+#define	RCC_CR_PLLRDY			REG_BIT_25
+
+#define	RCC_CFGR_SW			REG_BIT_0	/* 2 bits */
+#define	RCC_CFGR_SWS			REG_BIT_2	/* 2 bits */
+#define	RCC_CFGR_STOPWUCK		REG_BIT_15
+///@}
+
 /** @name RCC speed values.
  */
 ///@{
@@ -157,6 +177,15 @@ extern "C"
 #define RCC_PLLM_8			(7UL)
 ///@}
 
+/** @name Clock change callbacks. ITM, SysTick, delay and timestamp take
+ *  four, the rest is headroom for the application.
+ */
+///@{
+#ifndef RCC_CLOCK_CALLBACKS
+#define	RCC_CLOCK_CALLBACKS		(8U)
+#endif
+///@}
+
 /*****************************************************************************/
   /* TYPEDEFS */
 /*****************************************************************************/
@@ -166,6 +195,8 @@ typedef enum    /**< enum of RCC function status */
   RCC_STATUS_ERROR = 1          /**< RCC status ERROR */
 }RCC_STATUS;
 
+typedef void (*RCC_ClockCallback_t)(uint32_t HCLK);
+
 /*****************************************************************************/
   /* CONSTANTS */
 /*****************************************************************************/
@@ -181,6 +212,9 @@ RCC_STATUS RCC_Config_PLLCLK(uint32_t ClockSource, uint32_t ClockSourceFrequency
 void RCC_Config_MCO(uint8_t MCOprescaler, uint8_t MCOoutput);
 uint32_t RCC_GetSYSCLK(void);
 uint32_t RCC_GetHCLK(void);
+uint32_t RCC_GetHCLKCached(void);
+RCC_STATUS RCC_RegisterClockChangeCallback(RCC_ClockCallback_t pCallback);
+void RCC_NotifyClockChange(void);
 uint32_t RCC_GetMSIfreq(uint32_t RCC_MSISPEED);
 
 #ifdef __cplusplus
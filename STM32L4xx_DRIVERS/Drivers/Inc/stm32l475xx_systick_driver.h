@@ -0,0 +1,100 @@
+/**************************************************************************//**
+ * @file    stm32l475xx_systick_driver.h
+ * @brief   Header file for stm32l475xx_systick_driver.c
+ *
+ * This file has 8 function declarations (input parameters omitted):
+ *      <br>1) SYSTICK_Init()               - Starts the periodic tick from HCLK. </br>
+ *      <br>2) SYSTICK_Stop()               - Stops the tick. </br>
+ *      <br>3) SYSTICK_SetTickHook()        - Function called on every tick. </br>
+ *      <br>4) SYSTICK_GetTicks()           - Returns the ticks since SYSTICK_Init(). </br>
+ *      <br>5) SYSTICK_GetTickHz()          - Returns the tick frequency. </br>
+ *      <br>6) SYSTICK_Suspend()            - Stops the tick for a tickless sleep. </br>
+ *      <br>7) SYSTICK_Resume()             - Accounts the slept ticks and restarts. </br>
+ *      <br>8) SysTick_Handler()            - SysTick exception handler. </br>
+ *
+ * The SysTick counts HCLK cycles. The reload value is computed from the HCLK
+ * cached by the RCC driver, and recomputed by a clock change callback every
+ * time an RCC_Config_xxx() function changes HCLK, so the tick keeps its
+ * frequency across clock changes. The tick in progress during a change is
+ * restarted and ends up between one old and one new period long.
+ *
+ * The SysTick stops in Stop modes: the tick count does not include the time
+ * spent in them.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_STM32L475XX_SYSTICK_DRIVER_H_
+#define INC_STM32L475XX_SYSTICK_DRIVER_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/** @name Usual tick frequencies.
+ */
+///@{
+#define	SYSTICK_1KHZ			(1000UL)
+#define	SYSTICK_100HZ			(100UL)
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of SYSTICK function status */
+{
+  SYSTICK_STATUS_OK = 0,        /**< SYSTICK status OK */
+  SYSTICK_STATUS_ERROR = 1      /**< Argument error or period out of the 24-bit range */
+}SYSTICK_STATUS;
+
+typedef void (*SYSTICK_Hook_t)(void);
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+SYSTICK_STATUS SYSTICK_Init(uint32_t TickHz, uint8_t IRQpriority);
+void SYSTICK_Stop(void);
+void SYSTICK_SetTickHook(SYSTICK_Hook_t pHook);
+uint32_t SYSTICK_GetTicks(void);
+uint32_t SYSTICK_GetTickHz(void);
+uint32_t SYSTICK_Suspend(void);
+void SYSTICK_Resume(uint32_t Ticks);
+void SysTick_Handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_STM32L475XX_SYSTICK_DRIVER_H_ */
@@ -3,8 +3,15 @@
  * @brief   This file contains the function definitions for the Flash driver
  *          for the STM32L475VG microcontroller.
  *
- * This file has 1 function definition (input parameters omitted):
- *      <br>1) FLASH_SetLatency()  - Enables the GPIO peripheral clock. </br>
+ * This file has 8 function definitions (input parameters omitted):
+ *      <br>1) FLASH_SetLatency()           - Enables the GPIO peripheral clock. </br>
+ *      <br>2) FLASH_Unlock()               - Unlocks the FLASH_CR register. </br>
+ *      <br>3) FLASH_Lock()                 - Locks the FLASH_CR register. </br>
+ *      <br>4) FLASH_ErasePage()            - Erases one 2 KB page. </br>
+ *      <br>5) FLASH_ProgramDoubleWord()    - Programs a 64-bit double word. </br>
+ *      <br>6) FLASH_ConfigART()            - Configures prefetch and the ART caches. </br>
+ *      <br>7) FLASH_SetRunPowerDown()      - Powers the flash down in Run/LPRun. </br>
+ *      <br>8) FLASH_SetSleepPowerDown()    - Powers the flash down in Sleep/LPSleep. </br>
  *
  * @version 1.0.0.0
  *
@@ -51,6 +58,7 @@
 /*****************************************************************************/
   /* DEPENDENCIES */
 /*****************************************************************************/
+static FLASH_STATUS FLASH_WaitForLastOperation(void);
 
 /*****************************************************************************/
   /* FUNCTION DEFINITIONS */
@@ -64,47 +72,297 @@
 ******************************************************************************/
 void FLASH_SetLatency(uint32_t freq_HCLK)
 {
-	/* uint32_t LatencyValue = 0; */
-
-	/* Clearing register */
-	FLASH->FLASH_ACR &= ~(0x7 << 0);
+	uint32_t LatencyValue;
 
 	/* For voltage Range 1 */
 	if((freq_HCLK > 0) & (freq_HCLK <= 16000000UL))
 	{
 		/* 0 wait state */
-		FLASH->FLASH_ACR |= FLASH_LATENCY_ZERO_WAITSTATE;
-		/* LatencyValue = FLASH_LATENCY_ZERO_WAITSTATE; */
+		LatencyValue = FLASH_LATENCY_ZERO_WAITSTATE;
 	}
 	else if((freq_HCLK > 16000000UL) & (freq_HCLK <= 32000000UL))
 	{
 		/* 1 wait state */
-		FLASH->FLASH_ACR |= FLASH_LATENCY_ONE_WAITSTATE;
-		/* LatencyValue = FLASH_LATENCY_ONE_WAITSTATE; */
+		LatencyValue = FLASH_LATENCY_ONE_WAITSTATE;
 	}
 	else if((freq_HCLK > 32000000UL) & (freq_HCLK <= 48000000UL))
 	{
 		/* 2 wait state */
-		FLASH->FLASH_ACR |= FLASH_LATENCY_TWO_WAITSTATE;
-		/* LatencyValue = FLASH_LATENCY_TWO_WAITSTATE; */
+		LatencyValue = FLASH_LATENCY_TWO_WAITSTATE;
 	}
 	else if((freq_HCLK > 48000000UL) & (freq_HCLK <= 64000000UL))
 	{
 		/* 3 wait state */
-		FLASH->FLASH_ACR |= FLASH_LATENCY_THREE_WAITSTATE;
-		/* LatencyValue = FLASH_LATENCY_THREE_WAITSTATE; */
+		LatencyValue = FLASH_LATENCY_THREE_WAITSTATE;
 	}
 	else if((freq_HCLK > 64000000UL) & (freq_HCLK <= 80000000UL))
 	{
 		/* 4 wait state */
-		FLASH->FLASH_ACR |= FLASH_LATENCY_FOUR_WAITSTATE;
-		/* LatencyValue = FLASH_LATENCY_FOUR_WAITSTATE; */
+		LatencyValue = FLASH_LATENCY_FOUR_WAITSTATE;
 	}
 	else
 	{
 		/* Frequency out of range */
+		return;
 	}
 
+	/* One write: clearing the field first would run the current HCLK with
+	 * 0 wait states for a moment */
+	FLASH->FLASH_ACR = (FLASH->FLASH_ACR & ~(0x7UL << 0)) | LatencyValue;
+
 	/* Check if this new setting is being taken into account by reading the LATENCY bits in the FLASH_ACR register */
-	//while((FLASH->FLASH_ACR)&(0x00000007) != LatencyValue);
+	while(((FLASH->FLASH_ACR) & (0x7UL)) != LatencyValue);
+}
+
+/**************************************************************************//**
+* @brief       This function unlocks the FLASH_CR register by writing the key
+*              sequence into FLASH_KEYR. It does nothing if it is already
+*              unlocked.
+*
+* @return      FLASH_STATUS_OK or FLASH_STATUS_ERROR
+******************************************************************************/
+FLASH_STATUS FLASH_Unlock(void)
+{
+	if(READ_REG_BIT(FLASH->FLASH_CR, FLASH_CR_LOCK) != 0)
+	{
+		FLASH->FLASH_KEYR = FLASH_KEY1;
+		FLASH->FLASH_KEYR = FLASH_KEY2;
+	}
+
+	/* A wrong sequence keeps the register locked until the next reset */
+	if(READ_REG_BIT(FLASH->FLASH_CR, FLASH_CR_LOCK) != 0)
+	{
+		return FLASH_STATUS_ERROR;
+	}
+
+	return FLASH_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function locks the FLASH_CR register again.
+******************************************************************************/
+void FLASH_Lock(void)
+{
+	SET_REG_BIT(FLASH->FLASH_CR, FLASH_CR_LOCK);
+}
+
+/**************************************************************************//**
+* @brief       This function erases the 2 KB page that contains the given
+*              address. FLASH_CR must be unlocked.
+*
+*              The page is erased in the bank it belongs to, so erasing a
+*              page of bank 2 does not stall code fetched from bank 1.
+*
+* @param       PageAddress      Any address inside the page to erase.
+*
+* @return      FLASH_STATUS_OK or FLASH_STATUS_ERROR
+******************************************************************************/
+FLASH_STATUS FLASH_ErasePage(uint32_t PageAddress)
+{
+	FLASH_STATUS status;
+	uint32_t offset;
+	uint32_t page;
+
+	if((PageAddress < FLASH_BASE_ADDRESS) || (PageAddress >= (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE)))
+	{
+		return FLASH_STATUS_ERROR;
+	}
+
+	offset = PageAddress - FLASH_BASE_ADDRESS;
+	page = (offset % FLASH_BANK_SIZE) / FLASH_PAGE_SIZE;
+
+	/* Check that no flash memory operation is ongoing */
+	if(FLASH_WaitForLastOperation() != FLASH_STATUS_OK)
+	{
+		return FLASH_STATUS_ERROR;
+	}
+
+	/* Select the bank and the page number */
+	if(offset >= FLASH_BANK_SIZE)
+	{
+		SET_REG_BIT(FLASH->FLASH_CR, FLASH_CR_BKER);
+	}
+	else
+	{
+		CLR_REG_BIT(FLASH->FLASH_CR, FLASH_CR_BKER);
+	}
+	FLASH->FLASH_CR &= ~(0xFFUL << FLASH_CR_PNB);
+	FLASH->FLASH_CR |= (page << FLASH_CR_PNB);
+	SET_REG_BIT(FLASH->FLASH_CR, FLASH_CR_PER);
+
+	/* Start the erase operation */
+	SET_REG_BIT(FLASH->FLASH_CR, FLASH_CR_STRT);
+
+	status = FLASH_WaitForLastOperation();
+
+	CLR_REG_BIT(FLASH->FLASH_CR, FLASH_CR_PER);
+
+	/* The data cache may still hold lines of the erased page. It can only be
+	 * reset while it is disabled. */
+	if(READ_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_DCEN) != 0)
+	{
+		CLR_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_DCEN);
+		SET_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_DCRST);
+		CLR_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_DCRST);
+		SET_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_DCEN);
+	}
+
+	return status;
+}
+
+/**************************************************************************//**
+* @brief       This function programs a 64-bit double word. FLASH_CR must be
+*              unlocked and the address must be 8-byte aligned.
+*
+*              The double word must be erased beforehand, the only exception
+*              is writing all zeros over already programmed data.
+*
+* @param       Address          Destination address in flash memory.
+* @param       Data             Double word to program.
+*
+* @return      FLASH_STATUS_OK or FLASH_STATUS_ERROR
+******************************************************************************/
+FLASH_STATUS FLASH_ProgramDoubleWord(uint32_t Address, uint64_t Data)
+{
+	FLASH_STATUS status;
+
+	if(((Address & 0x7U) != 0) || (Address < FLASH_BASE_ADDRESS) || (Address >= (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE)))
+	{
+		return FLASH_STATUS_ERROR;
+	}
+
+	/* Check that no flash memory operation is ongoing */
+	if(FLASH_WaitForLastOperation() != FLASH_STATUS_OK)
+	{
+		return FLASH_STATUS_ERROR;
+	}
+
+	SET_REG_BIT(FLASH->FLASH_CR, FLASH_CR_PG);
+
+	/* Both words must be written back to back, the first one at the aligned address */
+	*(__vo uint32_t*)Address = (uint32_t)Data;
+	*(__vo uint32_t*)(Address + 4U) = (uint32_t)(Data >> 32);
+
+	status = FLASH_WaitForLastOperation();
+
+	CLR_REG_BIT(FLASH->FLASH_CR, FLASH_CR_PG);
+
+	return status;
+}
+
+/**************************************************************************//**
+* @brief       This function configures the ART accelerator: the prefetch
+*              buffer and the instruction and data caches. A cache that gets
+*              disabled is also reset, so it starts empty when enabled again.
+*
+*              The instruction cache holds 32 lines of 64 bits, code that is
+*              executed together should be placed together (.text.hot).
+*
+* @param       Prefetch         ENABLE or DISABLE the prefetch buffer.
+* @param       ICache           ENABLE or DISABLE the instruction cache.
+* @param       DCache           ENABLE or DISABLE the data cache.
+******************************************************************************/
+void FLASH_ConfigART(uint8_t Prefetch, uint8_t ICache, uint8_t DCache)
+{
+	if(Prefetch == ENABLE)
+	{
+		SET_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_PRFTEN);
+	}
+	else
+	{
+		CLR_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_PRFTEN);
+	}
+
+	/* The reset bits can only be written while the cache is disabled */
+	CLR_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_ICEN);
+	if(ICache == ENABLE)
+	{
+		SET_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_ICEN);
+	}
+	else
+	{
+		SET_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_ICRST);
+		CLR_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_ICRST);
+	}
+
+	CLR_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_DCEN);
+	if(DCache == ENABLE)
+	{
+		SET_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_DCEN);
+	}
+	else
+	{
+		SET_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_DCRST);
+		CLR_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_DCRST);
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function powers the flash down, or up again, while the
+*              device is in Run or Low-power run mode. RUN_PD is protected by
+*              the FLASH_PDKEYR sequence, which is needed for every write.
+*
+*              While the flash is down nothing may be fetched from it: this
+*              function runs from SRAM2 and so must its caller, the vector
+*              table and every handler that can be taken in the meantime.
+*
+* @param       Enabler          ENABLE powers the flash down, DISABLE wakes it up.
+******************************************************************************/
+__RAMFUNC void FLASH_SetRunPowerDown(uint8_t Enabler)
+{
+	FLASH->FLASH_PDKEYR = FLASH_PDKEY1;
+	FLASH->FLASH_PDKEYR = FLASH_PDKEY2;
+
+	if(Enabler == ENABLE)
+	{
+		SET_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_RUN_PD);
+	}
+	else
+	{
+		CLR_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_RUN_PD);
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function selects whether the flash is powered down while
+*              the device is in Sleep or Low-power sleep mode. The wakeup takes
+*              longer because the flash has to power up before the first fetch.
+*
+* @param       Enabler          ENABLE or DISABLE.
+******************************************************************************/
+void FLASH_SetSleepPowerDown(uint8_t Enabler)
+{
+	if(Enabler == ENABLE)
+	{
+		SET_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_SLEEP_PD);
+	}
+	else
+	{
+		CLR_REG_BIT(FLASH->FLASH_ACR, FLASH_ACR_SLEEP_PD);
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function waits until the BSY flag is cleared and then
+*              checks and clears the error flags of FLASH_SR.
+*
+* @return      FLASH_STATUS_OK or FLASH_STATUS_ERROR
+******************************************************************************/
+static FLASH_STATUS FLASH_WaitForLastOperation(void)
+{
+	uint32_t errors;
+
+	while(READ_REG_BIT(FLASH->FLASH_SR, FLASH_SR_BSY) != 0);
+
+	errors = FLASH->FLASH_SR & FLASH_SR_ERRORS_MASK;
+
+	/* Error flags and EOP are cleared by writing 1 */
+	FLASH->FLASH_SR = errors | (0x1UL << FLASH_SR_EOP);
+
+	if(errors != 0)
+	{
+		return FLASH_STATUS_ERROR;
+	}
+
+	return FLASH_STATUS_OK;
 }
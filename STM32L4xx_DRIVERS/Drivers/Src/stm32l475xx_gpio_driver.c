@@ -12,7 +12,7 @@
  *      <br>6) GPIO_WritePin()          - Writes the state of a GPIO pin. </br>
  *      <br>7) GPIO_WritePort()         - Writes the state of a GPIO port. </br>
  *      <br>8) GPIO_TogglePin()         - Toggles the state of a GPIO pin. </br>
- *      <br>9) GPIO_IRQConfig()         - Not implemented yet. </br>
+ *      <br>9) GPIO_IRQConfig()         - Configures the NVIC side of an EXTI IRQ. </br>
  *      <br>10) GPIO_IRQHandling()      - Not implemented yet. </br>
  *
  * @version 1.0.0.0
@@ -33,6 +33,7 @@
 /* Here go the system header files */
 
 /* Here go the project includes */
+#include <stm32l475xx_nvic_driver.h>
 
 /* Here go the own includes */
 #include <stm32l475xx_gpio_driver.h>
@@ -282,13 +283,13 @@ void GPIO_Init(GPIO_Handle_t* pGPIOHandle)
 
   /* 2. Configure the speed */
   temp = pGPIOHandle->GPIO_PinConfig.GPIO_PinSpeed << (2*(pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber));
-  pGPIOHandle->pGPIOx->GPIO_OSPEEDR &= ~(0x3 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
+  pGPIOHandle->pGPIOx->GPIO_OSPEEDR &= ~(0x3 << (2*(pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber)));
   pGPIOHandle->pGPIOx->GPIO_OSPEEDR |= temp;
   temp = 0;
 
   /* 3. Configure the pull-up/pull-down */
   temp = pGPIOHandle->GPIO_PinConfig.GPIO_PinPuPdControl << (2*(pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber));
-  pGPIOHandle->pGPIOx->GPIO_PUPDR &= ~(0x3 << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
+  pGPIOHandle->pGPIOx->GPIO_PUPDR &= ~(0x3 << (2*(pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber)));
   pGPIOHandle->pGPIOx->GPIO_PUPDR |= temp;
   temp = 0;
 
@@ -301,16 +302,16 @@ void GPIO_Init(GPIO_Handle_t* pGPIOHandle)
   /* 5. Configure the alternate functionality */
   if(pGPIOHandle->GPIO_PinConfig.GPIO_PinMode == GPIO_MODE_ALTFN)
   {
-          temp = pGPIOHandle->GPIO_PinConfig.GPIO_PinAltFunMode << (4*(pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber));
+          temp = pGPIOHandle->GPIO_PinConfig.GPIO_PinAltFunMode << (4*(pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber % 8));
 
           if((pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber >= 0) && (pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber <= 7))
           {
-                  pGPIOHandle->pGPIOx->GPIO_AFRL &= ~(0xF << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
+                  pGPIOHandle->pGPIOx->GPIO_AFRL &= ~(0xF << (4*(pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber % 8)));
                   pGPIOHandle->pGPIOx->GPIO_AFRL |= temp;
           }
           else if((pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber > 7) && (pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber <= 15))
           {
-                  pGPIOHandle->pGPIOx->GPIO_AFRH &= ~(0xF << pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber);
+                  pGPIOHandle->pGPIOx->GPIO_AFRH &= ~(0xF << (4*(pGPIOHandle->GPIO_PinConfig.GPIO_PinNumber % 8)));
                   pGPIOHandle->pGPIOx->GPIO_AFRH |= temp;
           }
   }
@@ -369,7 +370,7 @@ void GPIO_DeInit(GPIO_RegDef_t* pGPIOx)
 *
 * @return       Pin state stored in a uint8_t (1 == pin is set, 0 == pin is cleared).
 ******************************************************************************/
-uint8_t GPIO_ReadPin(GPIO_RegDef_t* pGPIOx, uint8_t PinNumber)
+__HOT uint8_t GPIO_ReadPin(GPIO_RegDef_t* pGPIOx, uint8_t PinNumber)
 {
   uint8_t value;
   value = (uint8_t) (((pGPIOx->GPIO_IDR) >> PinNumber) & (0x00000001));
@@ -399,7 +400,7 @@ uint16_t GPIO_ReadPort(GPIO_RegDef_t* pGPIOx)
 * @param        PinNumber	Number of the pin to write to.
 * @param        PinValue        Value to write to the pin (1 == pin is set, 0 == pin is cleared).
 ******************************************************************************/
-void GPIO_WritePin(GPIO_RegDef_t* pGPIOx, uint8_t PinNumber, uint8_t PinValue)
+__HOT void GPIO_WritePin(GPIO_RegDef_t* pGPIOx, uint8_t PinNumber, uint8_t PinValue)
 {
   if(PinValue == GPIO_PIN_SET)
   {
@@ -429,76 +430,26 @@ void GPIO_WritePort(GPIO_RegDef_t* pGPIOx, uint16_t PortValue)
 * @param        pGPIOx		Base address. The pointer to the base address of a GPIO.
 * @param        PinNumber	Number of the pin to toggle.
 ******************************************************************************/
-void GPIO_TogglePin(GPIO_RegDef_t* pGPIOx, uint8_t PinNumber)
+__RAMFUNC void GPIO_TogglePin(GPIO_RegDef_t* pGPIOx, uint8_t PinNumber)
 {
   pGPIOx->GPIO_ODR ^= (1 << PinNumber);
 }
 
 /**************************************************************************//**
 * @brief        API for configuring the interruptions on the processor side.
+*               The NVIC work is done by the NVIC driver.
 *
 * @param        IRQnumber       Interrupt Request Number to configure.
-* @param        IRQpriority	Priority of the IRQ.
+* @param        IRQpriority	Priority of the IRQ, 0 to NVIC_PRIORITY_MAX.
+*                               Build it with NVIC_EncodePriority() when a
+*                               priority grouping is used.
 * @param        Enabler         Enabler of the IRQ to the processor.
 ******************************************************************************/
 void GPIO_IRQConfig(uint8_t IRQnumber, uint8_t IRQpriority, uint8_t Enabler)
 {
-  /* Pin must be in input mode because you are receiving an interrupt */
-  /* Configure the edge detection (rising edge, falling edge, both) */
-  /* Enable interrupt delivery from peripheral to processor (in peripheral side) */
-  /* Identify the IRQ number on which the processor accepts the interrupt from that pin */
-  /* Configure the IRQ priority for the identified IRQ number (processor side on NVIC registers) */
-  /* Enable interrupt reception on that IRQ number (processor side in NVIC registers) */
-  /* Implement IRQ handler */
-
-  /* Enabling/Disabling an IRQ number */
-  if(Enabler == ENABLE)
-  {
-    /* The IRQ number interrupt will be enabled */
-    if(IRQnumber <= 31)
-    {
-      /* Program NVIC_ISER0 */
-      *NVIC_ISER0 |= (0x1UL << IRQnumber);
-    }
-    else if((IRQnumber > 31) & (IRQnumber < 64))
-    {
-      /* Program NVIC_ISER1 */
-      *NVIC_ISER1 |= (0x1UL << (IRQnumber%32));
-    }
-    else if((IRQnumber >= 64) & (IRQnumber < 96))
-    {
-      /* Program NVIC_ISER2 */
-      *NVIC_ISER2 |= (0x1UL << (IRQnumber%64));
-    }
-  }
-  else
-  {
-    /* The IRQ number interrupt will be disabled */
-    if(IRQnumber <= 31)
-    {
-      /* Program NVIC_ICER0 */
-      *NVIC_ICER0 |= (0x1UL << IRQnumber);
-    }
-    else if((IRQnumber > 31) & (IRQnumber < 64))
-    {
-      /* Program NVIC_ICER1 */
-      *NVIC_ICER1 |= (0x1UL << (IRQnumber%32));
-    }
-    else if((IRQnumber >= 64) & (IRQnumber < 96))
-    {
-      /* Program NVIC_ICER2 */
-      *NVIC_ICER2 |= (0x1UL << (IRQnumber%64));
-    }
-  }
-
-  /* Setting the priority for the given IRQ number */
-  uint8_t IPRx = IRQnumber / 4;
-  uint8_t IPRx_offset = IRQnumber % 4;
-  uint8_t shift_amount = (8*IPRx_offset) + (8 - NO_PR_BITS_IMPLEMENTED);
-
-  *(NVIC_PRIORITY_BASE_ADDRESS + (IPRx*4)) &= ~(0xFF << (8*IPRx_offset));
-  *(NVIC_PRIORITY_BASE_ADDRESS + (IPRx*4)) |= (IRQpriority << shift_amount);
-
+  /* Priority first, so the IRQ never runs with the previous one */
+  (void)NVIC_SetPriority(IRQnumber, IRQpriority);
+  (void)NVIC_IRQConfig(IRQnumber, Enabler);
 }
 
 /**************************************************************************//**
@@ -506,12 +457,13 @@ void GPIO_IRQConfig(uint8_t IRQnumber, uint8_t IRQpriority, uint8_t Enabler)
 *
 * @param        PinNumber       Interrupt Request Number to configure.
 ******************************************************************************/
-void GPIO_IRQHandling(uint8_t PinNumber)
+__RAMFUNC void GPIO_IRQHandling(uint8_t PinNumber)
 {
   /* Clear the EXTI Pending Register */
   if(EXTI->EXTI_PR1 & (1 << PinNumber))
   {
-    /* You clear the register by writing a 1 */
-    EXTI->EXTI_PR1 |= (1 << PinNumber);
+    /* You clear the register by writing a 1, a read-modify-write would also
+     * clear the other pending lines */
+    EXTI->EXTI_PR1 = (1UL << PinNumber);
   }
 }
@@ -0,0 +1,1174 @@
+/**************************************************************************//**
+ * @file    stm32l475xx_host_sim.c
+ * @brief   This file contains the function definitions for the register
+ *          simulation used to run the drivers on a Linux host.
+ *
+ * This file has 8 function definitions (input parameters omitted):
+ *      <br>1) SIM_Init()                   - Maps the register ranges and installs the access traps. </br>
+ *      <br>2) SIM_Reset()                  - Puts the registers and the models in their reset state. </br>
+ *      <br>3) SIM_Run()                    - Runs a function, stopping it if it polls forever. </br>
+ *      <br>4) SIM_SetPin()                 - Drives a GPIO input, with its EXTI edge. </br>
+ *      <br>5) SIM_GetHCLK()                - HCLK given by the simulated RCC. </br>
+ *      <br>6) SIM_AddCycles()              - Advances the simulated time. </br>
+ *      <br>7) SIM_GetStats()               - Returns the access and violation counters. </br>
+ *      <br>8) SIM_ClearStats()             - Clears the counters. </br>
+ *
+ * Only compiled with STM32L475XX_HOST_SIM, on x86-64 Linux.
+ *
+ * The register ranges are one memfd mapped twice: at the real addresses
+ * with no access rights, for the drivers, and anywhere with read/write
+ * rights, for the models. A driver access raises SIGSEGV: the handler runs
+ * the models that give the value to read, opens the page and sets the trap
+ * flag. The access is done, SIGTRAP follows: the handler runs the models of
+ * the written value and closes the page again.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+#ifdef STM32L475XX_HOST_SIM
+
+#define	_GNU_SOURCE
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+#include <setjmp.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <stm32l475xx_host_sim.h>
+#include <stm32l475xx_nvic_driver.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+#if !defined(__linux__) || !defined(__x86_64__)
+#error "The register simulation needs x86-64 Linux"
+#endif
+
+#ifndef MAP_FIXED_NOREPLACE
+#define	MAP_FIXED_NOREPLACE		(0x100000)
+#endif
+
+/** @name Simulated address ranges.
+ */
+///@{
+#define	SIM_PAGE_SIZE			(0x1000UL)
+#define	SIM_PERIPH_BASE			((uintptr_t)PERIPH_BASE_ADDRESS)
+#define	SIM_PERIPH_SIZE			(0x10061000UL)		/* Up to RNG */
+#define	SIM_CORE_BASE			((uintptr_t)0xE0000000UL)
+#define	SIM_CORE_SIZE			(0x00100000UL)
+///@}
+
+/** @name x86-64 trap flag and page fault error code.
+ */
+///@{
+#define	SIM_EFLAGS_TF			(0x100ULL)
+#define	SIM_PF_WRITE			(0x2ULL)
+///@}
+
+/** @name Register bits used by the models.
+ */
+///@{
+#define	SIM_RCC_CR_MSION		(1UL << 0)
+#define	SIM_RCC_CR_MSIRDY		(1UL << 1)
+#define	SIM_RCC_CR_MSIRGSEL		(1UL << 3)
+#define	SIM_RCC_CR_MSIRANGE		(0xFUL << 4)
+#define	SIM_RCC_CR_HSION		(1UL << 8)
+#define	SIM_RCC_CR_HSIRDY		(1UL << 10)
+#define	SIM_RCC_CR_HSEON		(1UL << 16)
+#define	SIM_RCC_CR_HSERDY		(1UL << 17)
+#define	SIM_RCC_CR_PLLON		(1UL << 24)
+#define	SIM_RCC_CR_PLLRDY		(1UL << 25)
+#define	SIM_RCC_CR_READY		(SIM_RCC_CR_MSIRDY | SIM_RCC_CR_HSIRDY | SIM_RCC_CR_HSERDY | SIM_RCC_CR_PLLRDY)
+#define	SIM_RCC_PLLCFGR_ENABLES		((1UL << 16) | (1UL << 20) | (1UL << 24))	/* Writable with the PLL on */
+#define	SIM_RCC_PLLCFGR_PLLREN		(1UL << 24)
+#define	SIM_RCC_CSR_LSION		(1UL << 0)
+#define	SIM_RCC_CSR_LSIRDY		(1UL << 1)
+#define	SIM_RCC_BDCR_LSEON		(1UL << 0)
+#define	SIM_RCC_BDCR_LSERDY		(1UL << 1)
+#define	SIM_RCC_APB1RSTR1_LPTIM1RST	(1UL << 31)
+#define	SIM_FLASH_CR_LOCK		(1UL << 31)
+#define	SIM_FLASH_CR_OPTLOCK		(1UL << 30)
+#define	SIM_FLASH_KEY1			(0x45670123UL)
+#define	SIM_FLASH_KEY2			(0xCDEF89ABUL)
+#define	SIM_PWR_CR1_LPR			(1UL << 14)
+#define	SIM_PWR_SR2_REGLPF		(1UL << 9)
+#define	SIM_LPTIM_ISR_CMPOK		(1UL << 3)
+#define	SIM_LPTIM_ISR_ARROK		(1UL << 4)
+#define	SIM_LPTIM_CR_ENABLE		(1UL << 0)
+#define	SIM_LPTIM_CR_STARTED		(0x6UL)			/* SNGSTRT or CNTSTRT */
+#define	SIM_SYSTICK_COUNTFLAG		(1UL << 16)
+///@}
+
+/** @name Backdoor access to a simulated register, from its device address.
+ */
+///@{
+#define	SIM_REG(reg)			(*SIM_Backdoor((uintptr_t)&(reg)))
+#define	SIM_CORE(pointer)		(*SIM_Backdoor((uintptr_t)(pointer)))
+///@}
+
+#define	SIM_NEVER			(UINT64_MAX)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< Oscillators with a start-up time */
+{
+  SIM_OSC_MSI = 0,
+  SIM_OSC_HSI = 1,
+  SIM_OSC_PLL = 2,
+  SIM_OSC_LSI = 3,
+  SIM_OSC_LSE = 4,
+  SIM_OSC_COUNT = 5
+}SIM_Osc_t;
+
+typedef struct  /**< Access in progress, between the SIGSEGV and the SIGTRAP */
+{
+  uintptr_t     Word;                   /**< Device address of the 32-bit register */
+  uintptr_t     Page;
+  uint32_t      Old;                    /**< Value seen by the access */
+  uint32_t      Hidden;                 /**< Value hidden by a gated read */
+  uint8_t       IsRead;
+  uint8_t       IsWrite;
+  uint8_t       Gated;                  /**< Bus clock of the peripheral off */
+  uint8_t       Active;
+}SIM_Access_t;
+
+typedef struct  /**< Bus clock enable of a peripheral */
+{
+  uintptr_t     Base;
+  __vo uint32_t *pEnable;
+  uint32_t      Mask;
+}SIM_Gate_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+static const uint32_t sim_msi_hz[16] = {100000U, 200000U, 400000U, 800000U, 1000000U, 2000000U, 4000000U, 8000000U, \
+                                        16000000U, 24000000U, 32000000U, 48000000U, 0U, 0U, 0U, 0U};
+
+/* HCLK limit of each wait state, voltage range 1 and 2 */
+static const uint32_t sim_range1_hz[] = {16000000U, 32000000U, 48000000U, 64000000U, 80000000U};
+static const uint32_t sim_range2_hz[] = {6000000U, 12000000U, 18000000U, 26000000U};
+
+/* HPRE 8 to 15 */
+static const uint8_t sim_hpre_shift[8] = {1U, 2U, 3U, 4U, 6U, 7U, 8U, 9U};
+
+static const SIM_Gate_t sim_gates[] =
+{
+	{GPIOA_BASE_ADDRESS,	&RCC->RCC_AHB2ENR,	(1UL << 0)},
+	{GPIOB_BASE_ADDRESS,	&RCC->RCC_AHB2ENR,	(1UL << 1)},
+	{GPIOC_BASE_ADDRESS,	&RCC->RCC_AHB2ENR,	(1UL << 2)},
+	{GPIOD_BASE_ADDRESS,	&RCC->RCC_AHB2ENR,	(1UL << 3)},
+	{GPIOE_BASE_ADDRESS,	&RCC->RCC_AHB2ENR,	(1UL << 4)},
+	{GPIOF_BASE_ADDRESS,	&RCC->RCC_AHB2ENR,	(1UL << 5)},
+	{GPIOG_BASE_ADDRESS,	&RCC->RCC_AHB2ENR,	(1UL << 6)},
+	{GPIOH_BASE_ADDRESS,	&RCC->RCC_AHB2ENR,	(1UL << 7)},
+	{SYSCFG_BASE_ADDRESS,	&RCC->RCC_APB2ENR,	(1UL << 0)},
+	{PWR_BASE_ADDRESS,	&RCC->RCC_APB1ENR1,	(1UL << 28)},
+	{LPTIM1_BASE_ADDRESS,	&RCC->RCC_APB1ENR1,	(1UL << 31)}
+};
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+__vo uint32_t SIM_Primask = 0;
+const uint32_t g_pfnVectors[NVIC_VECTOR_COUNT] = {0};	/* Stands for the startup file's table */
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static uint8_t *sim_backdoor = 0;
+static SIM_Access_t sim_access;
+static uint64_t sim_cycles = 0;
+static uint64_t sim_ready_at[SIM_OSC_COUNT];
+static SIM_Stats_t sim_stats;
+static uint64_t sim_stats_since = 0;
+static uint32_t sim_idle_reads = 0;
+static uint8_t sim_flash_key_step = 0;
+static uint8_t sim_flash_key_error = 0;
+static uint32_t sim_cyccnt_base = 0;
+static uint64_t sim_cyccnt_since = 0;
+static uint8_t sim_cyccnt_running = 0;
+static uint64_t sim_systick_since = 0;
+static uint64_t sim_systick_wraps = 0;
+static uint64_t sim_lptim_since = 0;
+static sigjmp_buf sim_run_jump;
+static __vo uint8_t sim_running = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static __vo uint32_t *SIM_Backdoor(uintptr_t Address);
+static uint8_t SIM_IsMapped(uintptr_t Address);
+static uint8_t SIM_IsPlainStore(const uint8_t *pCode);
+static void SIM_SegvHandler(int Signal, siginfo_t *pInfo, void *pContext);
+static void SIM_TrapHandler(int Signal, siginfo_t *pInfo, void *pContext);
+static void SIM_Violation(const char *pDescription);
+static uint8_t SIM_IsGated(uintptr_t Word);
+static void SIM_Settle(void);
+static uint8_t SIM_SourceReady(uint32_t Source);
+static void SIM_CheckClock(void);
+static void SIM_ReadModel(uintptr_t Word);
+static void SIM_WriteModel(uintptr_t Word, uint32_t Old, uint32_t New);
+static void SIM_WriteRCC(uintptr_t Offset, uint32_t Old, uint32_t New);
+static void SIM_WriteCore(uintptr_t Word, uint32_t Old, uint32_t New);
+static void SIM_UpdateCycleCounter(void);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function maps the peripheral and Cortex-M4 private
+*              register ranges at their addresses and installs the access
+*              traps, then resets the registers. Calling it again does
+*              nothing.
+*
+* @return      SIM_STATUS_OK, or SIM_STATUS_ERROR if a range is already used
+*              by the host process.
+******************************************************************************/
+SIM_STATUS SIM_Init(void)
+{
+	struct sigaction action;
+	void *periph;
+	void *core;
+	int fd;
+
+	if(sim_backdoor != 0)
+	{
+		return SIM_STATUS_OK;
+	}
+
+	fd = memfd_create("stm32l475xx_registers", 0);
+	if(fd < 0)
+	{
+		return SIM_STATUS_ERROR;
+	}
+
+	if(ftruncate(fd, (off_t)(SIM_PERIPH_SIZE + SIM_CORE_SIZE)) != 0)
+	{
+		close(fd);
+		return SIM_STATUS_ERROR;
+	}
+
+	periph = mmap((void *)SIM_PERIPH_BASE, SIM_PERIPH_SIZE, PROT_NONE, MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+	core = mmap((void *)SIM_CORE_BASE, SIM_CORE_SIZE, PROT_NONE, MAP_SHARED | MAP_FIXED_NOREPLACE, fd, (off_t)SIM_PERIPH_SIZE);
+	sim_backdoor = mmap(0, SIM_PERIPH_SIZE + SIM_CORE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	/* Older kernels take MAP_FIXED_NOREPLACE as a hint */
+	if((periph != (void *)SIM_PERIPH_BASE) || (core != (void *)SIM_CORE_BASE) || (sim_backdoor == MAP_FAILED))
+	{
+		sim_backdoor = 0;
+		return SIM_STATUS_ERROR;
+	}
+
+	memset(&action, 0, sizeof(action));
+	sigemptyset(&action.sa_mask);
+	action.sa_flags = SA_SIGINFO;
+	action.sa_sigaction = SIM_SegvHandler;
+	sigaction(SIGSEGV, &action, 0);
+	action.sa_sigaction = SIM_TrapHandler;
+	sigaction(SIGTRAP, &action, 0);
+
+	SIM_Reset();
+
+	return SIM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function gives every register its reset value (0 when
+*              not modeled), restarts the models and clears the counters.
+*              The drivers keep their own static state.
+******************************************************************************/
+void SIM_Reset(void)
+{
+	uint8_t index;
+
+	/* Drops every page of the memfd: all the registers read 0 again */
+	madvise(sim_backdoor, SIM_PERIPH_SIZE + SIM_CORE_SIZE, MADV_REMOVE);
+
+	SIM_REG(RCC->RCC_CR) = 0x00000063UL;		/* MSI 4 MHz, on and ready */
+	SIM_REG(RCC->RCC_ICSCR) = 0x10000000UL;
+	SIM_REG(RCC->RCC_PLLCFGR) = 0x00001000UL;
+	SIM_REG(RCC->RCC_AHB1ENR) = 0x00000100UL;
+	SIM_REG(RCC->RCC_CSR) = 0x0C000600UL;
+	SIM_REG(FLASH->FLASH_ACR) = 0x00000600UL;
+	SIM_REG(FLASH->FLASH_CR) = SIM_FLASH_CR_LOCK | SIM_FLASH_CR_OPTLOCK;
+	SIM_REG(PWR->PWR_CR1) = 0x00000200UL;		/* Range 1 */
+	SIM_REG(PWR->PWR_CR3) = 0x00008000UL;
+	SIM_REG(GPIOA->GPIO_MODER) = 0xABFFFFFFUL;
+	SIM_REG(GPIOA->GPIO_OSPEEDR) = 0x0C000000UL;
+	SIM_REG(GPIOA->GPIO_PUPDR) = 0x64000000UL;
+	SIM_REG(GPIOB->GPIO_MODER) = 0xFFFFFEBFUL;
+	SIM_REG(GPIOB->GPIO_PUPDR) = 0x00000100UL;
+	SIM_REG(GPIOC->GPIO_MODER) = 0xFFFFFFFFUL;
+	SIM_REG(GPIOD->GPIO_MODER) = 0xFFFFFFFFUL;
+	SIM_REG(GPIOE->GPIO_MODER) = 0xFFFFFFFFUL;
+	SIM_REG(GPIOF->GPIO_MODER) = 0xFFFFFFFFUL;
+	SIM_REG(GPIOG->GPIO_MODER) = 0xFFFFFFFFUL;
+	SIM_REG(GPIOH->GPIO_MODER) = 0x0000000FUL;
+	SIM_CORE(DWT_CTRL) = 0x40000000UL;
+
+	for(index = 0; index < SIM_OSC_COUNT; index++)
+	{
+		sim_ready_at[index] = SIM_NEVER;
+	}
+	sim_ready_at[SIM_OSC_MSI] = 0;
+
+	sim_cycles = 0;
+	sim_idle_reads = 0;
+	sim_flash_key_step = 0;
+	sim_flash_key_error = 0;
+	sim_cyccnt_base = 0;
+	sim_cyccnt_since = 0;
+	sim_cyccnt_running = 0;
+	sim_systick_since = 0;
+	sim_systick_wraps = 0;
+	sim_lptim_since = 0;
+	SIM_Primask = 0;
+
+	SIM_ClearStats();
+}
+
+/**************************************************************************//**
+* @brief       This function calls a function, and stops it when it reads
+*              registers SIM_STUCK_READS times in a row without writing any:
+*              a poll that never ends on the real part either.
+*
+* @param       pFunction    Function to run.
+*
+* @return      SIM_STATUS_OK, or SIM_STATUS_STUCK (see StuckAddress).
+******************************************************************************/
+SIM_STATUS SIM_Run(void (*pFunction)(void))
+{
+	sim_idle_reads = 0;
+	sim_running = 1;
+
+	if(sigsetjmp(sim_run_jump, 1) != 0)
+	{
+		sim_running = 0;
+		return SIM_STATUS_STUCK;
+	}
+
+	pFunction();
+	sim_running = 0;
+
+	return SIM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function drives a GPIO input. On an edge selected in
+*              EXTI_RTSR1/FTSR1 for a line routed to this port by SYSCFG,
+*              the EXTI pending bit is set, and the NVIC pending bit too if
+*              the line is not masked. No handler is called.
+*
+* @param       pGPIOx       GPIOA to GPIOH.
+* @param       PinNumber    0 to 15.
+* @param       Level        0 or 1.
+******************************************************************************/
+void SIM_SetPin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber, uint8_t Level)
+{
+	uint32_t port = (uint32_t)(((uintptr_t)pGPIOx - GPIOA_BASE_ADDRESS) / 0x400U);
+	uint32_t bit = 1UL << PinNumber;
+	uint32_t idr = SIM_REG(pGPIOx->GPIO_IDR);
+	uint32_t trigger;
+	uint32_t irq;
+
+	SIM_REG(pGPIOx->GPIO_IDR) = (Level != 0) ? (idr | bit) : (idr & ~bit);
+
+	if(((idr & bit) != 0) == (Level != 0))
+	{
+		return;
+	}
+
+	if(((SIM_REG((&SYSCFG->SYSCFG_EXTICR1)[PinNumber / 4U]) >> (4U * (PinNumber % 4U))) & 0xFU) != port)
+	{
+		return;
+	}
+
+	trigger = (Level != 0) ? SIM_REG(EXTI->EXTI_RTSR1) : SIM_REG(EXTI->EXTI_FTSR1);
+	if((trigger & bit) == 0)
+	{
+		return;
+	}
+
+	SIM_REG(EXTI->EXTI_PR1) |= bit;
+
+	if((SIM_REG(EXTI->EXTI_IMR1) & bit) != 0)
+	{
+		irq = (PinNumber <= 4U) ? (IRQ_NO_EXTI0 + PinNumber) : ((PinNumber <= 9U) ? IRQ_NO_EXTI9_5 : IRQ_NO_EXTI15_10);
+		SIM_CORE(NVIC_ISPR0 + (irq / 32U)) |= (1UL << (irq % 32U));
+		SIM_CORE(NVIC_ICPR0 + (irq / 32U)) = SIM_CORE(NVIC_ISPR0 + (irq / 32U));
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function computes HCLK from the simulated RCC registers,
+*              as the hardware does, to compare with what the drivers cached.
+*
+* @return      HCLK in Hz, 0 with no valid source.
+******************************************************************************/
+uint32_t SIM_GetHCLK(void)
+{
+	uint32_t cr = SIM_REG(RCC->RCC_CR);
+	uint32_t cfgr = SIM_REG(RCC->RCC_CFGR);
+	uint32_t pllcfgr = SIM_REG(RCC->RCC_PLLCFGR);
+	uint32_t msi;
+	uint32_t sysclk;
+	uint32_t hpre;
+
+	if((cr & SIM_RCC_CR_MSIRGSEL) != 0)
+	{
+		msi = sim_msi_hz[(cr >> 4) & 0xFU];
+	}
+	else
+	{
+		msi = sim_msi_hz[(SIM_REG(RCC->RCC_CSR) >> 8) & 0xFU];
+	}
+
+	switch((cfgr >> 2) & 0x3U)
+	{
+		case 0:
+			sysclk = msi;
+			break;
+
+		case 1:
+			sysclk = 16000000U;
+			break;
+
+		case 3:
+			switch(pllcfgr & 0x3U)
+			{
+				case 1:
+					sysclk = msi;
+					break;
+				case 2:
+					sysclk = 16000000U;
+					break;
+				default:
+					sysclk = 0;		/* No HSE crystal on the board */
+					break;
+			}
+			sysclk = (uint32_t)(((uint64_t)sysclk * ((pllcfgr >> 8) & 0x7FU)) / \
+			                    ((((pllcfgr >> 4) & 0x7U) + 1U) * ((((pllcfgr >> 25) & 0x3U) + 1U) * 2U)));
+			break;
+
+		default:
+			sysclk = 0;
+			break;
+	}
+
+	hpre = (cfgr >> 4) & 0xFU;
+	if(hpre >= 8U)
+	{
+		sysclk >>= sim_hpre_shift[hpre - 8U];
+	}
+
+	return sysclk;
+}
+
+/**************************************************************************//**
+* @brief       This function advances the simulated time, for the code that
+*              spends cycles without accessing registers.
+*
+* @param       Cycles       HCLK cycles.
+******************************************************************************/
+void SIM_AddCycles(uint32_t Cycles)
+{
+	sim_cycles += Cycles;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the counters since SIM_ClearStats().
+*
+* @param       pStats       Filled with the counters.
+******************************************************************************/
+void SIM_GetStats(SIM_Stats_t *pStats)
+{
+	*pStats = sim_stats;
+	pStats->Cycles = sim_cycles - sim_stats_since;
+}
+
+/**************************************************************************//**
+* @brief       This function clears the counters. The simulated time keeps
+*              running.
+******************************************************************************/
+void SIM_ClearStats(void)
+{
+	memset(&sim_stats, 0, sizeof(sim_stats));
+	sim_stats_since = sim_cycles;
+}
+
+/**************************************************************************//**
+* @brief       Read/write alias of a simulated register, for the models.
+******************************************************************************/
+static __vo uint32_t *SIM_Backdoor(uintptr_t Address)
+{
+	Address &= ~(uintptr_t)0x3U;
+
+	if(Address >= SIM_CORE_BASE)
+	{
+		return (__vo uint32_t *)(sim_backdoor + SIM_PERIPH_SIZE + (Address - SIM_CORE_BASE));
+	}
+
+	return (__vo uint32_t *)(sim_backdoor + (Address - SIM_PERIPH_BASE));
+}
+
+/**************************************************************************//**
+* @brief       1 if the address is a simulated register.
+******************************************************************************/
+static uint8_t SIM_IsMapped(uintptr_t Address)
+{
+	return (((Address - SIM_PERIPH_BASE) < SIM_PERIPH_SIZE) || ((Address - SIM_CORE_BASE) < SIM_CORE_SIZE)) ? 1U : 0U;
+}
+
+/**************************************************************************//**
+* @brief       1 if the faulting instruction only stores (MOV to memory), 0
+*              for a read-modify-write (OR, AND, XOR, ADD... to memory).
+******************************************************************************/
+static uint8_t SIM_IsPlainStore(const uint8_t *pCode)
+{
+	/* Operand size, segment and REX prefixes */
+	while((*pCode == 0x66U) || (*pCode == 0x67U) || (*pCode == 0x2EU) || (*pCode == 0x3EU) || \
+	      (*pCode == 0x26U) || (*pCode == 0x36U) || (*pCode == 0x64U) || (*pCode == 0x65U) || ((*pCode & 0xF0U) == 0x40U))
+	{
+		pCode++;
+	}
+
+	return ((*pCode == 0x88U) || (*pCode == 0x89U) || (*pCode == 0xC6U) || (*pCode == 0xC7U)) ? 1U : 0U;
+}
+
+/**************************************************************************//**
+* @brief       First half of an access: computes the value to read, opens
+*              the page and single steps the access.
+******************************************************************************/
+static void SIM_SegvHandler(int Signal, siginfo_t *pInfo, void *pContext)
+{
+	ucontext_t *context = (ucontext_t *)pContext;
+	uintptr_t address = (uintptr_t)pInfo->si_addr;
+	__vo uint32_t *word;
+
+	if((SIM_IsMapped(address) == 0) || (sim_access.Active != 0))
+	{
+		/* A real crash: fault again with the default action */
+		signal(Signal, SIG_DFL);
+		return;
+	}
+
+	sim_access.Word = address & ~(uintptr_t)0x3U;
+	sim_access.Page = address & ~(SIM_PAGE_SIZE - 1U);
+	sim_access.IsWrite = ((context->uc_mcontext.gregs[REG_ERR] & SIM_PF_WRITE) != 0) ? 1U : 0U;
+	sim_access.IsRead = ((sim_access.IsWrite == 0) || (SIM_IsPlainStore((const uint8_t *)context->uc_mcontext.gregs[REG_RIP]) == 0)) ? 1U : 0U;
+	sim_access.Gated = SIM_IsGated(sim_access.Word);
+	sim_access.Active = 1;
+
+	sim_cycles += SIM_ACCESS_CYCLES;
+	sim_stats.Reads += sim_access.IsRead;
+	sim_stats.Writes += sim_access.IsWrite;
+
+	SIM_Settle();
+
+	word = SIM_Backdoor(sim_access.Word);
+	if(sim_access.Gated != 0)
+	{
+		/* Reads 0, and the write is undone after the access */
+		sim_access.Hidden = *word;
+		*word = 0;
+	}
+	else if(sim_access.IsRead != 0)
+	{
+		SIM_ReadModel(sim_access.Word);
+	}
+	sim_access.Old = *word;
+
+	mprotect((void *)sim_access.Page, SIM_PAGE_SIZE, PROT_READ | PROT_WRITE);
+	context->uc_mcontext.gregs[REG_EFL] |= SIM_EFLAGS_TF;
+}
+
+/**************************************************************************//**
+* @brief       Second half of an access: runs the models of the written
+*              value, closes the page, and ends SIM_Run() on an endless poll.
+******************************************************************************/
+static void SIM_TrapHandler(int Signal, siginfo_t *pInfo, void *pContext)
+{
+	ucontext_t *context = (ucontext_t *)pContext;
+	__vo uint32_t *word;
+
+	(void)pInfo;
+
+	if(sim_access.Active == 0)
+	{
+		signal(Signal, SIG_DFL);
+		raise(Signal);
+		return;
+	}
+
+	context->uc_mcontext.gregs[REG_EFL] &= ~SIM_EFLAGS_TF;
+	mprotect((void *)sim_access.Page, SIM_PAGE_SIZE, PROT_NONE);
+
+	word = SIM_Backdoor(sim_access.Word);
+	if(sim_access.Gated != 0)
+	{
+		if(sim_access.IsWrite != 0)
+		{
+			SIM_Violation("register written with the bus clock of its peripheral off");
+		}
+		*word = sim_access.Hidden;
+	}
+	else if(sim_access.IsWrite != 0)
+	{
+		SIM_WriteModel(sim_access.Word, sim_access.Old, *word);
+	}
+	else if(sim_access.Word == (uintptr_t)SYSTICK_CTRL)
+	{
+		/* COUNTFLAG clears when read */
+		*word &= ~SIM_SYSTICK_COUNTFLAG;
+	}
+
+	sim_access.Active = 0;
+
+	if(sim_access.IsWrite != 0)
+	{
+		sim_idle_reads = 0;
+	}
+	else if(++sim_idle_reads >= SIM_STUCK_READS)
+	{
+		sim_stats.StuckAddress = sim_access.Word;
+		if(sim_running != 0)
+		{
+			siglongjmp(sim_run_jump, 1);
+		}
+		abort();
+	}
+}
+
+/**************************************************************************//**
+* @brief       Counts a violation at the register being accessed.
+******************************************************************************/
+static void SIM_Violation(const char *pDescription)
+{
+	sim_stats.Violations++;
+	sim_stats.pLastViolation = pDescription;
+	sim_stats.LastViolationAddress = sim_access.Word;
+}
+
+/**************************************************************************//**
+* @brief       1 if the register belongs to a peripheral with its bus clock
+*              off.
+******************************************************************************/
+static uint8_t SIM_IsGated(uintptr_t Word)
+{
+	uint8_t index;
+
+	for(index = 0; index < (sizeof(sim_gates) / sizeof(sim_gates[0])); index++)
+	{
+		if((Word - sim_gates[index].Base) < 0x400U)
+		{
+			return ((SIM_REG(*sim_gates[index].pEnable) & sim_gates[index].Mask) == 0) ? 1U : 0U;
+		}
+	}
+
+	return 0;
+}
+
+/**************************************************************************//**
+* @brief       Updates what depends on time: the oscillator ready flags and
+*              the system clock switch.
+******************************************************************************/
+static void SIM_Settle(void)
+{
+	uint32_t cr = SIM_REG(RCC->RCC_CR) & ~SIM_RCC_CR_READY;
+	uint32_t cfgr;
+	uint32_t sw;
+
+	cr |= (sim_cycles >= sim_ready_at[SIM_OSC_MSI]) ? SIM_RCC_CR_MSIRDY : 0U;
+	cr |= (sim_cycles >= sim_ready_at[SIM_OSC_HSI]) ? SIM_RCC_CR_HSIRDY : 0U;
+	cr |= (sim_cycles >= sim_ready_at[SIM_OSC_PLL]) ? SIM_RCC_CR_PLLRDY : 0U;
+	SIM_REG(RCC->RCC_CR) = cr;
+
+	if(sim_cycles >= sim_ready_at[SIM_OSC_LSI])
+	{
+		SIM_REG(RCC->RCC_CSR) |= SIM_RCC_CSR_LSIRDY;
+	}
+	else
+	{
+		SIM_REG(RCC->RCC_CSR) &= ~SIM_RCC_CSR_LSIRDY;
+	}
+
+	if(sim_cycles >= sim_ready_at[SIM_OSC_LSE])
+	{
+		SIM_REG(RCC->RCC_BDCR) |= SIM_RCC_BDCR_LSERDY;
+	}
+	else
+	{
+		SIM_REG(RCC->RCC_BDCR) &= ~SIM_RCC_BDCR_LSERDY;
+	}
+
+	/* SWS follows SW once the new source runs */
+	cfgr = SIM_REG(RCC->RCC_CFGR);
+	sw = cfgr & 0x3U;
+	if((sw != ((cfgr >> 2) & 0x3U)) && (SIM_SourceReady(sw) != 0))
+	{
+		SIM_REG(RCC->RCC_CFGR) = (cfgr & ~0xCUL) | (sw << 2);
+		SIM_CheckClock();
+	}
+}
+
+/**************************************************************************//**
+* @brief       1 if the system clock can switch to the source (SW value).
+******************************************************************************/
+static uint8_t SIM_SourceReady(uint32_t Source)
+{
+	uint32_t cr = SIM_REG(RCC->RCC_CR);
+
+	switch(Source)
+	{
+		case 0:
+			return ((cr & SIM_RCC_CR_MSIRDY) != 0) ? 1U : 0U;
+		case 1:
+			return ((cr & SIM_RCC_CR_HSIRDY) != 0) ? 1U : 0U;
+		case 3:
+			return (((cr & SIM_RCC_CR_PLLRDY) != 0) && ((SIM_REG(RCC->RCC_PLLCFGR) & SIM_RCC_PLLCFGR_PLLREN) != 0)) ? 1U : 0U;
+		default:
+			return 0;
+	}
+}
+
+/**************************************************************************//**
+* @brief       Checks HCLK against the flash wait states and the voltage
+*              range, after any change of one of them.
+******************************************************************************/
+static void SIM_CheckClock(void)
+{
+	uint32_t hclk = SIM_GetHCLK();
+	uint32_t latency = SIM_REG(FLASH->FLASH_ACR) & 0x7U;
+	const uint32_t *limits = sim_range1_hz;
+	uint32_t count = sizeof(sim_range1_hz) / sizeof(sim_range1_hz[0]);
+	uint32_t needed = 0;
+
+	if(((SIM_REG(PWR->PWR_CR1) >> 9) & 0x3U) == 2U)
+	{
+		limits = sim_range2_hz;
+		count = sizeof(sim_range2_hz) / sizeof(sim_range2_hz[0]);
+	}
+
+	while((needed < count) && (hclk > limits[needed]))
+	{
+		needed++;
+	}
+
+	if(needed == count)
+	{
+		SIM_Violation("HCLK above the maximum of the voltage range");
+	}
+	else if(needed > latency)
+	{
+		SIM_Violation("FLASH_ACR latency too low for HCLK");
+	}
+}
+
+/**************************************************************************//**
+* @brief       Puts the value to read in the counters read by the access.
+******************************************************************************/
+static void SIM_ReadModel(uintptr_t Word)
+{
+	uint32_t load;
+	uint64_t elapsed;
+	uint32_t arr;
+
+	if(Word == (uintptr_t)DWT_CYCCNT)
+	{
+		SIM_UpdateCycleCounter();
+	}
+	else if((Word - (uintptr_t)ITM_STIM32(0)) < (4U * 32U))
+	{
+		/* The FIFO is always ready */
+		SIM_CORE(Word) = 1U;
+	}
+	else if(((Word == (uintptr_t)SYSTICK_VAL) || (Word == (uintptr_t)SYSTICK_CTRL)) && ((SIM_CORE(SYSTICK_CTRL) & 0x1U) != 0))
+	{
+		load = (SIM_CORE(SYSTICK_LOAD) & SYSTICK_LOAD_MAX) + 1U;
+		elapsed = sim_cycles - sim_systick_since;
+		SIM_CORE(SYSTICK_VAL) = (uint32_t)(load - 1U - (elapsed % load));
+		if((elapsed / load) != sim_systick_wraps)
+		{
+			sim_systick_wraps = elapsed / load;
+			SIM_CORE(SYSTICK_CTRL) |= SIM_SYSTICK_COUNTFLAG;
+		}
+	}
+	else if((Word == (uintptr_t)&LPTIM1->LPTIM_CNT) && ((SIM_REG(LPTIM1->LPTIM_CR) & SIM_LPTIM_CR_ENABLE) != 0) && \
+	        ((SIM_REG(LPTIM1->LPTIM_CR) & SIM_LPTIM_CR_STARTED) != 0))
+	{
+		arr = (SIM_REG(LPTIM1->LPTIM_ARR) & 0xFFFFU) + 1U;
+		SIM_REG(LPTIM1->LPTIM_CNT) = (uint32_t)(((sim_cycles - sim_lptim_since) / SIM_LPTIM_COUNT_CYCLES) % arr);
+	}
+}
+
+/**************************************************************************//**
+* @brief       Applies a write to a modeled register: read-only bits, write
+*              1 to clear, side effects and checks. Old is the value before
+*              the write, New the value written.
+******************************************************************************/
+static void SIM_WriteModel(uintptr_t Word, uint32_t Old, uint32_t New)
+{
+	__vo uint32_t *word = SIM_Backdoor(Word);
+	uintptr_t offset;
+
+	if((Word - RCC_BASE_ADDRESS) < 0x400U)
+	{
+		SIM_WriteRCC(Word - RCC_BASE_ADDRESS, Old, New);
+	}
+	else if(Word == (uintptr_t)&FLASH->FLASH_ACR)
+	{
+		/* Latencies above 4 wait states are reserved */
+		if((New & 0x7U) > 4U)
+		{
+			*word = (New & ~0x7UL) | (Old & 0x7U);
+		}
+		SIM_CheckClock();
+	}
+	else if(Word == (uintptr_t)&FLASH->FLASH_KEYR)
+	{
+		if(sim_flash_key_error == 0)
+		{
+			if((sim_flash_key_step == 0) && (New == SIM_FLASH_KEY1))
+			{
+				sim_flash_key_step = 1;
+			}
+			else if((sim_flash_key_step == 1) && (New == SIM_FLASH_KEY2))
+			{
+				sim_flash_key_step = 0;
+				SIM_REG(FLASH->FLASH_CR) &= ~SIM_FLASH_CR_LOCK;
+			}
+			else
+			{
+				/* Locked until the next reset */
+				sim_flash_key_error = 1;
+				SIM_Violation("wrong FLASH_KEYR sequence");
+			}
+		}
+		*word = 0;
+	}
+	else if(Word == (uintptr_t)&FLASH->FLASH_CR)
+	{
+		if((Old & SIM_FLASH_CR_LOCK) != 0)
+		{
+			if(New != Old)
+			{
+				SIM_Violation("FLASH_CR written while locked");
+			}
+			*word = Old;
+		}
+		else
+		{
+			/* LOCK and OPTLOCK are only cleared by their key sequences */
+			*word = New | (Old & SIM_FLASH_CR_OPTLOCK);
+		}
+	}
+	else if(Word == (uintptr_t)&PWR->PWR_CR1)
+	{
+		/* VOS 00 and 11 are reserved and not taken */
+		if((((New >> 9) & 0x3U) == 0U) || (((New >> 9) & 0x3U) == 3U))
+		{
+			*word = (New & ~(0x3UL << 9)) | (Old & (0x3UL << 9));
+		}
+
+		if((New & SIM_PWR_CR1_LPR) != 0)
+		{
+			SIM_REG(PWR->PWR_SR2) |= SIM_PWR_SR2_REGLPF;
+		}
+		else
+		{
+			SIM_REG(PWR->PWR_SR2) &= ~SIM_PWR_SR2_REGLPF;
+		}
+		SIM_CheckClock();
+	}
+	else if(Word == (uintptr_t)&PWR->PWR_SR2)
+	{
+		*word = Old;
+	}
+	else if((Word == (uintptr_t)&EXTI->EXTI_PR1) || (Word == (uintptr_t)&EXTI->EXTI_PR2))
+	{
+		*word = Old & ~New;
+	}
+	else if((Word - GPIOA_BASE_ADDRESS) < (8U * 0x400U))
+	{
+		offset = (Word - GPIOA_BASE_ADDRESS) % 0x400U;
+		if(offset == offsetof(GPIO_RegDef_t, GPIO_IDR))
+		{
+			*word = Old;
+		}
+		else if(offset == offsetof(GPIO_RegDef_t, GPIO_BSRR))
+		{
+			/* Set wins over reset */
+			*SIM_Backdoor(Word - offset + offsetof(GPIO_RegDef_t, GPIO_ODR)) &= ~(New >> 16);
+			*SIM_Backdoor(Word - offset + offsetof(GPIO_RegDef_t, GPIO_ODR)) |= (New & 0xFFFFU);
+			*word = 0;
+		}
+		else if(offset == offsetof(GPIO_RegDef_t, GPIO_BRR))
+		{
+			*SIM_Backdoor(Word - offset + offsetof(GPIO_RegDef_t, GPIO_ODR)) &= ~(New & 0xFFFFU);
+			*word = 0;
+		}
+	}
+	else if((Word - LPTIM1_BASE_ADDRESS) < 0x400U)
+	{
+		offset = Word - LPTIM1_BASE_ADDRESS;
+		if(offset == offsetof(LPTIM_RegDef_t, LPTIM_ISR))
+		{
+			*word = Old;
+		}
+		else if(offset == offsetof(LPTIM_RegDef_t, LPTIM_ICR))
+		{
+			SIM_REG(LPTIM1->LPTIM_ISR) &= ~New;
+			*word = 0;
+		}
+		else if(offset == offsetof(LPTIM_RegDef_t, LPTIM_CMP))
+		{
+			SIM_REG(LPTIM1->LPTIM_ISR) |= SIM_LPTIM_ISR_CMPOK;
+		}
+		else if(offset == offsetof(LPTIM_RegDef_t, LPTIM_ARR))
+		{
+			SIM_REG(LPTIM1->LPTIM_ISR) |= SIM_LPTIM_ISR_ARROK;
+		}
+		else if((offset == offsetof(LPTIM_RegDef_t, LPTIM_CR)) && ((New & ~Old & SIM_LPTIM_CR_STARTED) != 0))
+		{
+			sim_lptim_since = sim_cycles;
+		}
+	}
+	else if(Word >= SIM_CORE_BASE)
+	{
+		SIM_WriteCore(Word, Old, New);
+	}
+}
+
+/**************************************************************************//**
+* @brief       Writes to the RCC: oscillators, PLL configuration, system
+*              clock switch and the LPTIM1 reset.
+******************************************************************************/
+static void SIM_WriteRCC(uintptr_t Offset, uint32_t Old, uint32_t New)
+{
+	uint32_t cfgr = SIM_REG(RCC->RCC_CFGR);
+	uint32_t sws = (cfgr >> 2) & 0x3U;
+	uint32_t pllsrc = SIM_REG(RCC->RCC_PLLCFGR) & 0x3U;
+	uint32_t in_use = 0;
+	uint32_t value;
+
+	if(Offset == offsetof(RCC_RegDef_t, RCC_CR))
+	{
+		/* The system clock source and the running PLL input cannot stop */
+		if((sws == 0U) || ((Old & SIM_RCC_CR_PLLON) && (pllsrc == 1U)))
+		{
+			in_use |= SIM_RCC_CR_MSION;
+		}
+		if((sws == 1U) || ((Old & SIM_RCC_CR_PLLON) && (pllsrc == 2U)))
+		{
+			in_use |= SIM_RCC_CR_HSION;
+		}
+		if(sws == 3U)
+		{
+			in_use |= SIM_RCC_CR_PLLON;
+		}
+
+		value = (New | (Old & in_use)) & ~SIM_RCC_CR_READY;
+		value |= Old & SIM_RCC_CR_READY;
+
+		if(((Old ^ value) & SIM_RCC_CR_MSIRANGE) && (Old & SIM_RCC_CR_MSION) && !(Old & SIM_RCC_CR_MSIRDY))
+		{
+			SIM_Violation("MSIRANGE written while MSI is starting");
+		}
+
+		if((value & ~Old) & SIM_RCC_CR_MSION)
+		{
+			sim_ready_at[SIM_OSC_MSI] = sim_cycles + SIM_MSI_STARTUP_CYCLES;
+		}
+		else if((Old & ~value) & SIM_RCC_CR_MSION)
+		{
+			sim_ready_at[SIM_OSC_MSI] = SIM_NEVER;
+		}
+
+		if((value & ~Old) & SIM_RCC_CR_HSION)
+		{
+			sim_ready_at[SIM_OSC_HSI] = sim_cycles + SIM_HSI_STARTUP_CYCLES;
+		}
+		else if((Old & ~value) & SIM_RCC_CR_HSION)
+		{
+			sim_ready_at[SIM_OSC_HSI] = SIM_NEVER;
+		}
+
+		if((value & ~Old) & SIM_RCC_CR_PLLON)
+		{
+			sim_ready_at[SIM_OSC_PLL] = sim_cycles + SIM_PLL_LOCK_CYCLES;
+		}
+		else if((Old & ~value) & SIM_RCC_CR_PLLON)
+		{
+			sim_ready_at[SIM_OSC_PLL] = SIM_NEVER;
+		}
+
+		SIM_REG(RCC->RCC_CR) = value;
+		SIM_Settle();
+		SIM_CheckClock();
+	}
+	else if(Offset == offsetof(RCC_RegDef_t, RCC_CFGR))
+	{
+		/* SWS is read-only, SIM_Settle() switches */
+		SIM_REG(RCC->RCC_CFGR) = (New & ~0xCUL) | (Old & 0xCUL);
+		SIM_Settle();
+		SIM_CheckClock();
+	}
+	else if(Offset == offsetof(RCC_RegDef_t, RCC_PLLCFGR))
+	{
+		if((SIM_REG(RCC->RCC_CR) & SIM_RCC_CR_PLLON) && ((Old ^ New) & ~SIM_RCC_PLLCFGR_ENABLES))
+		{
+			SIM_Violation("RCC_PLLCFGR written with the PLL on");
+			SIM_REG(RCC->RCC_PLLCFGR) = (Old & ~SIM_RCC_PLLCFGR_ENABLES) | (New & SIM_RCC_PLLCFGR_ENABLES);
+		}
+	}
+	else if(Offset == offsetof(RCC_RegDef_t, RCC_CSR))
+	{
+		if((New & ~Old) & SIM_RCC_CSR_LSION)
+		{
+			sim_ready_at[SIM_OSC_LSI] = sim_cycles + SIM_LSI_STARTUP_CYCLES;
+		}
+		else if((Old & ~New) & SIM_RCC_CSR_LSION)
+		{
+			sim_ready_at[SIM_OSC_LSI] = SIM_NEVER;
+		}
+		SIM_REG(RCC->RCC_CSR) = (New & ~SIM_RCC_CSR_LSIRDY) | (Old & SIM_RCC_CSR_LSIRDY);
+	}
+	else if(Offset == offsetof(RCC_RegDef_t, RCC_BDCR))
+	{
+		if((New & ~Old) & SIM_RCC_BDCR_LSEON)
+		{
+			sim_ready_at[SIM_OSC_LSE] = sim_cycles + SIM_LSE_STARTUP_CYCLES;
+		}
+		else if((Old & ~New) & SIM_RCC_BDCR_LSEON)
+		{
+			sim_ready_at[SIM_OSC_LSE] = SIM_NEVER;
+		}
+		SIM_REG(RCC->RCC_BDCR) = (New & ~SIM_RCC_BDCR_LSERDY) | (Old & SIM_RCC_BDCR_LSERDY);
+	}
+	else if((Offset == offsetof(RCC_RegDef_t, RCC_APB1RSTR1)) && (New & SIM_RCC_APB1RSTR1_LPTIM1RST))
+	{
+		memset((void *)SIM_Backdoor(LPTIM1_BASE_ADDRESS), 0, sizeof(LPTIM_RegDef_t));
+	}
+}
+
+/**************************************************************************//**
+* @brief       Writes to the Cortex-M4 private registers: NVIC set/clear
+*              pairs, SysTick and the DWT cycle counter.
+******************************************************************************/
+static void SIM_WriteCore(uintptr_t Word, uint32_t Old, uint32_t New)
+{
+	uintptr_t index;
+	uint32_t value;
+
+	if((Word - (uintptr_t)NVIC_ISER0) < 0x20U)
+	{
+		index = (Word - (uintptr_t)NVIC_ISER0) / 4U;
+		value = Old | New;
+		SIM_CORE(NVIC_ISER0 + index) = value;
+		SIM_CORE(NVIC_ICER0 + index) = value;
+	}
+	else if((Word - (uintptr_t)NVIC_ICER0) < 0x20U)
+	{
+		index = (Word - (uintptr_t)NVIC_ICER0) / 4U;
+		value = Old & ~New;
+		SIM_CORE(NVIC_ISER0 + index) = value;
+		SIM_CORE(NVIC_ICER0 + index) = value;
+	}
+	else if((Word - (uintptr_t)NVIC_ISPR0) < 0x20U)
+	{
+		index = (Word - (uintptr_t)NVIC_ISPR0) / 4U;
+		value = Old | New;
+		SIM_CORE(NVIC_ISPR0 + index) = value;
+		SIM_CORE(NVIC_ICPR0 + index) = value;
+	}
+	else if((Word - (uintptr_t)NVIC_ICPR0) < 0x20U)
+	{
+		index = (Word - (uintptr_t)NVIC_ICPR0) / 4U;
+		value = Old & ~New;
+		SIM_CORE(NVIC_ISPR0 + index) = value;
+		SIM_CORE(NVIC_ICPR0 + index) = value;
+	}
+	else if(Word == (uintptr_t)NVIC_STIR)
+	{
+		index = (New & 0xFFU) / 32U;
+		SIM_CORE(NVIC_ISPR0 + index) |= (1UL << (New % 32U));
+		SIM_CORE(NVIC_ICPR0 + index) = SIM_CORE(NVIC_ISPR0 + index);
+		SIM_CORE(NVIC_STIR) = 0;
+	}
+	else if((Word - (uintptr_t)NVIC_IABR0) < 0x20U)
+	{
+		SIM_CORE(Word) = Old;
+	}
+	else if(Word == (uintptr_t)SYSTICK_CTRL)
+	{
+		if((New & ~Old) & 0x1U)
+		{
+			sim_systick_since = sim_cycles;
+			sim_systick_wraps = 0;
+		}
+		SIM_CORE(SYSTICK_CTRL) = (New & ~SIM_SYSTICK_COUNTFLAG) | (Old & SIM_SYSTICK_COUNTFLAG);
+	}
+	else if(Word == (uintptr_t)SYSTICK_VAL)
+	{
+		/* Any write clears the counter and COUNTFLAG */
+		sim_systick_since = sim_cycles;
+		sim_systick_wraps = 0;
+		SIM_CORE(SYSTICK_VAL) = 0;
+		SIM_CORE(SYSTICK_CTRL) &= ~SIM_SYSTICK_COUNTFLAG;
+	}
+	else if(Word == (uintptr_t)DWT_CYCCNT)
+	{
+		sim_cyccnt_base = New;
+		sim_cyccnt_since = sim_cycles;
+	}
+	else if((Word == (uintptr_t)DWT_CTRL) || (Word == (uintptr_t)COREDEBUG_DEMCR))
+	{
+		SIM_UpdateCycleCounter();
+	}
+}
+
+/**************************************************************************//**
+* @brief       Brings DWT_CYCCNT up to date, and starts or stops it after a
+*              change of CYCCNTENA or TRCENA.
+******************************************************************************/
+static void SIM_UpdateCycleCounter(void)
+{
+	uint8_t running = ((SIM_CORE(DWT_CTRL) & (1UL << DWT_CTRL_CYCCNTENA)) && \
+	                   (SIM_CORE(COREDEBUG_DEMCR) & (1UL << COREDEBUG_DEMCR_TRCENA))) ? 1U : 0U;
+
+	if(sim_cyccnt_running != 0)
+	{
+		sim_cyccnt_base += (uint32_t)(sim_cycles - sim_cyccnt_since);
+	}
+	sim_cyccnt_since = sim_cycles;
+	sim_cyccnt_running = running;
+
+	SIM_CORE(DWT_CYCCNT) = sim_cyccnt_base;
+}
+
+#endif /* STM32L475XX_HOST_SIM */
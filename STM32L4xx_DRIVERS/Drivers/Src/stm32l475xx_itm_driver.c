@@ -0,0 +1,402 @@
+/**************************************************************************//**
+ * @file    stm32l475xx_itm_driver.c
+ * @brief   This file contains the function definitions for the ITM/SWO
+ *          trace driver for the STM32L475VG microcontroller.
+ *
+ * This file has 7 function definitions (input parameters omitted):
+ *      <br>1) ITM_Init()                   - Configures the SWO pin, TPIU and ITM ports. </br>
+ *      <br>2) ITM_DeInit()                 - Disables the ITM and the SWO pin. </br>
+ *      <br>3) ITM_IsPortEnabled()          - Tells if writes to a port leave the chip. </br>
+ *      <br>4) ITM_Write()                  - Sends a buffer on a stimulus port. </br>
+ *      <br>5) ITM_WriteWord()              - Sends one 32-bit word on a stimulus port. </br>
+ *      <br>6) ITM_GetDropped()             - Returns the bytes dropped on a busy FIFO. </br>
+ *      <br>7) ITM_IsDebuggerAttached()     - Tells if a debugger enabled the debug logic. </br>
+ *
+ * The size of the store to a stimulus port gives the size of the packet:
+ * buffers leave as 32-bit packets, and a 16 and/or 8-bit one for the tail.
+ * A 32-bit packet is 5 bytes on the wire, 50 bit times in NRZ mode.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+#include <stm32l475xx_rcc_driver.h>
+#include <stm32l475xx_gpio_driver.h>
+
+/* Here go the own includes */
+#include <stm32l475xx_itm_driver.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	ITM_WORD_BITS			(50UL)		/* 32-bit packet in NRZ */
+#define	ITM_WAIT_WORDS			(2UL)		/* Busy FIFO tolerated */
+#define	ITM_WAIT_DEFAULT_CYCLES		(0x10000UL)	/* Divider set by the debugger */
+#define	ITM_BAUD_TOLERANCE_PERCENT	(3UL)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static uint32_t itm_baudrate = 0;
+static uint32_t itm_wait_cycles = ITM_WAIT_DEFAULT_CYCLES;
+static uint8_t itm_clock_lost = 0;
+static __vo uint32_t itm_dropped = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static ITM_STATUS ITM_SetDivider(uint32_t HCLK);
+static void ITM_ClockChanged(uint32_t HCLK);
+static uint8_t ITM_WaitReady(uint8_t Port);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function sets PB3 as TRACESWO, the TPIU in NRZ mode with
+*              the formatter bypassed at the baudrate, and enables the ITM,
+*              the DWT packet forwarding and the given stimulus ports. A
+*              debugger that configures the trace itself (STM32CubeIDE SWV)
+*              does not need it. With a debugger attached, or with
+*              ITM_TRACE_IN_STOP, it also sets DBG_STOP: the clocks of the
+*              trace keep running in the Stop modes so packets still in the
+*              FIFO leave the chip, and Stop draws about the current of
+*              Sleep. Without either, Stop keeps its current and may cut the
+*              last packets. ITM_DeInit() clears it.
+*
+* @param       Baudrate     SWO baudrate, ITM_BAUD_xxx for example.
+* @param       PortMask     OR of ITM_PORT_MASK(port).
+*
+* @return      ITM_STATUS_OK, or ITM_STATUS_ERROR if HCLK cannot give the
+*              baudrate within 3%.
+******************************************************************************/
+ITM_STATUS ITM_Init(uint32_t Baudrate, uint32_t PortMask)
+{
+	GPIO_Handle_t swo;
+
+	if(Baudrate == 0)
+	{
+		return ITM_STATUS_ERROR;
+	}
+
+	itm_baudrate = Baudrate;
+	if(ITM_SetDivider(RCC_GetHCLKCached()) != ITM_STATUS_OK)
+	{
+		itm_baudrate = 0;
+		return ITM_STATUS_ERROR;
+	}
+	itm_clock_lost = 0;
+	itm_dropped = 0;
+
+	/* The cycle counter times the waits on the FIFO */
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	swo.pGPIOx = GPIOB;
+	swo.GPIO_PinConfig.GPIO_PinNumber = GPIO_PIN_3;
+	swo.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ALTFN;
+	swo.GPIO_PinConfig.GPIO_PinAltFunMode = GPIO_ALTFN_AF0;
+	swo.GPIO_PinConfig.GPIO_PinSpeed = GPIO_OSPEED_VERYHIGH;
+	swo.GPIO_PinConfig.GPIO_PinOType = GPIO_OTYPE_PP;
+	swo.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PUPD_NONE;
+	GPIO_PeriphClkControl(GPIOB, ENABLE);
+	GPIO_Init(&swo);
+
+	/* Asynchronous trace: TRACE_MODE = 0 */
+	*DBGMCU_CR &= ~(0x3UL << DBGMCU_CR_TRACE_MODE);
+	SET_REG_BIT(*DBGMCU_CR, DBGMCU_CR_TRACE_IOEN);
+
+	/* Without it the SWO stops with the clocks when the device enters Stop */
+	if((ITM_TRACE_IN_STOP != 0U) || (ITM_IsDebuggerAttached() != 0))
+	{
+		SET_REG_BIT(*DBGMCU_CR, DBGMCU_CR_DBG_STOP);
+	}
+
+	*TPI_CSPSR = 1UL;
+	*TPI_SPPR = TPI_SPPR_NRZ;
+	*TPI_FFCR = (1UL << TPI_FFCR_TRIGIN);
+
+	*ITM_LAR = ITM_LAR_KEY;
+	*ITM_TCR = (1UL << ITM_TCR_TRACEBUSID) | (1UL << ITM_TCR_SWOENA) | (1UL << ITM_TCR_TXENA) |
+		   (1UL << ITM_TCR_SYNCENA) | (1UL << ITM_TCR_ITMENA);
+	*ITM_TPR = 0;
+	*ITM_TER = PortMask;
+
+	if(RCC_RegisterClockChangeCallback(ITM_ClockChanged) != RCC_STATUS_OK)
+	{
+		return ITM_STATUS_ERROR;
+	}
+
+	return ITM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function disables the stimulus ports and the ITM, lets the
+*              Stop modes stop the clocks again and gives PB3 back to the GPIO
+*              configuration.
+******************************************************************************/
+void ITM_DeInit(void)
+{
+	*ITM_LAR = ITM_LAR_KEY;
+	*ITM_TER = 0;
+	*ITM_TCR = 0;
+	CLR_REG_BIT(*DBGMCU_CR, DBGMCU_CR_TRACE_IOEN);
+	CLR_REG_BIT(*DBGMCU_CR, DBGMCU_CR_DBG_STOP);
+
+	itm_baudrate = 0;
+	itm_wait_cycles = ITM_WAIT_DEFAULT_CYCLES;
+}
+
+/**************************************************************************//**
+* @brief       This function tells if the writes to a port are sent: ITM and
+*              port enabled, by ITM_Init() or by the debugger, and a divider
+*              valid for the current HCLK.
+*
+* @param       Port         0 to ITM_PORTS - 1.
+*
+* @return      1 if enabled, 0 otherwise.
+******************************************************************************/
+uint8_t ITM_IsPortEnabled(uint8_t Port)
+{
+	if((Port >= ITM_PORTS) || (itm_clock_lost != 0))
+	{
+		return 0;
+	}
+
+	if((READ_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA) == 0) ||
+	   (READ_REG_BIT(*ITM_TCR, ITM_TCR_ITMENA) == 0) ||
+	   (READ_REG_BIT(*ITM_TER, Port) == 0))
+	{
+		return 0;
+	}
+
+	return 1;
+}
+
+/**************************************************************************//**
+* @brief       This function sends a buffer on a stimulus port, four bytes per
+*              packet. Callable from any interrupt handler. The FIFO is waited
+*              on with interrupts enabled and each packet written with them
+*              masked, so writers sharing a port interleave whole packets.
+*
+* @param       Port         0 to ITM_PORTS - 1.
+* @param       pData        Bytes to send.
+* @param       Length       Number of bytes.
+*
+* @return      Bytes sent. Fewer than Length if the port is disabled or the
+*              FIFO stayed busy, the rest is counted as dropped.
+******************************************************************************/
+uint32_t ITM_Write(uint8_t Port, const void *pData, uint32_t Length)
+{
+	const uint8_t *data = (const uint8_t *)pData;
+	uint32_t sent = 0;
+	uint32_t primask;
+	uint32_t word;
+
+	if(ITM_IsPortEnabled(Port) == 0)
+	{
+		return 0;
+	}
+
+	while(sent < Length)
+	{
+		if(ITM_WaitReady(Port) == 0)
+		{
+			itm_dropped += Length - sent;
+			break;
+		}
+
+		/* An interrupt may have taken the slot since the wait */
+		primask = __get_PRIMASK();
+		__disable_irq();
+
+		if(READ_REG_BIT(*ITM_STIM32(Port), ITM_STIM_FIFOREADY) == 0)
+		{
+			__set_PRIMASK(primask);
+			continue;
+		}
+
+		if((Length - sent) >= 4U)
+		{
+			word = (uint32_t)data[sent] | ((uint32_t)data[sent + 1U] << 8) |
+			       ((uint32_t)data[sent + 2U] << 16) | ((uint32_t)data[sent + 3U] << 24);
+			*ITM_STIM32(Port) = word;
+			sent += 4U;
+		}
+		else if((Length - sent) >= 2U)
+		{
+			*ITM_STIM16(Port) = (uint16_t)((uint16_t)data[sent] | ((uint16_t)data[sent + 1U] << 8));
+			sent += 2U;
+		}
+		else
+		{
+			*ITM_STIM8(Port) = data[sent];
+			sent++;
+		}
+
+		__set_PRIMASK(primask);
+	}
+
+	return sent;
+}
+
+/**************************************************************************//**
+* @brief       This function sends one 32-bit packet on a stimulus port, for
+*              binary records. Callable from any interrupt handler.
+*
+* @param       Port         0 to ITM_PORTS - 1.
+* @param       Word         Packet payload.
+*
+* @return      1 if sent, 0 if the port is disabled or the FIFO stayed busy.
+******************************************************************************/
+uint8_t ITM_WriteWord(uint8_t Port, uint32_t Word)
+{
+	uint32_t primask;
+
+	if(ITM_IsPortEnabled(Port) == 0)
+	{
+		return 0;
+	}
+
+	while(ITM_WaitReady(Port) != 0)
+	{
+		primask = __get_PRIMASK();
+		__disable_irq();
+
+		if(READ_REG_BIT(*ITM_STIM32(Port), ITM_STIM_FIFOREADY) != 0)
+		{
+			*ITM_STIM32(Port) = Word;
+			__set_PRIMASK(primask);
+			return 1;
+		}
+
+		__set_PRIMASK(primask);
+	}
+
+	itm_dropped += 4U;
+
+	return 0;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the bytes dropped since ITM_Init()
+*              because the FIFO stayed busy.
+*
+* @return      Dropped bytes.
+******************************************************************************/
+uint32_t ITM_GetDropped(void)
+{
+	return itm_dropped;
+}
+
+/**************************************************************************//**
+* @brief       This function tells if a debugger is connected: C_DEBUGEN is
+*              set by the debugger through SWD and cleared only by a power-on
+*              reset. A probe attached after the check is not seen.
+*
+* @return      1 if attached, 0 if not.
+******************************************************************************/
+uint8_t ITM_IsDebuggerAttached(void)
+{
+	return (uint8_t)READ_REG_BIT(*COREDEBUG_DHCSR, COREDEBUG_DHCSR_C_DEBUGEN);
+}
+
+/**************************************************************************//**
+* @brief       Programs the TPIU divider for itm_baudrate at HCLK, and the
+*              longest wait for the FIFO.
+******************************************************************************/
+static ITM_STATUS ITM_SetDivider(uint32_t HCLK)
+{
+	uint32_t prescaler;
+	uint32_t actual;
+	uint32_t error;
+
+	if((HCLK == 0) || (itm_baudrate == 0))
+	{
+		return ITM_STATUS_ERROR;
+	}
+
+	prescaler = (HCLK + (itm_baudrate / 2U)) / itm_baudrate;
+	if((prescaler == 0) || ((prescaler - 1U) > TPI_ACPR_MAX))
+	{
+		return ITM_STATUS_ERROR;
+	}
+
+	actual = HCLK / prescaler;
+	error = (actual > itm_baudrate) ? (actual - itm_baudrate) : (itm_baudrate - actual);
+	if((error * 100U) > (itm_baudrate * ITM_BAUD_TOLERANCE_PERCENT))
+	{
+		return ITM_STATUS_ERROR;
+	}
+
+	*TPI_ACPR = prescaler - 1U;
+	itm_wait_cycles = prescaler * ITM_WORD_BITS * ITM_WAIT_WORDS;
+
+	return ITM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       Clock change callback registered in the RCC driver. The output
+*              stays off while the new HCLK cannot give the baudrate.
+******************************************************************************/
+static void ITM_ClockChanged(uint32_t HCLK)
+{
+	if(itm_baudrate == 0)
+	{
+		return;
+	}
+
+	itm_clock_lost = (ITM_SetDivider(HCLK) == ITM_STATUS_OK) ? 0 : 1;
+}
+
+/**************************************************************************//**
+* @brief       Waits for a free slot in the FIFO of a port, at most
+*              itm_wait_cycles. Returns 1 when free, 0 on timeout.
+******************************************************************************/
+static uint8_t ITM_WaitReady(uint8_t Port)
+{
+	uint32_t start;
+
+	if(READ_REG_BIT(*ITM_STIM32(Port), ITM_STIM_FIFOREADY) != 0)
+	{
+		return 1;
+	}
+
+	start = *DWT_CYCCNT;
+	while(READ_REG_BIT(*ITM_STIM32(Port), ITM_STIM_FIFOREADY) == 0)
+	{
+		if((*DWT_CYCCNT - start) > itm_wait_cycles)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
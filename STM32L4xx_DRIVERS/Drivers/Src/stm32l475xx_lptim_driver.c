@@ -0,0 +1,240 @@
+/**************************************************************************//**
+ * @file    stm32l475xx_lptim_driver.c
+ * @brief   This file contains the function definitions for the LPTIM1
+ *          driver for the STM32L475VG microcontroller.
+ *
+ * This file has 8 function definitions (input parameters omitted):
+ *      <br>1) LPTIM_PeriphClkControl()     - Enables or disables the LPTIM1 bus clock. </br>
+ *      <br>2) LPTIM_Init()                 - Starts LPTIM1 as a free running 16-bit counter. </br>
+ *      <br>3) LPTIM_DeInit()               - Stops and resets LPTIM1. </br>
+ *      <br>4) LPTIM_GetFrequency()         - Returns the counting frequency. </br>
+ *      <br>5) LPTIM_GetCounter()           - Reads the counter. </br>
+ *      <br>6) LPTIM_SetCompare()           - Programs the compare match. </br>
+ *      <br>7) LPTIM_GetFlags()             - Returns the status flags. </br>
+ *      <br>8) LPTIM_ClearFlags()           - Clears status flags. </br>
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+#include <stm32l475xx_rcc_driver.h>
+
+/* Here go the own includes */
+#include <stm32l475xx_lptim_driver.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static uint32_t lptim_frequency = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function enables or disables the APB1 clock of LPTIM1.
+*
+* @param       EnorDi       ENABLE or DISABLE.
+******************************************************************************/
+void LPTIM_PeriphClkControl(uint8_t EnorDi)
+{
+	if(EnorDi == ENABLE)
+	{
+		LPTIM1_PCLK_EN();
+	}
+	else
+	{
+		LPTIM1_PCLK_DI();
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function selects the kernel clock, resets LPTIM1 and
+*              starts it in continuous mode from 0 to 0xFFFF, with the
+*              compare match interrupt enabled in the peripheral. The NVIC
+*              and EXTI line 32 are left to the caller. LSI or LSE must
+*              already be running (RCC_Config_LSI()).
+*
+* @param       ClockSource  LPTIM_CLOCK_LSI or LPTIM_CLOCK_LSE to keep
+*                           counting in Stop modes, or PCLK and HSI16.
+* @param       Prescaler    LPTIM_PRESCALER_DIVn.
+*
+* @return      LPTIM_STATUS_OK or LPTIM_STATUS_ERROR.
+******************************************************************************/
+LPTIM_STATUS LPTIM_Init(uint8_t ClockSource, uint8_t Prescaler)
+{
+	uint32_t frequency;
+
+	if(Prescaler > LPTIM_PRESCALER_DIV128)
+	{
+		return LPTIM_STATUS_ERROR;
+	}
+
+	switch(ClockSource)
+	{
+		case LPTIM_CLOCK_LSI:
+			if(READ_REG_BIT(RCC->RCC_CSR, RCC_CSR_LSIRDY) == 0)
+			{
+				return LPTIM_STATUS_ERROR;
+			}
+			frequency = LPTIM_LSI_VALUE;
+			break;
+
+		case LPTIM_CLOCK_LSE:
+			if(READ_REG_BIT(RCC->RCC_BDCR, RCC_BDCR_LSERDY) == 0)
+			{
+				return LPTIM_STATUS_ERROR;
+			}
+			frequency = LPTIM_LSE_VALUE;
+			break;
+
+		case LPTIM_CLOCK_HSI16:
+			frequency = RCC_HSI16_VALUE;
+			break;
+
+		case LPTIM_CLOCK_PCLK:
+			/* APB1 prescaler is never changed by the RCC driver */
+			frequency = RCC_GetHCLKCached();
+			break;
+
+		default:
+			return LPTIM_STATUS_ERROR;
+	}
+
+	LPTIM_PeriphClkControl(ENABLE);
+
+	/* Peripheral reset: CR, CFGR and IER are only writable while disabled */
+	RCC->RCC_APB1RSTR1 |= (1UL << 31);
+	RCC->RCC_APB1RSTR1 &= ~(1UL << 31);
+
+	RCC->RCC_CCIPR &= ~(0x3UL << RCC_CCIPR_LPTIM1SEL);
+	RCC->RCC_CCIPR |= ((uint32_t)ClockSource << RCC_CCIPR_LPTIM1SEL);
+
+	LPTIM1->LPTIM_CFGR = ((uint32_t)Prescaler << LPTIM_CFGR_PRESC);
+	LPTIM1->LPTIM_IER = (1UL << LPTIM_IER_CMPMIE);
+
+	SET_REG_BIT(LPTIM1->LPTIM_CR, LPTIM_CR_ENABLE);
+
+	LPTIM1->LPTIM_ARR = LPTIM_COUNTER_MASK;
+	while(READ_REG_BIT(LPTIM1->LPTIM_ISR, LPTIM_ISR_ARROK) == 0);
+	LPTIM1->LPTIM_ICR = (1UL << LPTIM_ISR_ARROK);
+
+	LPTIM1->LPTIM_CMP = LPTIM_COUNTER_MASK;
+	while(READ_REG_BIT(LPTIM1->LPTIM_ISR, LPTIM_ISR_CMPOK) == 0);
+	LPTIM1->LPTIM_ICR = (1UL << LPTIM_ISR_CMPOK);
+
+	SET_REG_BIT(LPTIM1->LPTIM_CR, LPTIM_CR_CNTSTRT);
+
+	lptim_frequency = frequency >> Prescaler;
+
+	return LPTIM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function stops LPTIM1 and gates its bus clock.
+******************************************************************************/
+void LPTIM_DeInit(void)
+{
+	LPTIM1->LPTIM_CR = 0;
+	LPTIM_PeriphClkControl(DISABLE);
+	lptim_frequency = 0;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the counting frequency set by
+*              LPTIM_Init(), nominal for LSI.
+*
+* @return      Counts per second, 0 if not initialized.
+******************************************************************************/
+uint32_t LPTIM_GetFrequency(void)
+{
+	return lptim_frequency;
+}
+
+/**************************************************************************//**
+* @brief       This function reads the counter, twice or more until two
+*              consecutive reads match.
+*
+* @return      Counter value.
+******************************************************************************/
+uint16_t LPTIM_GetCounter(void)
+{
+	uint32_t first;
+	uint32_t second = LPTIM1->LPTIM_CNT;
+
+	do
+	{
+		first = second;
+		second = LPTIM1->LPTIM_CNT;
+	}while(first != second);
+
+	return (uint16_t)second;
+}
+
+/**************************************************************************//**
+* @brief       This function programs the compare match and clears a pending
+*              match. Waits for the previous CMP write to be done, up to two
+*              kernel clock cycles.
+*
+* @param       Compare      Counter value of the match.
+******************************************************************************/
+void LPTIM_SetCompare(uint16_t Compare)
+{
+	LPTIM1->LPTIM_CMP = Compare;
+	while(READ_REG_BIT(LPTIM1->LPTIM_ISR, LPTIM_ISR_CMPOK) == 0);
+	LPTIM1->LPTIM_ICR = (1UL << LPTIM_ISR_CMPOK) | (1UL << LPTIM_ISR_CMPM);
+}
+
+/**************************************************************************//**
+* @brief       This function returns the ISR register.
+*
+* @return      (1 << LPTIM_ISR_xxx) flags.
+******************************************************************************/
+uint32_t LPTIM_GetFlags(void)
+{
+	return LPTIM1->LPTIM_ISR;
+}
+
+/**************************************************************************//**
+* @brief       This function clears status flags.
+*
+* @param       Flags        (1 << LPTIM_ISR_xxx) flags to clear.
+******************************************************************************/
+void LPTIM_ClearFlags(uint32_t Flags)
+{
+	LPTIM1->LPTIM_ICR = Flags;
+}
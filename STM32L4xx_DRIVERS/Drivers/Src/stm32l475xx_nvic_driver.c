@@ -0,0 +1,451 @@
+/**************************************************************************//**
+ * @file    stm32l475xx_nvic_driver.c
+ * @brief   This file contains the function definitions for the NVIC driver
+ *          for the STM32L475VG microcontroller.
+ *
+ * This file has 16 function definitions (input parameters omitted):
+ *      <br>1) NVIC_IRQConfig()             - Enables or disables an IRQ. </br>
+ *      <br>2) NVIC_IsEnabled()             - Tells if an IRQ is enabled. </br>
+ *      <br>3) NVIC_SetPending()            - Sets the pending state of an IRQ. </br>
+ *      <br>4) NVIC_ClearPending()          - Clears the pending state of an IRQ. </br>
+ *      <br>5) NVIC_IsPending()             - Tells if an IRQ is pending. </br>
+ *      <br>6) NVIC_IsActive()              - Tells if an IRQ is being serviced. </br>
+ *      <br>7) NVIC_TriggerIRQ()            - Pends an IRQ through the STIR register. </br>
+ *      <br>8) NVIC_SetPriority()           - Sets the priority of an IRQ. </br>
+ *      <br>9) NVIC_GetPriority()           - Returns the priority of an IRQ. </br>
+ *      <br>10) NVIC_SetPriorityGrouping()  - Splits the priority in preempt and sub-priority. </br>
+ *      <br>11) NVIC_GetPriorityGrouping()  - Returns the PRIGROUP field. </br>
+ *      <br>12) NVIC_EncodePriority()       - Builds a priority from preempt and sub-priority. </br>
+ *      <br>13) NVIC_DecodePriority()       - Splits a priority in preempt and sub-priority. </br>
+ *      <br>14) NVIC_RelocateVectorTable()  - Copies the vector table to SRAM1 and moves VTOR. </br>
+ *      <br>15) NVIC_SetVector()            - Installs the handler of an IRQ at runtime. </br>
+ *      <br>16) NVIC_GetVector()            - Returns the handler of an IRQ. </br>
+ *
+ * The set-enable, clear-enable, set-pending and clear-pending registers are
+ * write-1-only: writing 0 does nothing, so they are written with the single
+ * bit of the IRQ, never read-modify-written. Priorities are written one byte
+ * at a time, the byte access of the IPR registers is supported by the core.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <stm32l475xx_nvic_driver.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	NVIC_REG_INDEX(IRQnumber)	((uint32_t)(IRQnumber) >> 5)
+#define	NVIC_REG_MASK(IRQnumber)	(1UL << ((uint32_t)(IRQnumber) & 0x1FUL))
+#define	NVIC_PRIGROUP_MASK		(0x7UL << SCB_AIRCR_PRIGROUP)
+#define	NVIC_VECTKEY_MASK		(0xFFFFUL << SCB_AIRCR_VECTKEY)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+extern const uint32_t g_pfnVectors[];	/* Flash vector table, startup file */
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+/* NOLOAD section at the start of SRAM1, filled by NVIC_RelocateVectorTable() */
+static __vo uint32_t nvic_ram_vectors[NVIC_VECTOR_COUNT]
+	__attribute__((section(".ram_vectors"), aligned(NVIC_VECTOR_TABLE_ALIGN)));
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static uint32_t NVIC_PreemptBits(void);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function enables or disables an IRQ in the NVIC.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+* @param       Enabler      ENABLE or DISABLE.
+*
+* @return      NVIC_STATUS_OK or NVIC_STATUS_ERROR (IRQ out of range).
+******************************************************************************/
+NVIC_STATUS NVIC_IRQConfig(uint8_t IRQnumber, uint8_t Enabler)
+{
+	if(IRQnumber >= NVIC_IRQ_COUNT)
+	{
+		return NVIC_STATUS_ERROR;
+	}
+
+	if(Enabler == ENABLE)
+	{
+		(NVIC_ISER0)[NVIC_REG_INDEX(IRQnumber)] = NVIC_REG_MASK(IRQnumber);
+	}
+	else
+	{
+		(NVIC_ICER0)[NVIC_REG_INDEX(IRQnumber)] = NVIC_REG_MASK(IRQnumber);
+
+		/* An interrupt already taken may still run once after the write */
+		__DSB();
+		__ISB();
+	}
+
+	return NVIC_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function tells if an IRQ is enabled.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+*
+* @return      1 if enabled, 0 if disabled or out of range.
+******************************************************************************/
+uint8_t NVIC_IsEnabled(uint8_t IRQnumber)
+{
+	if(IRQnumber >= NVIC_IRQ_COUNT)
+	{
+		return 0;
+	}
+
+	return (((NVIC_ISER0)[NVIC_REG_INDEX(IRQnumber)] & NVIC_REG_MASK(IRQnumber)) != 0) ? 1 : 0;
+}
+
+/**************************************************************************//**
+* @brief       This function sets the pending state of an IRQ. If the IRQ is
+*              enabled and its priority allows it, it runs right away.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+*
+* @return      NVIC_STATUS_OK or NVIC_STATUS_ERROR (IRQ out of range).
+******************************************************************************/
+NVIC_STATUS NVIC_SetPending(uint8_t IRQnumber)
+{
+	if(IRQnumber >= NVIC_IRQ_COUNT)
+	{
+		return NVIC_STATUS_ERROR;
+	}
+
+	(NVIC_ISPR0)[NVIC_REG_INDEX(IRQnumber)] = NVIC_REG_MASK(IRQnumber);
+
+	return NVIC_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function clears the pending state of an IRQ. A level
+*              interrupt still asserted by its peripheral pends again.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+*
+* @return      NVIC_STATUS_OK or NVIC_STATUS_ERROR (IRQ out of range).
+******************************************************************************/
+NVIC_STATUS NVIC_ClearPending(uint8_t IRQnumber)
+{
+	if(IRQnumber >= NVIC_IRQ_COUNT)
+	{
+		return NVIC_STATUS_ERROR;
+	}
+
+	(NVIC_ICPR0)[NVIC_REG_INDEX(IRQnumber)] = NVIC_REG_MASK(IRQnumber);
+
+	return NVIC_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function tells if an IRQ is pending.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+*
+* @return      1 if pending, 0 if not or out of range.
+******************************************************************************/
+uint8_t NVIC_IsPending(uint8_t IRQnumber)
+{
+	if(IRQnumber >= NVIC_IRQ_COUNT)
+	{
+		return 0;
+	}
+
+	return (((NVIC_ISPR0)[NVIC_REG_INDEX(IRQnumber)] & NVIC_REG_MASK(IRQnumber)) != 0) ? 1 : 0;
+}
+
+/**************************************************************************//**
+* @brief       This function tells if an IRQ is active: its handler is running
+*              or was preempted by a higher priority one.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+*
+* @return      1 if active, 0 if not or out of range.
+******************************************************************************/
+uint8_t NVIC_IsActive(uint8_t IRQnumber)
+{
+	if(IRQnumber >= NVIC_IRQ_COUNT)
+	{
+		return 0;
+	}
+
+	return (((NVIC_IABR0)[NVIC_REG_INDEX(IRQnumber)] & NVIC_REG_MASK(IRQnumber)) != 0) ? 1 : 0;
+}
+
+/**************************************************************************//**
+* @brief       This function pends an IRQ by writing its number to STIR. Same
+*              effect as NVIC_SetPending() with a single store and no index
+*              computation, used by the latency benchmark and to defer work
+*              to a lower priority.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+*
+* @return      NVIC_STATUS_OK or NVIC_STATUS_ERROR (IRQ out of range).
+******************************************************************************/
+NVIC_STATUS NVIC_TriggerIRQ(uint8_t IRQnumber)
+{
+	if(IRQnumber >= NVIC_IRQ_COUNT)
+	{
+		return NVIC_STATUS_ERROR;
+	}
+
+	*NVIC_STIR = IRQnumber;
+
+	return NVIC_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function sets the priority of an IRQ. Use
+*              NVIC_EncodePriority() to build it from a preempt and a
+*              sub-priority.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+* @param       Priority     0 (most urgent) to NVIC_PRIORITY_MAX.
+*
+* @return      NVIC_STATUS_OK or NVIC_STATUS_ERROR (argument out of range).
+******************************************************************************/
+NVIC_STATUS NVIC_SetPriority(uint8_t IRQnumber, uint8_t Priority)
+{
+	if((IRQnumber >= NVIC_IRQ_COUNT) || (Priority > NVIC_PRIORITY_MAX))
+	{
+		return NVIC_STATUS_ERROR;
+	}
+
+	/* Only the upper bits of each byte are implemented */
+	(NVIC_IPR_BYTE_BASE_ADDRESS)[IRQnumber] = (uint8_t)(Priority << (8U - NO_PR_BITS_IMPLEMENTED));
+
+	return NVIC_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the priority of an IRQ.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+*
+* @return      Priority, 0 to NVIC_PRIORITY_MAX. 0 if out of range.
+******************************************************************************/
+uint8_t NVIC_GetPriority(uint8_t IRQnumber)
+{
+	if(IRQnumber >= NVIC_IRQ_COUNT)
+	{
+		return 0;
+	}
+
+	return (uint8_t)((NVIC_IPR_BYTE_BASE_ADDRESS)[IRQnumber] >> (8U - NO_PR_BITS_IMPLEMENTED));
+}
+
+/**************************************************************************//**
+* @brief       This function sets the priority grouping (AIRCR PRIGROUP). Set
+*              it once at startup, before setting any priority: the priority
+*              values stay the same but their meaning changes.
+*
+* @param       PriorityGroup    NVIC_PRIORITYGROUP_x_y.
+*
+* @return      NVIC_STATUS_OK or NVIC_STATUS_ERROR (invalid group).
+******************************************************************************/
+NVIC_STATUS NVIC_SetPriorityGrouping(uint32_t PriorityGroup)
+{
+	uint32_t aircr;
+
+	if((PriorityGroup < NVIC_PRIORITYGROUP_4_0) || (PriorityGroup > NVIC_PRIORITYGROUP_0_4))
+	{
+		return NVIC_STATUS_ERROR;
+	}
+
+	/* AIRCR ignores every write without the key */
+	aircr = *SCB_AIRCR & ~(NVIC_VECTKEY_MASK | NVIC_PRIGROUP_MASK);
+	aircr |= (SCB_AIRCR_VECTKEY_VALUE << SCB_AIRCR_VECTKEY) | (PriorityGroup << SCB_AIRCR_PRIGROUP);
+	*SCB_AIRCR = aircr;
+
+	return NVIC_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the priority grouping.
+*
+* @return      PRIGROUP field, 0 to 7. Values below NVIC_PRIORITYGROUP_4_0
+*              (the reset value is 0) behave as NVIC_PRIORITYGROUP_4_0.
+******************************************************************************/
+uint32_t NVIC_GetPriorityGrouping(void)
+{
+	return (*SCB_AIRCR & NVIC_PRIGROUP_MASK) >> SCB_AIRCR_PRIGROUP;
+}
+
+/**************************************************************************//**
+* @brief       This function builds a priority for NVIC_SetPriority() from a
+*              preempt priority and a sub-priority, with the current grouping.
+*
+* @param [in]  PreemptPriority  0 to (2^preempt bits) - 1.
+* @param [in]  SubPriority      0 to (2^sub-priority bits) - 1.
+* @param [out] pPriority        Encoded priority.
+*
+* @return      NVIC_STATUS_OK or NVIC_STATUS_ERROR (a level does not fit).
+******************************************************************************/
+NVIC_STATUS NVIC_EncodePriority(uint8_t PreemptPriority, uint8_t SubPriority, uint8_t *pPriority)
+{
+	uint32_t preempt_bits = NVIC_PreemptBits();
+	uint32_t sub_bits = NO_PR_BITS_IMPLEMENTED - preempt_bits;
+
+	if((pPriority == 0) || (PreemptPriority >= (1UL << preempt_bits)) || (SubPriority >= (1UL << sub_bits)))
+	{
+		return NVIC_STATUS_ERROR;
+	}
+
+	*pPriority = (uint8_t)((PreemptPriority << sub_bits) | SubPriority);
+
+	return NVIC_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function splits a priority in its preempt priority and
+*              sub-priority, with the current grouping.
+*
+* @param [in]  Priority             Priority from NVIC_GetPriority().
+* @param [out] pPreemptPriority     Preempt priority. Can be 0.
+* @param [out] pSubPriority         Sub-priority. Can be 0.
+******************************************************************************/
+void NVIC_DecodePriority(uint8_t Priority, uint8_t *pPreemptPriority, uint8_t *pSubPriority)
+{
+	uint32_t sub_bits = NO_PR_BITS_IMPLEMENTED - NVIC_PreemptBits();
+
+	if(pPreemptPriority != 0)
+	{
+		*pPreemptPriority = (uint8_t)(Priority >> sub_bits);
+	}
+	if(pSubPriority != 0)
+	{
+		*pSubPriority = (uint8_t)(Priority & ((1UL << sub_bits) - 1UL));
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function copies the flash vector table to SRAM1 and points
+*              VTOR to the copy. Call it once, early in main(), before
+*              NVIC_SetVector(). The handlers stay the same until changed.
+******************************************************************************/
+void NVIC_RelocateVectorTable(void)
+{
+	uint32_t primask;
+	uint32_t i;
+
+	if(*SCB_VTOR == (uint32_t)nvic_ram_vectors)
+	{
+		return;
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	for(i = 0; i < NVIC_VECTOR_COUNT; i++)
+	{
+		nvic_ram_vectors[i] = g_pfnVectors[i];
+	}
+
+	/* The table must be complete before the core may fetch from it */
+	__DSB();
+	*SCB_VTOR = (uint32_t)nvic_ram_vectors;
+	__DSB();
+	__ISB();
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function installs the handler of an IRQ. The next entry of
+*              the IRQ uses it, an entry already running is not affected.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+* @param       pHandler     New handler.
+*
+* @return      NVIC_STATUS_OK or NVIC_STATUS_ERROR (IRQ out of range, null
+*              handler or table not relocated).
+******************************************************************************/
+NVIC_STATUS NVIC_SetVector(uint8_t IRQnumber, NVIC_Handler_t pHandler)
+{
+	if((IRQnumber >= NVIC_IRQ_COUNT) || (pHandler == 0) || (*SCB_VTOR != (uint32_t)nvic_ram_vectors))
+	{
+		return NVIC_STATUS_ERROR;
+	}
+
+	nvic_ram_vectors[NVIC_VECTOR_IRQ_OFFSET + IRQnumber] = (uint32_t)pHandler;
+	__DSB();
+
+	return NVIC_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the handler of an IRQ from the table in
+*              use (flash or SRAM1).
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+*
+* @return      Handler, 0 if out of range.
+******************************************************************************/
+NVIC_Handler_t NVIC_GetVector(uint8_t IRQnumber)
+{
+	const __vo uint32_t *table = (const __vo uint32_t*)*SCB_VTOR;
+
+	if(IRQnumber >= NVIC_IRQ_COUNT)
+	{
+		return 0;
+	}
+
+	if(table != nvic_ram_vectors)
+	{
+		table = g_pfnVectors;
+	}
+
+	return (NVIC_Handler_t)table[NVIC_VECTOR_IRQ_OFFSET + IRQnumber];
+}
+
+/**************************************************************************//**
+* @brief       Preempt priority bits of the implemented ones. PRIGROUP n puts
+*              bits [7:n+1] of the priority byte in the group priority.
+******************************************************************************/
+static uint32_t NVIC_PreemptBits(void)
+{
+	uint32_t group = NVIC_GetPriorityGrouping();
+
+	if(group < NVIC_PRIORITYGROUP_4_0)
+	{
+		group = NVIC_PRIORITYGROUP_4_0;
+	}
+
+	return 7UL - group;
+}
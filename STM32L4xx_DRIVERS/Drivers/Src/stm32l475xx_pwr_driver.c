@@ -3,8 +3,17 @@
  * @brief   This file contains the function definitions for the PWR driver
  *          for the STM32L475VG microcontroller.
  *
- * This file has 1 function definitions (input parameters omitted):
+ * This file has 10 function definitions (input parameters omitted):
  *      <br>1) PWR_ControlVoltageScaling()  - Enables the GPIO peripheral clock. </br>
+ *      <br>2) PWR_EnterSleepMode()         - Enters Sleep mode. </br>
+ *      <br>3) PWR_EnterStopMode()          - Enters Stop 0, 1 or 2 mode. </br>
+ *      <br>4) PWR_EnterStandbyMode()       - Enters Standby mode. </br>
+ *      <br>5) PWR_EnterShutdownMode()      - Enters Shutdown mode. </br>
+ *      <br>6) PWR_ConfigWakeupPin()        - Configures a WKUP pin. </br>
+ *      <br>7) PWR_GetWakeupFlags()         - Returns the PWR_SR1 wakeup flags. </br>
+ *      <br>8) PWR_ClearWakeupFlags()       - Clears the wakeup and standby flags. </br>
+ *      <br>9) PWR_EnableLowPowerRun()      - Puts the regulator in low-power mode (LPR). </br>
+ *      <br>10) PWR_DisableLowPowerRun()    - Puts the regulator back in main mode. </br>
  *
  * @version 1.0.0.0
  *
@@ -51,6 +60,8 @@
 /*****************************************************************************/
   /* DEPENDENCIES */
 /*****************************************************************************/
+static void PWR_WaitForInterrupt(uint8_t Entry);
+static PWR_STATUS PWR_EnterDeepMode(uint32_t LowPowerMode);
 
 /*****************************************************************************/
   /* FUNCTION DEFINITIONS */
@@ -68,6 +79,12 @@ PWR_STATUS PWR_ControlVoltageScaling(uint32_t VoltageScaling)
 {
 	PWR_STATUS status;
 
+	/* VOS cannot be changed while the regulator is in low-power mode */
+	if(READ_REG_BIT(PWR->PWR_CR1, PWR_CR1_LPR) != 0)
+	{
+		return PWR_STATUS_ERROR;
+	}
+
 	if(VoltageScaling == PWR_VOLTAGE_RANGE_1)
 	{
 		if(((PWR->PWR_CR1 & 0x600) >> 9) != PWR_VOLTAGE_RANGE_1)
@@ -76,12 +93,11 @@ PWR_STATUS PWR_ControlVoltageScaling(uint32_t VoltageScaling)
 			/* Process to change from Range 2 to Range 1 */
 
 			/* Need to set PWR Range 1. Program the VOS bits to “01” in the PWR_CR1 register */
-			PWR->PWR_CR1 &= ~(0x3 << 9);
-			CLR_REG_BIT(PWR->PWR_CR1, REG_BIT_10);
-			SET_REG_BIT(PWR->PWR_CR1, REG_BIT_9);
+			/* In one write: the hardware ignores the values “00” and “11” */
+			PWR->PWR_CR1 = (PWR->PWR_CR1 & ~(0x3UL << 9)) | (PWR_VOLTAGE_RANGE_1 << 9);
 
 			/* Wait until the VOSF flag is cleared in the PWR_SR2 register */
-			while(READ_REG_BIT(PWR->PWR_SR2, REG_BIT_10) != 0x1U);
+			while(READ_REG_BIT(PWR->PWR_SR2, PWR_SR2_VOSF) != 0x0U);
 
 			status = PWR_STATUS_OK;
 		}
@@ -97,9 +113,8 @@ PWR_STATUS PWR_ControlVoltageScaling(uint32_t VoltageScaling)
 		{
 			/* Means I am coming from Range 1 to Range 2 */
 			/* Set Range 2. Program the VOS bits to “10” in the PWR_CR1 register */
-			PWR->PWR_CR1 &= ~(0x3 << 9);
-			SET_REG_BIT(PWR->PWR_CR1, REG_BIT_10);
-			CLR_REG_BIT(PWR->PWR_CR1, REG_BIT_9);
+			/* In one write: the hardware ignores the values “00” and “11” */
+			PWR->PWR_CR1 = (PWR->PWR_CR1 & ~(0x3UL << 9)) | (PWR_VOLTAGE_RANGE_2 << 9);
 
 			status = PWR_STATUS_OK;
 		}
@@ -117,3 +132,224 @@ PWR_STATUS PWR_ControlVoltageScaling(uint32_t VoltageScaling)
 
 	return status;
 }
+
+/**************************************************************************//**
+* @brief       This function enters Sleep mode. The CPU clock stops and the
+*              peripherals keep running; any enabled interrupt (WFI) or event
+*              (WFE) wakes the CPU up in a few cycles.
+*
+* @param       Entry            PWR_ENTRY_WFI or PWR_ENTRY_WFE.
+******************************************************************************/
+void PWR_EnterSleepMode(uint8_t Entry)
+{
+	CLR_REG_BIT(*SCB_SCR, SCB_SCR_SLEEPDEEP);
+
+	PWR_WaitForInterrupt(Entry);
+}
+
+/**************************************************************************//**
+* @brief       This function enters Stop 0, 1 or 2 mode. All the clocks of the
+*              core domain stop; SRAM and registers are kept. On wakeup the
+*              system clock is MSI, or HSI16 if RCC_CFGR STOPWUCK is set, so
+*              the caller has to restore the PLL.
+*
+*              Stop 2 cannot be entered from Low-power run mode.
+*
+* @param       StopMode         PWR_LPMS_STOP0, PWR_LPMS_STOP1 or PWR_LPMS_STOP2.
+* @param       Entry            PWR_ENTRY_WFI or PWR_ENTRY_WFE.
+*
+* @return      PWR_STATUS_OK or PWR_STATUS_ERROR
+******************************************************************************/
+PWR_STATUS PWR_EnterStopMode(uint32_t StopMode, uint8_t Entry)
+{
+	if(StopMode > PWR_LPMS_STOP2)
+	{
+		return PWR_STATUS_ERROR;
+	}
+
+	PWR->PWR_CR1 &= ~(0x7UL << PWR_CR1_LPMS);
+	PWR->PWR_CR1 |= (StopMode << PWR_CR1_LPMS);
+
+	SET_REG_BIT(*SCB_SCR, SCB_SCR_SLEEPDEEP);
+	PWR_WaitForInterrupt(Entry);
+
+	/* Back in Run mode */
+	CLR_REG_BIT(*SCB_SCR, SCB_SCR_SLEEPDEEP);
+
+	return PWR_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function enters Standby mode. SRAM1 and the registers are
+*              lost (SRAM2 can be kept with PWR_CR3 RRS). The device wakes up
+*              through a reset, this function only returns when the entry is
+*              refused.
+*
+* @return      PWR_STATUS_ERROR, the device stayed in Run mode.
+******************************************************************************/
+PWR_STATUS PWR_EnterStandbyMode(void)
+{
+	return PWR_EnterDeepMode(PWR_LPMS_STANDBY);
+}
+
+/**************************************************************************//**
+* @brief       This function enters Shutdown mode, the lowest consumption
+*              mode. Only a WKUP pin, the RTC or a reset can wake the device,
+*              this function only returns when the entry is refused.
+*
+* @return      PWR_STATUS_ERROR, the device stayed in Run mode.
+******************************************************************************/
+PWR_STATUS PWR_EnterShutdownMode(void)
+{
+	return PWR_EnterDeepMode(PWR_LPMS_SHUTDOWN);
+}
+
+/**************************************************************************//**
+* @brief       This function enables or disables a WKUP pin as a wakeup
+*              source of Standby and Shutdown modes.
+*
+* @param       WakeupPin        PWR_WAKEUP_PIN1 to PWR_WAKEUP_PIN5.
+* @param       Polarity         PWR_WAKEUP_RISING or PWR_WAKEUP_FALLING.
+* @param       Enabler          ENABLE or DISABLE.
+*
+* @return      PWR_STATUS_OK or PWR_STATUS_ERROR
+******************************************************************************/
+PWR_STATUS PWR_ConfigWakeupPin(uint8_t WakeupPin, uint8_t Polarity, uint8_t Enabler)
+{
+	uint32_t bit;
+
+	if((WakeupPin < PWR_WAKEUP_PIN1) || (WakeupPin > PWR_WAKEUP_PIN5))
+	{
+		return PWR_STATUS_ERROR;
+	}
+
+	bit = (uint32_t)WakeupPin - 1U;
+
+	if(Enabler == ENABLE)
+	{
+		/* Polarity in PWR_CR4, then the enable bit in PWR_CR3 */
+		if(Polarity == PWR_WAKEUP_FALLING)
+		{
+			SET_REG_BIT(PWR->PWR_CR4, bit);
+		}
+		else
+		{
+			CLR_REG_BIT(PWR->PWR_CR4, bit);
+		}
+
+		/* A flag already set would wake the device up right away */
+		PWR->PWR_SCR = (0x1UL << bit);
+		SET_REG_BIT(PWR->PWR_CR3, bit);
+	}
+	else
+	{
+		CLR_REG_BIT(PWR->PWR_CR3, bit);
+	}
+
+	return PWR_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the wakeup flags of PWR_SR1: WUF1..5 in
+*              bits 0..4, SBF (woke up from Standby) in bit 8 and WUFI
+*              (internal wakeup, RTC) in bit 15.
+*
+* @return      PWR_SR1 flags.
+******************************************************************************/
+uint32_t PWR_GetWakeupFlags(void)
+{
+	return PWR->PWR_SR1 & (PWR_SR1_WUF_MASK | (0x1UL << PWR_SR1_SBF) | (0x1UL << PWR_SR1_WUFI));
+}
+
+/**************************************************************************//**
+* @brief       This function clears the WUF1..5 and SBF flags. WUFI is cleared
+*              by clearing the flag of the RTC event itself.
+******************************************************************************/
+void PWR_ClearWakeupFlags(void)
+{
+	/* Write 1 to clear, the other bits of PWR_SCR are reserved */
+	PWR->PWR_SCR = PWR_SCR_CWUF_MASK | (0x1UL << PWR_SCR_CSBF);
+}
+
+/**************************************************************************//**
+* @brief       This function puts the main regulator in low-power mode, the
+*              device enters Low-power run mode. The system clock must already
+*              be at most 2 MHz (PWR_LPRUN_MAX_FREQUENCY) and must not be raised
+*              before PWR_DisableLowPowerRun().
+*
+* @return      PWR_STATUS_OK or PWR_STATUS_ERROR
+******************************************************************************/
+PWR_STATUS PWR_EnableLowPowerRun(void)
+{
+	/* A voltage range change must be finished */
+	if(READ_REG_BIT(PWR->PWR_SR2, PWR_SR2_VOSF) != 0)
+	{
+		return PWR_STATUS_ERROR;
+	}
+
+	SET_REG_BIT(PWR->PWR_CR1, PWR_CR1_LPR);
+
+	return PWR_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function puts the regulator back in main mode and waits
+*              until REGLPF is cleared. Only then can the frequency be raised.
+******************************************************************************/
+void PWR_DisableLowPowerRun(void)
+{
+	CLR_REG_BIT(PWR->PWR_CR1, PWR_CR1_LPR);
+
+	while(READ_REG_BIT(PWR->PWR_SR2, PWR_SR2_REGLPF) != 0);
+}
+
+/**************************************************************************//**
+* @brief       Executes WFI, or SEV + WFE + WFE so a stale event does not
+*              make the WFE return immediately.
+******************************************************************************/
+static void PWR_WaitForInterrupt(uint8_t Entry)
+{
+	if(Entry == PWR_ENTRY_WFE)
+	{
+		__SEV();
+		__WFE();
+		__WFE();
+	}
+	else
+	{
+		__DSB();
+		__WFI();
+		__ISB();
+	}
+}
+
+/**************************************************************************//**
+* @brief       Enters Standby or Shutdown. Pending wakeup flags are cleared
+*              first, a set flag prevents the entry. A pending interrupt
+*              makes the WFI return as well, so after PWR_DEEP_ENTRY_ATTEMPTS
+*              tries the entry is given up and the core is back in Run mode.
+*
+* @return      PWR_STATUS_ERROR, the entry was refused.
+******************************************************************************/
+static PWR_STATUS PWR_EnterDeepMode(uint32_t LowPowerMode)
+{
+	uint32_t attempt;
+
+	PWR_ClearWakeupFlags();
+
+	PWR->PWR_CR1 &= ~(0x7UL << PWR_CR1_LPMS);
+	PWR->PWR_CR1 |= (LowPowerMode << PWR_CR1_LPMS);
+
+	SET_REG_BIT(*SCB_SCR, SCB_SCR_SLEEPDEEP);
+
+	for(attempt = 0; attempt < PWR_DEEP_ENTRY_ATTEMPTS; attempt++)
+	{
+		__DSB();
+		__WFI();
+	}
+
+	/* Still running: the entry was refused */
+	CLR_REG_BIT(*SCB_SCR, SCB_SCR_SLEEPDEEP);
+
+	return PWR_STATUS_ERROR;
+}
@@ -3,7 +3,7 @@
  * @brief   This file contains the function definitions for the RCC driver
  *          for the STM32L475VG microcontroller.
  *
- * This file has 8 functions definitions (input parameters omitted):
+ * This file has 11 functions definitions (input parameters omitted):
  *      <br>1) RCC_Config_MSI()         - Configures MSI as system clock. </br>
  *      <br>2) RCC_Config_HSI()         - Configures HSI as system clock. </br>
  *      <br>3) RCC_Config_PLLCLK()      - Configures PLL as system clock. </br>
@@ -12,6 +12,9 @@
  *      <br>6) RCC_GetSYSCLK()          - Gets system clock value. </br>
  *      <br>7) RCC_GetHCLK()            - Gets HCLK clock value. </br>
  *      <br>8) RCC_GetMSIfreq()         - Gets the MSI range. </br>
+ *      <br>9) RCC_GetHCLKCached()      - Gets the HCLK saved at the last clock change. </br>
+ *      <br>10) RCC_RegisterClockChangeCallback() - Calls a function on every HCLK change. </br>
+ *      <br>11) RCC_NotifyClockChange() - Updates the saved HCLK and calls the callbacks. </br>
  *
  * @version 1.0.0.0
  *
@@ -57,6 +60,9 @@ uint32_t MSIfrequencies[12] = {100000U,   200000U,   400000U,   800000U,  100000
 /*****************************************************************************/
   /* STATIC VARIABLES */
 /*****************************************************************************/
+static uint32_t rcc_hclk_cached = 0;
+static RCC_ClockCallback_t rcc_clock_callbacks[RCC_CLOCK_CALLBACKS];
+static uint8_t rcc_clock_callback_count = 0;
 
 /*****************************************************************************/
   /* DEPENDENCIES */
@@ -122,7 +128,7 @@ RCC_STATUS RCC_Config_MSI(uint32_t MSIspeed, uint32_t MSICalibrationValue, uint3
 			RCC->RCC_CFGR &= ~(0x3 << 0);
 			RCC->RCC_CFGR |= RCC_SYSCLK_MSI;
 
-			while(((RCC->RCC_CFGR)&(0xC) >> (2)) != RCC_SYSCLK_MSI);
+			while((((RCC->RCC_CFGR) & (0xC)) >> (2)) != RCC_SYSCLK_MSI);
 
 			/* Set the AHB Prescaler */
 			RCC->RCC_CFGR &= ~(0xF << 4);
@@ -169,7 +175,7 @@ RCC_STATUS RCC_Config_MSI(uint32_t MSIspeed, uint32_t MSICalibrationValue, uint3
 			RCC->RCC_CFGR &= ~(0x3 << 0);
 			RCC->RCC_CFGR |= RCC_SYSCLK_MSI;
 
-			while(((RCC->RCC_CFGR)&(0xC) >> 2) != RCC_SYSCLK_MSI);
+			while((((RCC->RCC_CFGR) & (0xC)) >> (2)) != RCC_SYSCLK_MSI);
 
 			/* Set the AHB Prescaler */
 			RCC->RCC_CFGR &= ~(0xF << 4);
@@ -177,10 +183,6 @@ RCC_STATUS RCC_Config_MSI(uint32_t MSIspeed, uint32_t MSICalibrationValue, uint3
 
 			while(((RCC->RCC_CFGR)&(0xF << 4)) != (AHB_Prescaler << 4));
 
-			/* Program the wait states according to Dynamic Voltage Range selected and the new frequency */
-			/* Check if this new setting is being taken into account by reading the LATENCY bits in the FLASH_ACR register */
-			FLASH_SetLatency(freq_new_HCLK);
-
 			/* Now, you can decrease the CPU frequency. */
 			if(READ_REG_BIT(RCC->RCC_CR, REG_BIT_0) == 0 || READ_REG_BIT(RCC->RCC_CR, REG_BIT_1))
 			{
@@ -204,6 +206,10 @@ RCC_STATUS RCC_Config_MSI(uint32_t MSIspeed, uint32_t MSICalibrationValue, uint3
 				/* Wait for MSI clock signal to stabilize */
 				while(READ_REG_BIT(RCC->RCC_CR, REG_BIT_1) == 0);		// MSIRDY
 
+				/* Program the wait states according to Dynamic Voltage Range selected and the new frequency */
+				/* Only once the frequency is down: fewer wait states at the old frequency make flash reads fail */
+				FLASH_SetLatency(freq_new_HCLK);
+
 				status = RCC_STATUS_OK;
 			}
 			else
@@ -222,7 +228,7 @@ RCC_STATUS RCC_Config_MSI(uint32_t MSIspeed, uint32_t MSICalibrationValue, uint3
 		RCC->RCC_CFGR &= ~(0x3 << 0);
 		RCC->RCC_CFGR |= RCC_SYSCLK_MSI;
 
-		while(((RCC->RCC_CFGR)&(0xC) >> 2) != RCC_SYSCLK_MSI);
+		while((((RCC->RCC_CFGR) & (0xC)) >> (2)) != RCC_SYSCLK_MSI);
 
 		/* Set the AHB Prescaler */
 		RCC->RCC_CFGR &= ~(0xF << 4);
@@ -272,6 +278,9 @@ RCC_STATUS RCC_Config_MSI(uint32_t MSIspeed, uint32_t MSICalibrationValue, uint3
 	// RCC_CSR
 		// MSISRANGE
 
+	/* Timers clocked from HCLK must reload */
+	RCC_NotifyClockChange();
+
 	return status;
 }
 
@@ -324,23 +333,23 @@ RCC_STATUS RCC_Config_HSI(uint32_t AHB_Prescaler)
 			/* Check if this new setting is being taken into account by reading the LATENCY bits in the FLASH_ACR register */
 			FLASH_SetLatency(freq_new_HCLK);
 
+			/* Enable HSI clock source. The switch only happens once it is ready */
+			SET_REG_BIT(RCC->RCC_CR, REG_BIT_8);			// HSION
+
+			/* Wait for HSI clock signal to stabilize */
+			while(READ_REG_BIT(RCC->RCC_CR, REG_BIT_10) == 0);		// HSIRDY
+
 			/* Modify the CPU clock source by writing the SW bits in the RCC_CFGR register */
 			/* Select HSI as SYSCLK source clock */
 			RCC->RCC_CFGR &= ~(0x3 << 0);
 			RCC->RCC_CFGR |= RCC_SYSCLK_HSI16;
-			while(((RCC->RCC_CFGR)&(0xC) >> 2) != RCC_SYSCLK_HSI16);
+			while((((RCC->RCC_CFGR) & (0xC)) >> (2)) != RCC_SYSCLK_HSI16);
 
 			/* Set the AHB Prescaler */
 			RCC->RCC_CFGR &= ~(0xF << 4);
 			RCC->RCC_CFGR |= (AHB_Prescaler << 4);
 			while(((RCC->RCC_CFGR)&(0xF << 4)) != (AHB_Prescaler << 4));
 
-			/* Enable HSI clock source */
-			SET_REG_BIT(RCC->RCC_CR, REG_BIT_8);			// HSION
-
-			/* Wait for HSI clock signal to stabilize */
-			while(READ_REG_BIT(RCC->RCC_CR, REG_BIT_10) == 0);		// HSIRDY
-
 			status = RCC_STATUS_OK;
 
 		}
@@ -348,11 +357,17 @@ RCC_STATUS RCC_Config_HSI(uint32_t AHB_Prescaler)
 		{
 			/* Decreasing frequency  */
 
+			/* Enable HSI clock source. The switch only happens once it is ready */
+			SET_REG_BIT(RCC->RCC_CR, REG_BIT_8);			// HSION
+
+			/* Wait for HSI clock signal to stabilize */
+			while(READ_REG_BIT(RCC->RCC_CR, REG_BIT_10) == 0);		// HSIRDY
+
 			/* Modify the CPU clock source by writing the SW bits in the RCC_CFGR register */
 			/* Select HSI as SYSCLK source clock */
 			RCC->RCC_CFGR &= ~(0x3 << 0);
 			RCC->RCC_CFGR |= RCC_SYSCLK_HSI16;
-			while(((RCC->RCC_CFGR)&(0xC) >> 2) != RCC_SYSCLK_HSI16);
+			while((((RCC->RCC_CFGR) & (0xC)) >> (2)) != RCC_SYSCLK_HSI16);
 
 			/* Set the AHB Prescaler */
 			RCC->RCC_CFGR &= ~(0xF << 4);
@@ -363,12 +378,6 @@ RCC_STATUS RCC_Config_HSI(uint32_t AHB_Prescaler)
 			/* Check if this new setting is being taken into account by reading the LATENCY bits in the FLASH_ACR register */
 			FLASH_SetLatency(freq_new_HCLK);
 
-			/* Enable HSI clock source */
-			SET_REG_BIT(RCC->RCC_CR, REG_BIT_8);			// HSION
-
-			/* Wait for HSI clock signal to stabilize */
-			while(READ_REG_BIT(RCC->RCC_CR, REG_BIT_10) == 0);		// HSIRDY
-
 			status = RCC_STATUS_OK;
 		}
 	}
@@ -377,6 +386,9 @@ RCC_STATUS RCC_Config_HSI(uint32_t AHB_Prescaler)
 		/* Frequencies are equal */
 	}
 
+	/* Timers clocked from HCLK must reload */
+	RCC_NotifyClockChange();
+
 	return status;
 }
 
@@ -556,7 +568,10 @@ RCC_STATUS RCC_Config_PLLCLK(uint32_t ClockSource, uint32_t ClockSourceFrequency
 	/* Select PLL as SYSCLK source clock */
 	RCC->RCC_CFGR &= ~(0x3 << 0);
 	RCC->RCC_CFGR |= RCC_SYSCLK_PLL;
-	while(((RCC->RCC_CFGR)&(0xC) >> 2) != RCC_SYSCLK_PLL);
+	while((((RCC->RCC_CFGR) & (0xC)) >> (2)) != RCC_SYSCLK_PLL);
+
+	/* Timers clocked from HCLK must reload */
+	RCC_NotifyClockChange();
 
 	return status;
 }
@@ -777,3 +792,80 @@ uint32_t RCC_GetMSIfreq(uint32_t RCC_MSISPEED)
 
 	return freq;
 }
+
+/**************************************************************************//**
+* @brief       The function returns the HCLK saved by the last
+*              RCC_NotifyClockChange(), without reading the RCC registers.
+*              Computed on the first call if no clock change happened yet.
+*
+* @return      HCLK frequency.
+******************************************************************************/
+uint32_t RCC_GetHCLKCached(void)
+{
+	if(rcc_hclk_cached == 0)
+	{
+		rcc_hclk_cached = RCC_GetHCLK();
+	}
+
+	return rcc_hclk_cached;
+}
+
+/**************************************************************************//**
+* @brief       The function registers a function called with the new HCLK
+*              after every clock change, for the drivers whose timing is
+*              derived from HCLK (SysTick reload, baud rates).
+*
+* @param       pCallback                Function to call.
+*
+* @return      RCC_STATUS_OK, or RCC_STATUS_ERROR if the table is full.
+******************************************************************************/
+RCC_STATUS RCC_RegisterClockChangeCallback(RCC_ClockCallback_t pCallback)
+{
+	uint8_t index;
+
+	if(pCallback == 0)
+	{
+		return RCC_STATUS_ERROR;
+	}
+
+	for(index = 0; index < rcc_clock_callback_count; index++)
+	{
+		if(rcc_clock_callbacks[index] == pCallback)
+		{
+			return RCC_STATUS_OK;
+		}
+	}
+
+	if(rcc_clock_callback_count >= RCC_CLOCK_CALLBACKS)
+	{
+		return RCC_STATUS_ERROR;
+	}
+
+	rcc_clock_callbacks[rcc_clock_callback_count] = pCallback;
+	rcc_clock_callback_count++;
+
+	return RCC_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       The function recomputes the saved HCLK and, if it changed,
+*              calls the registered callbacks. Called by the RCC_Config_xxx()
+*              functions; code writing RCC_CFGR directly must call it too.
+******************************************************************************/
+void RCC_NotifyClockChange(void)
+{
+	uint32_t hclk = RCC_GetHCLK();
+	uint8_t index;
+
+	if(hclk == rcc_hclk_cached)
+	{
+		return;
+	}
+
+	rcc_hclk_cached = hclk;
+
+	for(index = 0; index < rcc_clock_callback_count; index++)
+	{
+		rcc_clock_callbacks[index](hclk);
+	}
+}
@@ -0,0 +1,229 @@
+/**************************************************************************//**
+ * @file    stm32l475xx_systick_driver.c
+ * @brief   This file contains the function definitions for the SysTick
+ *          driver for the STM32L475VG microcontroller.
+ *
+ * This file has 8 function definitions (input parameters omitted):
+ *      <br>1) SYSTICK_Init()               - Starts the periodic tick from HCLK. </br>
+ *      <br>2) SYSTICK_Stop()               - Stops the tick. </br>
+ *      <br>3) SYSTICK_SetTickHook()        - Function called on every tick. </br>
+ *      <br>4) SYSTICK_GetTicks()           - Returns the ticks since SYSTICK_Init(). </br>
+ *      <br>5) SYSTICK_GetTickHz()          - Returns the tick frequency. </br>
+ *      <br>6) SYSTICK_Suspend()            - Stops the tick for a tickless sleep. </br>
+ *      <br>7) SYSTICK_Resume()             - Accounts the slept ticks and restarts. </br>
+ *      <br>8) SysTick_Handler()            - SysTick exception handler. </br>
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+#include <stm32l475xx_rcc_driver.h>
+
+/* Here go the own includes */
+#include <stm32l475xx_systick_driver.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static __vo uint32_t systick_ticks = 0;
+static uint32_t systick_tick_hz = 0;
+static SYSTICK_Hook_t systick_hook = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static SYSTICK_STATUS SYSTICK_Reload(uint32_t HCLK);
+static void SYSTICK_ClockChanged(uint32_t HCLK);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function starts the SysTick with a period of 1/TickHz,
+*              clocked from HCLK, and registers the clock change callback
+*              that keeps the period when HCLK changes.
+*
+* @param       TickHz       Tick frequency, for example SYSTICK_1KHZ.
+* @param       IRQpriority  Priority of the SysTick exception, 0 to 15.
+*
+* @return      SYSTICK_STATUS_OK, or SYSTICK_STATUS_ERROR if the period does
+*              not fit the 24-bit counter at the current HCLK.
+******************************************************************************/
+SYSTICK_STATUS SYSTICK_Init(uint32_t TickHz, uint8_t IRQpriority)
+{
+	if((TickHz == 0) || (IRQpriority >= (1U << NO_PR_BITS_IMPLEMENTED)))
+	{
+		return SYSTICK_STATUS_ERROR;
+	}
+
+	SYSTICK_Stop();
+
+	systick_tick_hz = TickHz;
+	systick_ticks = 0;
+
+	if(SYSTICK_Reload(RCC_GetHCLKCached()) != SYSTICK_STATUS_OK)
+	{
+		return SYSTICK_STATUS_ERROR;
+	}
+
+	if(RCC_RegisterClockChangeCallback(SYSTICK_ClockChanged) != RCC_STATUS_OK)
+	{
+		return SYSTICK_STATUS_ERROR;
+	}
+
+	/* Implemented bits are the upper ones of the byte */
+	*SCB_SHPR3 &= ~(0xFFUL << SCB_SHPR3_SYSTICK);
+	*SCB_SHPR3 |= ((uint32_t)IRQpriority << (8U - NO_PR_BITS_IMPLEMENTED)) << SCB_SHPR3_SYSTICK;
+
+	*SYSTICK_CTRL = (1UL << SYSTICK_CTRL_CLKSOURCE) | (1UL << SYSTICK_CTRL_TICKINT) | (1UL << SYSTICK_CTRL_ENABLE);
+
+	return SYSTICK_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function stops the counter and its exception. The tick
+*              count is kept.
+******************************************************************************/
+void SYSTICK_Stop(void)
+{
+	*SYSTICK_CTRL = 0;
+}
+
+/**************************************************************************//**
+* @brief       This function sets the function called by SysTick_Handler()
+*              on every tick, in exception context.
+*
+* @param       pHook        Function to call, 0 for none.
+******************************************************************************/
+void SYSTICK_SetTickHook(SYSTICK_Hook_t pHook)
+{
+	systick_hook = pHook;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the number of ticks since SYSTICK_Init().
+*              Wraps around after 2^32 ticks (49 days at 1 kHz).
+*
+* @return      Tick count.
+******************************************************************************/
+uint32_t SYSTICK_GetTicks(void)
+{
+	return systick_ticks;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the tick frequency given to SYSTICK_Init().
+*
+* @return      Tick frequency in Hz, 0 if not initialized.
+******************************************************************************/
+uint32_t SYSTICK_GetTickHz(void)
+{
+	return systick_tick_hz;
+}
+
+/**************************************************************************//**
+* @brief       This function stops the counter before a sleep in which it
+*              cannot run (Stop modes), and returns how far the current tick
+*              period went. A tick that ended before the call is still
+*              pending and is handled once interrupts are enabled.
+*
+* @return      HCLK cycles elapsed in the current tick period.
+******************************************************************************/
+uint32_t SYSTICK_Suspend(void)
+{
+	uint32_t elapsed;
+
+	CLR_REG_BIT(*SYSTICK_CTRL, SYSTICK_CTRL_ENABLE);
+	elapsed = *SYSTICK_LOAD - *SYSTICK_VAL;
+
+	return elapsed;
+}
+
+/**************************************************************************//**
+* @brief       This function adds the ticks elapsed while suspended, without
+*              calling the hook for them, and restarts a full tick period.
+*
+* @param       Ticks        Whole ticks slept.
+******************************************************************************/
+void SYSTICK_Resume(uint32_t Ticks)
+{
+	systick_ticks += Ticks;
+
+	*SYSTICK_VAL = 0;
+	SET_REG_BIT(*SYSTICK_CTRL, SYSTICK_CTRL_ENABLE);
+}
+
+/**************************************************************************//**
+* @brief       SysTick exception handler. Counts the tick and calls the hook.
+******************************************************************************/
+void SysTick_Handler(void)
+{
+	systick_ticks++;
+
+	if(systick_hook != 0)
+	{
+		systick_hook();
+	}
+}
+
+/**************************************************************************//**
+* @brief       Programs the reload value for systick_tick_hz at HCLK, rounded
+*              to the nearest cycle, and restarts the current period.
+******************************************************************************/
+static SYSTICK_STATUS SYSTICK_Reload(uint32_t HCLK)
+{
+	uint32_t cycles = (HCLK + (systick_tick_hz / 2U)) / systick_tick_hz;
+
+	if((cycles < 2U) || ((cycles - 1U) > SYSTICK_LOAD_MAX))
+	{
+		return SYSTICK_STATUS_ERROR;
+	}
+
+	*SYSTICK_LOAD = cycles - 1U;
+	*SYSTICK_VAL = 0;
+
+	return SYSTICK_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       Clock change callback registered in the RCC driver. Keeps the
+*              previous reload value if the new HCLK cannot give the period.
+******************************************************************************/
+static void SYSTICK_ClockChanged(uint32_t HCLK)
+{
+	if(systick_tick_hz != 0)
+	{
+		(void)SYSTICK_Reload(HCLK);
+	}
+}
@@ -0,0 +1,87 @@
+/**************************************************************************//**
+ * @file    driver_bench.h
+ * @brief   Header file for driver_bench.c
+ *
+ * This file has 5 functions declarations:
+ *      <br>1)  App_BenchInit()     - configures the cycle counter, the LED and SWO.</br>
+ *      <br>2)  App_BenchClock()    - times the driver APIs at one clock setting.</br>
+ *      <br>3)  App_BenchMeasure()  - times one API, median and worst case.</br>
+ *      <br>4)  App_BenchPrint()    - prints the table of one clock setting.</br>
+ *      <br>5)  Error_Handler()     - stops on a failed configuration.</br>
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef DRIVER_BENCH_H_
+#define DRIVER_BENCH_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+#include <stdint.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/* Timed calls per API and clock setting, odd for a true median */
+#define	BENCH_SAMPLES			(33U)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef struct  /**< A timed driver call, pPrepare is not timed */
+{
+  const char    *pName;
+  void          (*pPrepare)(void);
+  void          (*pCall)(void);
+}Bench_Api_t;
+
+typedef struct  /**< A clock setting the APIs are timed at */
+{
+  const char    *pName;
+  void          (*pApply)(void);        /**< Switches from MSI 4 MHz to the setting */
+}Bench_Clock_t;
+
+typedef struct  /**< Cycles of one API at one clock setting, marker cost removed */
+{
+  uint32_t      Median;
+  uint32_t      Worst;
+  uint32_t      Best;
+}Bench_Result_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+void App_BenchInit(void);
+void App_BenchClock(const Bench_Clock_t *pClock, Bench_Result_t *pResults);
+void App_BenchMeasure(const Bench_Api_t *pApi, Bench_Result_t *pResult);
+void App_BenchPrint(const Bench_Clock_t *pClock, const Bench_Result_t *pResults);
+void Error_Handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRIVER_BENCH_H_ */
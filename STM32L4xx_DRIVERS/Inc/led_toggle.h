@@ -8,9 +8,19 @@
 #ifndef LED_TOGGLE_H_
 #define LED_TOGGLE_H_
 
-void delay(void);
+#include <stdint.h>
+
 void App_RCC_Init(void);
 void App_GPIO_Init(void);
+void App_EXTI_Init(void);
 void Error_Handler(void);
+void Blink_Task(void *pArg);
+void Button_Task(void *pArg);
+void Button_IRQHandler(void);
+void Button_Debounced(void *pArg);
+void App_Tick(void);
+uint32_t App_IdleTicks(void);
+void App_Advance(uint32_t Ticks);
+uint32_t App_ReadLPTIM(void);
 
 #endif /* LED_TOGGLE_H_ */
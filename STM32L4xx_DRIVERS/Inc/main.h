@@ -52,8 +52,13 @@ void delay(void);
 void App_RCC_Init(void);
 void App_GPIO_Init(void);
 void App_EXTI_Init(void);
+void App_Time_Init(void);
+uint32_t App_ReadLPTIM(void);
+void App_LPTIMHandler(void);
 void Error_Handler(void);
-void EXTI0_IRQHandler(void);
+void App_ButtonHandler(void);
+void App_ToggleLed(void *pArg);
+void App_Idle(void);
 
 #ifdef __cplusplus
 }
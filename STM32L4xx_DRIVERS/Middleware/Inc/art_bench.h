@@ -0,0 +1,83 @@
+/**************************************************************************//**
+ * @file    art_bench.h
+ * @brief   Header file for art_bench.c
+ *
+ * This file has 3 functions declarations (input parameters omitted):
+ *      <br>1) ARTB_Init()              - Enables the DWT cycle and CPI counters. </br>
+ *      <br>2) ARTB_Run()               - Measures a workload in steady state. </br>
+ *      <br>3) ARTB_EnablePCSampling()  - Starts DWT PC sampling for the profiler. </br>
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_ART_BENCH_H_
+#define INC_ART_BENCH_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name PC sampling periods, in CPU cycles (DWT_CTRL CYCTAP and POSTPRESET).
+ */
+///@{
+#define	ARTB_PCSAMPLE_EVERY_1024	(0U)	/**< CYCTAP = 0 (bit 6), POSTPRESET = 15 */
+#define	ARTB_PCSAMPLE_EVERY_16384	(1U)	/**< CYCTAP = 1 (bit 10), POSTPRESET = 15 */
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef struct  /**< Result of a workload measurement */
+{
+  uint32_t      Iterations;     /**< Calls measured, warm-up excluded */
+  uint32_t      MinCycles;      /**< Cheapest call, fully cached */
+  uint32_t      MaxCycles;      /**< Most expensive call */
+  uint32_t      TotalCycles;    /**< Sum over all calls */
+  uint32_t      TotalCpiCycles; /**< Extra cycles from DWT_CPICNT, includes fetch stalls */
+}ARTB_Result_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+void ARTB_Init(void);
+void ARTB_Run(void (*pWorkload)(void), uint32_t Iterations, ARTB_Result_t *pResult);
+void ARTB_EnablePCSampling(uint8_t Period);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ART_BENCH_H_ */
@@ -0,0 +1,160 @@
+/**************************************************************************//**
+ * @file    binlog.h
+ * @brief   Header file for binlog.c
+ *
+ * This file has 4 functions declarations (input parameters omitted):
+ *      <br>1) BLOG_Init()              - Empties the ring and clears the statistics. </br>
+ *      <br>2) BLOG_Write()             - Stores one record, from anywhere. </br>
+ *      <br>3) BLOG_Flush()             - Sends the stored records through _write(). </br>
+ *      <br>4) BLOG_GetStats()          - Returns the logger statistics. </br>
+ *
+ * Logging without formatting on the target:
+ *
+ *      BLOG("pll locked after %u cycles, cfgr %08x", cycles, RCC->RCC_CFGR);
+ *
+ * The format string goes to the .binlog_fmt section, which the linker keeps
+ * in the ELF file but not in the flash; its offset in the section is the
+ * record identifier. A record is a header word (identifier and argument
+ * count), the DWT_CYCCNT value and the arguments as 32-bit words, nothing
+ * else. Tools/binlog_decode.py rebuilds the text from the ELF file.
+ *
+ * Arguments are integers of up to 32 bits or pointers, BLOG() converts each
+ * of them to a 32-bit word so call sites need no casts; %f is not supported.
+ * Only the pointer is logged for %s, the decoder reads the text back from the
+ * ELF file: the argument must point to a constant string in the flash (a
+ * string literal or a const array), never to a buffer in RAM. Building with
+ * BLOG_DISABLE removes every call.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_BINLOG_H_
+#define INC_BINLOG_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Ring size, in 32-bit words. Must be a power of 2.
+ */
+///@{
+#ifndef BLOG_RING_WORDS
+#define	BLOG_RING_WORDS			(256U)
+#endif
+///@}
+
+/** @name Record layout.
+ */
+///@{
+#define	BLOG_MAX_ARGS			(8U)
+#define	BLOG_HEADER_VALID		(0x80000000UL)
+#define	BLOG_HEADER_ARGS		REG_BIT_24	/* 7 bits */
+#define	BLOG_HEADER_ID_MASK		(0x00FFFFFFUL)
+#define	BLOG_ID_DROPPED			(0x00FFFFFFUL)	/**< One argument: records lost */
+///@}
+
+/** @name File number of the records in _write(), sent on ITM_PORT_BINLOG.
+ */
+///@{
+#define	BLOG_FILE			(3)
+///@}
+
+/** @name Argument conversion: BLOG_ARGS(a, b) gives ", word(a), word(b)",
+ *  up to BLOG_MAX_ARGS arguments.
+ */
+///@{
+#define	BLOG_ARG(arg)			((uint32_t)(uintptr_t)(arg))
+#define	BLOG_ARGS_0(...)
+#define	BLOG_ARGS_1(arg)		, BLOG_ARG(arg)
+#define	BLOG_ARGS_2(arg, ...)		, BLOG_ARG(arg) BLOG_ARGS_1(__VA_ARGS__)
+#define	BLOG_ARGS_3(arg, ...)		, BLOG_ARG(arg) BLOG_ARGS_2(__VA_ARGS__)
+#define	BLOG_ARGS_4(arg, ...)		, BLOG_ARG(arg) BLOG_ARGS_3(__VA_ARGS__)
+#define	BLOG_ARGS_5(arg, ...)		, BLOG_ARG(arg) BLOG_ARGS_4(__VA_ARGS__)
+#define	BLOG_ARGS_6(arg, ...)		, BLOG_ARG(arg) BLOG_ARGS_5(__VA_ARGS__)
+#define	BLOG_ARGS_7(arg, ...)		, BLOG_ARG(arg) BLOG_ARGS_6(__VA_ARGS__)
+#define	BLOG_ARGS_8(arg, ...)		, BLOG_ARG(arg) BLOG_ARGS_7(__VA_ARGS__)
+#define	BLOG_ARGS_PICK(_0, _1, _2, _3, _4, _5, _6, _7, _8, name, ...)	name
+#define	BLOG_ARGS(...)													\
+	BLOG_ARGS_PICK(0, ##__VA_ARGS__, BLOG_ARGS_8, BLOG_ARGS_7, BLOG_ARGS_6, BLOG_ARGS_5, BLOG_ARGS_4,	\
+	               BLOG_ARGS_3, BLOG_ARGS_2, BLOG_ARGS_1, BLOG_ARGS_0)(__VA_ARGS__)
+///@}
+
+/** @name Log call.
+ */
+///@{
+#ifndef BLOG_DISABLE
+#define	BLOG(fmt, ...)												\
+	do														\
+	{														\
+		static const char blog_fmt[] __attribute__((section(".binlog_fmt"), used)) = fmt;			\
+		const uint32_t blog_args[] = { 0 BLOG_ARGS(__VA_ARGS__) };						\
+		_Static_assert(sizeof(blog_args) <= ((BLOG_MAX_ARGS + 1U) * sizeof(uint32_t)), "too many arguments");	\
+		BLOG_Write(BLOG_ARG(blog_fmt), (sizeof(blog_args) / sizeof(uint32_t)) - 1U, &blog_args[1]);		\
+	}while(0)
+#else
+#define	BLOG(fmt, ...)			((void)0)
+#endif
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of BLOG function status */
+{
+  BLOG_STATUS_OK = 0,           /**< BLOG status OK */
+  BLOG_STATUS_FULL = 1          /**< Ring full, record dropped */
+}BLOG_STATUS;
+
+typedef struct  /**< Logger statistics */
+{
+  uint32_t      Records;                /**< Records stored */
+  uint32_t      Dropped;                /**< Records lost on a full ring */
+  uint32_t      MaxUsedWords;           /**< Highest ring occupation */
+}BLOG_Stats_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+void BLOG_Init(void);
+BLOG_STATUS BLOG_Write(uint32_t Id, uint32_t ArgCount, const uint32_t *pArgs);
+uint32_t BLOG_Flush(void);
+void BLOG_GetStats(BLOG_Stats_t *pStats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_BINLOG_H_ */
@@ -0,0 +1,114 @@
+/**************************************************************************//**
+ * @file    deferred_work.h
+ * @brief   Header file for deferred_work.c
+ *
+ * This file has 4 functions declarations (input parameters omitted):
+ *      <br>1) DEFER_Init()             - Installs and enables the bottom-half IRQ. </br>
+ *      <br>2) DEFER_Post()             - Queues a work item and pends the bottom half. </br>
+ *      <br>3) DEFER_GetStats()         - Returns the statistics of a priority level. </br>
+ *      <br>4) DEFER_IRQHandler()       - Bottom half, runs the queued work items. </br>
+ *
+ * An interrupt handler (top half) does only the urgent part of its work,
+ * posts the rest as a work item and returns. The item runs in the bottom
+ * half, a low priority IRQ pended through NVIC_STIR, as soon as no more
+ * urgent interrupt is running. Items run in priority level order, FIFO
+ * within a level, and any interrupt above the bottom half priority preempts
+ * them.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_DEFERRED_WORK_H_
+#define INC_DEFERRED_WORK_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Priority levels of the work items, 0 runs first.
+ */
+///@{
+#define	DEFER_PRIORITY_HIGH		(0U)
+#define	DEFER_PRIORITY_NORMAL		(1U)
+#define	DEFER_PRIORITY_LOW		(2U)
+#define	DEFER_LEVELS			(3U)
+///@}
+
+/** @name Sizing and IRQ. Can be overridden from the compiler command line.
+ */
+///@{
+#ifndef DEFER_QUEUE_SIZE
+#define	DEFER_QUEUE_SIZE		(16U)		/**< Items per level, power of 2 */
+#endif
+
+#ifndef DEFER_IRQ_NUMBER
+#define	DEFER_IRQ_NUMBER		IRQ_NO_SWPMI1	/**< Any IRQ whose peripheral is unused */
+#endif
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of DEFER function status */
+{
+  DEFER_STATUS_OK = 0,          /**< DEFER status OK */
+  DEFER_STATUS_ERROR = 1,       /**< Argument error */
+  DEFER_STATUS_FULL = 2         /**< Queue of the level full, item dropped */
+}DEFER_STATUS;
+
+typedef void (*DEFER_Work_t)(void *pArg);
+
+typedef struct  /**< Statistics of one priority level */
+{
+  uint32_t      Posted;                 /**< Items queued */
+  uint32_t      Dropped;                /**< Items refused, queue full */
+  uint32_t      MaxDepth;               /**< Most items waiting at once */
+  uint32_t      MaxWaitCycles;          /**< Longest post to start of the item */
+}DEFER_Stats_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+DEFER_STATUS DEFER_Init(uint8_t IRQpriority);
+DEFER_STATUS DEFER_Post(uint8_t Priority, DEFER_Work_t pWork, void *pArg);
+DEFER_STATUS DEFER_GetStats(uint8_t Priority, DEFER_Stats_t *pStats);
+void DEFER_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DEFERRED_WORK_H_ */
@@ -0,0 +1,111 @@
+/**************************************************************************//**
+ * @file    delay.h
+ * @brief   Header file for delay.c
+ *
+ * This file has 6 functions declarations (input parameters omitted):
+ *      <br>1) DELAY_Init()             - Enables the cycle counter and calibrates. </br>
+ *      <br>2) DELAY_Cycles()           - Waits a number of CPU cycles. </br>
+ *      <br>3) DELAY_Ns()               - Waits a number of nanoseconds. </br>
+ *      <br>4) DELAY_Us()               - Waits a number of microseconds. </br>
+ *      <br>5) DELAY_Ms()               - Waits a number of milliseconds. </br>
+ *      <br>6) DELAY_SelfTest()         - Measures each delay against DWT_CYCCNT. </br>
+ *
+ * Busy-wait delays in real time units. Long waits poll DWT_CYCCNT, short
+ * ones (below DELAY_SHORT_CYCLES) spin in a loop running from SRAM2 whose
+ * cost per iteration is measured by DELAY_Init(), as is the cost of the
+ * call itself, which is subtracted. Times are converted with the HCLK of
+ * the RCC driver, updated by a clock change callback: a delay started
+ * after RCC_Config_xxx() returns uses the new clock.
+ *
+ * The result is a minimum: interrupts taken during the wait lengthen it.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_DELAY_H_
+#define INC_DELAY_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Short path and self-test.
+ */
+///@{
+#define	DELAY_SHORT_CYCLES		(64UL)		/**< Below, calibrated loop */
+#define	DELAY_TEST_CASES		(6U)
+#define	DELAY_TEST_TOLERANCE_CYCLES	(8UL)		/**< Plus 1% of the request */
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of DELAY function status */
+{
+  DELAY_STATUS_OK = 0,          /**< DELAY status OK */
+  DELAY_STATUS_ERROR = 1,       /**< Clock unknown */
+  DELAY_STATUS_FAILED = 2       /**< A self-test case is out of tolerance */
+}DELAY_STATUS;
+
+typedef struct  /**< One self-test case */
+{
+  uint32_t      ExpectedCycles;         /**< Request converted at the current HCLK */
+  uint32_t      MeasuredCycles;         /**< DWT_CYCCNT around the call */
+}DELAY_TestCase_t;
+
+typedef struct  /**< Self-test result and calibration */
+{
+  DELAY_TestCase_t Cases[DELAY_TEST_CASES];     /**< 20 and 200 cycles, 500 ns, 1, 10 and 1000 us */
+  uint32_t      HCLK;                   /**< Clock of the test */
+  uint32_t      CallOverheadCycles;     /**< Cost of an empty DELAY_Cycles() */
+  uint32_t      LoopCyclesQ8;           /**< Short loop iteration cost, 1/256 cycles */
+}DELAY_TestResult_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+DELAY_STATUS DELAY_Init(void);
+void DELAY_Cycles(uint32_t Cycles);
+void DELAY_Ns(uint32_t Nanoseconds);
+void DELAY_Us(uint32_t Microseconds);
+void DELAY_Ms(uint32_t Milliseconds);
+DELAY_STATUS DELAY_SelfTest(DELAY_TestResult_t *pResult);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DELAY_H_ */
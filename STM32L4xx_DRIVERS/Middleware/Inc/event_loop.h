@@ -0,0 +1,126 @@
+/**************************************************************************//**
+ * @file    event_loop.h
+ * @brief   Header file for event_loop.c
+ *
+ * This file has 7 functions declarations (input parameters omitted):
+ *      <br>1) EVL_Init()               - Empties the queues and selects the idle instruction. </br>
+ *      <br>2) EVL_SetHandler()         - Sets the handler of a queue. </br>
+ *      <br>3) EVL_SetIdleHook()        - Replaces the idle instruction by a function. </br>
+ *      <br>4) EVL_Post()               - Posts an event, from interrupts or handlers. </br>
+ *      <br>5) EVL_Run()                - Dispatches events and sleeps when idle. </br>
+ *      <br>6) EVL_RunFromInterrupts()  - Sleeps forever with SLEEPONEXIT, for ISR-only apps. </br>
+ *      <br>7) EVL_GetLoad()            - Returns the CPU load since the last call. </br>
+ *
+ * Run-to-completion event loop: each queue has one handler, the highest
+ * priority non-empty queue (queue 0 first) is served one event at a time,
+ * and each handler runs to its end before the next event is taken. When
+ * every queue is empty the core sleeps until an interrupt posts something.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_EVENT_LOOP_H_
+#define INC_EVENT_LOOP_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Sizing. Can be overridden from the compiler command line.
+ */
+///@{
+#ifndef EVL_QUEUES
+#define	EVL_QUEUES			(4U)		/**< Queue 0 is served first */
+#endif
+
+#ifndef EVL_QUEUE_SIZE
+#define	EVL_QUEUE_SIZE			(8U)		/**< Events per queue, power of 2 */
+#endif
+///@}
+
+/** @name Idle instruction when every queue is empty.
+ */
+///@{
+#define	EVL_IDLE_WFI			(0U)	/**< Sleep until an interrupt */
+#define	EVL_IDLE_WFE			(1U)	/**< Sleep until an event or an interrupt (SEVONPEND) */
+#define	EVL_IDLE_NONE			(2U)	/**< Busy poll, for debugging */
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of EVL function status */
+{
+  EVL_STATUS_OK = 0,            /**< EVL status OK */
+  EVL_STATUS_ERROR = 1,         /**< Argument error */
+  EVL_STATUS_FULL = 2           /**< Queue full, event dropped */
+}EVL_STATUS;
+
+typedef struct  /**< One event */
+{
+  uint16_t      Signal;                 /**< What happened, defined by the application */
+  uint16_t      Queue;                  /**< Queue it was posted to */
+  uint32_t      Param;                  /**< Event data */
+}EVL_Event_t;
+
+typedef void (*EVL_Handler_t)(const EVL_Event_t *pEvent);
+
+typedef struct  /**< CPU load of a window, between two EVL_GetLoad() calls */
+{
+  uint32_t      LoadPermille;           /**< Busy cycles per 1000 cycles */
+  uint32_t      BusyCycles;             /**< Handlers, interrupts and loop overhead */
+  uint32_t      IdleCycles;             /**< Cycles spent in the idle instruction or hook */
+  uint32_t      Events;                 /**< Events dispatched */
+  uint32_t      Dropped;                /**< Events refused, queue full */
+  uint32_t      MaxHandlerCycles;       /**< Longest handler run */
+}EVL_Load_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+EVL_STATUS EVL_Init(uint8_t IdleMode);
+EVL_STATUS EVL_SetHandler(uint8_t Queue, EVL_Handler_t pHandler);
+void EVL_SetIdleHook(void (*pHook)(void));
+EVL_STATUS EVL_Post(uint8_t Queue, uint16_t Signal, uint32_t Param);
+void EVL_Run(void);
+void EVL_RunFromInterrupts(void);
+void EVL_GetLoad(EVL_Load_t *pLoad);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_EVENT_LOOP_H_ */
@@ -0,0 +1,128 @@
+/**************************************************************************//**
+ * @file    flash_ecc.h
+ * @brief   Header file for flash_ecc.c
+ *
+ * This file has 6 functions declarations (input parameters omitted):
+ *      <br>1) FECC_Init()              - Enables the ECC correction interrupt. </br>
+ *      <br>2) FECC_RegisterClient()    - Registers a flash-backed storage. </br>
+ *      <br>3) FECC_Service()           - Rewrites or retires the weak pages. </br>
+ *      <br>4) FECC_GetStats()          - Returns the ECC counters. </br>
+ *      <br>5) FECC_GetTable()          - Returns the per-page counter table. </br>
+ *      <br>6) FECC_DoubleErrorCallback() - Weak hook called on a double error. </br>
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_FLASH_ECC_H_
+#define INC_FLASH_ECC_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx_flash_driver.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name FECC configuration.
+ */
+///@{
+#define	FECC_TABLE_SIZE			(16U)	/**< Pages tracked in the counter table */
+#define	FECC_MAX_CLIENTS		(4U)	/**< Flash-backed storages that can register */
+#define	FECC_WEAK_THRESHOLD		(4U)	/**< Corrections before a page is rewritten */
+#define	FECC_RETIRE_THRESHOLD		(16U)	/**< Corrections before a page is retired */
+#define	FECC_PENDING_DOUBLE		(4U)	/**< Double errors the NMI can queue, power of 2 */
+///@}
+
+/** @name FECC table entry flags.
+ */
+///@{
+#define	FECC_FLAG_REWRITTEN		(0x01U)
+#define	FECC_FLAG_RETIRED		(0x02U)
+#define	FECC_FLAG_DOUBLE_ERROR		(0x04U)
+#define	FECC_FLAG_UNOWNED		(0x08U)
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of FECC function status */
+{
+  FECC_STATUS_OK = 0,           /**< FECC status OK */
+  FECC_STATUS_ERROR = 1         /**< FECC status ERROR */
+}FECC_STATUS;
+
+typedef struct  /**< Counter table entry, 4 bytes per tracked page */
+{
+  uint16_t      Page;           /**< Page number, 0 to 511 (bank 2 starts at 256) */
+  uint8_t       Count;          /**< Corrections seen, saturates at 255 */
+  uint8_t       Flags;          /**< FECC_FLAG_xxx */
+}FECC_Entry_t;
+
+typedef struct  /**< Flash-backed storage that can move its data off a weak page */
+{
+  uint32_t      StartAddress;                                   /**< First byte owned */
+  uint32_t      EndAddress;                                     /**< First byte not owned */
+  FECC_STATUS   (*Rewrite)(uint32_t PageAddress);               /**< Erases and rewrites the page */
+  FECC_STATUS   (*Retire)(uint32_t PageAddress);                /**< Moves data away, never uses the page again */
+}FECC_Client_t;
+
+typedef struct  /**< ECC counters */
+{
+  uint32_t      Corrections;            /**< Single-bit errors corrected */
+  uint32_t      DoubleErrors;           /**< Double-bit errors detected */
+  uint32_t      LastCorrectedAddress;   /**< Address of the last correction */
+  uint32_t      LastDoubleErrorAddress; /**< Address of the last double error */
+  uint32_t      Rewrites;               /**< Pages rewritten by FECC_Service */
+  uint32_t      Retirements;            /**< Pages retired by FECC_Service */
+  uint32_t      TableEvictions;         /**< Entries replaced because the table was full */
+  uint32_t      TableDrops;             /**< Errors not logged, every entry was pinned */
+  uint32_t      QueueDrops;             /**< Double errors not logged, the NMI queue was full */
+}FECC_Stats_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+void FECC_Init(void);
+FECC_STATUS FECC_RegisterClient(const FECC_Client_t *pClient);
+void FECC_Service(void);
+void FECC_GetStats(FECC_Stats_t *pStats);
+const __vo FECC_Entry_t* FECC_GetTable(void);
+void FECC_DoubleErrorCallback(uint32_t Address);
+void FLASH_IRQHandler(void);
+void NMI_Handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_FLASH_ECC_H_ */
@@ -0,0 +1,95 @@
+/**************************************************************************//**
+ * @file    irq_bench.h
+ * @brief   Header file for irq_bench.c
+ *
+ * This file has 3 functions declarations (input parameters omitted):
+ *      <br>1) IRQB_Run()               - Measures the IRQ latency and checks preemption. </br>
+ *      <br>2) LCD_IRQHandler()         - Low priority handler of the benchmark. </br>
+ *      <br>3) AES_IRQHandler()         - High priority handler of the benchmark. </br>
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_IRQ_BENCH_H_
+#define INC_IRQ_BENCH_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name IRQs used by the benchmark. Their vectors are free on the STM32L475
+ *  (no LCD, no AES), irq_bench.c defines LCD_IRQHandler and AES_IRQHandler.
+ */
+///@{
+#define	IRQB_IRQ_LOW			IRQ_NO_LCD
+#define	IRQB_IRQ_HIGH			IRQ_NO_AES
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of IRQB function status */
+{
+  IRQB_STATUS_OK = 0,           /**< Measured, preemption rules respected */
+  IRQB_STATUS_ERROR = 1,        /**< Argument error */
+  IRQB_STATUS_FAILED = 2        /**< A preemption check failed, see the result */
+}IRQB_STATUS;
+
+typedef struct  /**< Result of IRQB_Run(), latencies in CPU cycles */
+{
+  uint32_t      Samples;                /**< Measured entries */
+  uint32_t      EntryMinCycles;         /**< STIR write to handler, from thread mode */
+  uint32_t      EntryMaxCycles;
+  uint32_t      EntryTotalCycles;       /**< Divide by Samples for the mean */
+  uint32_t      PreemptMinCycles;       /**< STIR write to handler, from a lower priority handler */
+  uint32_t      PreemptMaxCycles;
+  uint8_t       PreemptOk;              /**< Higher preempt priority interrupted the running handler */
+  uint8_t       SamePreemptOk;          /**< Same preempt priority, better sub-priority waited */
+  uint8_t       SubPriorityOrderOk;     /**< Two pending, the better sub-priority ran first */
+}IRQB_Result_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+IRQB_STATUS IRQB_Run(uint32_t Iterations, IRQB_Result_t *pResult);
+void LCD_IRQHandler(void);
+void AES_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_IRQ_BENCH_H_ */
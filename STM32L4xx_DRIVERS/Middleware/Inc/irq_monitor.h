@@ -0,0 +1,134 @@
+/**************************************************************************//**
+ * @file    irq_monitor.h
+ * @brief   Header file for irq_monitor.c
+ *
+ * This file has 8 functions declarations (input parameters omitted):
+ *      <br>1) IRQMON_Init()            - Clears the statistics and starts a window. </br>
+ *      <br>2) IRQMON_Attach()          - Routes an IRQ through the monitor, with a budget. </br>
+ *      <br>3) IRQMON_Detach()          - Gives the IRQ its handler back. </br>
+ *      <br>4) IRQMON_IdleEnter()       - Marks the start of idle time. </br>
+ *      <br>5) IRQMON_IdleExit()        - Marks its end. </br>
+ *      <br>6) IRQMON_GetReport()       - Computes the loads of the window and starts a new one. </br>
+ *      <br>7) IRQMON_Log()             - Writes the last report to the binary logger. </br>
+ *      <br>8) IRQMON_Handler()         - Vector of the monitored IRQs. </br>
+ *
+ * CPU load and interrupt monitor. An attached IRQ has IRQMON_Handler() in
+ * its vector (SRAM1 table, see NVIC_RelocateVectorTable()), which times
+ * the original handler with DWT_CYCCNT. Each monitored IRQ gets its count,
+ * its cycles without the time of the interrupts preempting it, its longest
+ * run and the runs longer than its budget. The idle time is what passes
+ * between IRQMON_IdleEnter() and IRQMON_IdleExit(), monitored handlers
+ * excepted; the rest of the window is the CPU load.
+ *
+ * The window and the idle time are read with TS_Now(), so a Stop mode
+ * entered between IRQMON_IdleEnter() and IRQMON_IdleExit() counts as idle.
+ * Call TS_Init() and TS_SetReference() with a counter running in Stop
+ * (LPTIM1) before IRQMON_Init(); without the reference the time in Stop is
+ * missing from the window and the load reads too high.
+ *
+ * irqmon_window holds the counters of the running window and irqmon_report
+ * the last finished one, both readable with the debugger.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_IRQ_MONITOR_H_
+#define INC_IRQ_MONITOR_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Sizing. Can be overridden from the compiler command line.
+ */
+///@{
+#ifndef IRQMON_SLOTS
+#define	IRQMON_SLOTS			(8U)		/**< IRQs monitored at the same time */
+#endif
+///@}
+
+#define	IRQMON_NO_IRQ			(0xFFU)		/**< IRQnumber of a free slot */
+#define	IRQMON_NO_BUDGET		(0UL)		/**< Budget that is never overrun */
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of IRQMON function status */
+{
+  IRQMON_STATUS_OK = 0,         /**< IRQMON status OK */
+  IRQMON_STATUS_ERROR = 1,      /**< IRQ out of range, not attached, or vector table in flash */
+  IRQMON_STATUS_FULL = 2        /**< IRQMON_SLOTS IRQs already monitored */
+}IRQMON_STATUS;
+
+typedef struct  /**< One monitored IRQ, counters of a window */
+{
+  uint8_t       IRQnumber;              /**< IRQMON_NO_IRQ if the slot is free */
+  uint8_t       Reserved[3];
+  uint32_t      BudgetCycles;           /**< Longest acceptable run, IRQMON_NO_BUDGET for none */
+  uint32_t      Count;                  /**< Runs */
+  uint32_t      Cycles;                 /**< Total of the runs, preemptions excluded */
+  uint32_t      MaxCycles;              /**< Longest run */
+  uint32_t      Overruns;               /**< Runs longer than BudgetCycles */
+}IRQMON_Irq_t;
+
+typedef struct  /**< CPU load and interrupt counters of a window */
+{
+  uint32_t      WindowUs;               /**< Length of the window, Stop modes included */
+  uint32_t      IdleUs;                 /**< Between IdleEnter and IdleExit, handlers excluded */
+  uint32_t      IrqCycles;              /**< In monitored handlers */
+  uint16_t      LoadPermille;           /**< Not idle, per 1000 of the window */
+  uint16_t      IrqPermille;            /**< In monitored handlers, per 1000 of the window */
+  uint32_t      Overruns;               /**< Budget overruns of all the IRQs */
+  IRQMON_Irq_t  Irqs[IRQMON_SLOTS];
+}IRQMON_Report_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+void IRQMON_Init(void);
+IRQMON_STATUS IRQMON_Attach(uint8_t IRQnumber, uint32_t BudgetCycles);
+IRQMON_STATUS IRQMON_Detach(uint8_t IRQnumber);
+void IRQMON_IdleEnter(void);
+void IRQMON_IdleExit(void);
+void IRQMON_GetReport(IRQMON_Report_t *pReport);
+void IRQMON_Log(void);
+void IRQMON_Handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_IRQ_MONITOR_H_ */
@@ -0,0 +1,151 @@
+/**************************************************************************//**
+ * @file    kernel.h
+ * @brief   Header file for kernel.c
+ *
+ * This file has 13 functions declarations (input parameters omitted):
+ *      <br>1) KRN_TaskCreate()         - Creates a task on a static TCB and stack. </br>
+ *      <br>2) KRN_Start()              - Starts the scheduler, never returns. </br>
+ *      <br>3) KRN_SetIdleHook()        - Function run by the idle task. </br>
+ *      <br>4) KRN_Delay()              - Blocks the calling task for a number of ticks. </br>
+ *      <br>5) KRN_Tick()               - Advances the kernel time, from the tick interrupt. </br>
+ *      <br>6) KRN_GetTicks()           - Returns the kernel time. </br>
+ *      <br>7) KRN_GetIdleTicks()       - Ticks until a task needs the CPU. </br>
+ *      <br>8) KRN_Advance()            - Skips idle ticks after a tickless sleep. </br>
+ *      <br>9) KRN_SemInit()            - Initializes a counting semaphore. </br>
+ *      <br>10) KRN_SemTake()           - Takes a semaphore, blocking up to a timeout. </br>
+ *      <br>11) KRN_SemGive()           - Gives a semaphore, from tasks or interrupts. </br>
+ *      <br>12) KRN_GetSwitchStats()    - Returns the context switch statistics. </br>
+ *      <br>13) PendSV_Handler()        - Context switch. </br>
+ *
+ * Fixed-priority preemptive kernel: one task per priority level, 0 being the
+ * most urgent and KRN_PRIORITY_IDLE reserved for the idle task. The running
+ * task is always the most urgent ready one, found with one CLZ on the ready
+ * bitmap. Semaphores can be given from interrupt handlers, so an EXTI
+ * handler can wake the task that processes the pin.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_KERNEL_H_
+#define INC_KERNEL_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Priorities.
+ */
+///@{
+#define	KRN_PRIORITIES			(32U)
+#define	KRN_PRIORITY_IDLE		(KRN_PRIORITIES - 1U)	/**< Reserved */
+///@}
+
+/** @name Timeouts of KRN_SemTake(), in ticks.
+ */
+///@{
+#define	KRN_NO_WAIT			(0UL)
+#define	KRN_WAIT_FOREVER		(0xFFFFFFFFUL)
+///@}
+
+/** @name Stack sizes, in 32-bit words. A task using the FPU needs 50 more
+ *  words for the stacked floating point registers.
+ */
+///@{
+#define	KRN_STACK_MIN_WORDS		(64U)
+#ifndef KRN_IDLE_STACK_WORDS
+#define	KRN_IDLE_STACK_WORDS		(128U)
+#endif
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of KRN function status */
+{
+  KRN_STATUS_OK = 0,            /**< KRN status OK */
+  KRN_STATUS_ERROR = 1,         /**< Argument error or priority taken */
+  KRN_STATUS_TIMEOUT = 2,       /**< Semaphore not given in time */
+  KRN_STATUS_FULL = 3           /**< Semaphore count already at its maximum */
+}KRN_STATUS;
+
+typedef struct  /**< Task control block. Allocated by the application, opaque */
+{
+  uint32_t      *pStack;                /**< Saved stack pointer, must be first */
+  uint8_t       Priority;
+  uint8_t       WakeStatus;             /**< KRN_STATUS of the last wait */
+  uint32_t      Delay;                  /**< Ticks left of the current wait */
+  void          *pWaitSem;              /**< Semaphore waited on, or 0 */
+  uint32_t      *pStackBase;            /**< Lowest word, for stack checks */
+}KRN_Task_t;
+
+typedef struct  /**< Counting semaphore */
+{
+  __vo uint32_t Count;
+  uint32_t      MaxCount;
+  __vo uint32_t Waiters;                /**< Bitmap of the waiting priorities */
+}KRN_Sem_t;
+
+typedef struct  /**< Give-to-run latency, in CPU cycles */
+{
+  uint32_t      Switches;               /**< Context switches done */
+  uint32_t      Samples;                /**< Gives that woke a more urgent task */
+  uint32_t      MinCycles;              /**< From KRN_SemGive() to KRN_SemTake() return */
+  uint32_t      MaxCycles;
+  uint32_t      LastCycles;
+}KRN_SwitchStats_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+KRN_STATUS KRN_TaskCreate(KRN_Task_t *pTask, void (*pEntry)(void *pArg), void *pArg, uint32_t *pStack, uint32_t StackWords, uint8_t Priority);
+void KRN_Start(void);
+void KRN_SetIdleHook(void (*pHook)(void));
+void KRN_Delay(uint32_t Ticks);
+void KRN_Tick(void);
+uint32_t KRN_GetTicks(void);
+uint32_t KRN_GetIdleTicks(void);
+void KRN_Advance(uint32_t Ticks);
+void KRN_SemInit(KRN_Sem_t *pSem, uint32_t InitialCount, uint32_t MaxCount);
+KRN_STATUS KRN_SemTake(KRN_Sem_t *pSem, uint32_t TimeoutTicks);
+KRN_STATUS KRN_SemGive(KRN_Sem_t *pSem);
+void KRN_GetSwitchStats(KRN_SwitchStats_t *pStats);
+void PendSV_Handler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_KERNEL_H_ */
@@ -0,0 +1,168 @@
+/**************************************************************************//**
+ * @file    kv_store.h
+ * @brief   Header file for kv_store.c
+ *
+ * This file has 10 functions declarations (input parameters omitted):
+ *      <br>1) KVS_Mount()          - Scans the flash area and builds the RAM index. </br>
+ *      <br>2) KVS_Format()         - Erases the flash area and mounts an empty store. </br>
+ *      <br>3) KVS_Read()           - Reads the value of a key. </br>
+ *      <br>4) KVS_Write()          - Appends a new value for a key. </br>
+ *      <br>5) KVS_Delete()         - Appends a tombstone for a key. </br>
+ *      <br>6) KVS_GetStats()       - Returns usage and wear statistics. </br>
+ *      <br>7) KVS_GetFlashOps()    - Returns the flash backend of the target. </br>
+ *      <br>8) KVS_RefreshPage()    - Moves the records of a page away and erases it. </br>
+ *      <br>9) KVS_RetirePage()     - Moves the records of a page away and retires it. </br>
+ *      <br>10) KVS_RegisterEccClient() - Lets the flash ECC monitor refresh or retire pages. </br>
+ *
+ * The store is a log of 64-bit records kept in a ring of flash pages. Every
+ * write is appended to the head page, the RAM index maps each key to its
+ * newest record so reads never scan the flash. When only the reserve page is
+ * left free, the oldest page is garbage collected: its live records are
+ * copied to the head and the page is erased. Because pages are reclaimed in
+ * ring order and new pages are taken by lowest erase count, erases are spread
+ * over the whole area.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_KV_STORE_H_
+#define INC_KV_STORE_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name KVS sizing. Can be overridden from the compiler command line.
+ */
+///@{
+#ifndef KVS_MAX_PAGES
+#define	KVS_MAX_PAGES			(32UL)		/**< Maximum number of flash pages handled */
+#endif
+
+#ifndef KVS_INDEX_SLOTS
+#define	KVS_INDEX_SLOTS			(256UL)		/**< Hash index slots, must be a power of 2 */
+#endif
+
+#define	KVS_MAX_KEYS			((KVS_INDEX_SLOTS * 3UL) / 4UL)
+#define	KVS_MAX_VALUE_SIZE		(256UL)
+#define	KVS_RESERVE_PAGES		(1UL)
+///@}
+
+/** @name KVS keys. Key 0xFFFF is reserved for erased flash.
+ */
+///@{
+#define	KVS_KEY_INVALID			(0xFFFFU)
+///@}
+
+/** @name Flash area used by the target backend, the last 16 pages of bank 2.
+ */
+///@{
+#define	KVS_FLASH_AREA_ADDRESS		(0x080F8000UL)
+#define	KVS_FLASH_AREA_PAGES		(16UL)
+///@}
+
+/** @name Geometry of the host flash simulator (kv_store_flash_sim.c).
+ */
+///@{
+#ifndef KVS_SIM_PAGES
+#define	KVS_SIM_PAGES			(16UL)
+#endif
+#define	KVS_SIM_PAGE_SIZE		(2048UL)
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of KVS function status */
+{
+  KVS_STATUS_OK = 0,            /**< KVS status OK */
+  KVS_STATUS_ERROR = 1,         /**< Flash backend or argument error */
+  KVS_STATUS_NOT_FOUND = 2,     /**< Key not present */
+  KVS_STATUS_FULL = 3,          /**< No space left even after garbage collection */
+  KVS_STATUS_NO_INIT = 4        /**< Store not mounted */
+}KVS_STATUS;
+
+typedef struct  /**< Flash backend used by the store. Offsets are relative to Base. */
+{
+  const uint8_t *Base;                                          /**< Memory mapped start of the area */
+  uint32_t      PageSize;                                       /**< Erase unit in bytes */
+  uint32_t      PageCount;                                      /**< Number of pages of the area */
+  KVS_STATUS    (*ErasePage)(uint32_t PageIndex);               /**< Erases one page to 0xFF */
+  KVS_STATUS    (*Program)(uint32_t Offset, uint64_t Data);     /**< Programs one aligned double word */
+}KVS_FlashOps_t;
+
+typedef struct  /**< Statistics of the store */
+{
+  uint32_t      Keys;                   /**< Live keys in the index */
+  uint32_t      FreePages;              /**< Erased and formatted pages */
+  uint32_t      RetiredPages;           /**< Pages taken out of service */
+  uint32_t      HeadFreeBytes;          /**< Bytes left in the head page */
+  uint32_t      MinEraseCount;          /**< Lowest page erase count */
+  uint32_t      MaxEraseCount;          /**< Highest page erase count */
+  uint32_t      GCRuns;                 /**< Pages garbage collected since mount */
+  uint32_t      GCCopiedBytes;          /**< Bytes moved by the garbage collector */
+  uint32_t      LostRecords;            /**< Live values found corrupted when moved, deleted */
+}KVS_Stats_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+KVS_STATUS KVS_Mount(const KVS_FlashOps_t *pFlashOps);
+KVS_STATUS KVS_Format(const KVS_FlashOps_t *pFlashOps);
+KVS_STATUS KVS_Read(uint16_t Key, void *pBuffer, uint32_t BufferSize, uint32_t *pLength);
+KVS_STATUS KVS_Write(uint16_t Key, const void *pValue, uint32_t Length);
+KVS_STATUS KVS_Delete(uint16_t Key);
+void KVS_GetStats(KVS_Stats_t *pStats);
+const KVS_FlashOps_t* KVS_GetFlashOps(void);
+KVS_STATUS KVS_RefreshPage(uint32_t PageIndex);
+KVS_STATUS KVS_RetirePage(uint32_t PageIndex);
+
+#ifndef KVS_HOST_SIM
+KVS_STATUS KVS_RegisterEccClient(void);
+#endif
+
+#ifdef KVS_HOST_SIM
+void KVS_SIM_Reset(void);
+void KVS_SIM_SetPowerCut(uint32_t OperationsLeft);
+uint8_t KVS_SIM_PowerLost(void);
+void KVS_SIM_PowerCycle(void);
+void KVS_SIM_GetCounters(uint32_t *pErases, uint32_t *pPrograms);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_KV_STORE_H_ */
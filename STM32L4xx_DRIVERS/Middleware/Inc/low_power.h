@@ -0,0 +1,144 @@
+/**************************************************************************//**
+ * @file    low_power.h
+ * @brief   Header file for low_power.c
+ *
+ * This file has 15 functions declarations (input parameters omitted):
+ *      <br>1) LPM_Init()                   - Initializes the manager and its tables. </br>
+ *      <br>2) LPM_SetAllowedModes()        - Selects the modes the application accepts. </br>
+ *      <br>3) LPM_SetHardwareLatency()     - Overrides the hardware wakeup time of a mode. </br>
+ *      <br>4) LPM_SetProbePin()            - Selects a pin raised on every wakeup. </br>
+ *      <br>5) LPM_EnableWakeupLine()       - Enables an EXTI line as wakeup source. </br>
+ *      <br>6) LPM_EnableWakeupPin()        - Enables a WKUP pin for Standby/Shutdown. </br>
+ *      <br>7) LPM_Enter()                  - Enters a mode and restores the clocks. </br>
+ *      <br>8) LPM_SelectDeepestMode()      - Deepest allowed mode within a deadline. </br>
+ *      <br>9) LPM_EnterDeepest()           - Selects and enters the deepest mode. </br>
+ *      <br>10) LPM_GetStats()              - Returns the statistics of a mode. </br>
+ *      <br>11) LPM_EnterLowPowerRun()      - Drops to MSI <= 2 MHz, Range 2 and LPR. </br>
+ *      <br>12) LPM_ExitLowPowerRun()       - Returns to the regulator and clocks of before. </br>
+ *      <br>13) LPM_EnterLowPowerSleep()    - Sleeps with the regulator in low-power mode. </br>
+ *      <br>14) LPM_RunWithFlashOff()       - Runs a RAM function with the flash powered down. </br>
+ *      <br>15) LPM_SetStopHooks()          - Functions called around every Stop mode. </br>
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_LOW_POWER_H_
+#define INC_LOW_POWER_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+#include <stm32l475xx_gpio_driver.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Low-power modes, from the lightest to the deepest.
+ */
+///@{
+#define	LPM_MODE_SLEEP			(0U)
+#define	LPM_MODE_STOP0			(1U)
+#define	LPM_MODE_STOP1			(2U)
+#define	LPM_MODE_STOP2			(3U)
+#define	LPM_MODE_STANDBY		(4U)
+#define	LPM_MODE_SHUTDOWN		(5U)
+#define	LPM_MODE_COUNT			(6U)
+#define	LPM_MODE_NONE			(0xFFU)		/**< No mode meets the deadline */
+
+#define	LPM_MODE_MASK(mode)		(1UL << (mode))
+#define	LPM_MODES_RETAINING_RAM		(0x0FUL)	/**< Sleep to Stop 2, default */
+///@}
+
+/** @name EXTI lines of the internal wakeup sources.
+ */
+///@{
+#define	LPM_EXTI_LINE_RTC_ALARM		(18U)
+#define	LPM_EXTI_LINE_RTC_TAMPER	(19U)
+#define	LPM_EXTI_LINE_RTC_WAKEUP	(20U)
+#define	LPM_EXTI_LINE_LPTIM1		(32U)
+#define	LPM_EXTI_LINE_MAX		(40U)
+///@}
+
+/** @name Edge of the configurable EXTI lines (0 to 22).
+ */
+///@{
+#define	LPM_EDGE_KEEP			(0U)	/**< Direct lines, or GPIO lines set by GPIO_Init */
+#define	LPM_EDGE_RISING			(1U)
+#define	LPM_EDGE_FALLING		(2U)
+#define	LPM_EDGE_BOTH			(3U)
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of LPM function status */
+{
+  LPM_STATUS_OK = 0,            /**< LPM status OK */
+  LPM_STATUS_ERROR = 1          /**< LPM status ERROR */
+}LPM_STATUS;
+
+typedef struct  /**< Statistics of one mode */
+{
+  uint32_t      Entries;                /**< Times the mode was entered */
+  uint32_t      EntryCycles;            /**< Worst cycles from LPM_Enter to WFI */
+  uint32_t      ResumeMinNs;            /**< Fastest clock restoration after wakeup */
+  uint32_t      ResumeMaxNs;            /**< Slowest clock restoration after wakeup */
+  uint32_t      ResumeLastNs;           /**< Last clock restoration after wakeup */
+  uint32_t      HardwareNs;             /**< Wakeup time of the device itself */
+  uint32_t      WorstLatencyNs;         /**< HardwareNs + ResumeMaxNs */
+}LPM_Stats_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+void LPM_Init(void);
+void LPM_SetAllowedModes(uint32_t ModeMask);
+LPM_STATUS LPM_SetHardwareLatency(uint8_t Mode, uint32_t LatencyNs);
+void LPM_SetProbePin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber);
+LPM_STATUS LPM_EnableWakeupLine(uint8_t ExtiLine, uint8_t Edge, uint8_t Enabler);
+LPM_STATUS LPM_EnableWakeupPin(uint8_t WakeupPin, uint8_t Polarity, uint8_t Enabler);
+LPM_STATUS LPM_Enter(uint8_t Mode);
+uint8_t LPM_SelectDeepestMode(uint32_t DeadlineNs);
+LPM_STATUS LPM_EnterDeepest(uint32_t DeadlineNs);
+LPM_STATUS LPM_GetStats(uint8_t Mode, LPM_Stats_t *pStats);
+LPM_STATUS LPM_EnterLowPowerRun(uint32_t MSIspeed);
+LPM_STATUS LPM_ExitLowPowerRun(void);
+LPM_STATUS LPM_EnterLowPowerSleep(uint8_t FlashPowerDown);
+LPM_STATUS LPM_RunWithFlashOff(void (*pRamFunc)(void));
+void LPM_SetStopHooks(void (*pEnter)(void), void (*pExit)(void));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_LOW_POWER_H_ */
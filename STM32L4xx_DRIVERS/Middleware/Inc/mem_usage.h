@@ -0,0 +1,118 @@
+/**************************************************************************//**
+ * @file    mem_usage.h
+ * @brief   Header file for mem_usage.c
+ *
+ * This file has 6 functions declarations (input parameters omitted):
+ *      <br>1) MEMU_GetStackUsage()     - Peak and free bytes of the main stack. </br>
+ *      <br>2) MEMU_GetHeapUsage()      - Peak, free and fragmentation of the heap. </br>
+ *      <br>3) MEMU_PaintRegion()       - Fills a stack with MEMU_PAINT_PATTERN. </br>
+ *      <br>4) MEMU_RegionUsed()        - Peak words of a painted stack. </br>
+ *      <br>5) MEMU_Log()               - Writes both usages to the binary logger. </br>
+ *      <br>6) MEMU_PaintStack()        - Paints the free RAM below the stack pointer. </br>
+ *
+ * RAM high-water instrumentation. Reset_Handler paints the RAM between the
+ * end of .bss (linker symbol end) and the stack pointer with
+ * MEMU_PAINT_PATTERN. The stack grows down from _estack over the paint, so
+ * its peak is where the first overwritten word above the heap break is;
+ * the painted words left are RAM neither the stack nor the heap ever used.
+ *
+ * After a Standby wakeup restored by WARM_EarlyResume() the paint is
+ * skipped, it would take tens of milliseconds of the wake path. The stack
+ * is then reported as not painted until the application calls
+ * MEMU_PaintStack(), and the peak counts from that call.
+ *
+ * The heap figures come from _sbrk() in Src/sysmem.c (break, peak and
+ * refused requests) and from mallinfo() of the C library, so
+ * MEMU_GetHeapUsage() links malloc in. Compare both peaks with
+ * _Min_Stack_Size and _Min_Heap_Size of the linker script, see
+ * Tools/ram_report.py.
+ *
+ * A stack word that happens to be written with MEMU_PAINT_PATTERN is taken
+ * for paint: the peak can be a few words low, never high by more than that.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_MEM_USAGE_H_
+#define INC_MEM_USAGE_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/* Also in Startup/startup_stm32l475vgtx.s */
+#define	MEMU_PAINT_PATTERN		(0xCDCDCDCDUL)	/**< Word of never used RAM */
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef struct  /**< Main stack, in bytes */
+{
+  uint32_t      Size;                   /**< From the heap break to _estack */
+  uint32_t      Peak;                   /**< Deepest use since reset */
+  uint32_t      Free;                   /**< Size - Peak */
+  uint32_t      LinkerSize;             /**< _Min_Stack_Size of the linker script */
+  uint32_t      Painted;                /**< 0: RAM not painted, Peak and Free are 0 */
+}MEMU_Stack_t;
+
+typedef struct  /**< Heap, in bytes */
+{
+  uint32_t      Arena;                  /**< Obtained from _sbrk() */
+  uint32_t      Peak;                   /**< Largest arena since reset */
+  uint32_t      InUse;                  /**< Allocated by malloc() */
+  uint32_t      Free;                   /**< Inside the arena, not allocated */
+  uint32_t      FreeChunks;             /**< Free blocks the Free bytes are split into */
+  uint32_t      Failures;               /**< Requests _sbrk() refused */
+  uint32_t      LinkerSize;             /**< _Min_Heap_Size of the linker script */
+  uint16_t      FreePermille;           /**< Free per 1000 bytes of arena */
+  uint16_t      Reserved;
+}MEMU_Heap_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+void MEMU_GetStackUsage(MEMU_Stack_t *pStack);
+void MEMU_GetHeapUsage(MEMU_Heap_t *pHeap);
+void MEMU_PaintRegion(uint32_t *pBase, uint32_t Words);
+uint32_t MEMU_RegionUsed(const uint32_t *pBase, uint32_t Words);
+void MEMU_Log(void);
+void MEMU_PaintStack(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MEM_USAGE_H_ */
@@ -0,0 +1,118 @@
+/**************************************************************************//**
+ * @file    profiler.h
+ * @brief   Header file for profiler.c
+ *
+ * This file has 4 functions declarations (input parameters omitted):
+ *      <br>1) PROF_Init()              - Clears the sites and measures the probe cost. </br>
+ *      <br>2) PROF_Record()            - Adds one measurement to a site. </br>
+ *      <br>3) PROF_Reset()             - Clears the measurements of every site. </br>
+ *      <br>4) PROF_Dump()              - Prints the table of sites. </br>
+ *
+ * Scope probes on DWT_CYCCNT:
+ *
+ *      PROF_BEGIN(pll);
+ *      (void)RCC_Config_PLLCLK(...);
+ *      PROF_END(pll);
+ *
+ * PROF_BEGIN declares a static site in the .prof_sites section and reads the
+ * counter, PROF_END folds the difference into the count, min, max, total and
+ * log2 histogram of the site. The name must be unique within the function.
+ * Without PROF_ENABLE in the build the probes compile to nothing and the
+ * table is empty.
+ *
+ * The cycles include the counter read of PROF_END and the interrupts taken
+ * inside the scope; the PROF_Record() call of a nested probe counts in the
+ * enclosing scope. PROF_Dump() prints both costs as measured by PROF_Init(),
+ * subtract them when timing a few instructions.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_PROFILER_H_
+#define INC_PROFILER_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Histogram: bucket n counts the measurements in [2^n, 2^(n+1)),
+ *  bucket 0 also counts 0.
+ */
+///@{
+#define	PROF_BUCKETS			(32U)
+///@}
+
+/** @name Probes.
+ */
+///@{
+#ifdef PROF_ENABLE
+#define	PROF_BEGIN(name)											\
+	static PROF_Site_t prof_site_##name __attribute__((section(".prof_sites"), used)) =		\
+		{ #name, 0, 0xFFFFFFFFUL, 0, 0, {0} };							\
+	uint32_t prof_start_##name = *DWT_CYCCNT
+#define	PROF_END(name)			PROF_Record(&prof_site_##name, *DWT_CYCCNT - prof_start_##name)
+#else
+#define	PROF_BEGIN(name)		((void)0)
+#define	PROF_END(name)			((void)0)
+#endif
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef struct  /**< One probed scope, placed in .prof_sites by PROF_BEGIN */
+{
+  const char    *pName;
+  uint32_t      Count;
+  uint32_t      MinCycles;
+  uint32_t      MaxCycles;
+  uint64_t      TotalCycles;            /**< Mean is TotalCycles / Count */
+  uint32_t      Histogram[PROF_BUCKETS];
+}PROF_Site_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+void PROF_Init(void);
+void PROF_Record(PROF_Site_t *pSite, uint32_t Cycles);
+void PROF_Reset(void);
+void PROF_Dump(void (*pOutput)(const char *pText));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_PROFILER_H_ */
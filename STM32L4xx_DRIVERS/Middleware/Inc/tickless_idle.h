@@ -0,0 +1,105 @@
+/**************************************************************************//**
+ * @file    tickless_idle.h
+ * @brief   Header file for tickless_idle.c
+ *
+ * This file has 5 functions declarations (input parameters omitted):
+ *      <br>1) TLI_Init()               - Starts LPTIM1 and its wakeup line. </br>
+ *      <br>2) TLI_SetTimebase()        - Sets the functions giving and skipping idle ticks. </br>
+ *      <br>3) TLI_Idle()               - Sleeps in Stop 2 until the next deadline. </br>
+ *      <br>4) TLI_GetStats()           - Returns the tickless idle statistics. </br>
+ *      <br>5) TLI_LPTIMHandler()       - LPTIM1 compare match handler. </br>
+ *
+ * Tickless idle: when nothing is due for at least two ticks, the SysTick is
+ * stopped, LPTIM1 (LSI or LSE, running in Stop 2) is set to match at the
+ * tick boundary of the next deadline, and the device enters Stop 2. On the
+ * wakeup, by LPTIM1 or any other wakeup line, the slept time is read from
+ * LPTIM1, the timebase skips the whole ticks slept and the SysTick restarts.
+ *
+ * The match is set earlier by the wakeup latency (Stop 2 exit and clock
+ * restoration), measured on every LPTIM1 wakeup as the counts between the
+ * match and the end of LPM_Enter(). The fraction of tick left over by each
+ * sleep is carried to the next one, so the timebase does not drift.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_TICKLESS_IDLE_H_
+#define INC_TICKLESS_IDLE_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+#include <stm32l475xx_lptim_driver.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Limits.
+ */
+///@{
+#define	TLI_MIN_IDLE_TICKS		(2UL)		/**< Below, plain WFI */
+#define	TLI_MAX_SLEEP_COUNTS		(0xFF00UL)	/**< Margin below the 16-bit wrap */
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of TLI function status */
+{
+  TLI_STATUS_OK = 0,            /**< TLI status OK */
+  TLI_STATUS_ERROR = 1          /**< Clock or LPTIM1 error */
+}TLI_STATUS;
+
+typedef struct  /**< Tickless idle statistics, times in LPTIM1 counts */
+{
+  uint32_t      Sleeps;                 /**< Stop 2 entries */
+  uint32_t      SleptTicks;             /**< Ticks skipped or caught up after them */
+  uint32_t      EarlyWakeups;           /**< Woken by another source before the match */
+  uint32_t      LatencyCounts;          /**< Current wakeup latency estimate */
+  uint32_t      MaxLateCounts;          /**< Worst match to resume time measured */
+}TLI_Stats_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+TLI_STATUS TLI_Init(uint8_t ClockSource);
+void TLI_SetTimebase(uint32_t (*pGetIdleTicks)(void), void (*pAdvance)(uint32_t Ticks));
+void TLI_Idle(void);
+void TLI_GetStats(TLI_Stats_t *pStats);
+void TLI_LPTIMHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TICKLESS_IDLE_H_ */
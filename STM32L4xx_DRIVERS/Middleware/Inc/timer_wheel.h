@@ -0,0 +1,122 @@
+/**************************************************************************//**
+ * @file    timer_wheel.h
+ * @brief   Header file for timer_wheel.c
+ *
+ * This file has 8 functions declarations (input parameters omitted):
+ *      <br>1) TMW_Init()               - Empties the wheels and resets the time. </br>
+ *      <br>2) TMW_Start()              - Starts or restarts a one-shot or periodic timer. </br>
+ *      <br>3) TMW_Stop()               - Stops a timer. </br>
+ *      <br>4) TMW_IsActive()           - Tells if a timer is running. </br>
+ *      <br>5) TMW_Tick()               - Advances the time, from the tick interrupt. </br>
+ *      <br>6) TMW_GetTicks()           - Returns the time of the wheels. </br>
+ *      <br>7) TMW_GetIdleTicks()       - Ticks until the next tick with work. </br>
+ *      <br>8) TMW_Advance()            - Skips idle ticks after a tickless sleep. </br>
+ *
+ * Hierarchical timing wheel: TMW_LEVELS wheels of TMW_SLOTS slots. A timer
+ * due in less than 64 ticks goes to the slot of its expiry tick in wheel 0,
+ * one due in less than 64^2 ticks to wheel 1, and so on. Wheel 0 advances
+ * one slot per tick; each time it wraps, the next slot of wheel 1 is
+ * emptied and its timers go down to wheel 0, closer to their expiry.
+ *
+ * The timers are linked in their slot through their own TMW_Timer_t, so
+ * start and stop are O(1) with no allocation and no limit on the number of
+ * timers. A tick costs the timers that expire, plus one cascade every 64
+ * ticks. With 4 wheels of 64 slots the direct range is 2^24 ticks (4.6 h
+ * at 1 kHz); longer timers are parked in the last wheel and go around it
+ * again.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_TIMER_WHEEL_H_
+#define INC_TIMER_WHEEL_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Wheel geometry.
+ */
+///@{
+#define	TMW_LEVELS			(4U)
+#define	TMW_SLOT_BITS			(6U)
+#define	TMW_SLOTS			(1U << TMW_SLOT_BITS)
+///@}
+
+/** @name TMW_GetIdleTicks() value when no timer runs.
+ */
+///@{
+#define	TMW_NO_DEADLINE			(0xFFFFFFFFUL)
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of TMW function status */
+{
+  TMW_STATUS_OK = 0,            /**< TMW status OK */
+  TMW_STATUS_ERROR = 1          /**< Argument error */
+}TMW_STATUS;
+
+typedef void (*TMW_Callback_t)(void *pArg);
+
+typedef struct TMW_Timer  /**< Software timer. Allocated by the application */
+{
+  struct TMW_Timer      *pNext;         /**< Next timer of the slot */
+  struct TMW_Timer      **ppPrev;       /**< Link pointing to this timer, 0 if stopped */
+  uint32_t              Expires;        /**< Tick of the expiry */
+  uint32_t              Period;         /**< Reload in ticks, 0 for one-shot */
+  TMW_Callback_t        pCallback;
+  void                  *pArg;
+}TMW_Timer_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+void TMW_Init(void);
+TMW_STATUS TMW_Start(TMW_Timer_t *pTimer, uint32_t Ticks, uint32_t Period, TMW_Callback_t pCallback, void *pArg);
+void TMW_Stop(TMW_Timer_t *pTimer);
+uint8_t TMW_IsActive(const TMW_Timer_t *pTimer);
+void TMW_Tick(void);
+uint32_t TMW_GetTicks(void);
+uint32_t TMW_GetIdleTicks(void);
+void TMW_Advance(uint32_t Ticks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TIMER_WHEEL_H_ */
@@ -0,0 +1,104 @@
+/**************************************************************************//**
+ * @file    timestamp.h
+ * @brief   Header file for timestamp.c
+ *
+ * This file has 6 functions declarations (input parameters omitted):
+ *      <br>1) TS_Init()                - Starts the time base at 0 ns. </br>
+ *      <br>2) TS_SetReference()        - Sets the counter running in Stop modes. </br>
+ *      <br>3) TS_Now()                 - Returns the time in ns, from anywhere. </br>
+ *      <br>4) TS_Update()              - Moves the epoch to now, before CYCCNT wraps. </br>
+ *      <br>5) TS_Suspend()             - Saves the time before a Stop mode. </br>
+ *      <br>6) TS_Resync()              - Adds the time slept after a Stop mode. </br>
+ *
+ * Monotonic 64-bit time in nanoseconds since TS_Init(). Between two epochs
+ * it is extrapolated from DWT_CYCCNT at the HCLK of the epoch; a new epoch
+ * starts at every HCLK change, at every Stop mode exit and whenever the
+ * counter is more than half way to its wrap.
+ *
+ * TS_Now() takes no lock: it reads the active epoch of a double buffer and
+ * the counter, and reads again only if an epoch was published meanwhile.
+ * The writers mask interrupts for a few tens of cycles.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_TIMESTAMP_H_
+#define INC_TIMESTAMP_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Epoch age, in CPU cycles. TS_Now() or TS_Update() must run at
+ *  least once per 2^32 cycles (53 s at 80 MHz); TS_Now() starts a new epoch
+ *  by itself past TS_REBASE_CYCLES.
+ */
+///@{
+#define	TS_REBASE_CYCLES		(0x80000000UL)
+///@}
+
+/** @name Time units.
+ */
+///@{
+#define	TS_NS_PER_US			(1000ULL)
+#define	TS_NS_PER_MS			(1000000ULL)
+#define	TS_NS_PER_S			(1000000000ULL)
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of TS function status */
+{
+  TS_STATUS_OK = 0,             /**< TS status OK */
+  TS_STATUS_ERROR = 1           /**< TS status ERROR */
+}TS_STATUS;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+TS_STATUS TS_Init(void);
+TS_STATUS TS_SetReference(uint32_t (*pRead)(void), uint32_t Hz, uint32_t Mask);
+uint64_t TS_Now(void);
+void TS_Update(void);
+void TS_Suspend(void);
+void TS_Resync(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TIMESTAMP_H_ */
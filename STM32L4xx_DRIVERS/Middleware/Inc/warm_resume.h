@@ -0,0 +1,101 @@
+/**************************************************************************//**
+ * @file    warm_resume.h
+ * @brief   Header file for warm_resume.c
+ *
+ * This file has 6 functions declarations (input parameters omitted):
+ *      <br>1) WARM_Save()              - Saves the clock, GPIO and application state to SRAM2. </br>
+ *      <br>2) WARM_EarlyResume()       - Restores the snapshot from Reset_Handler. </br>
+ *      <br>3) WARM_IsWarmBoot()        - Tells if the reset is a Standby wakeup with a snapshot. </br>
+ *      <br>4) WARM_Complete()          - Restores the NVIC and consumes the snapshot. </br>
+ *      <br>5) WARM_GetAppData()        - Copies the application data of the snapshot. </br>
+ *      <br>6) WARM_GetResumeCycles()   - Cycles from the reset vector to WARM_Complete(). </br>
+ *
+ * Standby powers the core off, so the wakeup goes through the reset vector.
+ * With PWR_CR3 RRS set SRAM2 keeps its content, so the state saved there by
+ * WARM_Save() lets Reset_Handler rebuild the clocks and the pins right after
+ * setting the stack, without the full driver initialization of main().
+ *
+ * Usage:
+ *      <br>1) Before Standby: WARM_Save(), then LPM_Enter(LPM_MODE_STANDBY). </br>
+ *      <br>2) Reset_Handler calls WARM_EarlyResume() when this file is linked. </br>
+ *      <br>3) In main(): if WARM_IsWarmBoot(), call WARM_Complete() instead of
+ *             the clock and GPIO initialization. </br>
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* Include guard */
+#ifndef INC_WARM_RESUME_H_
+#define INC_WARM_RESUME_H_
+
+/* For C++ */
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************************************/
+  /* INCLUDES */
+/******************************************************************************/
+
+/* Here go the system header files */
+#include <stdint.h>
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+
+/******************************************************************************/
+  /* DEFINES */
+/******************************************************************************/
+
+/** @name Snapshot sizing.
+ */
+///@{
+#ifndef WARM_APP_DATA_SIZE
+#define	WARM_APP_DATA_SIZE		(64UL)		/**< Application bytes kept, multiple of 4 */
+#endif
+
+#define	WARM_GPIO_PORTS			(8UL)		/**< GPIOA to GPIOH */
+#define	WARM_NVIC_IPR_WORDS		(21UL)		/**< Priorities of IRQ 0 to 83 */
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum    /**< enum of WARM function status */
+{
+  WARM_STATUS_OK = 0,           /**< WARM status OK */
+  WARM_STATUS_ERROR = 1,        /**< Argument error */
+  WARM_STATUS_NO_SNAPSHOT = 2   /**< No valid snapshot in SRAM2 */
+}WARM_STATUS;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DECLARATIONS */
+/*****************************************************************************/
+
+WARM_STATUS WARM_Save(const void *pAppData, uint32_t Length);
+uint8_t WARM_EarlyResume(void);
+uint8_t WARM_IsWarmBoot(void);
+WARM_STATUS WARM_Complete(void);
+WARM_STATUS WARM_GetAppData(void *pBuffer, uint32_t BufferSize, uint32_t *pLength);
+uint32_t WARM_GetResumeCycles(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_WARM_RESUME_H_ */
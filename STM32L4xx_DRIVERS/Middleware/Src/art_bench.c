@@ -0,0 +1,167 @@
+/**************************************************************************//**
+ * @file    art_bench.c
+ * @brief   This file contains a small benchmark for the flash layout and the
+ *          ART accelerator of the STM32L475VG microcontroller.
+ *
+ * This file has 3 functions definitions (input parameters omitted):
+ *      <br>1) ARTB_Init()              - Enables the DWT cycle and CPI counters. </br>
+ *      <br>2) ARTB_Run()               - Measures a workload in steady state. </br>
+ *      <br>3) ARTB_EnablePCSampling()  - Starts DWT PC sampling for the profiler. </br>
+ *
+ * Workflow for the profile-guided layout:
+ *      <br>1) Build, call ARTB_EnablePCSampling() and capture the SWO output
+ *             of the steady state (or record an emulator trace). </br>
+ *      <br>2) Run Tools/pgo_layout.py --apply to write the ranked hot
+ *             functions in the linker scripts, and commit them. </br>
+ *      <br>3) Rebuild with -ffunction-sections and compare ARTB_Run() of
+ *             the same workload. </br>
+ *
+ * DWT_CPICNT counts the extra cycles of multi-cycle instructions and of
+ * instruction fetch stalls. For the same code only the fetch stalls depend
+ * on the layout, so the difference between two builds is the flash stall
+ * saving. The counter is 8 bits wide and is read after every call, keep
+ * each call below 256 extra cycles (one handler or driver call).
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <art_bench.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	ARTB_WARMUP_CALLS		(4U)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function enables the trace block and the DWT cycle and
+*              CPI counters.
+******************************************************************************/
+void ARTB_Init(void)
+{
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	*DWT_CYCCNT = 0;
+	*DWT_CPICNT = 0;
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CPIEVTENA);
+}
+
+/**************************************************************************//**
+* @brief       This function calls a workload a few times to fill the caches
+*              and then measures Iterations calls. Interrupts should be masked
+*              by the caller if they must not be counted.
+*
+* @param       pWorkload        Function to measure.
+* @param       Iterations       Number of measured calls.
+* @param       pResult          Structure to fill.
+******************************************************************************/
+void ARTB_Run(void (*pWorkload)(void), uint32_t Iterations, ARTB_Result_t *pResult)
+{
+	uint32_t overhead;
+	uint32_t start;
+	uint32_t i;
+
+	pResult->Iterations = Iterations;
+	pResult->MinCycles = 0xFFFFFFFFUL;
+	pResult->MaxCycles = 0;
+	pResult->TotalCycles = 0;
+	pResult->TotalCpiCycles = 0;
+
+	/* Cost of the two counter reads themselves */
+	start = *DWT_CYCCNT;
+	overhead = *DWT_CYCCNT - start;
+
+	for(i = 0; i < ARTB_WARMUP_CALLS; i++)
+	{
+		pWorkload();
+	}
+
+	for(i = 0; i < Iterations; i++)
+	{
+		uint32_t cpi_start = *DWT_CPICNT;
+		uint32_t cycles;
+
+		start = *DWT_CYCCNT;
+		pWorkload();
+		cycles = (*DWT_CYCCNT - start) - overhead;
+
+		pResult->TotalCpiCycles += (*DWT_CPICNT - cpi_start) & 0xFFU;
+		pResult->TotalCycles += cycles;
+		if(cycles < pResult->MinCycles)
+		{
+			pResult->MinCycles = cycles;
+		}
+		if(cycles > pResult->MaxCycles)
+		{
+			pResult->MaxCycles = cycles;
+		}
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function starts the periodic PC sampling of the DWT. The
+*              samples leave through the ITM as hardware source packets, the
+*              SWO pin and the TPIU are configured by the debug probe
+*              (STM32CubeIDE SWV or OpenOCD "tpiu config").
+*
+* @param       Period           ARTB_PCSAMPLE_EVERY_xxx.
+******************************************************************************/
+void ARTB_EnablePCSampling(uint8_t Period)
+{
+	ARTB_Init();
+
+	CLR_REG_BIT(*DWT_CTRL, DWT_CTRL_PCSAMPLENA);
+	*DWT_CTRL &= ~(0xFUL << DWT_CTRL_POSTPRESET);
+	*DWT_CTRL |= (0xFUL << DWT_CTRL_POSTPRESET);
+
+	if(Period == ARTB_PCSAMPLE_EVERY_16384)
+	{
+		SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCTAP);
+	}
+	else
+	{
+		CLR_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCTAP);
+	}
+
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_PCSAMPLENA);
+}
@@ -0,0 +1,247 @@
+/**************************************************************************//**
+ * @file    binlog.c
+ * @brief   This file contains the binary logger with deferred formatting
+ *          for the STM32L475VG microcontroller.
+ *
+ * This file has 4 functions definitions (input parameters omitted):
+ *      <br>1) BLOG_Init()              - Empties the ring and clears the statistics. </br>
+ *      <br>2) BLOG_Write()             - Stores one record, from anywhere. </br>
+ *      <br>3) BLOG_Flush()             - Sends the stored records through _write(). </br>
+ *      <br>4) BLOG_GetStats()          - Returns the logger statistics. </br>
+ *
+ * The ring takes records from any number of writers without masking
+ * interrupts. A writer reserves its words by moving the head with
+ * LDREX/STREX (an interrupt in between makes the STREX fail and the
+ * reservation is tried again), fills the arguments, then writes the header
+ * last with BLOG_HEADER_VALID. The reader stops at the first header not yet
+ * valid, so a record reserved by a preempted writer holds back the ones
+ * after it until it is complete.
+ *
+ * BLOG_Flush() is the only reader: call it from one context, the idle loop
+ * or a low-priority deferred work item for example.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <binlog.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	BLOG_RING_MASK			(BLOG_RING_WORDS - 1U)
+#define	BLOG_RECORD_WORDS(args)		((args) + 2U)	/* Header and cycle count */
+
+#if ((BLOG_RING_WORDS & BLOG_RING_MASK) != 0)
+#error "BLOG_RING_WORDS must be a power of 2"
+#endif
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static uint32_t blog_ring[BLOG_RING_WORDS];
+static __vo uint32_t blog_head = 0;             /* Reserved by the writers */
+static __vo uint32_t blog_tail = 0;             /* Released by BLOG_Flush() */
+static __vo uint32_t blog_records = 0;
+static __vo uint32_t blog_dropped = 0;
+static uint32_t blog_dropped_sent = 0;
+static uint32_t blog_max_used = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static void BLOG_AtomicIncrement(__vo uint32_t *pCounter);
+
+/* Src/syscalls.c */
+extern int _write(int file, char *ptr, int len);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function empties the ring and clears the statistics. Call
+*              it before the first record.
+******************************************************************************/
+void BLOG_Init(void)
+{
+	uint32_t index;
+
+	for(index = 0; index < BLOG_RING_WORDS; index++)
+	{
+		blog_ring[index] = 0;
+	}
+
+	blog_head = 0;
+	blog_tail = 0;
+	blog_records = 0;
+	blog_dropped = 0;
+	blog_dropped_sent = 0;
+	blog_max_used = 0;
+
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+}
+
+/**************************************************************************//**
+* @brief       This function stores one record, called by BLOG(). Lock-free,
+*              callable from any interrupt handler.
+*
+* @param       Id           Offset of the format string in .binlog_fmt.
+* @param       ArgCount     0 to BLOG_MAX_ARGS.
+* @param       pArgs        Arguments.
+*
+* @return      BLOG_STATUS_OK, or BLOG_STATUS_FULL if the record was dropped.
+******************************************************************************/
+__RAMFUNC BLOG_STATUS BLOG_Write(uint32_t Id, uint32_t ArgCount, const uint32_t *pArgs)
+{
+	uint32_t words = BLOG_RECORD_WORDS(ArgCount);
+	uint32_t head;
+	uint32_t used;
+	uint32_t arg;
+
+	if(ArgCount > BLOG_MAX_ARGS)
+	{
+		return BLOG_STATUS_FULL;
+	}
+
+	do
+	{
+		head = __LDREXW(&blog_head);
+		used = head - blog_tail;
+		if((used + words) > BLOG_RING_WORDS)
+		{
+			__CLREX();
+			BLOG_AtomicIncrement(&blog_dropped);
+			return BLOG_STATUS_FULL;
+		}
+	}while(__STREXW(head + words, &blog_head) != 0);
+
+	/* Statistic only, a lost update under contention is harmless */
+	if((used + words) > blog_max_used)
+	{
+		blog_max_used = used + words;
+	}
+
+	blog_ring[(head + 1U) & BLOG_RING_MASK] = *DWT_CYCCNT;
+	for(arg = 0; arg < ArgCount; arg++)
+	{
+		blog_ring[(head + 2U + arg) & BLOG_RING_MASK] = pArgs[arg];
+	}
+
+	__DMB();
+	blog_ring[head & BLOG_RING_MASK] = BLOG_HEADER_VALID | (ArgCount << BLOG_HEADER_ARGS) | (Id & BLOG_HEADER_ID_MASK);
+
+	BLOG_AtomicIncrement(&blog_records);
+
+	return BLOG_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function sends the complete records to _write(BLOG_FILE),
+*              preceded by a BLOG_ID_DROPPED record if some were lost since
+*              the previous call, and frees their words.
+*
+* @return      Words sent.
+******************************************************************************/
+uint32_t BLOG_Flush(void)
+{
+	uint32_t record[BLOG_RECORD_WORDS(BLOG_MAX_ARGS)];
+	uint32_t sent = 0;
+	uint32_t tail = blog_tail;
+	uint32_t header;
+	uint32_t words;
+	uint32_t word;
+	uint32_t dropped = blog_dropped;
+
+	if(dropped != blog_dropped_sent)
+	{
+		record[0] = BLOG_HEADER_VALID | (1UL << BLOG_HEADER_ARGS) | BLOG_ID_DROPPED;
+		record[1] = *DWT_CYCCNT;
+		record[2] = dropped - blog_dropped_sent;
+		(void)_write(BLOG_FILE, (char *)record, (int)(3U * sizeof(uint32_t)));
+		blog_dropped_sent = dropped;
+		sent += 3U;
+	}
+
+	while(tail != blog_head)
+	{
+		header = blog_ring[tail & BLOG_RING_MASK];
+		if((header & BLOG_HEADER_VALID) == 0)
+		{
+			/* Reserved, still being written */
+			break;
+		}
+		__DMB();
+
+		words = BLOG_RECORD_WORDS((header >> BLOG_HEADER_ARGS) & 0x7FUL);
+		/* Any of the words can be the header of a later record: all of
+		 * them are made invalid before the writers can reuse them */
+		for(word = 0; word < words; word++)
+		{
+			record[word] = blog_ring[(tail + word) & BLOG_RING_MASK];
+			blog_ring[(tail + word) & BLOG_RING_MASK] = 0;
+		}
+		__DMB();
+		tail += words;
+		blog_tail = tail;
+
+		(void)_write(BLOG_FILE, (char *)record, (int)(words * sizeof(uint32_t)));
+		sent += words;
+	}
+
+	return sent;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the logger statistics.
+*
+* @param [out] pStats       Structure to fill.
+******************************************************************************/
+void BLOG_GetStats(BLOG_Stats_t *pStats)
+{
+	pStats->Records = blog_records;
+	pStats->Dropped = blog_dropped;
+	pStats->MaxUsedWords = blog_max_used;
+}
+
+/**************************************************************************//**
+* @brief       Adds one to a counter shared by interrupt levels.
+******************************************************************************/
+__RAMFUNC static void BLOG_AtomicIncrement(__vo uint32_t *pCounter)
+{
+	uint32_t value;
+
+	do
+	{
+		value = __LDREXW(pCounter);
+	}while(__STREXW(value + 1U, pCounter) != 0);
+}
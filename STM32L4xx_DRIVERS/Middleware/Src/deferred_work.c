@@ -0,0 +1,249 @@
+/**************************************************************************//**
+ * @file    deferred_work.c
+ * @brief   This file contains the deferred work (interrupt bottom halves) for
+ *          the STM32L475VG microcontroller.
+ *
+ * This file has 4 functions definitions (input parameters omitted):
+ *      <br>1) DEFER_Init()             - Installs and enables the bottom-half IRQ. </br>
+ *      <br>2) DEFER_Post()             - Queues a work item and pends the bottom half. </br>
+ *      <br>3) DEFER_GetStats()         - Returns the statistics of a priority level. </br>
+ *      <br>4) DEFER_IRQHandler()       - Bottom half, runs the queued work items. </br>
+ *
+ * Each level is a ring of DEFER_QUEUE_SIZE items with free running Head and
+ * Tail counters. DEFER_Post() may be called from handlers of any priority,
+ * which can preempt each other, so it writes the item and moves Head with
+ * PRIMASK set (a few instructions). The bottom half is the only reader and
+ * the only writer of Tail, it needs no lock. After every item it starts over
+ * from the highest level, so an urgent item posted meanwhile runs next.
+ *
+ * Give the bottom half the lowest priority used by the application: every
+ * other interrupt preempts it, and it preempts the main loop.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+#include <stm32l475xx_nvic_driver.h>
+
+/* Here go the own includes */
+#include <deferred_work.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	DEFER_QUEUE_MASK		(DEFER_QUEUE_SIZE - 1U)
+
+#if ((DEFER_QUEUE_SIZE & DEFER_QUEUE_MASK) != 0)
+#error "DEFER_QUEUE_SIZE must be a power of 2"
+#endif
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef struct  /* One queued work item */
+{
+  DEFER_Work_t  pWork;
+  void          *pArg;
+  uint32_t      PostCycles;     /* DWT_CYCCNT when posted */
+}DEFER_Item_t;
+
+typedef struct  /* Queue of one priority level */
+{
+  DEFER_Item_t  Items[DEFER_QUEUE_SIZE];
+  __vo uint32_t Head;           /* Written by DEFER_Post() only */
+  __vo uint32_t Tail;           /* Written by DEFER_IRQHandler() only */
+}DEFER_Queue_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static DEFER_Queue_t defer_queues[DEFER_LEVELS];
+static DEFER_Stats_t defer_stats[DEFER_LEVELS];
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function empties the queues, installs DEFER_IRQHandler()
+*              in the DEFER_IRQ_NUMBER vector and enables it. The vector table
+*              must be relocated first (NVIC_RelocateVectorTable()).
+*
+* @param       IRQpriority  Priority of the bottom half, 0 to NVIC_PRIORITY_MAX.
+*                           Normally the lowest one of the application.
+*
+* @return      DEFER_STATUS_OK or DEFER_STATUS_ERROR.
+******************************************************************************/
+DEFER_STATUS DEFER_Init(uint8_t IRQpriority)
+{
+	uint8_t level;
+
+	(void)NVIC_IRQConfig(DEFER_IRQ_NUMBER, DISABLE);
+
+	for(level = 0; level < DEFER_LEVELS; level++)
+	{
+		defer_queues[level].Head = 0;
+		defer_queues[level].Tail = 0;
+		defer_stats[level].Posted = 0;
+		defer_stats[level].Dropped = 0;
+		defer_stats[level].MaxDepth = 0;
+		defer_stats[level].MaxWaitCycles = 0;
+	}
+
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	if(NVIC_SetVector(DEFER_IRQ_NUMBER, DEFER_IRQHandler) != NVIC_STATUS_OK)
+	{
+		return DEFER_STATUS_ERROR;
+	}
+
+	if(NVIC_SetPriority(DEFER_IRQ_NUMBER, IRQpriority) != NVIC_STATUS_OK)
+	{
+		return DEFER_STATUS_ERROR;
+	}
+
+	(void)NVIC_ClearPending(DEFER_IRQ_NUMBER);
+	(void)NVIC_IRQConfig(DEFER_IRQ_NUMBER, ENABLE);
+
+	return DEFER_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function queues a work item and pends the bottom half.
+*              Callable from any interrupt handler and from the main loop.
+*
+* @param       Priority     DEFER_PRIORITY_xxx.
+* @param       pWork        Function to run in the bottom half.
+* @param       pArg         Argument given to pWork.
+*
+* @return      DEFER_STATUS_OK, DEFER_STATUS_FULL or DEFER_STATUS_ERROR.
+******************************************************************************/
+__RAMFUNC DEFER_STATUS DEFER_Post(uint8_t Priority, DEFER_Work_t pWork, void *pArg)
+{
+	DEFER_Queue_t *queue;
+	DEFER_Item_t *item;
+	uint32_t primask;
+	uint32_t depth;
+
+	if((Priority >= DEFER_LEVELS) || (pWork == 0))
+	{
+		return DEFER_STATUS_ERROR;
+	}
+
+	queue = &defer_queues[Priority];
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	depth = queue->Head - queue->Tail;
+	if(depth >= DEFER_QUEUE_SIZE)
+	{
+		defer_stats[Priority].Dropped++;
+		__set_PRIMASK(primask);
+		return DEFER_STATUS_FULL;
+	}
+
+	item = &queue->Items[queue->Head & DEFER_QUEUE_MASK];
+	item->pWork = pWork;
+	item->pArg = pArg;
+	item->PostCycles = *DWT_CYCCNT;
+	queue->Head++;
+
+	defer_stats[Priority].Posted++;
+	if((depth + 1U) > defer_stats[Priority].MaxDepth)
+	{
+		defer_stats[Priority].MaxDepth = depth + 1U;
+	}
+
+	__set_PRIMASK(primask);
+
+	*NVIC_STIR = DEFER_IRQ_NUMBER;
+
+	return DEFER_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the statistics of a priority level.
+*
+* @param [in]  Priority     DEFER_PRIORITY_xxx.
+* @param [out] pStats       Structure to fill.
+*
+* @return      DEFER_STATUS_OK or DEFER_STATUS_ERROR.
+******************************************************************************/
+DEFER_STATUS DEFER_GetStats(uint8_t Priority, DEFER_Stats_t *pStats)
+{
+	if((Priority >= DEFER_LEVELS) || (pStats == 0))
+	{
+		return DEFER_STATUS_ERROR;
+	}
+
+	*pStats = defer_stats[Priority];
+
+	return DEFER_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       Bottom half. Runs the queued items, highest level first, until
+*              every queue is empty. Installed by DEFER_Init(), not called by
+*              the application.
+******************************************************************************/
+void DEFER_IRQHandler(void)
+{
+	DEFER_Queue_t *queue;
+	DEFER_Item_t item;
+	uint32_t wait;
+	uint8_t level = 0;
+
+	while(level < DEFER_LEVELS)
+	{
+		queue = &defer_queues[level];
+
+		if(queue->Tail == queue->Head)
+		{
+			level++;
+			continue;
+		}
+
+		/* Copy before releasing the slot to the producers */
+		item = queue->Items[queue->Tail & DEFER_QUEUE_MASK];
+		__DMB();
+		queue->Tail++;
+
+		wait = *DWT_CYCCNT - item.PostCycles;
+		if(wait > defer_stats[level].MaxWaitCycles)
+		{
+			defer_stats[level].MaxWaitCycles = wait;
+		}
+
+		item.pWork(item.pArg);
+
+		level = 0;
+	}
+}
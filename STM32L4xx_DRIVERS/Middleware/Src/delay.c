@@ -0,0 +1,450 @@
+/**************************************************************************//**
+ * @file    delay.c
+ * @brief   This file contains the busy-wait delays in CPU cycles and real
+ *          time units for the STM32L475VG microcontroller.
+ *
+ * This file has 6 functions definitions (input parameters omitted):
+ *      <br>1) DELAY_Init()             - Enables the cycle counter and calibrates. </br>
+ *      <br>2) DELAY_Cycles()           - Waits a number of CPU cycles. </br>
+ *      <br>3) DELAY_Ns()               - Waits a number of nanoseconds. </br>
+ *      <br>4) DELAY_Us()               - Waits a number of microseconds. </br>
+ *      <br>5) DELAY_Ms()               - Waits a number of milliseconds. </br>
+ *      <br>6) DELAY_SelfTest()         - Measures each delay against DWT_CYCCNT. </br>
+ *
+ * Time to cycles: the multipliers are HCLK / unit in Q32, rounded up, so a
+ * conversion never gives fewer cycles than asked. They are recomputed by the
+ * RCC clock change callback, which also calibrates again: executed from
+ * flash (NO_RAMFUNC) the loop cost depends on the wait states.
+ *
+ * Should the callback not fit in the RCC table, every delay compares
+ * RCC_GetHCLKCached() with its HCLK and converts again when they differ.
+ *
+ * The fixed cost of a call (entry, conversion, exit) is measured once per
+ * clock and taken out of the wait. A request shorter than that cost returns
+ * right away, it is the shortest delay available at that HCLK.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+#include <stm32l475xx_rcc_driver.h>
+
+/* Here go the own includes */
+#include <delay.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+/* Longest DWT_CYCCNT poll, far from the 2^32 wrap even if an interrupt
+ * takes a long time */
+#define	DELAY_CHUNK_CYCLES		(0x40000000UL)
+
+/* Loops timed by the calibration, the difference is 256 iterations */
+#define	DELAY_CAL_SHORT_LOOPS		(16UL)
+#define	DELAY_CAL_LONG_LOOPS		(DELAY_CAL_SHORT_LOOPS + 256UL)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static uint32_t delay_hclk = 0;
+static uint64_t delay_ns_q32 = 0;               /* Cycles per ns, Q32 */
+static uint64_t delay_us_q32 = 0;               /* Cycles per us, Q32 */
+static uint64_t delay_ms_q32 = 0;               /* Cycles per ms, Q32 */
+static uint32_t delay_loop_q8 = 0x300UL;        /* Loop iteration, 1/256 cycles */
+static uint32_t delay_read_cycles = 0;          /* Two back to back DWT_CYCCNT reads */
+static uint32_t delay_overhead_cycles = 0;      /* DELAY_Cycles() fixed cost */
+static uint32_t delay_overhead_time = 0;        /* DELAY_Ns/Us/Ms() fixed cost */
+static uint8_t delay_tracked = 0;               /* 1 once the clock callback is registered */
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static void DELAY_ClockChanged(uint32_t HCLK);
+static inline void DELAY_Track(void);
+static void DELAY_Calibrate(void);
+static uint64_t DELAY_Convert(uint32_t Value, uint64_t MulQ32);
+static void DELAY_Wait(uint64_t Cycles, uint32_t Overhead);
+static void DELAY_Spin(uint32_t Iterations);
+static uint32_t DELAY_Measure(void (*pDelay)(uint32_t), uint32_t Value);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function enables the cycle counter, converts the units at
+*              the HCLK of the RCC driver and calibrates the short loop and
+*              the call costs, with interrupts masked. Called by the first
+*              delay if the application does not; call it explicitly before
+*              using the delays from an interrupt handler.
+*
+* @return      DELAY_STATUS_OK, or DELAY_STATUS_ERROR if HCLK is unknown or
+*              the clock change callback cannot be registered. In the second
+*              case the delays still work and follow HCLK themselves.
+******************************************************************************/
+DELAY_STATUS DELAY_Init(void)
+{
+	uint32_t hclk = RCC_GetHCLKCached();
+
+	if(hclk == 0)
+	{
+		return DELAY_STATUS_ERROR;
+	}
+
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	DELAY_ClockChanged(hclk);
+
+	if(RCC_RegisterClockChangeCallback(DELAY_ClockChanged) != RCC_STATUS_OK)
+	{
+		return DELAY_STATUS_ERROR;
+	}
+	delay_tracked = 1;
+
+	return DELAY_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function waits a number of CPU cycles, the call included.
+*              Requests below DELAY_SHORT_CYCLES run the calibrated loop, the
+*              longer ones poll DWT_CYCCNT.
+*
+* @param       Cycles       CPU cycles.
+******************************************************************************/
+__RAMFUNC void DELAY_Cycles(uint32_t Cycles)
+{
+	DELAY_Track();
+
+	DELAY_Wait(Cycles, delay_overhead_cycles);
+}
+
+/**************************************************************************//**
+* @brief       This function waits a number of nanoseconds at the current
+*              HCLK, rounded up to the next cycle.
+*
+* @param       Nanoseconds  Time to wait.
+******************************************************************************/
+__RAMFUNC void DELAY_Ns(uint32_t Nanoseconds)
+{
+	DELAY_Track();
+
+	DELAY_Wait(DELAY_Convert(Nanoseconds, delay_ns_q32), delay_overhead_time);
+}
+
+/**************************************************************************//**
+* @brief       This function waits a number of microseconds at the current
+*              HCLK, rounded up to the next cycle.
+*
+* @param       Microseconds Time to wait.
+******************************************************************************/
+__RAMFUNC void DELAY_Us(uint32_t Microseconds)
+{
+	DELAY_Track();
+
+	DELAY_Wait(DELAY_Convert(Microseconds, delay_us_q32), delay_overhead_time);
+}
+
+/**************************************************************************//**
+* @brief       This function waits a number of milliseconds at the current
+*              HCLK. Prefer KRN_Delay() or a timer wheel timer when the CPU
+*              has something else to do.
+*
+* @param       Milliseconds Time to wait.
+******************************************************************************/
+void DELAY_Ms(uint32_t Milliseconds)
+{
+	DELAY_Track();
+
+	DELAY_Wait(DELAY_Convert(Milliseconds, delay_ms_q32), delay_overhead_time);
+}
+
+/**************************************************************************//**
+* @brief       This function times each delay with DWT_CYCCNT, interrupts
+*              masked, and compares it with the request converted at the
+*              current HCLK. A case passes when it is within
+*              DELAY_TEST_TOLERANCE_CYCLES plus 1% of the request, or of the
+*              call cost for requests shorter than it.
+*
+* @param [out] pResult      Measurements and calibration, may be 0.
+*
+* @return      DELAY_STATUS_OK, DELAY_STATUS_FAILED or DELAY_STATUS_ERROR.
+******************************************************************************/
+DELAY_STATUS DELAY_SelfTest(DELAY_TestResult_t *pResult)
+{
+	static void (* const delay_test_func[DELAY_TEST_CASES])(uint32_t) =
+	{
+		DELAY_Cycles, DELAY_Cycles, DELAY_Ns, DELAY_Us, DELAY_Us, DELAY_Us
+	};
+	static const uint32_t delay_test_value[DELAY_TEST_CASES] =
+	{
+		20U, 200U, 500U, 1U, 10U, 1000U
+	};
+	DELAY_TestResult_t result;
+	DELAY_STATUS status = DELAY_STATUS_OK;
+	uint32_t expected;
+	uint32_t floor_cycles;
+	uint32_t tolerance;
+	uint8_t index;
+
+	if(DELAY_Init() != DELAY_STATUS_OK)
+	{
+		return DELAY_STATUS_ERROR;
+	}
+
+	for(index = 0; index < DELAY_TEST_CASES; index++)
+	{
+		if(delay_test_func[index] == DELAY_Cycles)
+		{
+			expected = delay_test_value[index];
+			floor_cycles = delay_overhead_cycles;
+		}
+		else
+		{
+			expected = (uint32_t)DELAY_Convert(delay_test_value[index], (delay_test_func[index] == DELAY_Ns) ? delay_ns_q32 : delay_us_q32);
+			floor_cycles = delay_overhead_time;
+		}
+
+		result.Cases[index].ExpectedCycles = expected;
+		result.Cases[index].MeasuredCycles = DELAY_Measure(delay_test_func[index], delay_test_value[index]);
+
+		tolerance = DELAY_TEST_TOLERANCE_CYCLES + (expected / 100U);
+		if(expected < floor_cycles)
+		{
+			expected = floor_cycles;
+		}
+
+		if((result.Cases[index].MeasuredCycles + tolerance < expected) ||
+		   (result.Cases[index].MeasuredCycles > expected + tolerance))
+		{
+			status = DELAY_STATUS_FAILED;
+		}
+	}
+
+	result.HCLK = delay_hclk;
+	result.CallOverheadCycles = delay_overhead_cycles;
+	result.LoopCyclesQ8 = delay_loop_q8;
+
+	if(pResult != 0)
+	{
+		*pResult = result;
+	}
+
+	return status;
+}
+
+/**************************************************************************//**
+* @brief       Lazy initialization of every delay. Without the clock change
+*              callback, converts again when HCLK moved since the last call.
+******************************************************************************/
+static inline void DELAY_Track(void)
+{
+	uint32_t hclk;
+
+	if(delay_hclk == 0)
+	{
+		(void)DELAY_Init();
+	}
+	else if(delay_tracked == 0)
+	{
+		hclk = RCC_GetHCLKCached();
+		if(hclk != delay_hclk)
+		{
+			DELAY_ClockChanged(hclk);
+		}
+	}
+}
+
+/**************************************************************************//**
+* @brief       Clock change callback registered in the RCC driver. Converts
+*              the units at the new HCLK and calibrates again.
+******************************************************************************/
+static void DELAY_ClockChanged(uint32_t HCLK)
+{
+	if(HCLK == 0)
+	{
+		return;
+	}
+
+	delay_ns_q32 = (((uint64_t)HCLK << 32) + 999999999ULL) / 1000000000ULL;
+	delay_us_q32 = (((uint64_t)HCLK << 32) + 999999ULL) / 1000000ULL;
+	delay_ms_q32 = (((uint64_t)HCLK << 32) + 999ULL) / 1000ULL;
+	delay_hclk = HCLK;
+
+	DELAY_Calibrate();
+}
+
+/**************************************************************************//**
+* @brief       Measures the cost of a DWT_CYCCNT read, of a loop iteration and
+*              the fixed cost of the calls. The call costs are measured with
+*              no correction, as the excess over requests just below
+*              DELAY_SHORT_CYCLES.
+******************************************************************************/
+static void DELAY_Calibrate(void)
+{
+	uint32_t primask;
+	uint32_t start;
+	uint32_t stop;
+	uint32_t short_loops;
+	uint32_t long_loops;
+	uint32_t request;
+	uint32_t value;
+	uint32_t measured;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	start = *DWT_CYCCNT;
+	stop = *DWT_CYCCNT;
+	delay_read_cycles = stop - start;
+
+	/* The first run loads the loop into the flash cache when not in SRAM2 */
+	DELAY_Spin(DELAY_CAL_SHORT_LOOPS);
+	start = *DWT_CYCCNT;
+	DELAY_Spin(DELAY_CAL_SHORT_LOOPS);
+	stop = *DWT_CYCCNT;
+	short_loops = stop - start;
+
+	start = *DWT_CYCCNT;
+	DELAY_Spin(DELAY_CAL_LONG_LOOPS);
+	stop = *DWT_CYCCNT;
+	long_loops = stop - start;
+
+	delay_loop_q8 = (long_loops > short_loops) ? (long_loops - short_loops) : 0x100UL;
+
+	delay_overhead_cycles = 0;
+	request = DELAY_SHORT_CYCLES - 1U;
+	(void)DELAY_Measure(DELAY_Cycles, request);
+	measured = DELAY_Measure(DELAY_Cycles, request);
+	delay_overhead_cycles = (measured > request) ? (measured - request) : 0;
+
+	delay_overhead_time = 0;
+	if(DELAY_Convert(1U, delay_us_q32) < DELAY_SHORT_CYCLES)
+	{
+		value = 1U;
+		measured = DELAY_Measure(DELAY_Us, value);
+		request = (uint32_t)DELAY_Convert(value, delay_us_q32);
+	}
+	else
+	{
+		/* Fast clock, the longest short request in nanoseconds */
+		value = (uint32_t)(((uint64_t)(DELAY_SHORT_CYCLES - 1U) * 1000000000ULL) / delay_hclk);
+		measured = DELAY_Measure(DELAY_Ns, value);
+		request = (uint32_t)DELAY_Convert(value, delay_ns_q32);
+	}
+	delay_overhead_time = (measured > request) ? (measured - request) : 0;
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       Value in a unit times cycles per unit (Q32), rounded up. Two
+*              32x32 products, the multiplier can exceed 32 bits.
+******************************************************************************/
+__RAMFUNC static uint64_t DELAY_Convert(uint32_t Value, uint64_t MulQ32)
+{
+	uint64_t high = (uint64_t)Value * (uint32_t)(MulQ32 >> 32);
+	uint64_t low = (uint64_t)Value * (uint32_t)MulQ32;
+
+	return high + ((low + 0xFFFFFFFFULL) >> 32);
+}
+
+/**************************************************************************//**
+* @brief       Waits the cycles left after the fixed cost of the call.
+******************************************************************************/
+__RAMFUNC static void DELAY_Wait(uint64_t Cycles, uint32_t Overhead)
+{
+	uint32_t start = *DWT_CYCCNT;
+	uint32_t chunk;
+
+	if(Cycles <= Overhead)
+	{
+		return;
+	}
+	Cycles -= Overhead;
+
+	if(Cycles < DELAY_SHORT_CYCLES)
+	{
+		/* Rounded up, a fraction of iteration more rather than less */
+		DELAY_Spin((((uint32_t)Cycles << 8) + delay_loop_q8 - 1U) / delay_loop_q8);
+		return;
+	}
+
+	while(Cycles != 0)
+	{
+		chunk = (Cycles > DELAY_CHUNK_CYCLES) ? DELAY_CHUNK_CYCLES : (uint32_t)Cycles;
+		while((*DWT_CYCCNT - start) < chunk)
+		{
+		}
+		start += chunk;
+		Cycles -= chunk;
+	}
+}
+
+/**************************************************************************//**
+* @brief       Two instructions per iteration, its cost is measured by
+*              DELAY_Calibrate(). Nothing is done for 0 iterations.
+******************************************************************************/
+__RAMFUNC static void DELAY_Spin(uint32_t Iterations)
+{
+	if(Iterations == 0)
+	{
+		return;
+	}
+
+	__asm volatile(
+		"1:	subs	%0, %0, #1	\n"
+		"	bne	1b		\n"
+		: "+r" (Iterations)
+		:
+		: "cc");
+}
+
+/**************************************************************************//**
+* @brief       Cycles taken by one delay call, without the DWT_CYCCNT reads.
+******************************************************************************/
+static uint32_t DELAY_Measure(void (*pDelay)(uint32_t), uint32_t Value)
+{
+	uint32_t primask;
+	uint32_t start;
+	uint32_t stop;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	start = *DWT_CYCCNT;
+	pDelay(Value);
+	stop = *DWT_CYCCNT;
+
+	__set_PRIMASK(primask);
+
+	stop -= start;
+
+	return (stop > delay_read_cycles) ? (stop - delay_read_cycles) : 0;
+}
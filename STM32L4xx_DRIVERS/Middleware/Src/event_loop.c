@@ -0,0 +1,381 @@
+/**************************************************************************//**
+ * @file    event_loop.c
+ * @brief   This file contains a run-to-completion event loop for the
+ *          STM32L475VG microcontroller.
+ *
+ * This file has 7 functions definitions (input parameters omitted):
+ *      <br>1) EVL_Init()               - Empties the queues and selects the idle instruction. </br>
+ *      <br>2) EVL_SetHandler()         - Sets the handler of a queue. </br>
+ *      <br>3) EVL_SetIdleHook()        - Replaces the idle instruction by a function. </br>
+ *      <br>4) EVL_Post()               - Posts an event, from interrupts or handlers. </br>
+ *      <br>5) EVL_Run()                - Dispatches events and sleeps when idle. </br>
+ *      <br>6) EVL_RunFromInterrupts()  - Sleeps forever with SLEEPONEXIT, for ISR-only apps. </br>
+ *      <br>7) EVL_GetLoad()            - Returns the CPU load since the last call. </br>
+ *
+ * Going to sleep without losing a wakeup: the queues are checked again with
+ * PRIMASK set, and the WFI (or WFE with SEVONPEND) is executed still masked.
+ * A pending interrupt wakes the core even when masked, so an event posted
+ * between the check and the sleep only delays the handler to the unmask
+ * right after the wakeup.
+ *
+ * Idle time is measured with DWT_CYCCNT around the idle instruction or hook,
+ * the rest of the window is busy time. The counter only runs with the core
+ * clock: in Stop modes (idle hook calling LPM_EnterDeepest()) the stopped
+ * time is missing from both, the load is relative to the running time.
+ * Call EVL_GetLoad() at least once every 2^32 cycles (53 s at 80 MHz).
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <event_loop.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	EVL_QUEUE_MASK			(EVL_QUEUE_SIZE - 1U)
+
+#if ((EVL_QUEUE_SIZE & EVL_QUEUE_MASK) != 0)
+#error "EVL_QUEUE_SIZE must be a power of 2"
+#endif
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef struct  /* One event queue */
+{
+  EVL_Event_t   Events[EVL_QUEUE_SIZE];
+  __vo uint32_t Head;           /* Written by EVL_Post() only */
+  __vo uint32_t Tail;           /* Written by EVL_Run() only */
+  EVL_Handler_t pHandler;
+}EVL_Queue_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static EVL_Queue_t evl_queues[EVL_QUEUES];
+static uint8_t evl_idle_mode = EVL_IDLE_WFI;
+static void (*evl_idle_hook)(void) = 0;
+static uint32_t evl_window_start = 0;
+static uint32_t evl_idle_cycles = 0;
+static uint32_t evl_events = 0;
+static __vo uint32_t evl_dropped = 0;
+static uint32_t evl_max_handler_cycles = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static uint8_t EVL_NextQueue(void);
+static void EVL_Idle(void);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function empties the queues, removes the handlers and the
+*              idle hook, selects the idle instruction and starts the load
+*              window.
+*
+* @param       IdleMode     EVL_IDLE_WFI, EVL_IDLE_WFE or EVL_IDLE_NONE.
+*
+* @return      EVL_STATUS_OK or EVL_STATUS_ERROR.
+******************************************************************************/
+EVL_STATUS EVL_Init(uint8_t IdleMode)
+{
+	uint8_t queue;
+
+	if(IdleMode > EVL_IDLE_NONE)
+	{
+		return EVL_STATUS_ERROR;
+	}
+
+	for(queue = 0; queue < EVL_QUEUES; queue++)
+	{
+		evl_queues[queue].Head = 0;
+		evl_queues[queue].Tail = 0;
+		evl_queues[queue].pHandler = 0;
+	}
+
+	evl_idle_mode = IdleMode;
+	evl_idle_hook = 0;
+
+	/* WFE must also wake on interrupts pended while PRIMASK is set */
+	if(IdleMode == EVL_IDLE_WFE)
+	{
+		SET_REG_BIT(*SCB_SCR, SCB_SCR_SEVONPEND);
+	}
+	else
+	{
+		CLR_REG_BIT(*SCB_SCR, SCB_SCR_SEVONPEND);
+	}
+
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	evl_window_start = *DWT_CYCCNT;
+	evl_idle_cycles = 0;
+	evl_events = 0;
+	evl_dropped = 0;
+	evl_max_handler_cycles = 0;
+
+	return EVL_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function sets the handler of a queue. Events of a queue
+*              without handler are taken and discarded.
+*
+* @param       Queue        0 to EVL_QUEUES - 1.
+* @param       pHandler     Handler, or 0.
+*
+* @return      EVL_STATUS_OK or EVL_STATUS_ERROR.
+******************************************************************************/
+EVL_STATUS EVL_SetHandler(uint8_t Queue, EVL_Handler_t pHandler)
+{
+	if(Queue >= EVL_QUEUES)
+	{
+		return EVL_STATUS_ERROR;
+	}
+
+	evl_queues[Queue].pHandler = pHandler;
+
+	return EVL_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function replaces the idle instruction by a function, for
+*              example one calling LPM_EnterDeepest(). The hook is called with
+*              PRIMASK set and must return after the wakeup; a WFI executed
+*              inside it still wakes on any enabled interrupt.
+*
+* @param       pHook        Idle function, 0 to use the idle instruction again.
+******************************************************************************/
+void EVL_SetIdleHook(void (*pHook)(void))
+{
+	evl_idle_hook = pHook;
+}
+
+/**************************************************************************//**
+* @brief       This function posts an event. Callable from any interrupt
+*              handler and from the event handlers.
+*
+* @param       Queue        0 to EVL_QUEUES - 1.
+* @param       Signal       Event identifier.
+* @param       Param        Event data.
+*
+* @return      EVL_STATUS_OK, EVL_STATUS_FULL or EVL_STATUS_ERROR.
+******************************************************************************/
+__RAMFUNC EVL_STATUS EVL_Post(uint8_t Queue, uint16_t Signal, uint32_t Param)
+{
+	EVL_Queue_t *queue;
+	EVL_Event_t *event;
+	uint32_t primask;
+
+	if(Queue >= EVL_QUEUES)
+	{
+		return EVL_STATUS_ERROR;
+	}
+
+	queue = &evl_queues[Queue];
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if((queue->Head - queue->Tail) >= EVL_QUEUE_SIZE)
+	{
+		evl_dropped++;
+		__set_PRIMASK(primask);
+		return EVL_STATUS_FULL;
+	}
+
+	event = &queue->Events[queue->Head & EVL_QUEUE_MASK];
+	event->Signal = Signal;
+	event->Queue = Queue;
+	event->Param = Param;
+	queue->Head++;
+
+	__set_PRIMASK(primask);
+
+	/* Wakes a WFE even if the post comes from the loop itself */
+	__SEV();
+
+	return EVL_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function runs the event loop and never returns. Call it
+*              at the end of main() once the handlers are set.
+******************************************************************************/
+void EVL_Run(void)
+{
+	EVL_Queue_t *queue;
+	EVL_Event_t event;
+	uint32_t start;
+	uint32_t cycles;
+	uint8_t index;
+
+	while(1)
+	{
+		index = EVL_NextQueue();
+
+		if(index >= EVL_QUEUES)
+		{
+			EVL_Idle();
+			continue;
+		}
+
+		queue = &evl_queues[index];
+
+		/* Copy before releasing the slot to the producers */
+		event = queue->Events[queue->Tail & EVL_QUEUE_MASK];
+		__DMB();
+		queue->Tail++;
+
+		if(queue->pHandler != 0)
+		{
+			start = *DWT_CYCCNT;
+			queue->pHandler(&event);
+			cycles = *DWT_CYCCNT - start;
+
+			if(cycles > evl_max_handler_cycles)
+			{
+				evl_max_handler_cycles = cycles;
+			}
+		}
+
+		evl_events++;
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function is the idle loop of applications whose work is
+*              all done in interrupt handlers. With SLEEPONEXIT the core goes
+*              back to sleep at the end of every handler without returning to
+*              thread mode, so the events of the queues are never dispatched
+*              and the load is not measured. Never returns.
+******************************************************************************/
+void EVL_RunFromInterrupts(void)
+{
+	SET_REG_BIT(*SCB_SCR, SCB_SCR_SLEEPONEXIT);
+	__DSB();
+
+	while(1)
+	{
+		__WFI();
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function returns the load of the window since the previous
+*              call (or EVL_Init()) and starts a new window.
+*
+* @param [out] pLoad        Structure to fill.
+******************************************************************************/
+void EVL_GetLoad(EVL_Load_t *pLoad)
+{
+	uint32_t primask;
+	uint32_t now;
+	uint32_t total;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	now = *DWT_CYCCNT;
+	total = now - evl_window_start;
+
+	pLoad->IdleCycles = (evl_idle_cycles < total) ? evl_idle_cycles : total;
+	pLoad->BusyCycles = total - pLoad->IdleCycles;
+	pLoad->LoadPermille = (total == 0) ? 0 : (uint32_t)(((uint64_t)pLoad->BusyCycles * 1000ULL) / total);
+	pLoad->Events = evl_events;
+	pLoad->Dropped = evl_dropped;
+	pLoad->MaxHandlerCycles = evl_max_handler_cycles;
+
+	evl_window_start = now;
+	evl_idle_cycles = 0;
+	evl_events = 0;
+	evl_dropped = 0;
+	evl_max_handler_cycles = 0;
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       Highest priority non-empty queue, EVL_QUEUES if all are empty.
+******************************************************************************/
+static uint8_t EVL_NextQueue(void)
+{
+	uint8_t queue;
+
+	for(queue = 0; queue < EVL_QUEUES; queue++)
+	{
+		if(evl_queues[queue].Head != evl_queues[queue].Tail)
+		{
+			return queue;
+		}
+	}
+
+	return EVL_QUEUES;
+}
+
+/**************************************************************************//**
+* @brief       Sleeps if the queues are still empty with PRIMASK set, and
+*              accounts the time spent asleep. The interrupt that woke the
+*              core runs when PRIMASK is restored.
+******************************************************************************/
+static void EVL_Idle(void)
+{
+	uint32_t primask;
+	uint32_t start;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if(EVL_NextQueue() >= EVL_QUEUES)
+	{
+		start = *DWT_CYCCNT;
+
+		if(evl_idle_hook != 0)
+		{
+			evl_idle_hook();
+		}
+		else if(evl_idle_mode == EVL_IDLE_WFI)
+		{
+			__DSB();
+			__WFI();
+		}
+		else if(evl_idle_mode == EVL_IDLE_WFE)
+		{
+			__DSB();
+			__WFE();
+		}
+
+		evl_idle_cycles += *DWT_CYCCNT - start;
+	}
+
+	__set_PRIMASK(primask);
+}
@@ -0,0 +1,426 @@
+/**************************************************************************//**
+ * @file    flash_ecc.c
+ * @brief   This file contains the flash ECC monitor for the STM32L475VG
+ *          microcontroller.
+ *
+ * This file has 8 functions definitions (input parameters omitted):
+ *      <br>1) FECC_Init()              - Enables the ECC correction interrupt. </br>
+ *      <br>2) FECC_RegisterClient()    - Registers a flash-backed storage. </br>
+ *      <br>3) FECC_Service()           - Rewrites or retires the weak pages. </br>
+ *      <br>4) FECC_GetStats()          - Returns the ECC counters. </br>
+ *      <br>5) FECC_GetTable()          - Returns the per-page counter table. </br>
+ *      <br>6) FECC_DoubleErrorCallback() - Weak hook called on a double error. </br>
+ *      <br>7) FLASH_IRQHandler()       - Logs single-bit corrections (ECCC). </br>
+ *      <br>8) NMI_Handler()            - Logs double-bit detections (ECCD). </br>
+ *
+ * The handlers only log into the counter table. Rewriting or retiring pages
+ * erases flash, so it is left to FECC_Service() which runs in thread mode.
+ *
+ * The NMI cannot be masked, so it never writes the table: it queues the
+ * address of a double error and pends the FLASH IRQ. FLASH_IRQHandler() is
+ * then the only interrupt writing the table, and FECC_Service() reads and
+ * updates an entry with interrupts masked, keeping its result only if the
+ * entry still holds the page it serviced.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <flash_ecc.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	FECC_PAGE_NONE			(0xFFFFU)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static __vo FECC_Entry_t fecc_table[FECC_TABLE_SIZE];
+static const FECC_Client_t *fecc_clients[FECC_MAX_CLIENTS];
+static __vo FECC_Stats_t fecc_stats;
+
+/* Written by the NMI (head) and FLASH_IRQHandler (tail) only */
+static __vo uint32_t fecc_pending[FECC_PENDING_DOUBLE];
+static __vo uint8_t fecc_pending_head = 0;
+static __vo uint8_t fecc_pending_tail = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static uint32_t FECC_ReadAddress(uint32_t eccr);
+static __vo FECC_Entry_t* FECC_Log(uint32_t Address);
+static const FECC_Client_t* FECC_FindClient(uint32_t Address);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function clears the counter table, the pending ECC flags
+*              and enables the correction interrupt on the FLASH IRQ. Double
+*              errors always raise the NMI.
+******************************************************************************/
+void FECC_Init(void)
+{
+	uint8_t i;
+
+	for(i = 0; i < FECC_TABLE_SIZE; i++)
+	{
+		fecc_table[i].Page = FECC_PAGE_NONE;
+		fecc_table[i].Count = 0;
+		fecc_table[i].Flags = 0;
+	}
+	fecc_pending_head = 0;
+	fecc_pending_tail = 0;
+
+	/* ECCC and ECCD are cleared by writing 1 */
+	FLASH->FLASH_ECCR = (0x1UL << FLASH_ECCR_ECCIE) | (0x1UL << FLASH_ECCR_ECCC) | (0x1UL << FLASH_ECCR_ECCD);
+
+	/* ISER is write-1-to-set, a plain write leaves the other IRQs alone */
+	*NVIC_ISER0 = (0x1UL << IRQ_NO_FLASH);
+}
+
+/**************************************************************************//**
+* @brief       This function registers a storage that owns a flash range and
+*              knows how to move its data off a weak page.
+*
+* @param       pClient          Storage description, must stay valid.
+*
+* @return      FECC_STATUS_OK or FECC_STATUS_ERROR
+******************************************************************************/
+FECC_STATUS FECC_RegisterClient(const FECC_Client_t *pClient)
+{
+	uint8_t i;
+
+	for(i = 0; i < FECC_MAX_CLIENTS; i++)
+	{
+		if(fecc_clients[i] == 0)
+		{
+			fecc_clients[i] = pClient;
+			return FECC_STATUS_OK;
+		}
+	}
+
+	return FECC_STATUS_ERROR;
+}
+
+/**************************************************************************//**
+* @brief       This function handles the pages logged by the interrupt
+*              handlers. A page over FECC_WEAK_THRESHOLD corrections is
+*              rewritten once, which restores the charge of its cells. If it
+*              keeps failing, or had a double error, it is retired.
+*              Call it from the main loop, never from an interrupt.
+******************************************************************************/
+void FECC_Service(void)
+{
+	uint8_t i;
+
+	for(i = 0; i < FECC_TABLE_SIZE; i++)
+	{
+		__vo FECC_Entry_t *entry = &fecc_table[i];
+		const FECC_Client_t *client;
+		uint32_t primask;
+		uint32_t address;
+		uint16_t page;
+		uint8_t count;
+		uint8_t flags;
+		uint8_t result = 0;
+
+		/* Snapshot, FLASH_IRQHandler may replace the entry at any time */
+		primask = __get_PRIMASK();
+		__disable_irq();
+		page = entry->Page;
+		count = entry->Count;
+		flags = entry->Flags;
+		__set_PRIMASK(primask);
+
+		if((page == FECC_PAGE_NONE) || ((flags & (FECC_FLAG_RETIRED | FECC_FLAG_UNOWNED)) != 0))
+		{
+			continue;
+		}
+
+		address = FLASH_BASE_ADDRESS + ((uint32_t)page * FLASH_PAGE_SIZE);
+		client = FECC_FindClient(address);
+		if(client == 0)
+		{
+			/* Code or constants, nothing can be moved */
+			result = FECC_FLAG_UNOWNED;
+		}
+		else if(((flags & FECC_FLAG_DOUBLE_ERROR) != 0) || (count >= FECC_RETIRE_THRESHOLD))
+		{
+			if((client->Retire != 0) && (client->Retire(address) == FECC_STATUS_OK))
+			{
+				result = FECC_FLAG_RETIRED;
+				fecc_stats.Retirements++;
+			}
+		}
+		else if((count >= FECC_WEAK_THRESHOLD) && ((flags & FECC_FLAG_REWRITTEN) == 0))
+		{
+			if((client->Rewrite != 0) && (client->Rewrite(address) == FECC_STATUS_OK))
+			{
+				result = FECC_FLAG_REWRITTEN;
+				fecc_stats.Rewrites++;
+			}
+		}
+
+		if(result != 0)
+		{
+			__disable_irq();
+			if(entry->Page == page)
+			{
+				entry->Flags |= result;
+			}
+			__set_PRIMASK(primask);
+		}
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function returns a copy of the ECC counters.
+*
+* @param       pStats           Structure to fill.
+******************************************************************************/
+void FECC_GetStats(FECC_Stats_t *pStats)
+{
+	*pStats = fecc_stats;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the counter table (FECC_TABLE_SIZE
+*              entries, unused ones have Page = 0xFFFF). The interrupts
+*              update it, read an entry with them masked for a consistent one.
+*
+* @return      Pointer to the table.
+******************************************************************************/
+const __vo FECC_Entry_t* FECC_GetTable(void)
+{
+	return fecc_table;
+}
+
+/**************************************************************************//**
+* @brief       Hook called from the NMI after a double-bit error was logged.
+*              The data read by the faulting access is wrong; override it to
+*              reset or to enter a safe state.
+*
+* @param       Address          Flash address of the double error.
+******************************************************************************/
+__attribute__((weak)) void FECC_DoubleErrorCallback(uint32_t Address)
+{
+	(void)Address;
+}
+
+/**************************************************************************//**
+* @brief       FLASH global interrupt. Logs the double errors queued by the
+*              NMI, then the corrected address, and clears ECCC without
+*              touching a pending ECCD. The only interrupt writing the table.
+******************************************************************************/
+void FLASH_IRQHandler(void)
+{
+	uint32_t eccr;
+	__vo FECC_Entry_t *entry;
+
+	while(fecc_pending_tail != fecc_pending_head)
+	{
+		entry = FECC_Log(fecc_pending[fecc_pending_tail]);
+		if(entry != 0)
+		{
+			entry->Flags |= FECC_FLAG_DOUBLE_ERROR;
+		}
+		fecc_pending_tail = (uint8_t)((fecc_pending_tail + 1U) & (FECC_PENDING_DOUBLE - 1U));
+	}
+
+	eccr = FLASH->FLASH_ECCR;
+
+	if(READ_REG_BIT(eccr, FLASH_ECCR_ECCC) != 0)
+	{
+		uint32_t address = FECC_ReadAddress(eccr);
+
+		fecc_stats.Corrections++;
+		fecc_stats.LastCorrectedAddress = address;
+		(void)FECC_Log(address);
+
+		FLASH->FLASH_ECCR = (0x1UL << FLASH_ECCR_ECCIE) | (0x1UL << FLASH_ECCR_ECCC);
+	}
+}
+
+/**************************************************************************//**
+* @brief       Non maskable interrupt. A double ECC error is the only NMI
+*              source of this device besides the clock security system. The
+*              address is queued for FLASH_IRQHandler(), pended here; with
+*              the queue full the error is counted in QueueDrops.
+******************************************************************************/
+void NMI_Handler(void)
+{
+	uint32_t eccr = FLASH->FLASH_ECCR;
+
+	if(READ_REG_BIT(eccr, FLASH_ECCR_ECCD) != 0)
+	{
+		uint32_t address = FECC_ReadAddress(eccr);
+		uint8_t next = (uint8_t)((fecc_pending_head + 1U) & (FECC_PENDING_DOUBLE - 1U));
+
+		fecc_stats.DoubleErrors++;
+		fecc_stats.LastDoubleErrorAddress = address;
+
+		if(next != fecc_pending_tail)
+		{
+			fecc_pending[fecc_pending_head] = address;
+			fecc_pending_head = next;
+		}
+		else
+		{
+			fecc_stats.QueueDrops++;
+		}
+
+		/* ISPR is write-1-to-set */
+		*NVIC_ISPR0 = (0x1UL << IRQ_NO_FLASH);
+
+		FLASH->FLASH_ECCR = (eccr & (0x1UL << FLASH_ECCR_ECCIE)) | (0x1UL << FLASH_ECCR_ECCD);
+
+		FECC_DoubleErrorCallback(address);
+	}
+}
+
+/**************************************************************************//**
+* @brief       Converts the FLASH_ECCR content into a memory address.
+******************************************************************************/
+static uint32_t FECC_ReadAddress(uint32_t eccr)
+{
+	uint32_t address = FLASH_BASE_ADDRESS + (eccr & FLASH_ECCR_ADDR_MASK);
+
+	if(READ_REG_BIT(eccr, FLASH_ECCR_BK_ECC) != 0)
+	{
+		address += FLASH_BANK_SIZE;
+	}
+
+	return address;
+}
+
+/**************************************************************************//**
+* @brief       Counts one error for the page of Address. When the table is
+*              full an entry is replaced: a retired or unowned page first,
+*              then the lowest count, so the weakest pages are kept. A double
+*              error not yet serviced is pinned and never replaced; with only
+*              pinned entries left the error is dropped. Called from
+*              FLASH_IRQHandler() only.
+*
+* @return      The entry of the page, or 0 when not logged.
+******************************************************************************/
+static __vo FECC_Entry_t* FECC_Log(uint32_t Address)
+{
+	uint16_t page;
+	__vo FECC_Entry_t *victim = 0;
+	uint8_t victim_rank = 0;
+	uint8_t rank;
+	uint8_t i;
+
+	if((Address < FLASH_BASE_ADDRESS) || (Address >= (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE)))
+	{
+		/* System memory or OTP, not tracked */
+		return 0;
+	}
+
+	page = (uint16_t)((Address - FLASH_BASE_ADDRESS) / FLASH_PAGE_SIZE);
+
+	for(i = 0; i < FECC_TABLE_SIZE; i++)
+	{
+		__vo FECC_Entry_t *entry = &fecc_table[i];
+
+		if(entry->Page == page)
+		{
+			if(entry->Count < 0xFFU)
+			{
+				entry->Count++;
+			}
+			return entry;
+		}
+
+		/* 3: free, 2: already handled, 1: still counting, 0: pinned */
+		if(entry->Page == FECC_PAGE_NONE)
+		{
+			rank = 3U;
+		}
+		else if((entry->Flags & (FECC_FLAG_RETIRED | FECC_FLAG_UNOWNED)) != 0)
+		{
+			rank = 2U;
+		}
+		else if((entry->Flags & FECC_FLAG_DOUBLE_ERROR) == 0)
+		{
+			rank = 1U;
+		}
+		else
+		{
+			continue;
+		}
+
+		if((victim == 0) || (rank > victim_rank) || ((rank == victim_rank) && (entry->Count < victim->Count)))
+		{
+			victim = entry;
+			victim_rank = rank;
+		}
+	}
+
+	if(victim == 0)
+	{
+		fecc_stats.TableDrops++;
+		return 0;
+	}
+
+	if(victim->Page != FECC_PAGE_NONE)
+	{
+		fecc_stats.TableEvictions++;
+	}
+
+	victim->Page = page;
+	victim->Count = 1;
+	victim->Flags = 0;
+
+	return victim;
+}
+
+/**************************************************************************//**
+* @brief       Returns the client that owns Address, or 0.
+******************************************************************************/
+static const FECC_Client_t* FECC_FindClient(uint32_t Address)
+{
+	uint8_t i;
+
+	for(i = 0; i < FECC_MAX_CLIENTS; i++)
+	{
+		if((fecc_clients[i] != 0) && (Address >= fecc_clients[i]->StartAddress) && \
+		   (Address < fecc_clients[i]->EndAddress))
+		{
+			return fecc_clients[i];
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,287 @@
+/**************************************************************************//**
+ * @file    irq_bench.c
+ * @brief   This file contains an interrupt latency and preemption benchmark
+ *          for the NVIC driver of the STM32L475VG microcontroller.
+ *
+ * This file has 3 functions definitions (input parameters omitted):
+ *      <br>1) IRQB_Run()               - Measures the IRQ latency and checks preemption. </br>
+ *      <br>2) LCD_IRQHandler()         - Low priority handler of the benchmark. </br>
+ *      <br>3) AES_IRQHandler()         - High priority handler of the benchmark. </br>
+ *
+ * The IRQs are pended with a store to NVIC_STIR, right after reading
+ * DWT_CYCCNT, and each handler reads DWT_CYCCNT first. The latency is the
+ * difference minus the cost of two back to back counter reads, so it covers
+ * the STIR store, the exception entry (stacking and vector fetch, 12 cycles
+ * with zero wait state memory) and the handler prologue. Run it with the
+ * other interrupts quiet, or the maximum includes their handlers.
+ *
+ * Checks done with grouping NVIC_PRIORITYGROUP_2_2:
+ *      <br>1) Preempt 1 interrupts a running preempt 2 handler. </br>
+ *      <br>2) Preempt 2 sub 0 does not interrupt preempt 2 sub 1, it is
+ *             tail-chained when the running handler returns. </br>
+ *      <br>3) Both pending with preempt 2, sub 0 runs before sub 1. </br>
+ *
+ * The grouping, priorities and enables of both IRQs are restored at the end.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+#include <stm32l475xx_nvic_driver.h>
+
+/* Here go the own includes */
+#include <irq_bench.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	IRQB_PREEMPT_LOW		(2U)
+#define	IRQB_PREEMPT_HIGH		(1U)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static __vo uint32_t irqb_low_stamp = 0;
+static __vo uint32_t irqb_high_stamp = 0;
+static __vo uint32_t irqb_trigger_stamp = 0;
+static __vo uint8_t irqb_nested = 0;
+static __vo uint8_t irqb_high_ran = 0;
+static __vo uint8_t irqb_high_inside = 0;
+static __vo uint8_t irqb_order[2];
+static __vo uint8_t irqb_order_count = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static void IRQB_SetPriorities(uint8_t LowPreempt, uint8_t LowSub, uint8_t HighPreempt, uint8_t HighSub);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function measures Iterations interrupt entries from thread
+*              mode and Iterations preempting entries, then checks the
+*              preemption rules. Call it from thread mode.
+*
+* @param [in]  Iterations   Number of measured entries of each kind.
+* @param [out] pResult      Structure to fill.
+*
+* @return      IRQB_STATUS_OK       Measured, every check passed.
+* @return      IRQB_STATUS_ERROR    Invalid argument.
+* @return      IRQB_STATUS_FAILED   A preemption check failed.
+******************************************************************************/
+IRQB_STATUS IRQB_Run(uint32_t Iterations, IRQB_Result_t *pResult)
+{
+	uint32_t saved_group = NVIC_GetPriorityGrouping();
+	uint8_t saved_low_prio = NVIC_GetPriority(IRQB_IRQ_LOW);
+	uint8_t saved_high_prio = NVIC_GetPriority(IRQB_IRQ_HIGH);
+	uint8_t saved_low_en = NVIC_IsEnabled(IRQB_IRQ_LOW);
+	uint8_t saved_high_en = NVIC_IsEnabled(IRQB_IRQ_HIGH);
+	uint32_t overhead;
+	uint32_t start;
+	uint32_t cycles;
+	uint32_t i;
+
+	if((pResult == 0) || (Iterations == 0))
+	{
+		return IRQB_STATUS_ERROR;
+	}
+
+	pResult->Samples = Iterations;
+	pResult->EntryMinCycles = 0xFFFFFFFFUL;
+	pResult->EntryMaxCycles = 0;
+	pResult->EntryTotalCycles = 0;
+	pResult->PreemptMinCycles = 0xFFFFFFFFUL;
+	pResult->PreemptMaxCycles = 0;
+	pResult->PreemptOk = 1;
+	pResult->SamePreemptOk = 1;
+	pResult->SubPriorityOrderOk = 0;
+
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	/* Cost of the two counter reads themselves */
+	start = *DWT_CYCCNT;
+	irqb_low_stamp = *DWT_CYCCNT;
+	overhead = irqb_low_stamp - start;
+
+	(void)NVIC_SetPriorityGrouping(NVIC_PRIORITYGROUP_2_2);
+	IRQB_SetPriorities(IRQB_PREEMPT_LOW, 0, IRQB_PREEMPT_HIGH, 0);
+	(void)NVIC_ClearPending(IRQB_IRQ_LOW);
+	(void)NVIC_ClearPending(IRQB_IRQ_HIGH);
+	(void)NVIC_IRQConfig(IRQB_IRQ_LOW, ENABLE);
+	(void)NVIC_IRQConfig(IRQB_IRQ_HIGH, ENABLE);
+
+	/* 1) Entry from thread mode */
+	irqb_nested = 0;
+	for(i = 0; i < Iterations; i++)
+	{
+		start = *DWT_CYCCNT;
+		*NVIC_STIR = IRQB_IRQ_LOW;
+		__DSB();
+		__ISB();
+		cycles = (irqb_low_stamp - start) - overhead;
+
+		pResult->EntryTotalCycles += cycles;
+		if(cycles < pResult->EntryMinCycles)
+		{
+			pResult->EntryMinCycles = cycles;
+		}
+		if(cycles > pResult->EntryMaxCycles)
+		{
+			pResult->EntryMaxCycles = cycles;
+		}
+	}
+
+	/* 2) Preempt 1 interrupts preempt 2 */
+	irqb_nested = 1;
+	for(i = 0; i < Iterations; i++)
+	{
+		*NVIC_STIR = IRQB_IRQ_LOW;
+		__DSB();
+		__ISB();
+		cycles = (irqb_high_stamp - irqb_trigger_stamp) - overhead;
+
+		if(irqb_high_inside == 0)
+		{
+			pResult->PreemptOk = 0;
+		}
+		if(cycles < pResult->PreemptMinCycles)
+		{
+			pResult->PreemptMinCycles = cycles;
+		}
+		if(cycles > pResult->PreemptMaxCycles)
+		{
+			pResult->PreemptMaxCycles = cycles;
+		}
+	}
+
+	/* 3) Same preempt priority: the better sub-priority waits its turn */
+	IRQB_SetPriorities(IRQB_PREEMPT_LOW, 1, IRQB_PREEMPT_LOW, 0);
+	*NVIC_STIR = IRQB_IRQ_LOW;
+	__DSB();
+	__ISB();
+	if((irqb_high_inside != 0) || (irqb_high_ran == 0))
+	{
+		pResult->SamePreemptOk = 0;
+	}
+
+	/* 4) Both pending, the sub-priority decides the order */
+	irqb_nested = 0;
+	IRQB_SetPriorities(IRQB_PREEMPT_LOW, 0, IRQB_PREEMPT_LOW, 1);
+	irqb_order_count = 0;
+	__disable_irq();
+	(void)NVIC_SetPending(IRQB_IRQ_HIGH);
+	(void)NVIC_SetPending(IRQB_IRQ_LOW);
+	__enable_irq();
+	__ISB();
+	if((irqb_order_count == 2) && (irqb_order[0] == IRQB_IRQ_LOW) && (irqb_order[1] == IRQB_IRQ_HIGH))
+	{
+		pResult->SubPriorityOrderOk = 1;
+	}
+
+	(void)NVIC_IRQConfig(IRQB_IRQ_LOW, saved_low_en);
+	(void)NVIC_IRQConfig(IRQB_IRQ_HIGH, saved_high_en);
+	(void)NVIC_SetPriority(IRQB_IRQ_LOW, saved_low_prio);
+	(void)NVIC_SetPriority(IRQB_IRQ_HIGH, saved_high_prio);
+	if(saved_group >= NVIC_PRIORITYGROUP_4_0)
+	{
+		(void)NVIC_SetPriorityGrouping(saved_group);
+	}
+	else
+	{
+		(void)NVIC_SetPriorityGrouping(NVIC_PRIORITYGROUP_4_0);
+	}
+
+	if((pResult->PreemptOk == 0) || (pResult->SamePreemptOk == 0) || (pResult->SubPriorityOrderOk == 0))
+	{
+		return IRQB_STATUS_FAILED;
+	}
+
+	return IRQB_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       Low priority handler. Time stamps its entry and, in the nested
+*              tests, pends the high priority IRQ and notes if it ran before
+*              the store returned.
+******************************************************************************/
+void LCD_IRQHandler(void)
+{
+	irqb_low_stamp = *DWT_CYCCNT;
+
+	if(irqb_order_count < 2U)
+	{
+		irqb_order[irqb_order_count] = IRQB_IRQ_LOW;
+		irqb_order_count++;
+	}
+
+	if(irqb_nested != 0)
+	{
+		irqb_high_ran = 0;
+		irqb_trigger_stamp = *DWT_CYCCNT;
+		*NVIC_STIR = IRQB_IRQ_HIGH;
+		__DSB();
+		__ISB();
+		irqb_high_inside = irqb_high_ran;
+	}
+}
+
+/**************************************************************************//**
+* @brief       High priority handler. Time stamps its entry.
+******************************************************************************/
+void AES_IRQHandler(void)
+{
+	irqb_high_stamp = *DWT_CYCCNT;
+	irqb_high_ran = 1;
+
+	if(irqb_order_count < 2U)
+	{
+		irqb_order[irqb_order_count] = IRQB_IRQ_HIGH;
+		irqb_order_count++;
+	}
+}
+
+/**************************************************************************//**
+* @brief       Sets the priorities of both IRQs with the current grouping.
+******************************************************************************/
+static void IRQB_SetPriorities(uint8_t LowPreempt, uint8_t LowSub, uint8_t HighPreempt, uint8_t HighSub)
+{
+	uint8_t priority;
+
+	if(NVIC_EncodePriority(LowPreempt, LowSub, &priority) == NVIC_STATUS_OK)
+	{
+		(void)NVIC_SetPriority(IRQB_IRQ_LOW, priority);
+	}
+	if(NVIC_EncodePriority(HighPreempt, HighSub, &priority) == NVIC_STATUS_OK)
+	{
+		(void)NVIC_SetPriority(IRQB_IRQ_HIGH, priority);
+	}
+}
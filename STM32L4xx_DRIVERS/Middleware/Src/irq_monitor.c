@@ -0,0 +1,430 @@
+/**************************************************************************//**
+ * @file    irq_monitor.c
+ * @brief   This file contains a CPU load and interrupt monitor for the
+ *          STM32L475VG microcontroller.
+ *
+ * This file has 9 functions definitions (input parameters omitted):
+ *      <br>1) IRQMON_Init()            - Clears the statistics and starts a window. </br>
+ *      <br>2) IRQMON_Attach()          - Routes an IRQ through the monitor, with a budget. </br>
+ *      <br>3) IRQMON_Detach()          - Gives the IRQ its handler back. </br>
+ *      <br>4) IRQMON_IdleEnter()       - Marks the start of idle time. </br>
+ *      <br>5) IRQMON_IdleExit()        - Marks its end. </br>
+ *      <br>6) IRQMON_GetReport()       - Computes the loads of the window and starts a new one. </br>
+ *      <br>7) IRQMON_Log()             - Writes the last report to the binary logger. </br>
+ *      <br>8) IRQMON_Handler()         - Vector of the monitored IRQs. </br>
+ *      <br>9) IRQMON_CyclesToNs()      - Converts handler cycles at the current HCLK. </br>
+ *
+ * IRQMON_Handler() finds the IRQ in IPSR and calls the original handler.
+ * The cycles of monitored interrupts preempting it are accumulated in
+ * irqmon_preempted and subtracted, so the cycles of the IRQs add up to the
+ * time spent in monitored handlers. The exception entry and exit (about 12
+ * cycles each with zero wait state memory) and the monitor itself, about
+ * 30 cycles, are not counted in any IRQ.
+ *
+ * The handlers run with the core clock and are timed with DWT_CYCCNT. The
+ * window and the idle time span Stop modes, where the counter stops, and
+ * are read with TS_Now(). Handler cycles are converted to time at the HCLK
+ * of IRQMON_IdleExit() and IRQMON_GetReport(); a window with clock changes
+ * gets an approximate IrqPermille.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+#include <string.h>
+
+/* Here go the project includes */
+#include <stm32l475xx_nvic_driver.h>
+#include <stm32l475xx_rcc_driver.h>
+#include <binlog.h>
+#include <timestamp.h>
+
+/* Here go the own includes */
+#include <irq_monitor.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	IRQMON_IPSR_MASK		(0x1FFUL)
+#define	IRQMON_NO_SLOT			(0xFFU)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+/* Running window and last finished one, read with the debugger */
+IRQMON_Report_t irqmon_window;
+IRQMON_Report_t irqmon_report;
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static NVIC_Handler_t irqmon_handlers[IRQMON_SLOTS];
+static uint8_t irqmon_slots[NVIC_IRQ_COUNT];
+static uint64_t irqmon_window_start = 0;        /**< TS_Now() at the start of the window */
+static uint64_t irqmon_idle_ns = 0;             /**< Idle time of the window */
+static uint32_t irqmon_preempted = 0;           /**< Cycles of the handlers preempting the running one */
+static uint64_t irqmon_idle_start = 0;
+static uint32_t irqmon_idle_irq_cycles = 0;     /**< IrqCycles when the idle time started */
+static uint8_t irqmon_idle = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static uint64_t IRQMON_CyclesToNs(uint32_t Cycles);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function enables the cycle counter, frees every slot and
+*              starts the first window. Call it once, after TS_Init() and
+*              before IRQMON_Attach(): it does not restore the vectors of
+*              attached IRQs.
+******************************************************************************/
+void IRQMON_Init(void)
+{
+	uint32_t slot;
+
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	memset(&irqmon_window, 0, sizeof(irqmon_window));
+	memset(&irqmon_report, 0, sizeof(irqmon_report));
+	memset(irqmon_slots, IRQMON_NO_SLOT, sizeof(irqmon_slots));
+	for(slot = 0; slot < IRQMON_SLOTS; slot++)
+	{
+		irqmon_window.Irqs[slot].IRQnumber = IRQMON_NO_IRQ;
+		irqmon_handlers[slot] = 0;
+	}
+
+	irqmon_preempted = 0;
+	irqmon_idle = 0;
+	irqmon_idle_ns = 0;
+	irqmon_window_start = TS_Now();
+}
+
+/**************************************************************************//**
+* @brief       This function installs IRQMON_Handler() in the vector of an IRQ
+*              and keeps the handler it replaces. Attaching an IRQ again only
+*              changes its budget.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+* @param       BudgetCycles Longest acceptable run of the handler, preemptions
+*                           excluded, IRQMON_NO_BUDGET for none.
+*
+* @return      IRQMON_STATUS_OK, IRQMON_STATUS_FULL or IRQMON_STATUS_ERROR
+*              (IRQ out of range or vector table not relocated).
+******************************************************************************/
+IRQMON_STATUS IRQMON_Attach(uint8_t IRQnumber, uint32_t BudgetCycles)
+{
+	NVIC_Handler_t handler;
+	uint32_t primask;
+	uint8_t slot;
+
+	if(IRQnumber >= NVIC_IRQ_COUNT)
+	{
+		return IRQMON_STATUS_ERROR;
+	}
+
+	if(irqmon_slots[IRQnumber] != IRQMON_NO_SLOT)
+	{
+		irqmon_window.Irqs[irqmon_slots[IRQnumber]].BudgetCycles = BudgetCycles;
+		return IRQMON_STATUS_OK;
+	}
+
+	for(slot = 0; slot < IRQMON_SLOTS; slot++)
+	{
+		if(irqmon_handlers[slot] == 0)
+		{
+			break;
+		}
+	}
+	if(slot >= IRQMON_SLOTS)
+	{
+		return IRQMON_STATUS_FULL;
+	}
+
+	handler = NVIC_GetVector(IRQnumber);
+	if(handler == 0)
+	{
+		return IRQMON_STATUS_ERROR;
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	irqmon_handlers[slot] = handler;
+	memset(&irqmon_window.Irqs[slot], 0, sizeof(irqmon_window.Irqs[slot]));
+	irqmon_window.Irqs[slot].IRQnumber = IRQnumber;
+	irqmon_window.Irqs[slot].BudgetCycles = BudgetCycles;
+	irqmon_slots[IRQnumber] = slot;
+
+	/* Last, the slot must be complete when the IRQ enters the monitor */
+	if(NVIC_SetVector(IRQnumber, IRQMON_Handler) != NVIC_STATUS_OK)
+	{
+		irqmon_slots[IRQnumber] = IRQMON_NO_SLOT;
+		irqmon_window.Irqs[slot].IRQnumber = IRQMON_NO_IRQ;
+		irqmon_handlers[slot] = 0;
+		__set_PRIMASK(primask);
+		return IRQMON_STATUS_ERROR;
+	}
+
+	__set_PRIMASK(primask);
+
+	return IRQMON_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function puts the original handler back in the vector of
+*              an IRQ and frees its slot.
+*
+* @param       IRQnumber    IRQ number, 0 to IRQ_NO_MAX.
+*
+* @return      IRQMON_STATUS_OK or IRQMON_STATUS_ERROR (IRQ not attached).
+******************************************************************************/
+IRQMON_STATUS IRQMON_Detach(uint8_t IRQnumber)
+{
+	uint32_t primask;
+	uint8_t slot;
+
+	if((IRQnumber >= NVIC_IRQ_COUNT) || (irqmon_slots[IRQnumber] == IRQMON_NO_SLOT))
+	{
+		return IRQMON_STATUS_ERROR;
+	}
+
+	slot = irqmon_slots[IRQnumber];
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	/* Masked: an entry of the IRQ cannot be running in this context */
+	(void)NVIC_SetVector(IRQnumber, irqmon_handlers[slot]);
+	irqmon_slots[IRQnumber] = IRQMON_NO_SLOT;
+	irqmon_window.Irqs[slot].IRQnumber = IRQMON_NO_IRQ;
+	irqmon_handlers[slot] = 0;
+
+	__set_PRIMASK(primask);
+
+	return IRQMON_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function marks the start of idle time, before the WFI,
+*              WFE or low-power entry of the idle loop.
+******************************************************************************/
+void IRQMON_IdleEnter(void)
+{
+	irqmon_idle_irq_cycles = irqmon_window.IrqCycles;
+	irqmon_idle_start = TS_Now();
+	irqmon_idle = 1;
+}
+
+/**************************************************************************//**
+* @brief       This function marks the end of idle time. Monitored handlers
+*              run in between are not idle time.
+******************************************************************************/
+void IRQMON_IdleExit(void)
+{
+	uint32_t primask;
+	uint64_t idle;
+	uint64_t irq;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if(irqmon_idle != 0)
+	{
+		idle = TS_Now() - irqmon_idle_start;
+		irq = IRQMON_CyclesToNs(irqmon_window.IrqCycles - irqmon_idle_irq_cycles);
+		irqmon_idle_ns += (idle > irq) ? (idle - irq) : 0;
+		irqmon_idle = 0;
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function finishes the window: computes its length and
+*              loads, copies it to irqmon_report and to pReport, and starts
+*              a new window with the same IRQs and budgets.
+*
+* @param [out] pReport      Structure to fill, or 0 for irqmon_report only.
+******************************************************************************/
+void IRQMON_GetReport(IRQMON_Report_t *pReport)
+{
+	uint32_t primask;
+	uint64_t now;
+	uint64_t total;
+	uint64_t busy;
+	uint64_t irq;
+	uint32_t slot;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	now = TS_Now();
+	total = now - irqmon_window_start;
+
+	/* Idle time running, split at the window boundary */
+	if(irqmon_idle != 0)
+	{
+		IRQMON_IdleExit();
+		IRQMON_IdleEnter();
+		irqmon_idle_irq_cycles = 0;
+	}
+
+	if(irqmon_idle_ns > total)
+	{
+		irqmon_idle_ns = total;
+	}
+	busy = total - irqmon_idle_ns;
+	irq = IRQMON_CyclesToNs(irqmon_window.IrqCycles);
+	if(irq > total)
+	{
+		irq = total;
+	}
+
+	/* Saturated past 71 minutes, the loads are exact */
+	irqmon_window.WindowUs = ((total / TS_NS_PER_US) > 0xFFFFFFFFULL) ? 0xFFFFFFFFUL : (uint32_t)(total / TS_NS_PER_US);
+	irqmon_window.IdleUs = ((irqmon_idle_ns / TS_NS_PER_US) > 0xFFFFFFFFULL) ? 0xFFFFFFFFUL : (uint32_t)(irqmon_idle_ns / TS_NS_PER_US);
+	irqmon_window.LoadPermille = (total == 0) ? 0 : (uint16_t)((busy * 1000ULL) / total);
+	irqmon_window.IrqPermille = (total == 0) ? 0 : (uint16_t)((irq * 1000ULL) / total);
+
+	irqmon_report = irqmon_window;
+
+	irqmon_window_start = now;
+	irqmon_idle_ns = 0;
+	irqmon_window.WindowUs = 0;
+	irqmon_window.IdleUs = 0;
+	irqmon_window.IrqCycles = 0;
+	irqmon_window.LoadPermille = 0;
+	irqmon_window.IrqPermille = 0;
+	irqmon_window.Overruns = 0;
+	for(slot = 0; slot < IRQMON_SLOTS; slot++)
+	{
+		irqmon_window.Irqs[slot].Count = 0;
+		irqmon_window.Irqs[slot].Cycles = 0;
+		irqmon_window.Irqs[slot].MaxCycles = 0;
+		irqmon_window.Irqs[slot].Overruns = 0;
+	}
+
+	__set_PRIMASK(primask);
+
+	if(pReport != 0)
+	{
+		*pReport = irqmon_report;
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function writes irqmon_report to the binary logger: one
+*              record for the loads, one per monitored IRQ.
+******************************************************************************/
+void IRQMON_Log(void)
+{
+	const IRQMON_Irq_t *pIrq;
+	uint32_t slot;
+
+	BLOG("irqmon load %u/1000 irq %u/1000 window %u us idle %u us overruns %u",
+	     irqmon_report.LoadPermille, irqmon_report.IrqPermille,
+	     irqmon_report.WindowUs, irqmon_report.IdleUs, irqmon_report.Overruns);
+
+	for(slot = 0; slot < IRQMON_SLOTS; slot++)
+	{
+		pIrq = &irqmon_report.Irqs[slot];
+		if(pIrq->IRQnumber != IRQMON_NO_IRQ)
+		{
+			BLOG("irqmon irq %u count %u cycles %u max %u budget %u overruns %u",
+			     pIrq->IRQnumber, pIrq->Count, pIrq->Cycles, pIrq->MaxCycles,
+			     pIrq->BudgetCycles, pIrq->Overruns);
+		}
+	}
+}
+
+/**************************************************************************//**
+* @brief       Vector of every monitored IRQ: times the original handler and
+*              updates the counters of its slot.
+******************************************************************************/
+__RAMFUNC void IRQMON_Handler(void)
+{
+	IRQMON_Irq_t *pIrq;
+	uint32_t primask;
+	uint32_t outer;
+	uint32_t start;
+	uint32_t cycles;
+	uint32_t own;
+	uint8_t slot;
+
+	slot = irqmon_slots[(__get_IPSR() & IRQMON_IPSR_MASK) - NVIC_VECTOR_IRQ_OFFSET];
+	if(slot == IRQMON_NO_SLOT)
+	{
+		return;
+	}
+
+	/* Masked, a preempting handler restores irqmon_preempted on its way out */
+	primask = __get_PRIMASK();
+	__disable_irq();
+	outer = irqmon_preempted;
+	irqmon_preempted = 0;
+	start = *DWT_CYCCNT;
+	__set_PRIMASK(primask);
+
+	irqmon_handlers[slot]();
+
+	__disable_irq();
+	cycles = *DWT_CYCCNT - start;
+	own = cycles - irqmon_preempted;
+	irqmon_preempted = outer + cycles;
+
+	pIrq = &irqmon_window.Irqs[slot];
+	pIrq->Count++;
+	pIrq->Cycles += own;
+	irqmon_window.IrqCycles += own;
+	if(own > pIrq->MaxCycles)
+	{
+		pIrq->MaxCycles = own;
+	}
+	if((pIrq->BudgetCycles != IRQMON_NO_BUDGET) && (own > pIrq->BudgetCycles))
+	{
+		pIrq->Overruns++;
+		irqmon_window.Overruns++;
+	}
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       Time of handler cycles at the HCLK of the RCC driver, 0 if it
+*              is unknown.
+******************************************************************************/
+static uint64_t IRQMON_CyclesToNs(uint32_t Cycles)
+{
+	uint32_t hclk = RCC_GetHCLKCached();
+
+	if(hclk == 0)
+	{
+		return 0;
+	}
+
+	return ((uint64_t)Cycles * TS_NS_PER_S) / hclk;
+}
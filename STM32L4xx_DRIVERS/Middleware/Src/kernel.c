@@ -0,0 +1,677 @@
+/**************************************************************************//**
+ * @file    kernel.c
+ * @brief   This file contains a fixed-priority preemptive kernel for the
+ *          STM32L475VG microcontroller.
+ *
+ * This file has 13 functions definitions (input parameters omitted):
+ *      <br>1) KRN_TaskCreate()         - Creates a task on a static TCB and stack. </br>
+ *      <br>2) KRN_Start()              - Starts the scheduler, never returns. </br>
+ *      <br>3) KRN_SetIdleHook()        - Function run by the idle task. </br>
+ *      <br>4) KRN_Delay()              - Blocks the calling task for a number of ticks. </br>
+ *      <br>5) KRN_Tick()               - Advances the kernel time, from the tick interrupt. </br>
+ *      <br>6) KRN_GetTicks()           - Returns the kernel time. </br>
+ *      <br>7) KRN_GetIdleTicks()       - Ticks until a task needs the CPU. </br>
+ *      <br>8) KRN_Advance()            - Skips idle ticks after a tickless sleep. </br>
+ *      <br>9) KRN_SemInit()            - Initializes a counting semaphore. </br>
+ *      <br>10) KRN_SemTake()           - Takes a semaphore, blocking up to a timeout. </br>
+ *      <br>11) KRN_SemGive()           - Gives a semaphore, from tasks or interrupts. </br>
+ *      <br>12) KRN_GetSwitchStats()    - Returns the context switch statistics. </br>
+ *      <br>13) PendSV_Handler()        - Context switch. </br>
+ *
+ * Scheduling: priority P is bit (31 - P) of the ready bitmap, so the most
+ * urgent ready task is krn_tasks[CLZ(ready)]. The idle task is always ready,
+ * the bitmap is never 0. Every kernel call changes the bitmaps with PRIMASK
+ * set, then asks for a switch by pending PendSV. PendSV has the lowest
+ * priority: the switch happens once every interrupt handler has returned,
+ * and a handler waking several tasks causes one switch only.
+ *
+ * Context: the hardware stacks R0-R3, R12, LR, PC and xPSR on the task
+ * stack (PSP), PendSV pushes R4-R11 and EXC_RETURN under them. With the
+ * hardware FPU, lazy stacking (FPCCR ASPEN and LSPEN) reserves room for
+ * S0-S15 and FPSCR but only writes them if the handler uses the FPU, and
+ * PendSV saves S16-S31 only for tasks whose frame has the FPU part
+ * (EXC_RETURN bit 4 cleared). Tasks never using the FPU pay nothing.
+ *
+ * Switch latency: KRN_SemGive() stamps DWT_CYCCNT when it readies a task
+ * more urgent than the running one, and KRN_SemTake() reads it back when
+ * that task returns. The difference covers the rest of the giving handler,
+ * the PendSV tail-chain and the switch itself.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <kernel.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	KRN_PRIO_BIT(prio)		(0x80000000UL >> (prio))
+#define	KRN_INITIAL_XPSR		(0x01000000UL)	/* Thumb bit */
+#define	KRN_INITIAL_EXC_RETURN		(0xFFFFFFFDUL)	/* Thread mode, PSP, no FPU frame */
+#define	KRN_FRAME_WORDS			(17U)		/* R4-R11, EXC_RETURN, hardware frame */
+#define	KRN_BOOT_STACK_WORDS		(48U)		/* Room for the first save, FPU included */
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+/* Used by PendSV_Handler(), not static */
+KRN_Task_t *__vo krn_current = 0;
+KRN_Task_t *__vo krn_next = 0;
+__vo uint32_t krn_switches = 0;
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static KRN_Task_t *krn_tasks[KRN_PRIORITIES];
+static __vo uint32_t krn_ready = 0;
+static __vo uint32_t krn_delayed = 0;
+static __vo uint32_t krn_ticks = 0;
+static uint8_t krn_started = 0;
+static void (*krn_idle_hook)(void) = 0;
+
+static KRN_Task_t krn_idle_task;
+static uint32_t krn_idle_stack[KRN_IDLE_STACK_WORDS] __attribute__((aligned(8)));
+
+/* Receives the context of main() at the first switch, never restored */
+static KRN_Task_t krn_boot_task;
+static uint32_t krn_boot_stack[KRN_BOOT_STACK_WORDS] __attribute__((aligned(8)));
+
+static KRN_Task_t *krn_give_task = 0;
+static uint32_t krn_give_cycles = 0;
+static KRN_SwitchStats_t krn_stats = {0, 0, 0xFFFFFFFFUL, 0, 0};
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static void KRN_InitTask(KRN_Task_t *pTask, void (*pEntry)(void *pArg), void *pArg, uint32_t *pStack, uint32_t StackWords, uint8_t Priority);
+static void KRN_Schedule(void);
+static void KRN_Block(void);
+static void KRN_TaskExit(void);
+static void KRN_IdleTask(void *pArg);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function creates a task and makes it ready. Can be called
+*              before KRN_Start() or from a running task. A task returning
+*              from its entry function is deleted.
+*
+* @param       pTask        TCB, static, owned by the kernel until the task ends.
+* @param       pEntry       Task function.
+* @param       pArg         Argument given to pEntry.
+* @param       pStack       Stack of the task, static.
+* @param       StackWords   Size of pStack, at least KRN_STACK_MIN_WORDS.
+* @param       Priority     0 (most urgent) to KRN_PRIORITY_IDLE - 1, one task
+*                           per priority.
+*
+* @return      KRN_STATUS_OK or KRN_STATUS_ERROR.
+******************************************************************************/
+KRN_STATUS KRN_TaskCreate(KRN_Task_t *pTask, void (*pEntry)(void *pArg), void *pArg, uint32_t *pStack, uint32_t StackWords, uint8_t Priority)
+{
+	uint32_t primask;
+
+	if((pTask == 0) || (pEntry == 0) || (pStack == 0) || (StackWords < KRN_STACK_MIN_WORDS) || (Priority >= KRN_PRIORITY_IDLE))
+	{
+		return KRN_STATUS_ERROR;
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if(krn_tasks[Priority] != 0)
+	{
+		__set_PRIMASK(primask);
+		return KRN_STATUS_ERROR;
+	}
+
+	KRN_InitTask(pTask, pEntry, pArg, pStack, StackWords, Priority);
+	KRN_Schedule();
+
+	__set_PRIMASK(primask);
+
+	return KRN_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function creates the idle task and switches to the most
+*              urgent task. Call it at the end of main(), with the tasks
+*              created; main() does not run again. Whatever drives KRN_Tick()
+*              can be started before or after.
+******************************************************************************/
+void KRN_Start(void)
+{
+	__disable_irq();
+
+	KRN_InitTask(&krn_idle_task, KRN_IdleTask, 0, krn_idle_stack, KRN_IDLE_STACK_WORDS, KRN_PRIORITY_IDLE);
+
+	/* PendSV below every interrupt, so it only runs when they are done */
+	*SCB_SHPR3 |= (0xFFUL << SCB_SHPR3_PENDSV);
+
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+	/* Lazy stacking, these are the reset values */
+	*FPU_FPCCR |= ((1UL << FPU_FPCCR_ASPEN) | (1UL << FPU_FPCCR_LSPEN));
+#endif
+
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	/* main() runs on MSP; the first PendSV saves its registers on this
+	 * scratch PSP and returns to the first task with EXC_RETURN 0xFFFFFFFD,
+	 * which moves thread mode to PSP. The MSP stays for the handlers. */
+	__set_PSP((uint32_t)&krn_boot_stack[KRN_BOOT_STACK_WORDS]);
+	__ISB();
+
+	krn_current = &krn_boot_task;
+	krn_started = 1;
+	KRN_Schedule();
+
+	__enable_irq();
+
+	while(1)
+	{
+		/* Never reached, PendSV is taken at the enable */
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function sets the function called in a loop by the idle
+*              task, for example one entering a low power mode. It runs with
+*              interrupts enabled and must not block.
+*
+* @param       pHook        Idle function, 0 to execute WFI.
+******************************************************************************/
+void KRN_SetIdleHook(void (*pHook)(void))
+{
+	krn_idle_hook = pHook;
+}
+
+/**************************************************************************//**
+* @brief       This function blocks the calling task for a number of ticks.
+*
+* @param       Ticks        Ticks to wait, 0 returns at once.
+******************************************************************************/
+void KRN_Delay(uint32_t Ticks)
+{
+	uint32_t primask;
+
+	if(Ticks == 0)
+	{
+		return;
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	krn_current->Delay = Ticks;
+	krn_delayed |= KRN_PRIO_BIT(krn_current->Priority);
+	KRN_Block();
+
+	/* PendSV runs here, the task continues after the delay */
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function advances the kernel time by one tick and wakes
+*              the tasks whose delay or timeout is over. Call it from the
+*              periodic tick interrupt.
+******************************************************************************/
+void KRN_Tick(void)
+{
+	KRN_Task_t *task;
+	KRN_Sem_t *sem;
+	uint32_t primask;
+	uint32_t pending;
+	uint32_t bit;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	krn_ticks++;
+
+	pending = krn_delayed;
+	while(pending != 0)
+	{
+		bit = KRN_PRIO_BIT(__CLZ(pending));
+		pending &= ~bit;
+		task = krn_tasks[__CLZ(bit)];
+
+		if(--task->Delay != 0)
+		{
+			continue;
+		}
+
+		if(task->pWaitSem != 0)
+		{
+			sem = (KRN_Sem_t*)task->pWaitSem;
+			sem->Waiters &= ~bit;
+			task->pWaitSem = 0;
+			task->WakeStatus = KRN_STATUS_TIMEOUT;
+		}
+
+		krn_delayed &= ~bit;
+		krn_ready |= bit;
+	}
+
+	KRN_Schedule();
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function returns the number of KRN_Tick() calls.
+*
+* @return      Kernel time, in ticks.
+******************************************************************************/
+uint32_t KRN_GetTicks(void)
+{
+	return krn_ticks;
+}
+
+/**************************************************************************//**
+* @brief       This function returns in how many ticks a delay or a timeout
+*              ends. Used by the tickless idle to choose how long to sleep.
+*
+* @return      0 if a task other than idle is ready, KRN_WAIT_FOREVER if no
+*              task waits with a timeout.
+******************************************************************************/
+uint32_t KRN_GetIdleTicks(void)
+{
+	uint32_t primask;
+	uint32_t pending;
+	uint32_t bit;
+	uint32_t best = KRN_WAIT_FOREVER;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if((krn_ready & ~KRN_PRIO_BIT(KRN_PRIORITY_IDLE)) != 0)
+	{
+		best = 0;
+	}
+	else
+	{
+		pending = krn_delayed;
+		while(pending != 0)
+		{
+			bit = KRN_PRIO_BIT(__CLZ(pending));
+			pending &= ~bit;
+
+			if(krn_tasks[__CLZ(bit)]->Delay < best)
+			{
+				best = krn_tasks[__CLZ(bit)]->Delay;
+			}
+		}
+	}
+
+	__set_PRIMASK(primask);
+
+	return best;
+}
+
+/**************************************************************************//**
+* @brief       This function moves the kernel time forward without waking
+*              anybody, after a sleep in which the tick was stopped. Ticks
+*              must be below KRN_GetIdleTicks().
+*
+* @param       Ticks        Ticks slept.
+******************************************************************************/
+void KRN_Advance(uint32_t Ticks)
+{
+	uint32_t primask;
+	uint32_t pending;
+	uint32_t bit;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	krn_ticks += Ticks;
+
+	pending = krn_delayed;
+	while(pending != 0)
+	{
+		bit = KRN_PRIO_BIT(__CLZ(pending));
+		pending &= ~bit;
+		krn_tasks[__CLZ(bit)]->Delay -= Ticks;
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function initializes a counting semaphore. A binary one
+*              has MaxCount 1.
+*
+* @param       pSem         Semaphore.
+* @param       InitialCount Tokens available, at most MaxCount.
+* @param       MaxCount     Most tokens the semaphore holds.
+******************************************************************************/
+void KRN_SemInit(KRN_Sem_t *pSem, uint32_t InitialCount, uint32_t MaxCount)
+{
+	pSem->MaxCount = MaxCount;
+	pSem->Count = (InitialCount < MaxCount) ? InitialCount : MaxCount;
+	pSem->Waiters = 0;
+}
+
+/**************************************************************************//**
+* @brief       This function takes a token, blocking the calling task until
+*              one is given or the timeout expires. From interrupt handlers
+*              only KRN_NO_WAIT can be used.
+*
+* @param       pSem         Semaphore.
+* @param       TimeoutTicks KRN_NO_WAIT, ticks, or KRN_WAIT_FOREVER.
+*
+* @return      KRN_STATUS_OK or KRN_STATUS_TIMEOUT.
+******************************************************************************/
+KRN_STATUS KRN_SemTake(KRN_Sem_t *pSem, uint32_t TimeoutTicks)
+{
+	KRN_Task_t *task;
+	uint32_t primask;
+	uint32_t cycles;
+	uint32_t bit;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if(pSem->Count != 0)
+	{
+		pSem->Count--;
+		__set_PRIMASK(primask);
+		return KRN_STATUS_OK;
+	}
+
+	if(TimeoutTicks == KRN_NO_WAIT)
+	{
+		__set_PRIMASK(primask);
+		return KRN_STATUS_TIMEOUT;
+	}
+
+	task = krn_current;
+	bit = KRN_PRIO_BIT(task->Priority);
+
+	task->pWaitSem = pSem;
+	task->WakeStatus = KRN_STATUS_TIMEOUT;
+	pSem->Waiters |= bit;
+
+	if(TimeoutTicks != KRN_WAIT_FOREVER)
+	{
+		task->Delay = TimeoutTicks;
+		krn_delayed |= bit;
+	}
+
+	KRN_Block();
+	__set_PRIMASK(primask);
+
+	/* Woken by KRN_SemGive() (token handed over) or by the timeout */
+	if(krn_give_task == task)
+	{
+		cycles = *DWT_CYCCNT - krn_give_cycles;
+		krn_give_task = 0;
+
+		krn_stats.Samples++;
+		krn_stats.LastCycles = cycles;
+		if(cycles < krn_stats.MinCycles)
+		{
+			krn_stats.MinCycles = cycles;
+		}
+		if(cycles > krn_stats.MaxCycles)
+		{
+			krn_stats.MaxCycles = cycles;
+		}
+	}
+
+	return (KRN_STATUS)task->WakeStatus;
+}
+
+/**************************************************************************//**
+* @brief       This function gives a token. If tasks wait for it, the token
+*              goes to the most urgent of them, which preempts the caller
+*              if it is more urgent. Callable from any interrupt handler,
+*              for example an EXTI handler waking the task of the pin.
+*
+* @param       pSem         Semaphore.
+*
+* @return      KRN_STATUS_OK or KRN_STATUS_FULL.
+******************************************************************************/
+KRN_STATUS KRN_SemGive(KRN_Sem_t *pSem)
+{
+	KRN_Task_t *task;
+	uint32_t primask;
+	uint32_t bit;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if(pSem->Waiters == 0)
+	{
+		if(pSem->Count >= pSem->MaxCount)
+		{
+			__set_PRIMASK(primask);
+			return KRN_STATUS_FULL;
+		}
+
+		pSem->Count++;
+		__set_PRIMASK(primask);
+		return KRN_STATUS_OK;
+	}
+
+	bit = KRN_PRIO_BIT(__CLZ(pSem->Waiters));
+	task = krn_tasks[__CLZ(bit)];
+
+	pSem->Waiters &= ~bit;
+	krn_delayed &= ~bit;
+	task->pWaitSem = 0;
+	task->WakeStatus = KRN_STATUS_OK;
+	krn_ready |= bit;
+
+	if(task->Priority < krn_current->Priority)
+	{
+		krn_give_task = task;
+		krn_give_cycles = *DWT_CYCCNT;
+	}
+
+	KRN_Schedule();
+
+	__set_PRIMASK(primask);
+
+	return KRN_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the context switch statistics since
+*              KRN_Start().
+*
+* @param [out] pStats       Structure to fill. MinCycles is 0xFFFFFFFF until
+*                           the first sample.
+******************************************************************************/
+void KRN_GetSwitchStats(KRN_SwitchStats_t *pStats)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	*pStats = krn_stats;
+	pStats->Switches = krn_switches;
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       Context switch, pended by KRN_Schedule(). Saves the context of
+*              krn_current on its stack, restores the one of krn_next. Needs
+*              no lock: an interrupt changing krn_next meanwhile pends PendSV
+*              again.
+******************************************************************************/
+__attribute__((naked)) void PendSV_Handler(void)
+{
+	__asm volatile
+	(
+		"	mrs	r0, psp				\n"
+		"	isb					\n"
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+		"	tst	lr, #0x10			\n"
+		"	it	eq				\n"
+		"	vstmdbeq r0!, {s16-s31}			\n"
+#endif
+		"	stmdb	r0!, {r4-r11, lr}		\n"
+		"	movw	r1, #:lower16:krn_current	\n"
+		"	movt	r1, #:upper16:krn_current	\n"
+		"	ldr	r2, [r1]			\n"
+		"	str	r0, [r2]			\n"	/* krn_current->pStack */
+		"	movw	r3, #:lower16:krn_next		\n"
+		"	movt	r3, #:upper16:krn_next		\n"
+		"	ldr	r2, [r3]			\n"
+		"	str	r2, [r1]			\n"	/* krn_current = krn_next */
+		"	movw	r3, #:lower16:krn_switches	\n"
+		"	movt	r3, #:upper16:krn_switches	\n"
+		"	ldr	r1, [r3]			\n"
+		"	adds	r1, r1, #1			\n"
+		"	str	r1, [r3]			\n"
+		"	ldr	r0, [r2]			\n"
+		"	ldmia	r0!, {r4-r11, lr}		\n"
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+		"	tst	lr, #0x10			\n"
+		"	it	eq				\n"
+		"	vldmiaeq r0!, {s16-s31}			\n"
+#endif
+		"	msr	psp, r0				\n"
+		"	isb					\n"
+		"	bx	lr				\n"
+	);
+}
+
+/**************************************************************************//**
+* @brief       Fills the TCB, builds the initial frame and readies the task.
+*              Called with PRIMASK set.
+******************************************************************************/
+static void KRN_InitTask(KRN_Task_t *pTask, void (*pEntry)(void *pArg), void *pArg, uint32_t *pStack, uint32_t StackWords, uint8_t Priority)
+{
+	uint32_t *sp;
+	uint8_t reg;
+
+	/* AAPCS: 8-byte aligned stack at the task entry */
+	sp = (uint32_t*)((uint32_t)&pStack[StackWords] & ~0x7UL);
+
+	*(--sp) = KRN_INITIAL_XPSR;
+	*(--sp) = (uint32_t)pEntry & ~0x1UL;	/* PC */
+	*(--sp) = (uint32_t)KRN_TaskExit;	/* LR */
+	*(--sp) = 0;				/* R12 */
+	*(--sp) = 0;				/* R3 */
+	*(--sp) = 0;				/* R2 */
+	*(--sp) = 0;				/* R1 */
+	*(--sp) = (uint32_t)pArg;		/* R0 */
+	*(--sp) = KRN_INITIAL_EXC_RETURN;
+	for(reg = 0; reg < (KRN_FRAME_WORDS - 9U); reg++)
+	{
+		*(--sp) = 0;			/* R11 to R4 */
+	}
+
+	pTask->pStack = sp;
+	pTask->pStackBase = pStack;
+	pTask->Priority = Priority;
+	pTask->WakeStatus = KRN_STATUS_OK;
+	pTask->Delay = 0;
+	pTask->pWaitSem = 0;
+
+	krn_tasks[Priority] = pTask;
+	krn_ready |= KRN_PRIO_BIT(Priority);
+}
+
+/**************************************************************************//**
+* @brief       Selects the most urgent ready task and pends PendSV if it is
+*              not the running one. Called with PRIMASK set.
+******************************************************************************/
+static void KRN_Schedule(void)
+{
+	KRN_Task_t *next;
+
+	if(krn_started == 0)
+	{
+		return;
+	}
+
+	next = krn_tasks[__CLZ(krn_ready)];
+	krn_next = next;
+
+	if(next != krn_current)
+	{
+		*SCB_ICSR = (1UL << SCB_ICSR_PENDSVSET);
+	}
+}
+
+/**************************************************************************//**
+* @brief       Removes the running task from the ready bitmap and pends the
+*              switch. Called with PRIMASK set, the switch happens when the
+*              caller restores it.
+******************************************************************************/
+static void KRN_Block(void)
+{
+	krn_ready &= ~KRN_PRIO_BIT(krn_current->Priority);
+	KRN_Schedule();
+}
+
+/**************************************************************************//**
+* @brief       Return address of every task: deletes the calling task.
+******************************************************************************/
+static void KRN_TaskExit(void)
+{
+	__disable_irq();
+
+	krn_tasks[krn_current->Priority] = 0;
+	KRN_Block();
+
+	__enable_irq();
+
+	while(1)
+	{
+		/* Never reached */
+	}
+}
+
+/**************************************************************************//**
+* @brief       Idle task, runs when no other task is ready.
+******************************************************************************/
+static void KRN_IdleTask(void *pArg)
+{
+	(void)pArg;
+
+	while(1)
+	{
+		if(krn_idle_hook != 0)
+		{
+			krn_idle_hook();
+		}
+		else
+		{
+			__DSB();
+			__WFI();
+		}
+	}
+}
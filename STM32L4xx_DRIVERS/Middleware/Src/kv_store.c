@@ -0,0 +1,1154 @@
+/**************************************************************************//**
+ * @file    kv_store.c
+ * @brief   This file contains the function definitions for the log-structured
+ *          key-value store kept in internal flash.
+ *
+ * This file has 9 functions definitions (input parameters omitted):
+ *      <br>1) KVS_Mount()          - Scans the flash area and builds the RAM index. </br>
+ *      <br>2) KVS_Format()         - Erases the flash area and mounts an empty store. </br>
+ *      <br>3) KVS_Read()           - Reads the value of a key. </br>
+ *      <br>4) KVS_Write()          - Appends a new value for a key. </br>
+ *      <br>5) KVS_Delete()         - Appends a tombstone for a key. </br>
+ *      <br>6) KVS_GetStats()       - Returns usage and wear statistics. </br>
+ *      <br>7) KVS_GetFlashOps()    - Defined by the flash backend (port or simulator). </br>
+ *      <br>8) KVS_RefreshPage()    - Moves the records of a page away and erases it. </br>
+ *      <br>9) KVS_RetirePage()     - Moves the records of a page away and retires it. </br>
+ *
+ * Page layout (every field is one 64-bit double word):
+ *      <br>0) Page header: tag in the high word, erase count in the low word. </br>
+ *      <br>1) Sequence: written when the page becomes the head, ~seq in the high word. </br>
+ *      <br>2..) Records: one header double word followed by the value padded to 8 bytes. </br>
+ *
+ * Record header: key [15:0], length [31:16], CRC16 of the value [47:32],
+ * type [55:48] and a check byte [63:56] over the other seven bytes. A record
+ * whose value CRC does not match was cut by a reset and is ignored; a header
+ * that fails its check seals the rest of the page.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+#include <string.h>
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <kv_store.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	KVS_ERASED_DWORD		(0xFFFFFFFFFFFFFFFFULL)
+#define	KVS_PAGE_TAG			(0x4B5601FFUL)		/* "KV", layout version 1 */
+#define	KVS_PAGE_HEADER_SIZE		(16UL)
+#define	KVS_RECORD_HEADER_SIZE		(8UL)
+
+#define	KVS_TYPE_VALUE			(0xA5U)
+#define	KVS_TYPE_TOMBSTONE		(0x5AU)
+
+#define	KVS_PAGE_NONE			(0xFFFFFFFFUL)
+
+#define	KVS_ROUND8(x)			(((x) + 7UL) & ~7UL)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef enum
+{
+  KVS_PAGE_FREE = 0,            /* Formatted, no sequence yet */
+  KVS_PAGE_USED = 1,            /* Part of the log */
+  KVS_PAGE_RETIRED = 2          /* Out of service */
+}KVS_PageState;
+
+typedef struct
+{
+  uint32_t      Seq;
+  uint32_t      EraseCount;
+  uint32_t      WriteOffset;    /* Page relative offset of the next record */
+  KVS_PageState State;
+}KVS_PageInfo_t;
+
+typedef struct
+{
+  uint16_t      Key;
+  uint16_t      Length;
+  uint16_t      Crc;
+  uint8_t       Type;
+}KVS_Record_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static const KVS_FlashOps_t *kvs_ops = 0;
+static KVS_PageInfo_t kvs_pages[KVS_MAX_PAGES];
+static uint32_t kvs_head = KVS_PAGE_NONE;
+static uint32_t kvs_next_seq = 0;
+static uint32_t kvs_live_bytes = 0;
+static uint32_t kvs_key_count = 0;
+static uint32_t kvs_gc_runs = 0;
+static uint32_t kvs_gc_copied = 0;
+static uint32_t kvs_lost = 0;
+static uint8_t kvs_collecting = 0;
+
+static uint16_t kvs_index_key[KVS_INDEX_SLOTS];
+static uint32_t kvs_index_offset[KVS_INDEX_SLOTS];
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static uint64_t KVS_ReadDword(uint32_t Offset);
+static uint16_t KVS_Crc16(const uint8_t *pData, uint32_t Length);
+static uint64_t KVS_EncodeHeader(const KVS_Record_t *pRecord);
+static uint8_t KVS_DecodeHeader(uint64_t Header, KVS_Record_t *pRecord);
+static int32_t KVS_IndexFind(uint16_t Key);
+static KVS_STATUS KVS_IndexPut(uint16_t Key, uint32_t Offset);
+static void KVS_IndexRemove(uint16_t Key);
+static uint32_t KVS_RecordSize(uint32_t Offset);
+static KVS_STATUS KVS_FormatPage(uint32_t Page, uint32_t EraseCount);
+static KVS_STATUS KVS_OpenPage(uint8_t AllowReserve);
+static uint32_t KVS_OldestPage(void);
+static KVS_STATUS KVS_CollectPage(uint32_t Victim);
+static KVS_STATUS KVS_CollectOldest(void);
+static KVS_STATUS KVS_Reserve(uint32_t Size, uint8_t AllowReserve);
+static KVS_STATUS KVS_Append(uint16_t Key, uint8_t Type, const uint8_t *pValue, uint32_t Length, uint32_t *pOffset);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function mounts the store. It classifies every page,
+*              formats the unreadable ones and replays the records of the used
+*              pages in sequence order to build the RAM index.
+*
+* @param       pFlashOps        Flash backend holding the store.
+*
+* @return      KVS_STATUS_OK or KVS_STATUS_ERROR
+******************************************************************************/
+KVS_STATUS KVS_Mount(const KVS_FlashOps_t *pFlashOps)
+{
+	uint32_t order[KVS_MAX_PAGES];
+	uint32_t used = 0;
+	uint32_t max_erase = 0;
+	uint8_t needs_format[KVS_MAX_PAGES];
+	uint32_t page, i, j;
+
+	if((pFlashOps == 0) || (pFlashOps->PageCount < 3U) || (pFlashOps->PageCount > KVS_MAX_PAGES) || \
+	   (pFlashOps->PageSize < (KVS_PAGE_HEADER_SIZE + KVS_RECORD_HEADER_SIZE + KVS_MAX_VALUE_SIZE)))
+	{
+		return KVS_STATUS_ERROR;
+	}
+
+	kvs_ops = pFlashOps;
+	kvs_head = KVS_PAGE_NONE;
+	kvs_next_seq = 0;
+	kvs_live_bytes = 0;
+	kvs_key_count = 0;
+	kvs_gc_runs = 0;
+	kvs_gc_copied = 0;
+	kvs_lost = 0;
+
+	for(i = 0; i < KVS_INDEX_SLOTS; i++)
+	{
+		kvs_index_key[i] = KVS_KEY_INVALID;
+	}
+
+	/* 1. Classify the pages from their two header double words */
+	for(page = 0; page < kvs_ops->PageCount; page++)
+	{
+		uint32_t base = page * kvs_ops->PageSize;
+		uint64_t header = KVS_ReadDword(base);
+		uint64_t seq = KVS_ReadDword(base + 8U);
+
+		needs_format[page] = 0;
+		kvs_pages[page].WriteOffset = KVS_PAGE_HEADER_SIZE;
+
+		if(header == 0)
+		{
+			kvs_pages[page].State = KVS_PAGE_RETIRED;
+		}
+		else if((uint32_t)(header >> 32) == KVS_PAGE_TAG)
+		{
+			kvs_pages[page].EraseCount = (uint32_t)header;
+			if(kvs_pages[page].EraseCount > max_erase)
+			{
+				max_erase = kvs_pages[page].EraseCount;
+			}
+
+			if(seq == KVS_ERASED_DWORD)
+			{
+				kvs_pages[page].State = KVS_PAGE_FREE;
+			}
+			else if((uint32_t)(seq >> 32) == (uint32_t)~((uint32_t)seq))
+			{
+				kvs_pages[page].State = KVS_PAGE_USED;
+				kvs_pages[page].Seq = (uint32_t)seq;
+
+				/* Keep the used pages sorted by sequence */
+				for(j = used; (j > 0) && (kvs_pages[order[j - 1U]].Seq > kvs_pages[page].Seq); j--)
+				{
+					order[j] = order[j - 1U];
+				}
+				order[j] = page;
+				used++;
+			}
+			else
+			{
+				/* Sequence write was cut by a reset */
+				needs_format[page] = 1;
+			}
+		}
+		else
+		{
+			/* Blank part, interrupted erase or foreign data */
+			kvs_pages[page].EraseCount = 0;
+			needs_format[page] = 1;
+		}
+	}
+
+	/* 2. Bring the unreadable pages back as free pages */
+	for(page = 0; page < kvs_ops->PageCount; page++)
+	{
+		if(needs_format[page] != 0)
+		{
+			uint32_t erase_count = kvs_pages[page].EraseCount;
+
+			if(erase_count < max_erase)
+			{
+				erase_count = max_erase;
+			}
+			(void)KVS_FormatPage(page, erase_count);
+		}
+	}
+
+	/* 3. Replay the log, oldest page first, so newer records win */
+	for(i = 0; i < used; i++)
+	{
+		uint32_t base;
+		uint32_t offset = KVS_PAGE_HEADER_SIZE;
+
+		page = order[i];
+		base = page * kvs_ops->PageSize;
+
+		while((offset + KVS_RECORD_HEADER_SIZE) <= kvs_ops->PageSize)
+		{
+			KVS_Record_t record;
+			uint64_t header = KVS_ReadDword(base + offset);
+			uint32_t size;
+
+			if(header == KVS_ERASED_DWORD)
+			{
+				break;
+			}
+
+			if(KVS_DecodeHeader(header, &record) == 0)
+			{
+				/* Corrupted header, nothing after it can be trusted */
+				offset = kvs_ops->PageSize;
+				break;
+			}
+
+			size = KVS_RECORD_HEADER_SIZE + KVS_ROUND8(record.Length);
+			if((offset + size) > kvs_ops->PageSize)
+			{
+				offset = kvs_ops->PageSize;
+				break;
+			}
+
+			if(KVS_Crc16(&kvs_ops->Base[base + offset + KVS_RECORD_HEADER_SIZE], record.Length) == record.Crc)
+			{
+				int32_t slot = KVS_IndexFind(record.Key);
+
+				if(slot >= 0)
+				{
+					kvs_live_bytes -= KVS_RecordSize(kvs_index_offset[slot]);
+				}
+
+				if(record.Type == KVS_TYPE_VALUE)
+				{
+					if(KVS_IndexPut(record.Key, base + offset) == KVS_STATUS_OK)
+					{
+						kvs_live_bytes += size;
+					}
+				}
+				else
+				{
+					KVS_IndexRemove(record.Key);
+				}
+			}
+
+			offset += size;
+		}
+
+		kvs_pages[page].WriteOffset = offset;
+		kvs_head = page;
+		kvs_next_seq = kvs_pages[page].Seq + 1U;
+	}
+
+	return KVS_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function erases every page of the area and mounts an empty
+*              store. Erase counts found in valid page headers are preserved.
+*
+* @param       pFlashOps        Flash backend holding the store.
+*
+* @return      KVS_STATUS_OK or KVS_STATUS_ERROR
+******************************************************************************/
+KVS_STATUS KVS_Format(const KVS_FlashOps_t *pFlashOps)
+{
+	uint32_t page;
+
+	if((pFlashOps == 0) || (pFlashOps->PageCount > KVS_MAX_PAGES))
+	{
+		return KVS_STATUS_ERROR;
+	}
+
+	kvs_ops = pFlashOps;
+
+	for(page = 0; page < kvs_ops->PageCount; page++)
+	{
+		uint64_t header = KVS_ReadDword(page * kvs_ops->PageSize);
+		uint32_t erase_count = 0;
+
+		if(header == 0)
+		{
+			/* Retired pages stay retired */
+			continue;
+		}
+
+		if((uint32_t)(header >> 32) == KVS_PAGE_TAG)
+		{
+			erase_count = (uint32_t)header;
+		}
+
+		if(KVS_FormatPage(page, erase_count) != KVS_STATUS_OK)
+		{
+			return KVS_STATUS_ERROR;
+		}
+	}
+
+	return KVS_Mount(pFlashOps);
+}
+
+/**************************************************************************//**
+* @brief       This function reads the newest value of a key. The lookup is a
+*              single hash probe sequence in RAM followed by a copy from the
+*              memory mapped flash.
+*
+* @param       Key              Key to read.
+* @param       pBuffer          Destination buffer.
+* @param       BufferSize       Size of the destination buffer.
+* @param       pLength          Returns the full length of the value (may be 0).
+*
+* @return      KVS_STATUS_OK, KVS_STATUS_NOT_FOUND or KVS_STATUS_NO_INIT
+******************************************************************************/
+KVS_STATUS KVS_Read(uint16_t Key, void *pBuffer, uint32_t BufferSize, uint32_t *pLength)
+{
+	KVS_Record_t record;
+	uint32_t offset;
+	uint32_t length;
+	int32_t slot;
+
+	if(kvs_ops == 0)
+	{
+		return KVS_STATUS_NO_INIT;
+	}
+
+	slot = KVS_IndexFind(Key);
+	if(slot < 0)
+	{
+		return KVS_STATUS_NOT_FOUND;
+	}
+
+	offset = kvs_index_offset[slot];
+	(void)KVS_DecodeHeader(KVS_ReadDword(offset), &record);
+
+	length = record.Length;
+	if(length > BufferSize)
+	{
+		length = BufferSize;
+	}
+
+	if((pBuffer != 0) && (length != 0))
+	{
+		memcpy(pBuffer, &kvs_ops->Base[offset + KVS_RECORD_HEADER_SIZE], length);
+	}
+
+	if(pLength != 0)
+	{
+		*pLength = record.Length;
+	}
+
+	return KVS_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function appends a new value for a key. The previous value
+*              becomes garbage and is reclaimed by a later garbage collection.
+*
+* @param       Key              Key to write (0xFFFF is reserved).
+* @param       pValue           Value to store.
+* @param       Length           Length of the value, up to KVS_MAX_VALUE_SIZE.
+*
+* @return      KVS_STATUS_OK, KVS_STATUS_FULL, KVS_STATUS_ERROR or KVS_STATUS_NO_INIT
+******************************************************************************/
+KVS_STATUS KVS_Write(uint16_t Key, const void *pValue, uint32_t Length)
+{
+	KVS_STATUS status;
+	uint32_t size = KVS_RECORD_HEADER_SIZE + KVS_ROUND8(Length);
+	uint32_t old_size = 0;
+	uint32_t capacity;
+	uint32_t offset;
+	int32_t slot;
+
+	if(kvs_ops == 0)
+	{
+		return KVS_STATUS_NO_INIT;
+	}
+
+	if((Key == KVS_KEY_INVALID) || (Length > KVS_MAX_VALUE_SIZE) || ((pValue == 0) && (Length != 0)))
+	{
+		return KVS_STATUS_ERROR;
+	}
+
+	slot = KVS_IndexFind(Key);
+	if(slot >= 0)
+	{
+		old_size = KVS_RecordSize(kvs_index_offset[slot]);
+	}
+	else if(kvs_key_count >= KVS_MAX_KEYS)
+	{
+		return KVS_STATUS_FULL;
+	}
+
+	/* Live data must fit in the pages left besides the reserve, keeping one
+	 * page of slack for the unused tails of the pages */
+	capacity = 0;
+	for(offset = 0; offset < kvs_ops->PageCount; offset++)
+	{
+		if(kvs_pages[offset].State != KVS_PAGE_RETIRED)
+		{
+			capacity++;
+		}
+	}
+	if(capacity <= (KVS_RESERVE_PAGES + 1U))
+	{
+		return KVS_STATUS_FULL;
+	}
+	capacity = (capacity - KVS_RESERVE_PAGES - 1U) * (kvs_ops->PageSize - KVS_PAGE_HEADER_SIZE);
+
+	if(((kvs_live_bytes - old_size) + size) > capacity)
+	{
+		return KVS_STATUS_FULL;
+	}
+
+	status = KVS_Append(Key, KVS_TYPE_VALUE, (const uint8_t*)pValue, Length, &offset);
+	if(status != KVS_STATUS_OK)
+	{
+		return status;
+	}
+
+	/* The garbage collector may have moved the old record, look it up again */
+	slot = KVS_IndexFind(Key);
+	if(slot >= 0)
+	{
+		kvs_live_bytes -= KVS_RecordSize(kvs_index_offset[slot]);
+	}
+
+	status = KVS_IndexPut(Key, offset);
+	if(status == KVS_STATUS_OK)
+	{
+		kvs_live_bytes += size;
+	}
+
+	return status;
+}
+
+/**************************************************************************//**
+* @brief       This function deletes a key by appending a tombstone record.
+*
+* @param       Key              Key to delete.
+*
+* @return      KVS_STATUS_OK, KVS_STATUS_NOT_FOUND, KVS_STATUS_FULL, KVS_STATUS_ERROR
+*              or KVS_STATUS_NO_INIT
+******************************************************************************/
+KVS_STATUS KVS_Delete(uint16_t Key)
+{
+	KVS_STATUS status;
+	uint32_t offset;
+	int32_t slot;
+
+	if(kvs_ops == 0)
+	{
+		return KVS_STATUS_NO_INIT;
+	}
+
+	if(KVS_IndexFind(Key) < 0)
+	{
+		return KVS_STATUS_NOT_FOUND;
+	}
+
+	status = KVS_Append(Key, KVS_TYPE_TOMBSTONE, 0, 0, &offset);
+	if(status != KVS_STATUS_OK)
+	{
+		return status;
+	}
+
+	slot = KVS_IndexFind(Key);
+	if(slot >= 0)
+	{
+		kvs_live_bytes -= KVS_RecordSize(kvs_index_offset[slot]);
+		KVS_IndexRemove(Key);
+	}
+
+	return KVS_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function returns usage and wear statistics of the store.
+*
+* @param       pStats           Structure to fill.
+******************************************************************************/
+void KVS_GetStats(KVS_Stats_t *pStats)
+{
+	uint32_t page;
+
+	memset(pStats, 0, sizeof(KVS_Stats_t));
+
+	if(kvs_ops == 0)
+	{
+		return;
+	}
+
+	pStats->Keys = kvs_key_count;
+	pStats->GCRuns = kvs_gc_runs;
+	pStats->GCCopiedBytes = kvs_gc_copied;
+	pStats->LostRecords = kvs_lost;
+	pStats->MinEraseCount = 0xFFFFFFFFUL;
+
+	if(kvs_head != KVS_PAGE_NONE)
+	{
+		pStats->HeadFreeBytes = kvs_ops->PageSize - kvs_pages[kvs_head].WriteOffset;
+	}
+
+	for(page = 0; page < kvs_ops->PageCount; page++)
+	{
+		if(kvs_pages[page].State == KVS_PAGE_RETIRED)
+		{
+			pStats->RetiredPages++;
+			continue;
+		}
+
+		if(kvs_pages[page].State == KVS_PAGE_FREE)
+		{
+			pStats->FreePages++;
+		}
+
+		if(kvs_pages[page].EraseCount < pStats->MinEraseCount)
+		{
+			pStats->MinEraseCount = kvs_pages[page].EraseCount;
+		}
+		if(kvs_pages[page].EraseCount > pStats->MaxEraseCount)
+		{
+			pStats->MaxEraseCount = kvs_pages[page].EraseCount;
+		}
+	}
+
+	if(pStats->MinEraseCount > pStats->MaxEraseCount)
+	{
+		pStats->MinEraseCount = 0;
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function moves the live records of a page to the head and
+*              erases it. Used when the page shows ECC corrections: the erase
+*              and reprogram restores the charge of its cells.
+*
+* @param       PageIndex        Page of the area.
+*
+* @return      KVS_STATUS_OK, KVS_STATUS_FULL, KVS_STATUS_ERROR or KVS_STATUS_NO_INIT
+******************************************************************************/
+KVS_STATUS KVS_RefreshPage(uint32_t PageIndex)
+{
+	KVS_STATUS status;
+
+	if(kvs_ops == 0)
+	{
+		return KVS_STATUS_NO_INIT;
+	}
+
+	if((PageIndex >= kvs_ops->PageCount) || (kvs_pages[PageIndex].State == KVS_PAGE_RETIRED))
+	{
+		return KVS_STATUS_ERROR;
+	}
+
+	if(kvs_pages[PageIndex].State == KVS_PAGE_FREE)
+	{
+		return KVS_FormatPage(PageIndex, kvs_pages[PageIndex].EraseCount);
+	}
+
+	status = KVS_CollectPage(PageIndex);
+	if(status != KVS_STATUS_OK)
+	{
+		return status;
+	}
+
+	return KVS_FormatPage(PageIndex, kvs_pages[PageIndex].EraseCount);
+}
+
+/**************************************************************************//**
+* @brief       This function moves the live records of a page to the head and
+*              takes the page out of service by programming its header to zero.
+*              The capacity of the store shrinks by one page.
+*
+* @param       PageIndex        Page of the area.
+*
+* @return      KVS_STATUS_OK, KVS_STATUS_FULL, KVS_STATUS_ERROR or KVS_STATUS_NO_INIT
+******************************************************************************/
+KVS_STATUS KVS_RetirePage(uint32_t PageIndex)
+{
+	KVS_STATUS status;
+
+	if(kvs_ops == 0)
+	{
+		return KVS_STATUS_NO_INIT;
+	}
+
+	if(PageIndex >= kvs_ops->PageCount)
+	{
+		return KVS_STATUS_ERROR;
+	}
+
+	if(kvs_pages[PageIndex].State == KVS_PAGE_RETIRED)
+	{
+		return KVS_STATUS_OK;
+	}
+
+	if(kvs_pages[PageIndex].State == KVS_PAGE_USED)
+	{
+		status = KVS_CollectPage(PageIndex);
+		if(status != KVS_STATUS_OK)
+		{
+			return status;
+		}
+	}
+
+	/* Zero can always be programmed over any content */
+	(void)kvs_ops->Program(PageIndex * kvs_ops->PageSize, 0);
+	kvs_pages[PageIndex].State = KVS_PAGE_RETIRED;
+
+	return KVS_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       Reads a double word of the area.
+******************************************************************************/
+static uint64_t KVS_ReadDword(uint32_t Offset)
+{
+	uint64_t value;
+
+	memcpy(&value, &kvs_ops->Base[Offset], sizeof(value));
+	return value;
+}
+
+/**************************************************************************//**
+* @brief       CRC16-CCITT (polynomial 0x1021, initial value 0xFFFF).
+******************************************************************************/
+static uint16_t KVS_Crc16(const uint8_t *pData, uint32_t Length)
+{
+	uint16_t crc = 0xFFFFU;
+	uint32_t i;
+	uint8_t bit;
+
+	for(i = 0; i < Length; i++)
+	{
+		crc ^= (uint16_t)((uint16_t)pData[i] << 8);
+		for(bit = 0; bit < 8U; bit++)
+		{
+			if((crc & 0x8000U) != 0)
+			{
+				crc = (uint16_t)((crc << 1) ^ 0x1021U);
+			}
+			else
+			{
+				crc = (uint16_t)(crc << 1);
+			}
+		}
+	}
+
+	return crc;
+}
+
+/**************************************************************************//**
+* @brief       Packs a record header into its double word, check byte included.
+******************************************************************************/
+static uint64_t KVS_EncodeHeader(const KVS_Record_t *pRecord)
+{
+	uint64_t header;
+	uint8_t check = 0;
+	uint8_t i;
+
+	header = ((uint64_t)pRecord->Key) | ((uint64_t)pRecord->Length << 16) | \
+	         ((uint64_t)pRecord->Crc << 32) | ((uint64_t)pRecord->Type << 48);
+
+	for(i = 0; i < 7U; i++)
+	{
+		check = (uint8_t)(check + (uint8_t)(header >> (8U * i)));
+	}
+
+	return header | ((uint64_t)(uint8_t)~check << 56);
+}
+
+/**************************************************************************//**
+* @brief       Unpacks a record header. Returns 0 if the header is not valid.
+******************************************************************************/
+static uint8_t KVS_DecodeHeader(uint64_t Header, KVS_Record_t *pRecord)
+{
+	uint8_t check = 0;
+	uint8_t i;
+
+	for(i = 0; i < 7U; i++)
+	{
+		check = (uint8_t)(check + (uint8_t)(Header >> (8U * i)));
+	}
+
+	pRecord->Key = (uint16_t)Header;
+	pRecord->Length = (uint16_t)(Header >> 16);
+	pRecord->Crc = (uint16_t)(Header >> 32);
+	pRecord->Type = (uint8_t)(Header >> 48);
+
+	if(((uint8_t)~check != (uint8_t)(Header >> 56)) || (pRecord->Key == KVS_KEY_INVALID) || \
+	   (pRecord->Length > KVS_MAX_VALUE_SIZE) || \
+	   ((pRecord->Type != KVS_TYPE_VALUE) && (pRecord->Type != KVS_TYPE_TOMBSTONE)))
+	{
+		return 0;
+	}
+
+	return 1;
+}
+
+/**************************************************************************//**
+* @brief       Returns the index slot of a key or -1. Linear probing.
+******************************************************************************/
+static int32_t KVS_IndexFind(uint16_t Key)
+{
+	uint32_t slot = ((uint32_t)Key * 0x9E3779B1UL) >> 16;
+	uint32_t i;
+
+	for(i = 0; i < KVS_INDEX_SLOTS; i++)
+	{
+		slot &= (KVS_INDEX_SLOTS - 1U);
+
+		if(kvs_index_key[slot] == Key)
+		{
+			return (int32_t)slot;
+		}
+		if(kvs_index_key[slot] == KVS_KEY_INVALID)
+		{
+			return -1;
+		}
+		slot++;
+	}
+
+	return -1;
+}
+
+/**************************************************************************//**
+* @brief       Inserts a key or updates its record offset.
+******************************************************************************/
+static KVS_STATUS KVS_IndexPut(uint16_t Key, uint32_t Offset)
+{
+	uint32_t slot = ((uint32_t)Key * 0x9E3779B1UL) >> 16;
+	uint32_t i;
+
+	for(i = 0; i < KVS_INDEX_SLOTS; i++)
+	{
+		slot &= (KVS_INDEX_SLOTS - 1U);
+
+		if(kvs_index_key[slot] == Key)
+		{
+			kvs_index_offset[slot] = Offset;
+			return KVS_STATUS_OK;
+		}
+		if(kvs_index_key[slot] == KVS_KEY_INVALID)
+		{
+			if(kvs_key_count >= KVS_MAX_KEYS)
+			{
+				return KVS_STATUS_FULL;
+			}
+			kvs_index_key[slot] = Key;
+			kvs_index_offset[slot] = Offset;
+			kvs_key_count++;
+			return KVS_STATUS_OK;
+		}
+		slot++;
+	}
+
+	return KVS_STATUS_FULL;
+}
+
+/**************************************************************************//**
+* @brief       Removes a key. The probe chain is closed by shifting the
+*              following entries back, so no deleted markers are needed.
+******************************************************************************/
+static void KVS_IndexRemove(uint16_t Key)
+{
+	int32_t found = KVS_IndexFind(Key);
+	uint32_t hole, next, home;
+
+	if(found < 0)
+	{
+		return;
+	}
+
+	hole = (uint32_t)found;
+	next = hole;
+
+	while(1)
+	{
+		next = (next + 1U) & (KVS_INDEX_SLOTS - 1U);
+
+		if(kvs_index_key[next] == KVS_KEY_INVALID)
+		{
+			break;
+		}
+
+		home = (((uint32_t)kvs_index_key[next] * 0x9E3779B1UL) >> 16) & (KVS_INDEX_SLOTS - 1U);
+
+		/* Move the entry if its home is not cyclically inside (hole, next] */
+		if(((next - home) & (KVS_INDEX_SLOTS - 1U)) >= ((next - hole) & (KVS_INDEX_SLOTS - 1U)))
+		{
+			kvs_index_key[hole] = kvs_index_key[next];
+			kvs_index_offset[hole] = kvs_index_offset[next];
+			hole = next;
+		}
+	}
+
+	kvs_index_key[hole] = KVS_KEY_INVALID;
+	kvs_key_count--;
+}
+
+/**************************************************************************//**
+* @brief       Returns the flash footprint of the record at the given offset.
+******************************************************************************/
+static uint32_t KVS_RecordSize(uint32_t Offset)
+{
+	KVS_Record_t record;
+
+	(void)KVS_DecodeHeader(KVS_ReadDword(Offset), &record);
+
+	return KVS_RECORD_HEADER_SIZE + KVS_ROUND8(record.Length);
+}
+
+/**************************************************************************//**
+* @brief       Erases a page and writes its header. A page that cannot be
+*              erased is retired by programming its header to zero.
+******************************************************************************/
+static KVS_STATUS KVS_FormatPage(uint32_t Page, uint32_t EraseCount)
+{
+	uint32_t base = Page * kvs_ops->PageSize;
+
+	kvs_pages[Page].WriteOffset = KVS_PAGE_HEADER_SIZE;
+
+	if((kvs_ops->ErasePage(Page) != KVS_STATUS_OK) || \
+	   (kvs_ops->Program(base, ((uint64_t)KVS_PAGE_TAG << 32) | (EraseCount + 1U)) != KVS_STATUS_OK))
+	{
+		(void)kvs_ops->Program(base, 0);
+		kvs_pages[Page].State = KVS_PAGE_RETIRED;
+		return KVS_STATUS_ERROR;
+	}
+
+	kvs_pages[Page].State = KVS_PAGE_FREE;
+	kvs_pages[Page].EraseCount = EraseCount + 1U;
+
+	return KVS_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       Turns the least worn free page into the new head. The reserve
+*              page may only be taken by the garbage collector.
+******************************************************************************/
+static KVS_STATUS KVS_OpenPage(uint8_t AllowReserve)
+{
+	uint32_t best = KVS_PAGE_NONE;
+	uint32_t free_pages = 0;
+	uint32_t page;
+
+	for(page = 0; page < kvs_ops->PageCount; page++)
+	{
+		if(kvs_pages[page].State == KVS_PAGE_FREE)
+		{
+			free_pages++;
+			if((best == KVS_PAGE_NONE) || (kvs_pages[page].EraseCount < kvs_pages[best].EraseCount))
+			{
+				best = page;
+			}
+		}
+	}
+
+	if((best == KVS_PAGE_NONE) || ((AllowReserve == 0) && (free_pages <= KVS_RESERVE_PAGES)))
+	{
+		return KVS_STATUS_FULL;
+	}
+
+	if(kvs_ops->Program((best * kvs_ops->PageSize) + 8U, \
+	                    ((uint64_t)(uint32_t)~kvs_next_seq << 32) | kvs_next_seq) != KVS_STATUS_OK)
+	{
+		(void)kvs_ops->Program(best * kvs_ops->PageSize, 0);
+		kvs_pages[best].State = KVS_PAGE_RETIRED;
+		return KVS_STATUS_ERROR;
+	}
+
+	kvs_pages[best].State = KVS_PAGE_USED;
+	kvs_pages[best].Seq = kvs_next_seq;
+	kvs_pages[best].WriteOffset = KVS_PAGE_HEADER_SIZE;
+	kvs_next_seq++;
+	kvs_head = best;
+
+	return KVS_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       Returns the used page with the lowest sequence, head excluded.
+******************************************************************************/
+static uint32_t KVS_OldestPage(void)
+{
+	uint32_t oldest = KVS_PAGE_NONE;
+	uint32_t page;
+
+	for(page = 0; page < kvs_ops->PageCount; page++)
+	{
+		if((kvs_pages[page].State == KVS_PAGE_USED) && (page != kvs_head) && \
+		   ((oldest == KVS_PAGE_NONE) || (kvs_pages[page].Seq < kvs_pages[oldest].Seq)))
+		{
+			oldest = page;
+		}
+	}
+
+	return oldest;
+}
+
+/**************************************************************************//**
+* @brief       Appends the live records of a used page to the head. The page is
+*              left untouched, the caller erases or retires it. Tombstones are
+*              dropped only from the oldest page, elsewhere they may still hide
+*              a record of an older page and are copied while the key is absent.
+*              A live value whose CRC no longer matches, on a page retired after
+*              an ECC double error for example, is not copied: the key is
+*              deleted with a tombstone, so no older record of it comes back
+*              at the next mount, and counted in LostRecords.
+******************************************************************************/
+static KVS_STATUS KVS_CollectPage(uint32_t Victim)
+{
+	uint32_t base = Victim * kvs_ops->PageSize;
+	uint32_t offset = KVS_PAGE_HEADER_SIZE;
+	uint8_t keep_tombstones = (uint8_t)(Victim != KVS_OldestPage());
+
+	kvs_collecting = 1;
+
+	/* Never append into the page being emptied */
+	if((Victim == kvs_head) && (KVS_OpenPage(1) != KVS_STATUS_OK))
+	{
+		kvs_collecting = 0;
+		return KVS_STATUS_FULL;
+	}
+
+	while(offset < kvs_pages[Victim].WriteOffset)
+	{
+		KVS_Record_t record;
+		int32_t slot;
+		uint32_t size;
+		uint32_t new_offset;
+
+		if(KVS_DecodeHeader(KVS_ReadDword(base + offset), &record) == 0)
+		{
+			break;
+		}
+		size = KVS_RECORD_HEADER_SIZE + KVS_ROUND8(record.Length);
+
+		slot = KVS_IndexFind(record.Key);
+		if((slot >= 0) && (kvs_index_offset[slot] == (base + offset)) && \
+		   (KVS_Crc16(&kvs_ops->Base[base + offset + KVS_RECORD_HEADER_SIZE], record.Length) != record.Crc))
+		{
+			if(KVS_Append(record.Key, KVS_TYPE_TOMBSTONE, 0, 0, &new_offset) != KVS_STATUS_OK)
+			{
+				kvs_collecting = 0;
+				return KVS_STATUS_ERROR;
+			}
+
+			kvs_live_bytes -= size;
+			KVS_IndexRemove(record.Key);
+			kvs_lost++;
+		}
+		else if((slot >= 0) && (kvs_index_offset[slot] == (base + offset)))
+		{
+			if(KVS_Append(record.Key, KVS_TYPE_VALUE, &kvs_ops->Base[base + offset + KVS_RECORD_HEADER_SIZE], \
+			              record.Length, &new_offset) != KVS_STATUS_OK)
+			{
+				kvs_collecting = 0;
+				return KVS_STATUS_ERROR;
+			}
+
+			kvs_index_offset[slot] = new_offset;
+			kvs_gc_copied += size;
+		}
+		else if((record.Type == KVS_TYPE_TOMBSTONE) && (slot < 0) && (keep_tombstones != 0))
+		{
+			if(KVS_Append(record.Key, KVS_TYPE_TOMBSTONE, 0, 0, &new_offset) != KVS_STATUS_OK)
+			{
+				kvs_collecting = 0;
+				return KVS_STATUS_ERROR;
+			}
+
+			kvs_gc_copied += size;
+		}
+
+		offset += size;
+	}
+
+	kvs_collecting = 0;
+	kvs_gc_runs++;
+
+	return KVS_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       Garbage collects the oldest page: live records are appended to
+*              the head and the page is erased. Tombstones are dropped because
+*              no older page can hold a record they would have to hide.
+******************************************************************************/
+static KVS_STATUS KVS_CollectOldest(void)
+{
+	uint32_t victim = KVS_OldestPage();
+	KVS_STATUS status;
+
+	if(victim == KVS_PAGE_NONE)
+	{
+		return KVS_STATUS_FULL;
+	}
+
+	status = KVS_CollectPage(victim);
+	if(status != KVS_STATUS_OK)
+	{
+		return status;
+	}
+
+	return KVS_FormatPage(victim, kvs_pages[victim].EraseCount);
+}
+
+/**************************************************************************//**
+* @brief       Makes sure the head page has room for a record of Size bytes,
+*              opening new pages and collecting old ones as needed.
+******************************************************************************/
+static KVS_STATUS KVS_Reserve(uint32_t Size, uint8_t AllowReserve)
+{
+	uint32_t attempts;
+
+	for(attempts = 0; attempts <= kvs_ops->PageCount; attempts++)
+	{
+		if((kvs_head != KVS_PAGE_NONE) && ((kvs_pages[kvs_head].WriteOffset + Size) <= kvs_ops->PageSize))
+		{
+			return KVS_STATUS_OK;
+		}
+
+		if(KVS_OpenPage(AllowReserve) == KVS_STATUS_OK)
+		{
+			continue;
+		}
+
+		if(AllowReserve != 0)
+		{
+			/* The collector itself ran out of pages */
+			return KVS_STATUS_FULL;
+		}
+
+		if(KVS_CollectOldest() == KVS_STATUS_FULL)
+		{
+			return KVS_STATUS_FULL;
+		}
+	}
+
+	return KVS_STATUS_FULL;
+}
+
+/**************************************************************************//**
+* @brief       Programs one record at the head: the header first, then the
+*              value double words padded with 0xFF.
+******************************************************************************/
+static KVS_STATUS KVS_Append(uint16_t Key, uint8_t Type, const uint8_t *pValue, uint32_t Length, uint32_t *pOffset)
+{
+	KVS_Record_t record;
+	uint32_t size = KVS_RECORD_HEADER_SIZE + KVS_ROUND8(Length);
+	uint32_t offset;
+	uint32_t i;
+	KVS_STATUS status;
+
+	/* Only the garbage collector may take the reserve page */
+	status = KVS_Reserve(size, kvs_collecting);
+	if(status != KVS_STATUS_OK)
+	{
+		return status;
+	}
+
+	record.Key = Key;
+	record.Length = (uint16_t)Length;
+	record.Crc = KVS_Crc16(pValue, Length);
+	record.Type = Type;
+
+	offset = (kvs_head * kvs_ops->PageSize) + kvs_pages[kvs_head].WriteOffset;
+
+	/* The space is consumed even if programming fails, so a torn record is
+	 * never overwritten */
+	kvs_pages[kvs_head].WriteOffset += size;
+
+	if(kvs_ops->Program(offset, KVS_EncodeHeader(&record)) != KVS_STATUS_OK)
+	{
+		kvs_pages[kvs_head].WriteOffset = kvs_ops->PageSize;
+		return KVS_STATUS_ERROR;
+	}
+
+	for(i = 0; i < Length; i += 8U)
+	{
+		uint64_t data = KVS_ERASED_DWORD;
+		uint32_t chunk = Length - i;
+
+		if(chunk > 8U)
+		{
+			chunk = 8U;
+		}
+		memcpy(&data, &pValue[i], chunk);
+
+		if(kvs_ops->Program(offset + KVS_RECORD_HEADER_SIZE + i, data) != KVS_STATUS_OK)
+		{
+			kvs_pages[kvs_head].WriteOffset = kvs_ops->PageSize;
+			return KVS_STATUS_ERROR;
+		}
+	}
+
+	*pOffset = offset;
+
+	return KVS_STATUS_OK;
+}
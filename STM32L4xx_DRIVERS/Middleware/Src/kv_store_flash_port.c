@@ -0,0 +1,168 @@
+/**************************************************************************//**
+ * @file    kv_store_flash_port.c
+ * @brief   This file contains the flash backend of the key-value store for
+ *          the STM32L475VG microcontroller.
+ *
+ * This file has 2 functions definitions (input parameters omitted):
+ *      <br>1) KVS_GetFlashOps()    - Returns the internal flash backend. </br>
+ *      <br>2) KVS_RegisterEccClient() - Hands the store area to the ECC monitor. </br>
+ *
+ * The store uses the last KVS_FLASH_AREA_PAGES pages of bank 2, so erasing
+ * and programming does not stall the code fetched from bank 1.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/* The host build links kv_store_flash_sim.c instead */
+#ifndef KVS_HOST_SIM
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+#include <stm32l475xx_flash_driver.h>
+#include <flash_ecc.h>
+
+/* Here go the own includes */
+#include <kv_store.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static KVS_STATUS KVS_PortErasePage(uint32_t PageIndex);
+static KVS_STATUS KVS_PortProgram(uint32_t Offset, uint64_t Data);
+static FECC_STATUS KVS_EccRewrite(uint32_t PageAddress);
+static FECC_STATUS KVS_EccRetire(uint32_t PageAddress);
+
+static const KVS_FlashOps_t kvs_flash_ops =
+{
+  (const uint8_t*)KVS_FLASH_AREA_ADDRESS,
+  FLASH_PAGE_SIZE,
+  KVS_FLASH_AREA_PAGES,
+  KVS_PortErasePage,
+  KVS_PortProgram
+};
+
+static const FECC_Client_t kvs_ecc_client =
+{
+  KVS_FLASH_AREA_ADDRESS,
+  KVS_FLASH_AREA_ADDRESS + (KVS_FLASH_AREA_PAGES * FLASH_PAGE_SIZE),
+  KVS_EccRewrite,
+  KVS_EccRetire
+};
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function returns the backend that maps the store on the
+*              internal flash.
+*
+* @return      Pointer to the flash backend.
+******************************************************************************/
+const KVS_FlashOps_t* KVS_GetFlashOps(void)
+{
+	return &kvs_flash_ops;
+}
+
+/**************************************************************************//**
+* @brief       This function registers the store area with the flash ECC
+*              monitor, so pages with repeated corrections are rewritten and
+*              failing pages are retired. Call it after KVS_Mount().
+*
+* @return      KVS_STATUS_OK or KVS_STATUS_ERROR
+******************************************************************************/
+KVS_STATUS KVS_RegisterEccClient(void)
+{
+	return (FECC_RegisterClient(&kvs_ecc_client) == FECC_STATUS_OK) ? KVS_STATUS_OK : KVS_STATUS_ERROR;
+}
+
+/**************************************************************************//**
+* @brief       Erases one page of the store area.
+******************************************************************************/
+static KVS_STATUS KVS_PortErasePage(uint32_t PageIndex)
+{
+	FLASH_STATUS status;
+
+	if(FLASH_Unlock() != FLASH_STATUS_OK)
+	{
+		return KVS_STATUS_ERROR;
+	}
+
+	status = FLASH_ErasePage(KVS_FLASH_AREA_ADDRESS + (PageIndex * FLASH_PAGE_SIZE));
+	FLASH_Lock();
+
+	return (status == FLASH_STATUS_OK) ? KVS_STATUS_OK : KVS_STATUS_ERROR;
+}
+
+/**************************************************************************//**
+* @brief       Programs one double word of the store area.
+******************************************************************************/
+static KVS_STATUS KVS_PortProgram(uint32_t Offset, uint64_t Data)
+{
+	FLASH_STATUS status;
+
+	if(FLASH_Unlock() != FLASH_STATUS_OK)
+	{
+		return KVS_STATUS_ERROR;
+	}
+
+	status = FLASH_ProgramDoubleWord(KVS_FLASH_AREA_ADDRESS + Offset, Data);
+	FLASH_Lock();
+
+	return (status == FLASH_STATUS_OK) ? KVS_STATUS_OK : KVS_STATUS_ERROR;
+}
+
+/**************************************************************************//**
+* @brief       ECC monitor hook, refreshes a weak page of the store.
+******************************************************************************/
+static FECC_STATUS KVS_EccRewrite(uint32_t PageAddress)
+{
+	uint32_t page = (PageAddress - KVS_FLASH_AREA_ADDRESS) / FLASH_PAGE_SIZE;
+
+	return (KVS_RefreshPage(page) == KVS_STATUS_OK) ? FECC_STATUS_OK : FECC_STATUS_ERROR;
+}
+
+/**************************************************************************//**
+* @brief       ECC monitor hook, retires a failing page of the store.
+******************************************************************************/
+static FECC_STATUS KVS_EccRetire(uint32_t PageAddress)
+{
+	uint32_t page = (PageAddress - KVS_FLASH_AREA_ADDRESS) / FLASH_PAGE_SIZE;
+
+	return (KVS_RetirePage(page) == KVS_STATUS_OK) ? FECC_STATUS_OK : FECC_STATUS_ERROR;
+}
+
+#endif /* KVS_HOST_SIM */
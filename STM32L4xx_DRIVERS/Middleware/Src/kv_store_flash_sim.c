@@ -0,0 +1,239 @@
+/**************************************************************************//**
+ * @file    kv_store_flash_sim.c
+ * @brief   This file contains a host side NOR flash simulator used as the
+ *          backend of the key-value store when it is built on Linux.
+ *
+ * This file has 6 functions definitions (input parameters omitted):
+ *      <br>1) KVS_GetFlashOps()        - Returns the simulated flash backend. </br>
+ *      <br>2) KVS_SIM_Reset()          - Turns the simulated part into a blank one. </br>
+ *      <br>3) KVS_SIM_SetPowerCut()    - Arms a power loss after N operations. </br>
+ *      <br>4) KVS_SIM_PowerLost()      - Tells if the armed power loss happened. </br>
+ *      <br>5) KVS_SIM_PowerCycle()     - Restores power after a power loss. </br>
+ *      <br>6) KVS_SIM_GetCounters()    - Returns the operation counters. </br>
+ *
+ * The simulator follows the STM32L4 rules: erase sets a page to 0xFF, a double
+ * word can only be programmed when erased or when writing zeros, and the
+ * operation hit by a power loss is left half done (the first word of a
+ * double word, or a page erased only up to its middle).
+ *
+ * Build it together with kv_store.c with -DKVS_HOST_SIM. The power-cut
+ * fuzzer and benchmark of kv_store_fuzz.c drive it, Tools/host_sim.py runs
+ * them:
+ *      gcc -DKVS_HOST_SIM -IMiddleware/Inc Middleware/Src/kv_store.c
+ *          Middleware/Src/kv_store_flash_sim.c Middleware/Src/kv_store_fuzz.c
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+#ifdef KVS_HOST_SIM
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+#include <string.h>
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <kv_store.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static uint8_t sim_flash[KVS_SIM_PAGES * KVS_SIM_PAGE_SIZE] __attribute__((aligned(8)));
+static uint32_t sim_ops_left = 0;
+static uint8_t sim_power_lost = 0;
+static uint32_t sim_erases = 0;
+static uint32_t sim_programs = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static KVS_STATUS KVS_SIM_ErasePage(uint32_t PageIndex);
+static KVS_STATUS KVS_SIM_Program(uint32_t Offset, uint64_t Data);
+static uint8_t KVS_SIM_ConsumeOperation(void);
+
+static const KVS_FlashOps_t kvs_sim_ops =
+{
+  sim_flash,
+  KVS_SIM_PAGE_SIZE,
+  KVS_SIM_PAGES,
+  KVS_SIM_ErasePage,
+  KVS_SIM_Program
+};
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function returns the simulated flash backend.
+*
+* @return      Pointer to the flash backend.
+******************************************************************************/
+const KVS_FlashOps_t* KVS_GetFlashOps(void)
+{
+	return &kvs_sim_ops;
+}
+
+/**************************************************************************//**
+* @brief       This function turns the simulated part into a blank one and
+*              clears the counters and the power loss state.
+******************************************************************************/
+void KVS_SIM_Reset(void)
+{
+	memset(sim_flash, 0xFF, sizeof(sim_flash));
+	sim_ops_left = 0;
+	sim_power_lost = 0;
+	sim_erases = 0;
+	sim_programs = 0;
+}
+
+/**************************************************************************//**
+* @brief       This function arms a power loss. The operation number
+*              OperationsLeft is torn and every following one fails.
+*
+* @param       OperationsLeft   Operations before the loss, 0 disarms it.
+******************************************************************************/
+void KVS_SIM_SetPowerCut(uint32_t OperationsLeft)
+{
+	sim_ops_left = OperationsLeft;
+}
+
+/**************************************************************************//**
+* @brief       This function tells if the armed power loss happened.
+*
+* @return      1 if the power was lost, 0 otherwise.
+******************************************************************************/
+uint8_t KVS_SIM_PowerLost(void)
+{
+	return sim_power_lost;
+}
+
+/**************************************************************************//**
+* @brief       This function restores power. The flash content is kept, the
+*              store must be mounted again as after a reset.
+******************************************************************************/
+void KVS_SIM_PowerCycle(void)
+{
+	sim_power_lost = 0;
+	sim_ops_left = 0;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the operation counters since the last
+*              KVS_SIM_Reset().
+*
+* @param       pErases          Number of page erases.
+* @param       pPrograms        Number of double word programs.
+******************************************************************************/
+void KVS_SIM_GetCounters(uint32_t *pErases, uint32_t *pPrograms)
+{
+	*pErases = sim_erases;
+	*pPrograms = sim_programs;
+}
+
+/**************************************************************************//**
+* @brief       Erases one simulated page.
+******************************************************************************/
+static KVS_STATUS KVS_SIM_ErasePage(uint32_t PageIndex)
+{
+	uint8_t *page = &sim_flash[PageIndex * KVS_SIM_PAGE_SIZE];
+
+	if((PageIndex >= KVS_SIM_PAGES) || (sim_power_lost != 0))
+	{
+		return KVS_STATUS_ERROR;
+	}
+
+	if(KVS_SIM_ConsumeOperation() == 0)
+	{
+		memset(page, 0xFF, KVS_SIM_PAGE_SIZE / 2U);
+		return KVS_STATUS_ERROR;
+	}
+
+	memset(page, 0xFF, KVS_SIM_PAGE_SIZE);
+	sim_erases++;
+
+	return KVS_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       Programs one simulated double word.
+******************************************************************************/
+static KVS_STATUS KVS_SIM_Program(uint32_t Offset, uint64_t Data)
+{
+	uint64_t current;
+
+	if(((Offset & 0x7U) != 0) || (Offset >= sizeof(sim_flash)) || (sim_power_lost != 0))
+	{
+		return KVS_STATUS_ERROR;
+	}
+
+	memcpy(&current, &sim_flash[Offset], sizeof(current));
+
+	/* PROGERR: the target must be erased unless all zeros are written */
+	if((current != 0xFFFFFFFFFFFFFFFFULL) && (Data != 0))
+	{
+		return KVS_STATUS_ERROR;
+	}
+
+	if(KVS_SIM_ConsumeOperation() == 0)
+	{
+		memcpy(&sim_flash[Offset], &Data, 4U);
+		return KVS_STATUS_ERROR;
+	}
+
+	memcpy(&sim_flash[Offset], &Data, sizeof(Data));
+	sim_programs++;
+
+	return KVS_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       Counts down the armed power loss. Returns 0 for the torn
+*              operation.
+******************************************************************************/
+static uint8_t KVS_SIM_ConsumeOperation(void)
+{
+	if(sim_ops_left == 0)
+	{
+		return 1;
+	}
+
+	sim_ops_left--;
+	if(sim_ops_left == 0)
+	{
+		sim_power_lost = 1;
+		return 0;
+	}
+
+	return 1;
+}
+
+#endif /* KVS_HOST_SIM */
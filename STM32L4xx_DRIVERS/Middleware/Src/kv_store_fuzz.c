@@ -0,0 +1,363 @@
+/**************************************************************************//**
+ * @file    kv_store_fuzz.c
+ * @brief   This file contains the power-cut fuzzer and the benchmark of the
+ *          key-value store, run on the host flash simulator.
+ *
+ * This file has 6 functions definitions (input parameters omitted):
+ *      <br>1) main()                   - Runs the fuzzer, then the benchmark. </br>
+ *      <br>2) KVS_FUZZ_Trial()         - Runs a workload until an armed power loss. </br>
+ *      <br>3) KVS_FUZZ_Verify()        - Compares the remounted store with the model. </br>
+ *      <br>4) KVS_FUZZ_Operation()     - Writes or deletes a random key. </br>
+ *      <br>5) KVS_FUZZ_Bench()         - Measures the write and garbage collection cost. </br>
+ *      <br>6) KVS_FUZZ_Random()        - Returns the next pseudo random number. </br>
+ *
+ * Every trial formats the simulated part, arms a power loss after a random
+ * number of flash operations and runs random writes and deletes until the
+ * power is lost, so the loss lands in a write, in a tombstone or in the
+ * garbage collection. After the power cycle the store is mounted again:
+ * every key must hold the last value acknowledged, except the key of the
+ * interrupted operation which may hold its old or its new value. The store
+ * must then accept a new write of that key.
+ *
+ * The benchmark runs a fixed workload that wraps the ring several times and
+ * reports the flash cost per write and per garbage collected page. Output,
+ * in the format of Tools/host_sim.py which builds and runs this file:
+ *      PASS <name>
+ *      FAIL <name>: <reason>
+ *      BENCH <name> <metric>=<n>... ns=<n>
+ *
+ * Build it together with kv_store.c and kv_store_flash_sim.c:
+ *      gcc -DKVS_HOST_SIM -IMiddleware/Inc Middleware/Src/kv_store.c
+ *          Middleware/Src/kv_store_flash_sim.c Middleware/Src/kv_store_fuzz.c
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+#ifdef KVS_HOST_SIM
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <kv_store.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/** @name Fuzzer and benchmark sizing. Can be overridden from the compiler
+ *  command line.
+ */
+///@{
+#ifndef KVS_FUZZ_TRIALS
+#define	KVS_FUZZ_TRIALS			(2000UL)	/**< Power losses tried */
+#endif
+
+#ifndef KVS_FUZZ_SEED
+#define	KVS_FUZZ_SEED			(0x2545F491UL)
+#endif
+
+#define	KVS_FUZZ_KEYS			(120U)		/**< Keys 1 to KVS_FUZZ_KEYS */
+#define	KVS_FUZZ_MAX_LENGTH		(64U)		/**< Value sizes 1 to this */
+#define	KVS_FUZZ_MAX_CUT		(4000UL)	/**< Flash operations before the loss */
+#define	KVS_FUZZ_BENCH_WRITES		(5000UL)
+///@}
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef struct  /**< Value of a key the store must return */
+{
+  uint8_t       Present;
+  uint32_t      Length;
+  uint8_t       Value[KVS_FUZZ_MAX_LENGTH];
+}KVS_FUZZ_Value_t;
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static uint32_t fuzz_random = KVS_FUZZ_SEED;
+static KVS_FUZZ_Value_t fuzz_model[KVS_FUZZ_KEYS + 1U];
+static char fuzz_failure[256];
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static uint8_t KVS_FUZZ_Trial(uint32_t Trial);
+static uint8_t KVS_FUZZ_Verify(uint16_t Key, const KVS_FUZZ_Value_t *pNew);
+static KVS_STATUS KVS_FUZZ_Operation(uint16_t *pKey, KVS_FUZZ_Value_t *pNew);
+static void KVS_FUZZ_Bench(void);
+static uint32_t KVS_FUZZ_Random(void);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+int main(void)
+{
+	uint32_t trial;
+	uint8_t passed = 1;
+
+	for(trial = 0; (trial < KVS_FUZZ_TRIALS) && (passed != 0); trial++)
+	{
+		passed = KVS_FUZZ_Trial(trial);
+	}
+
+	if(passed != 0)
+	{
+		printf("PASS kvs_power_cut\n");
+	}
+	else
+	{
+		printf("FAIL kvs_power_cut: %s\n", fuzz_failure);
+	}
+
+	KVS_FUZZ_Bench();
+
+	return (passed != 0) ? 0 : 1;
+}
+
+/**************************************************************************//**
+* @brief       Formats the part, arms a power loss and runs random operations
+*              until it happens, then remounts and checks the store.
+*
+* @param       Trial            Trial number, for the failure message.
+*
+* @return      1 if the store survived the power loss.
+******************************************************************************/
+static uint8_t KVS_FUZZ_Trial(uint32_t Trial)
+{
+	KVS_FUZZ_Value_t value;
+	KVS_STATUS status;
+	uint32_t cut;
+	uint16_t key = 0;
+
+	KVS_SIM_Reset();
+	memset(fuzz_model, 0, sizeof(fuzz_model));
+
+	if(KVS_Format(KVS_GetFlashOps()) != KVS_STATUS_OK)
+	{
+		snprintf(fuzz_failure, sizeof(fuzz_failure), "trial %lu: format failed", (unsigned long)Trial);
+		return 0;
+	}
+
+	cut = 1U + (KVS_FUZZ_Random() % KVS_FUZZ_MAX_CUT);
+	KVS_SIM_SetPowerCut(cut);
+
+	while(KVS_SIM_PowerLost() == 0)
+	{
+		status = KVS_FUZZ_Operation(&key, &value);
+		if(KVS_SIM_PowerLost() != 0)
+		{
+			break;
+		}
+		if(status != KVS_STATUS_OK)
+		{
+			snprintf(fuzz_failure, sizeof(fuzz_failure), "trial %lu: key %u operation failed with %d before the loss",
+			         (unsigned long)Trial, (unsigned)key, (int)status);
+			return 0;
+		}
+		fuzz_model[key] = value;
+	}
+
+	KVS_SIM_PowerCycle();
+
+	if(KVS_Mount(KVS_GetFlashOps()) != KVS_STATUS_OK)
+	{
+		snprintf(fuzz_failure, sizeof(fuzz_failure), "trial %lu: mount failed after a loss at operation %lu",
+		         (unsigned long)Trial, (unsigned long)cut);
+		return 0;
+	}
+
+	if(KVS_FUZZ_Verify(key, &value) == 0)
+	{
+		size_t used = strlen(fuzz_failure);
+
+		snprintf(&fuzz_failure[used], sizeof(fuzz_failure) - used, " (trial %lu, loss at operation %lu)",
+		         (unsigned long)Trial, (unsigned long)cut);
+		return 0;
+	}
+
+	/* The interrupted key is writable again */
+	value.Present = 1;
+	value.Length = 1;
+	value.Value[0] = (uint8_t)Trial;
+	fuzz_model[key] = value;
+	if((KVS_Write(key, value.Value, value.Length) != KVS_STATUS_OK) || (KVS_FUZZ_Verify(0, 0) == 0))
+	{
+		snprintf(fuzz_failure, sizeof(fuzz_failure), "trial %lu: key %u not writable after the loss",
+		         (unsigned long)Trial, (unsigned)key);
+		return 0;
+	}
+
+	return 1;
+}
+
+/**************************************************************************//**
+* @brief       Reads every key of the remounted store and compares it with
+*              the model. Key may also hold the value of the interrupted
+*              operation, pNew, which then becomes the model.
+*
+* @param       Key              Key of the interrupted operation, 0 if none.
+* @param       pNew             Value of the interrupted operation.
+*
+* @return      1 if every key matches.
+******************************************************************************/
+static uint8_t KVS_FUZZ_Verify(uint16_t Key, const KVS_FUZZ_Value_t *pNew)
+{
+	uint8_t buffer[KVS_MAX_VALUE_SIZE];
+	uint32_t length;
+	KVS_STATUS status;
+	uint16_t key;
+	uint8_t kept;
+	uint8_t pending;
+
+	for(key = 1; key <= KVS_FUZZ_KEYS; key++)
+	{
+		length = 0;
+		status = KVS_Read(key, buffer, sizeof(buffer), &length);
+		if((status != KVS_STATUS_OK) && (status != KVS_STATUS_NOT_FOUND))
+		{
+			snprintf(fuzz_failure, sizeof(fuzz_failure), "key %u read failed with %d", (unsigned)key, (int)status);
+			return 0;
+		}
+
+		kept = (fuzz_model[key].Present != 0) ?
+		      ((status == KVS_STATUS_OK) && (length == fuzz_model[key].Length) &&
+		       (memcmp(buffer, fuzz_model[key].Value, length) == 0)) :
+		      (status == KVS_STATUS_NOT_FOUND);
+
+		pending = 0;
+		if((key == Key) && (kept == 0))
+		{
+			pending = (pNew->Present != 0) ?
+			      ((status == KVS_STATUS_OK) && (length == pNew->Length) && (memcmp(buffer, pNew->Value, length) == 0)) :
+			      (status == KVS_STATUS_NOT_FOUND);
+			if(pending != 0)
+			{
+				fuzz_model[key] = *pNew;
+			}
+		}
+
+		if((kept == 0) && (pending == 0))
+		{
+			snprintf(fuzz_failure, sizeof(fuzz_failure), "key %u %s after the loss", (unsigned)key,
+			         (status == KVS_STATUS_NOT_FOUND) ? "lost" : "holds a wrong value");
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/**************************************************************************//**
+* @brief       Writes a random value to a random key, or deletes it one time
+*              out of five when the model holds it.
+*
+* @param       pKey             Returns the key.
+* @param       pNew             Returns the value the key has if the
+*                               operation completes.
+*
+* @return      Status of the store call.
+******************************************************************************/
+static KVS_STATUS KVS_FUZZ_Operation(uint16_t *pKey, KVS_FUZZ_Value_t *pNew)
+{
+	uint32_t index;
+
+	*pKey = (uint16_t)(1U + (KVS_FUZZ_Random() % KVS_FUZZ_KEYS));
+
+	if(((KVS_FUZZ_Random() % 5U) == 0) && (fuzz_model[*pKey].Present != 0))
+	{
+		pNew->Present = 0;
+		pNew->Length = 0;
+		return KVS_Delete(*pKey);
+	}
+
+	pNew->Present = 1;
+	pNew->Length = 1U + (KVS_FUZZ_Random() % KVS_FUZZ_MAX_LENGTH);
+	for(index = 0; index < pNew->Length; index++)
+	{
+		pNew->Value[index] = (uint8_t)KVS_FUZZ_Random();
+	}
+
+	return KVS_Write(*pKey, pNew->Value, pNew->Length);
+}
+
+/**************************************************************************//**
+* @brief       Runs KVS_FUZZ_BENCH_WRITES random operations on a formatted
+*              part and prints the flash programs and erases per operation,
+*              and the bytes copied per garbage collected page.
+******************************************************************************/
+static void KVS_FUZZ_Bench(void)
+{
+	KVS_FUZZ_Value_t value;
+	KVS_Stats_t stats;
+	struct timespec start;
+	struct timespec end;
+	uint32_t erases;
+	uint32_t programs;
+	uint32_t format_erases;
+	uint32_t format_programs;
+	uint32_t call;
+	uint16_t key;
+	double ns;
+
+	fuzz_random = KVS_FUZZ_SEED;
+	memset(fuzz_model, 0, sizeof(fuzz_model));
+	KVS_SIM_Reset();
+	(void)KVS_Format(KVS_GetFlashOps());
+	KVS_SIM_GetCounters(&format_erases, &format_programs);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(call = 0; call < KVS_FUZZ_BENCH_WRITES; call++)
+	{
+		if(KVS_FUZZ_Operation(&key, &value) == KVS_STATUS_OK)
+		{
+			fuzz_model[key] = value;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	KVS_SIM_GetCounters(&erases, &programs);
+	erases -= format_erases;
+	programs -= format_programs;
+	(void)KVS_GetStats(&stats);
+	ns = ((double)(end.tv_sec - start.tv_sec) * 1e9) + (double)(end.tv_nsec - start.tv_nsec);
+
+	printf("BENCH KVS_Write programs=%.2f erases=%.4f ns=%.0f\n", (double)programs / KVS_FUZZ_BENCH_WRITES,
+	       (double)erases / KVS_FUZZ_BENCH_WRITES, ns / KVS_FUZZ_BENCH_WRITES);
+	printf("BENCH KVS_GC copied=%.2f runs=%.2f ns=0\n",
+	       (stats.GCRuns != 0) ? ((double)stats.GCCopiedBytes / stats.GCRuns) : 0.0,
+	       ((double)stats.GCRuns * 1000.0) / KVS_FUZZ_BENCH_WRITES);
+}
+
+/**************************************************************************//**
+* @brief       Returns the next number of a xorshift32 sequence, the same on
+*              every run.
+******************************************************************************/
+static uint32_t KVS_FUZZ_Random(void)
+{
+	fuzz_random ^= fuzz_random << 13;
+	fuzz_random ^= fuzz_random >> 17;
+	fuzz_random ^= fuzz_random << 5;
+
+	return fuzz_random;
+}
+
+#endif /* KVS_HOST_SIM */
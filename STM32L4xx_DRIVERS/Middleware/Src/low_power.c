@@ -0,0 +1,715 @@
+/**************************************************************************//**
+ * @file    low_power.c
+ * @brief   This file contains the low-power mode manager for the STM32L475VG
+ *          microcontroller.
+ *
+ * This file has 15 functions definitions (input parameters omitted):
+ *      <br>1) LPM_Init()                   - Initializes the manager and its tables. </br>
+ *      <br>2) LPM_SetAllowedModes()        - Selects the modes the application accepts. </br>
+ *      <br>3) LPM_SetHardwareLatency()     - Overrides the hardware wakeup time of a mode. </br>
+ *      <br>4) LPM_SetProbePin()            - Selects a pin raised on every wakeup. </br>
+ *      <br>5) LPM_EnableWakeupLine()       - Enables an EXTI line as wakeup source. </br>
+ *      <br>6) LPM_EnableWakeupPin()        - Enables a WKUP pin for Standby/Shutdown. </br>
+ *      <br>7) LPM_Enter()                  - Enters a mode and restores the clocks. </br>
+ *      <br>8) LPM_SelectDeepestMode()      - Deepest allowed mode within a deadline. </br>
+ *      <br>9) LPM_EnterDeepest()           - Selects and enters the deepest mode. </br>
+ *      <br>10) LPM_GetStats()              - Returns the statistics of a mode. </br>
+ *      <br>11) LPM_EnterLowPowerRun()      - Drops to MSI <= 2 MHz, Range 2 and LPR. </br>
+ *      <br>12) LPM_ExitLowPowerRun()       - Returns to the regulator and clocks of before. </br>
+ *      <br>13) LPM_EnterLowPowerSleep()    - Sleeps with the regulator in low-power mode. </br>
+ *      <br>14) LPM_RunWithFlashOff()       - Runs a RAM function with the flash powered down. </br>
+ *      <br>15) LPM_SetStopHooks()          - Functions called around every Stop mode. </br>
+ *
+ * The wakeup latency of a mode has two parts:
+ *      <br>1) Hardware: from the wakeup event to the first instruction. The
+ *             CPU is not running, so it cannot time it. The table starts with
+ *             typical datasheet values; measure them on the board with the
+ *             probe pin (wakeup edge to pin edge, minus ResumeLastNs) and set
+ *             them with LPM_SetHardwareLatency(). </br>
+ *      <br>2) Software: from the first instruction to the clocks running as
+ *             before the entry (oscillators and PLL lock). Measured on every
+ *             wakeup with DWT_CYCCNT at the wakeup clock. </br>
+ *
+ * LPM_Enter() sleeps with PRIMASK set. The interrupt that woke the device is
+ * only served once the clocks and the timebase are restored, so its handler
+ * never runs at the wakeup clock.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+#include <stm32l475xx_pwr_driver.h>
+#include <stm32l475xx_rcc_driver.h>
+#include <stm32l475xx_flash_driver.h>
+
+/* Here go the own includes */
+#include <low_power.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	LPM_SLEEP_WAKEUP_CYCLES		(6UL)		/* Sleep wakeup, in CPU cycles */
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/* Typical wakeup times to Run mode from flash, Range 1 (STM32L475xx datasheet,
+ * low-power mode wakeup timings). Sleep is computed from the CPU clock. */
+static const uint32_t lpm_default_hw_ns[LPM_MODE_COUNT] =
+{
+  0UL,          /* Sleep */
+  4100UL,       /* Stop 0 */
+  6300UL,       /* Stop 1 */
+  8400UL,       /* Stop 2 */
+  14300UL,      /* Standby, followed by the reset sequence */
+  256000UL      /* Shutdown, followed by the reset sequence */
+};
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static LPM_Stats_t lpm_stats[LPM_MODE_COUNT];
+static uint32_t lpm_allowed = LPM_MODES_RETAINING_RAM;
+static GPIO_RegDef_t *lpm_probe_port = 0;
+static uint8_t lpm_probe_pin = 0;
+static uint32_t lpm_saved_cr = 0;
+static uint32_t lpm_saved_cfgr = 0;
+static uint32_t lpm_lprun_cr = 0;
+static uint32_t lpm_lprun_cfgr = 0;
+static uint32_t lpm_lprun_vos = 0;
+static uint32_t lpm_lprun_latency = 0;
+static void (*lpm_stop_enter)(void) = 0;
+static void (*lpm_stop_exit)(void) = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static void LPM_SaveClocks(void);
+static void LPM_RestoreClocks(uint32_t SavedCr, uint32_t SavedCfgr);
+static LPM_STATUS LPM_RestoreRun(void);
+static void LPM_UpdateStats(uint8_t Mode, uint32_t EntryCycles, uint32_t ResumeNs);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function enables the PWR clock and the cycle counter and
+*              loads the default latency table. Only the modes that keep the
+*              RAM are allowed until LPM_SetAllowedModes() says otherwise.
+******************************************************************************/
+void LPM_Init(void)
+{
+	uint8_t mode;
+
+	PWR_PCLK_EN();
+
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	for(mode = 0; mode < LPM_MODE_COUNT; mode++)
+	{
+		lpm_stats[mode].Entries = 0;
+		lpm_stats[mode].EntryCycles = 0;
+		lpm_stats[mode].ResumeMinNs = 0xFFFFFFFFUL;
+		lpm_stats[mode].ResumeMaxNs = 0;
+		lpm_stats[mode].ResumeLastNs = 0;
+		lpm_stats[mode].HardwareNs = lpm_default_hw_ns[mode];
+		lpm_stats[mode].WorstLatencyNs = lpm_default_hw_ns[mode];
+	}
+
+	lpm_allowed = LPM_MODES_RETAINING_RAM;
+
+	PWR_ClearWakeupFlags();
+}
+
+/**************************************************************************//**
+* @brief       This function selects the modes LPM_SelectDeepestMode() may
+*              return. Standby and Shutdown lose SRAM1 and end in a reset.
+*
+* @param       ModeMask         OR of LPM_MODE_MASK(LPM_MODE_xxx).
+******************************************************************************/
+void LPM_SetAllowedModes(uint32_t ModeMask)
+{
+	lpm_allowed = ModeMask;
+}
+
+/**************************************************************************//**
+* @brief       This function replaces the hardware wakeup time of a mode with
+*              a value measured on the board.
+*
+* @param       Mode             LPM_MODE_xxx.
+* @param       LatencyNs        Wakeup event to first instruction, in ns.
+*
+* @return      LPM_STATUS_OK or LPM_STATUS_ERROR
+******************************************************************************/
+LPM_STATUS LPM_SetHardwareLatency(uint8_t Mode, uint32_t LatencyNs)
+{
+	if(Mode >= LPM_MODE_COUNT)
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	lpm_stats[Mode].HardwareNs = LatencyNs;
+	lpm_stats[Mode].WorstLatencyNs = LatencyNs + lpm_stats[Mode].ResumeMaxNs;
+
+	return LPM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function selects an output pin that is cleared before the
+*              entry and set right before the waking interrupt is served,
+*              after the clock restoration and the stop hooks. The delay from
+*              the wakeup event to the pin edge is the full response latency;
+*              minus ResumeLastNs of the mode it is the hardware latency. The
+*              pin must be configured as output by the application.
+*
+* @param       pGPIOx           GPIO port, 0 to disable the probe.
+* @param       PinNumber        Pin of the port.
+******************************************************************************/
+void LPM_SetProbePin(GPIO_RegDef_t *pGPIOx, uint8_t PinNumber)
+{
+	lpm_probe_port = pGPIOx;
+	lpm_probe_pin = PinNumber;
+}
+
+/**************************************************************************//**
+* @brief       This function unmasks an EXTI line so its event wakes the
+*              device from Sleep and Stop modes. GPIO lines (0 to 15) get their
+*              edge from GPIO_Init, the RTC lines need a rising edge.
+*
+* @param       ExtiLine         EXTI line, 0 to 40.
+* @param       Edge             LPM_EDGE_xxx, only for lines 0 to 22.
+* @param       Enabler          ENABLE or DISABLE.
+*
+* @return      LPM_STATUS_OK or LPM_STATUS_ERROR
+******************************************************************************/
+LPM_STATUS LPM_EnableWakeupLine(uint8_t ExtiLine, uint8_t Edge, uint8_t Enabler)
+{
+	__vo uint32_t *imr;
+	uint8_t bit;
+
+	if(ExtiLine > LPM_EXTI_LINE_MAX)
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	if(ExtiLine < 32U)
+	{
+		imr = &EXTI->EXTI_IMR1;
+		bit = ExtiLine;
+	}
+	else
+	{
+		imr = &EXTI->EXTI_IMR2;
+		bit = (uint8_t)(ExtiLine - 32U);
+	}
+
+	if((Edge != LPM_EDGE_KEEP) && (ExtiLine <= 22U))
+	{
+		CLR_REG_BIT(EXTI->EXTI_RTSR1, ExtiLine);
+		CLR_REG_BIT(EXTI->EXTI_FTSR1, ExtiLine);
+
+		if((Edge == LPM_EDGE_RISING) || (Edge == LPM_EDGE_BOTH))
+		{
+			SET_REG_BIT(EXTI->EXTI_RTSR1, ExtiLine);
+		}
+		if((Edge == LPM_EDGE_FALLING) || (Edge == LPM_EDGE_BOTH))
+		{
+			SET_REG_BIT(EXTI->EXTI_FTSR1, ExtiLine);
+		}
+	}
+
+	if(Enabler == ENABLE)
+	{
+		SET_REG_BIT(*imr, bit);
+	}
+	else
+	{
+		CLR_REG_BIT(*imr, bit);
+	}
+
+	return LPM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function enables a WKUP pin, the only GPIO wakeup source
+*              of Standby and Shutdown modes.
+*
+* @param       WakeupPin        PWR_WAKEUP_PIN1 to PWR_WAKEUP_PIN5.
+* @param       Polarity         PWR_WAKEUP_RISING or PWR_WAKEUP_FALLING.
+* @param       Enabler          ENABLE or DISABLE.
+*
+* @return      LPM_STATUS_OK or LPM_STATUS_ERROR
+******************************************************************************/
+LPM_STATUS LPM_EnableWakeupPin(uint8_t WakeupPin, uint8_t Polarity, uint8_t Enabler)
+{
+	if(PWR_ConfigWakeupPin(WakeupPin, Polarity, Enabler) != PWR_STATUS_OK)
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	return LPM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function enters a low-power mode and, for the Stop modes,
+*              brings the oscillators, the PLL and the system clock switch
+*              back to their state before the entry. Interrupts are masked
+*              over the whole sleep: an enabled interrupt still wakes the
+*              device, and is taken when the PRIMASK of the caller is
+*              restored, after the clocks and the stop hooks. Standby and
+*              Shutdown do not return; when their entry is refused (wakeup
+*              flag or pending interrupt) the device enters Stop 2 instead
+*              and LPM_STATUS_ERROR is returned after the wakeup.
+*
+* @param       Mode             LPM_MODE_xxx.
+*
+* @return      LPM_STATUS_OK or LPM_STATUS_ERROR
+******************************************************************************/
+LPM_STATUS LPM_Enter(uint8_t Mode)
+{
+	uint32_t start;
+	uint32_t entry_cycles;
+	uint32_t resume_cycles;
+	uint32_t wake_clock;
+	uint32_t primask;
+	LPM_STATUS status = LPM_STATUS_OK;
+
+	if(Mode >= LPM_MODE_COUNT)
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	/* The waking interrupt must not run before the clocks are back */
+	primask = __get_PRIMASK();
+	__disable_irq();
+	start = *DWT_CYCCNT;
+
+	if(lpm_probe_port != 0)
+	{
+		GPIO_WritePin(lpm_probe_port, lpm_probe_pin, GPIO_PIN_RESET);
+	}
+
+	if(Mode >= LPM_MODE_STANDBY)
+	{
+		lpm_stats[Mode].Entries++;
+		if(Mode == LPM_MODE_STANDBY)
+		{
+			(void)PWR_EnterStandbyMode();
+		}
+		else
+		{
+			(void)PWR_EnterShutdownMode();
+		}
+
+		/* Entry refused, still sleep rather than return straight away */
+		Mode = LPM_MODE_STOP2;
+		status = LPM_STATUS_ERROR;
+	}
+
+	switch(Mode)
+	{
+		case LPM_MODE_SLEEP:
+			entry_cycles = *DWT_CYCCNT - start;
+			PWR_EnterSleepMode(PWR_ENTRY_WFI);
+			start = *DWT_CYCCNT;
+			break;
+
+		case LPM_MODE_STOP0:
+		case LPM_MODE_STOP1:
+		default:
+			if(lpm_stop_enter != 0)
+			{
+				lpm_stop_enter();
+			}
+			LPM_SaveClocks();
+			entry_cycles = *DWT_CYCCNT - start;
+			if(READ_REG_BIT(PWR->PWR_CR1, PWR_CR1_LPR) != 0)
+			{
+				/* Stop 1 is the only Stop mode reachable from Low-power run */
+				Mode = LPM_MODE_STOP1;
+			}
+			(void)PWR_EnterStopMode((uint32_t)(Mode - LPM_MODE_STOP0), PWR_ENTRY_WFI);
+			start = *DWT_CYCCNT;
+			break;
+	}
+
+	/* Count the restoration at the clock the device woke up with */
+	wake_clock = RCC_GetHCLK();
+	if(Mode != LPM_MODE_SLEEP)
+	{
+		LPM_RestoreClocks(lpm_saved_cr, lpm_saved_cfgr);
+	}
+	resume_cycles = *DWT_CYCCNT - start;
+
+	if((Mode != LPM_MODE_SLEEP) && (lpm_stop_exit != 0))
+	{
+		lpm_stop_exit();
+	}
+
+	if(lpm_probe_port != 0)
+	{
+		GPIO_WritePin(lpm_probe_port, lpm_probe_pin, GPIO_PIN_SET);
+	}
+
+	__set_PRIMASK(primask);
+
+	if(wake_clock == 0)
+	{
+		wake_clock = 1;
+	}
+
+	LPM_UpdateStats(Mode, entry_cycles, (uint32_t)(((uint64_t)resume_cycles * 1000000000ULL) / wake_clock));
+
+	return status;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the deepest allowed mode whose worst
+*              wakeup latency (hardware plus measured clock restoration) is
+*              within the deadline.
+*
+* @param       DeadlineNs       Maximum response time to a wakeup event.
+*
+* @return      LPM_MODE_xxx or LPM_MODE_NONE
+******************************************************************************/
+uint8_t LPM_SelectDeepestMode(uint32_t DeadlineNs)
+{
+	uint32_t hclk = RCC_GetHCLK();
+	uint8_t mode;
+
+	for(mode = LPM_MODE_COUNT; mode > 0U; mode--)
+	{
+		uint8_t candidate = (uint8_t)(mode - 1U);
+		uint32_t latency = lpm_stats[candidate].WorstLatencyNs;
+
+		if((lpm_allowed & LPM_MODE_MASK(candidate)) == 0)
+		{
+			continue;
+		}
+
+		if((candidate == LPM_MODE_SLEEP) && (hclk != 0))
+		{
+			latency += (uint32_t)((LPM_SLEEP_WAKEUP_CYCLES * 1000000000ULL) / hclk);
+		}
+
+		if(latency <= DeadlineNs)
+		{
+			return candidate;
+		}
+	}
+
+	return LPM_MODE_NONE;
+}
+
+/**************************************************************************//**
+* @brief       This function enters the deepest mode that meets the deadline.
+*              If none does, it returns without sleeping.
+*
+* @param       DeadlineNs       Maximum response time to a wakeup event.
+*
+* @return      LPM_STATUS_OK or LPM_STATUS_ERROR
+******************************************************************************/
+LPM_STATUS LPM_EnterDeepest(uint32_t DeadlineNs)
+{
+	uint8_t mode = LPM_SelectDeepestMode(DeadlineNs);
+
+	if(mode == LPM_MODE_NONE)
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	return LPM_Enter(mode);
+}
+
+/**************************************************************************//**
+* @brief       This function returns the statistics of a mode.
+*
+* @param       Mode             LPM_MODE_xxx.
+* @param       pStats           Structure to fill.
+*
+* @return      LPM_STATUS_OK or LPM_STATUS_ERROR
+******************************************************************************/
+LPM_STATUS LPM_GetStats(uint8_t Mode, LPM_Stats_t *pStats)
+{
+	if(Mode >= LPM_MODE_COUNT)
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	*pStats = lpm_stats[Mode];
+	if(pStats->ResumeMinNs > pStats->ResumeMaxNs)
+	{
+		pStats->ResumeMinNs = 0;
+	}
+
+	return LPM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function enters Low-power run mode: the system clock is
+*              switched to MSI at 2 MHz or less, the PLL is stopped, the core
+*              goes to voltage Range 2 and the regulator to low-power mode.
+*              The previous clocks, range and flash latency are saved for
+*              LPM_ExitLowPowerRun(), and restored before an error return
+*              once the clocks have been touched.
+*
+* @param       MSIspeed         RCC_MSISPEED_100K to RCC_MSISPEED_2M.
+*
+* @return      LPM_STATUS_OK, or LPM_STATUS_ERROR for a range above 2 MHz,
+*              if the device already is in Low-power run mode or if a step
+*              failed (the device is back in Run mode as before).
+******************************************************************************/
+LPM_STATUS LPM_EnterLowPowerRun(uint32_t MSIspeed)
+{
+	uint32_t trim;
+
+	if((MSIspeed > RCC_MSISPEED_2M) || (READ_REG_BIT(PWR->PWR_CR1, PWR_CR1_LPR) != 0))
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	/* Checked before the clocks are touched */
+	if(RCC_GetMSIfreq(MSIspeed) > PWR_LPRUN_MAX_FREQUENCY)
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	lpm_lprun_cr = RCC->RCC_CR;
+	lpm_lprun_cfgr = RCC->RCC_CFGR;
+	lpm_lprun_vos = (PWR->PWR_CR1 >> PWR_CR1_VOS) & 0x3UL;
+	lpm_lprun_latency = FLASH->FLASH_ACR & 0x7UL;
+
+	/* Keep the current MSI trimming */
+	trim = (RCC->RCC_ICSCR >> 8) & 0xFFUL;
+	if(RCC_Config_MSI(MSIspeed, trim, RCC_AHBPRESCALER_DIV1) != RCC_STATUS_OK)
+	{
+		(void)LPM_RestoreRun();
+		return LPM_STATUS_ERROR;
+	}
+
+	/* The PLL cannot run in Low-power run mode */
+	CLR_REG_BIT(RCC->RCC_CR, RCC_CR_PLLON);
+	while(READ_REG_BIT(RCC->RCC_CR, RCC_CR_PLLRDY) != 0);
+
+	if((PWR_ControlVoltageScaling(PWR_VOLTAGE_RANGE_2) != PWR_STATUS_OK) ||
+	   (PWR_EnableLowPowerRun() != PWR_STATUS_OK))
+	{
+		(void)LPM_RestoreRun();
+		return LPM_STATUS_ERROR;
+	}
+
+	return LPM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function leaves Low-power run mode: the regulator goes back
+*              to main mode, then the voltage range, the flash latency and the
+*              clocks saved by LPM_EnterLowPowerRun() are restored, in the
+*              order that keeps every step legal.
+*
+* @return      LPM_STATUS_OK or LPM_STATUS_ERROR
+******************************************************************************/
+LPM_STATUS LPM_ExitLowPowerRun(void)
+{
+	if(READ_REG_BIT(PWR->PWR_CR1, PWR_CR1_LPR) == 0)
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	PWR_DisableLowPowerRun();
+
+	return LPM_RestoreRun();
+}
+
+/**************************************************************************//**
+* @brief       This function enters Low-power sleep mode: Sleep mode entered
+*              from Low-power run mode. The flash can be powered down as well,
+*              which lengthens the wakeup by the flash power-up time.
+*
+* @param       FlashPowerDown   ENABLE or DISABLE.
+*
+* @return      LPM_STATUS_OK, or LPM_STATUS_ERROR if not in Low-power run mode.
+******************************************************************************/
+LPM_STATUS LPM_EnterLowPowerSleep(uint8_t FlashPowerDown)
+{
+	if(READ_REG_BIT(PWR->PWR_CR1, PWR_CR1_LPR) == 0)
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	FLASH_SetSleepPowerDown(FlashPowerDown);
+	PWR_EnterSleepMode(PWR_ENTRY_WFI);
+	FLASH_SetSleepPowerDown(DISABLE);
+
+	return LPM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function powers the flash down, calls a function placed in
+*              SRAM (__RAMFUNC) and powers the flash up again. Meant for the
+*              background loop of Low-power run mode. Interrupts must be masked
+*              or served from SRAM, with the vector table in SRAM too.
+*
+* @param       pRamFunc         Function to run, must not touch the flash.
+*
+* @return      LPM_STATUS_OK, or LPM_STATUS_ERROR if pRamFunc is in flash.
+******************************************************************************/
+__RAMFUNC LPM_STATUS LPM_RunWithFlashOff(void (*pRamFunc)(void))
+{
+	uint32_t address = (uint32_t)pRamFunc;
+
+	if((address >= FLASH_BASE_ADDRESS) && (address < (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE)))
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	FLASH_SetRunPowerDown(ENABLE);
+	pRamFunc();
+	FLASH_SetRunPowerDown(DISABLE);
+
+	return LPM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function sets the functions LPM_Enter() calls right before
+*              a Stop mode and right after the clocks are restored, for the
+*              modules whose time stands still while the core clock is off.
+*
+* @param       pEnter           Called before the entry, or 0.
+* @param       pExit            Called after the wakeup, or 0.
+******************************************************************************/
+void LPM_SetStopHooks(void (*pEnter)(void), void (*pExit)(void))
+{
+	lpm_stop_enter = pEnter;
+	lpm_stop_exit = pExit;
+}
+
+/**************************************************************************//**
+* @brief       Saves the oscillator enables and the system clock switch.
+******************************************************************************/
+static void LPM_SaveClocks(void)
+{
+	lpm_saved_cr = RCC->RCC_CR;
+	lpm_saved_cfgr = RCC->RCC_CFGR;
+}
+
+/**************************************************************************//**
+* @brief       Turns the saved oscillators and the PLL back on and switches the
+*              system clock back with its MSI range and AHB prescaler. The PLL
+*              configuration is kept by the Stop and Low-power run modes.
+******************************************************************************/
+static void LPM_RestoreClocks(uint32_t SavedCr, uint32_t SavedCfgr)
+{
+	uint32_t sw = (SavedCfgr >> RCC_CFGR_SW) & 0x3UL;
+
+	if(READ_REG_BIT(SavedCr, RCC_CR_MSION) != 0)
+	{
+		SET_REG_BIT(RCC->RCC_CR, RCC_CR_MSION);
+		while(READ_REG_BIT(RCC->RCC_CR, RCC_CR_MSIRDY) == 0);
+
+		/* MSIRANGE may only change while MSI is ready */
+		RCC->RCC_CR = (RCC->RCC_CR & ~0xF0UL) | (SavedCr & 0xF0UL);
+		while(READ_REG_BIT(RCC->RCC_CR, RCC_CR_MSIRDY) == 0);
+	}
+
+	if(READ_REG_BIT(SavedCr, RCC_CR_HSION) != 0)
+	{
+		SET_REG_BIT(RCC->RCC_CR, RCC_CR_HSION);
+		while(READ_REG_BIT(RCC->RCC_CR, RCC_CR_HSIRDY) == 0);
+	}
+
+	if(READ_REG_BIT(SavedCr, RCC_CR_HSEON) != 0)
+	{
+		SET_REG_BIT(RCC->RCC_CR, RCC_CR_HSEON);
+		while(READ_REG_BIT(RCC->RCC_CR, RCC_CR_HSERDY) == 0);
+	}
+
+	if(READ_REG_BIT(SavedCr, RCC_CR_PLLON) != 0)
+	{
+		SET_REG_BIT(RCC->RCC_CR, RCC_CR_PLLON);
+		while(READ_REG_BIT(RCC->RCC_CR, RCC_CR_PLLRDY) == 0);
+	}
+
+	/* AHB prescaler (HPRE) */
+	RCC->RCC_CFGR = (RCC->RCC_CFGR & ~0xF0UL) | (SavedCfgr & 0xF0UL);
+
+	if(((RCC->RCC_CFGR >> RCC_CFGR_SWS) & 0x3UL) != sw)
+	{
+		RCC->RCC_CFGR &= ~(0x3UL << RCC_CFGR_SW);
+		RCC->RCC_CFGR |= (sw << RCC_CFGR_SW);
+		while(((RCC->RCC_CFGR >> RCC_CFGR_SWS) & 0x3UL) != sw);
+	}
+}
+
+/**************************************************************************//**
+* @brief       Brings back the voltage range, the flash latency and the clocks
+*              saved by LPM_EnterLowPowerRun(), with the regulator in main
+*              mode.
+******************************************************************************/
+static LPM_STATUS LPM_RestoreRun(void)
+{
+	if(PWR_ControlVoltageScaling(lpm_lprun_vos) != PWR_STATUS_OK)
+	{
+		return LPM_STATUS_ERROR;
+	}
+
+	/* Wait states first, the frequency goes up afterwards */
+	FLASH->FLASH_ACR = (FLASH->FLASH_ACR & ~0x7UL) | lpm_lprun_latency;
+	while((FLASH->FLASH_ACR & 0x7UL) != lpm_lprun_latency);
+
+	LPM_RestoreClocks(lpm_lprun_cr, lpm_lprun_cfgr);
+	RCC_NotifyClockChange();
+
+	return LPM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       Accounts one wakeup of a mode.
+******************************************************************************/
+static void LPM_UpdateStats(uint8_t Mode, uint32_t EntryCycles, uint32_t ResumeNs)
+{
+	LPM_Stats_t *stats = &lpm_stats[Mode];
+
+	stats->Entries++;
+	stats->ResumeLastNs = ResumeNs;
+
+	if(EntryCycles > stats->EntryCycles)
+	{
+		stats->EntryCycles = EntryCycles;
+	}
+	if(ResumeNs < stats->ResumeMinNs)
+	{
+		stats->ResumeMinNs = ResumeNs;
+	}
+	if(ResumeNs > stats->ResumeMaxNs)
+	{
+		stats->ResumeMaxNs = ResumeNs;
+	}
+
+	stats->WorstLatencyNs = stats->HardwareNs + stats->ResumeMaxNs;
+}
@@ -0,0 +1,227 @@
+/**************************************************************************//**
+ * @file    mem_usage.c
+ * @brief   This file contains the stack and heap high-water instrumentation
+ *          for the STM32L475VG microcontroller.
+ *
+ * This file has 7 functions definitions (input parameters omitted):
+ *      <br>1) MEMU_GetStackUsage()     - Peak and free bytes of the main stack. </br>
+ *      <br>2) MEMU_GetHeapUsage()      - Peak, free and fragmentation of the heap. </br>
+ *      <br>3) MEMU_PaintRegion()       - Fills a stack with MEMU_PAINT_PATTERN. </br>
+ *      <br>4) MEMU_RegionUsed()        - Peak words of a painted stack. </br>
+ *      <br>5) MEMU_Log()               - Writes both usages to the binary logger. </br>
+ *      <br>6) MEMU_PaintStack()        - Paints the free RAM below the stack pointer. </br>
+ *      <br>7) MEMU_HeapBreak()         - Current end of the heap. </br>
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+#include <malloc.h>
+
+/* Here go the project includes */
+#include <binlog.h>
+
+/* Here go the own includes */
+#include <mem_usage.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+/* Left unpainted below the stack pointer by MEMU_PaintStack(), for its own frame */
+#define	MEMU_PAINT_GUARD_BYTES		(64UL)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+
+/* Defined by the linker script, the addresses are the values */
+extern char end[];
+extern char _estack[];
+extern char _Min_Heap_Size[];
+extern char _Min_Stack_Size[];
+
+/* Defined in Startup/startup_stm32l475vgtx.s, 0 after a warm boot */
+extern uint32_t stack_painted;
+
+/* Defined in Src/sysmem.c */
+extern char *sbrk_heap_end;
+extern char *sbrk_heap_peak;
+extern uint32_t sbrk_failures;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static char* MEMU_HeapBreak(void);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function measures the main stack: the painted words above
+*              the heap break that are still intact were never reached.
+*
+* @param [out] pStack       Structure to fill.
+******************************************************************************/
+void MEMU_GetStackUsage(MEMU_Stack_t *pStack)
+{
+	const uint32_t *pWord;
+	const uint32_t *pTop;
+
+	pWord = (const uint32_t*)(((uint32_t)MEMU_HeapBreak() + 3U) & ~3UL);
+	pTop = (const uint32_t*)_estack;
+
+	pStack->Size = (uint32_t)pTop - (uint32_t)pWord;
+	pStack->LinkerSize = (uint32_t)_Min_Stack_Size;
+	pStack->Painted = stack_painted;
+	if(stack_painted == 0)
+	{
+		pStack->Peak = 0;
+		pStack->Free = 0;
+		return;
+	}
+	pStack->Peak = 4U * MEMU_RegionUsed(pWord, pStack->Size / 4U);
+	pStack->Free = pStack->Size - pStack->Peak;
+}
+
+/**************************************************************************//**
+* @brief       This function reads the heap counters of _sbrk() and the free
+*              list of malloc().
+*
+* @param [out] pHeap        Structure to fill.
+******************************************************************************/
+void MEMU_GetHeapUsage(MEMU_Heap_t *pHeap)
+{
+	struct mallinfo info;
+	char *pPeak;
+
+	info = mallinfo();
+
+	pPeak = (sbrk_heap_peak != 0) ? sbrk_heap_peak : end;
+
+	pHeap->Arena = (uint32_t)MEMU_HeapBreak() - (uint32_t)end;
+	pHeap->Peak = (uint32_t)pPeak - (uint32_t)end;
+	pHeap->InUse = (uint32_t)info.uordblks;
+	pHeap->Free = (uint32_t)info.fordblks;
+	pHeap->FreeChunks = (uint32_t)info.ordblks;
+	pHeap->Failures = sbrk_failures;
+	pHeap->LinkerSize = (uint32_t)_Min_Heap_Size;
+	pHeap->FreePermille = (pHeap->Arena == 0) ? 0 : (uint16_t)((pHeap->Free * 1000ULL) / pHeap->Arena);
+	pHeap->Reserved = 0;
+}
+
+/**************************************************************************//**
+* @brief       This function paints a stack before its first use, for
+*              example the stack of a kernel task.
+*
+* @param       pBase        Lowest word of the stack.
+* @param       Words        Size of the stack, in 32-bit words.
+******************************************************************************/
+void MEMU_PaintRegion(uint32_t *pBase, uint32_t Words)
+{
+	while(Words != 0)
+	{
+		*pBase++ = MEMU_PAINT_PATTERN;
+		Words--;
+	}
+}
+
+/**************************************************************************//**
+* @brief       This function finds how deep a painted, descending stack was
+*              used: the words from its base up to the first overwritten one
+*              were never written.
+*
+* @param       pBase        Lowest word of the stack.
+* @param       Words        Size of the stack, in 32-bit words.
+*
+* @return      Words ever used, from the top of the stack.
+******************************************************************************/
+uint32_t MEMU_RegionUsed(const uint32_t *pBase, uint32_t Words)
+{
+	uint32_t untouched = 0;
+
+	while((untouched < Words) && (pBase[untouched] == MEMU_PAINT_PATTERN))
+	{
+		untouched++;
+	}
+
+	return Words - untouched;
+}
+
+/**************************************************************************//**
+* @brief       This function writes the stack and heap usage to the binary
+*              logger, in bytes.
+******************************************************************************/
+void MEMU_Log(void)
+{
+	MEMU_Stack_t stack;
+	MEMU_Heap_t heap;
+
+	MEMU_GetStackUsage(&stack);
+	MEMU_GetHeapUsage(&heap);
+
+	if(stack.Painted != 0)
+	{
+		BLOG("memu stack peak %u free %u linker %u", stack.Peak, stack.Free, stack.LinkerSize);
+	}
+	else
+	{
+		BLOG("memu stack not painted, linker %u", stack.LinkerSize);
+	}
+	BLOG("memu heap arena %u peak %u in use %u free %u chunks %u failures %u linker %u",
+	     heap.Arena, heap.Peak, heap.InUse, heap.Free, heap.FreeChunks, heap.Failures, heap.LinkerSize);
+}
+
+/**************************************************************************//**
+* @brief       This function paints the RAM from the heap break to a little
+*              below the stack pointer, for a stack peak after a warm boot.
+*              The peak found afterwards only covers the stack used since.
+*              Takes about as long as the paint of a cold boot.
+******************************************************************************/
+void MEMU_PaintStack(void)
+{
+	uint32_t base;
+	uint32_t top;
+
+	base = ((uint32_t)MEMU_HeapBreak() + 3U) & ~3UL;
+	top = (__get_MSP() - MEMU_PAINT_GUARD_BYTES) & ~3UL;
+
+	if(top > base)
+	{
+		MEMU_PaintRegion((uint32_t*)base, (top - base) / 4U);
+	}
+	stack_painted = 1;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the end of the heap, end before the
+*              first allocation.
+******************************************************************************/
+static char* MEMU_HeapBreak(void)
+{
+	return (sbrk_heap_end != 0) ? sbrk_heap_end : end;
+}
@@ -0,0 +1,277 @@
+/**************************************************************************//**
+ * @file    profiler.c
+ * @brief   This file contains the cycle profiler of code scopes for the
+ *          STM32L475VG microcontroller.
+ *
+ * This file has 4 functions definitions (input parameters omitted):
+ *      <br>1) PROF_Init()              - Clears the sites and measures the probe cost. </br>
+ *      <br>2) PROF_Record()            - Adds one measurement to a site. </br>
+ *      <br>3) PROF_Reset()             - Clears the measurements of every site. </br>
+ *      <br>4) PROF_Dump()              - Prints the table of sites. </br>
+ *
+ * The sites are initialized data: the linker script gathers them between
+ * _sprof_sites and _eprof_sites inside .data, so the startup gives them
+ * their names and PROF_Dump() finds them without any registration.
+ *
+ * PROF_Dump() formats the text itself, no printf, and hands it line by line
+ * to an output function of the application.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <profiler.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	PROF_LINE_SIZE			(96U)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static uint32_t prof_probe_cycles = 0;          /* Inside the measurement */
+static uint32_t prof_record_cycles = 0;         /* PROF_Record() call, outside it */
+
+/* Defined by the linker script */
+extern PROF_Site_t _sprof_sites[];
+extern PROF_Site_t _eprof_sites[];
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static uint32_t PROF_Append(char *pLine, uint32_t Position, const char *pText, uint32_t Width);
+static uint32_t PROF_AppendNumber(char *pLine, uint32_t Position, uint64_t Value, uint32_t Width);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function enables the cycle counter, clears every site and
+*              times an empty PROF_BEGIN/PROF_END pair with interrupts masked:
+*              the cycles it adds to each measurement, and the cycles of
+*              PROF_Record() that the enclosing scopes see.
+******************************************************************************/
+void PROF_Init(void)
+{
+	uint32_t primask;
+	PROF_Site_t probe = { "probe", 0, 0xFFFFFFFFUL, 0, 0, {0} };
+	uint32_t start;
+	uint32_t record = 0xFFFFFFFFUL;
+	uint32_t cycles;
+	uint8_t run;
+
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	PROF_Reset();
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	/* The first runs fill the flash cache */
+	for(run = 0; run < 4U; run++)
+	{
+		start = *DWT_CYCCNT;
+		PROF_Record(&probe, *DWT_CYCCNT - start);
+		cycles = *DWT_CYCCNT - start;
+		if(cycles < record)
+		{
+			record = cycles;
+		}
+	}
+
+	__set_PRIMASK(primask);
+
+	prof_probe_cycles = probe.MinCycles;
+	prof_record_cycles = record - probe.MinCycles;
+}
+
+/**************************************************************************//**
+* @brief       This function adds one measurement to a site, called by
+*              PROF_END. Callable from any interrupt handler.
+*
+* @param       pSite        Site of the scope.
+* @param       Cycles       Cycles spent in the scope.
+******************************************************************************/
+__RAMFUNC void PROF_Record(PROF_Site_t *pSite, uint32_t Cycles)
+{
+	uint32_t primask;
+	uint32_t bucket = (Cycles == 0) ? 0 : (31U - __CLZ(Cycles));
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	pSite->Count++;
+	pSite->TotalCycles += Cycles;
+	pSite->Histogram[bucket]++;
+	if(Cycles < pSite->MinCycles)
+	{
+		pSite->MinCycles = Cycles;
+	}
+	if(Cycles > pSite->MaxCycles)
+	{
+		pSite->MaxCycles = Cycles;
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function clears the measurements of every site, the names
+*              are kept.
+******************************************************************************/
+void PROF_Reset(void)
+{
+	uint32_t primask;
+	PROF_Site_t *site;
+	uint8_t bucket;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	for(site = _sprof_sites; site < _eprof_sites; site++)
+	{
+		site->Count = 0;
+		site->MinCycles = 0xFFFFFFFFUL;
+		site->MaxCycles = 0;
+		site->TotalCycles = 0;
+		for(bucket = 0; bucket < PROF_BUCKETS; bucket++)
+		{
+			site->Histogram[bucket] = 0;
+		}
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function prints one line per site with its count and its
+*              min, max and mean cycles, followed by the non-empty buckets of
+*              its histogram. Sites never reached are skipped. The table is
+*              read while the probes keep running, a line may mix two states.
+*
+* @param       pOutput      Prints a zero terminated line, '\n' included.
+******************************************************************************/
+void PROF_Dump(void (*pOutput)(const char *pText))
+{
+	char line[PROF_LINE_SIZE];
+	PROF_Site_t *site;
+	uint32_t position;
+	uint8_t bucket;
+
+	position = PROF_Append(line, 0, "probe cost ", 0);
+	position = PROF_AppendNumber(line, position, prof_probe_cycles, 0);
+	position = PROF_Append(line, position, " cycles in, ", 0);
+	position = PROF_AppendNumber(line, position, prof_record_cycles, 0);
+	position = PROF_Append(line, position, " cycles out\n", 0);
+	pOutput(line);
+
+	position = PROF_Append(line, 0, "site", 24);
+	position = PROF_Append(line, position, "count", 11);
+	position = PROF_Append(line, position, "min", 11);
+	position = PROF_Append(line, position, "max", 11);
+	position = PROF_Append(line, position, "mean", 11);
+	position = PROF_Append(line, position, "\n", 0);
+	pOutput(line);
+
+	for(site = _sprof_sites; site < _eprof_sites; site++)
+	{
+		if(site->Count == 0)
+		{
+			continue;
+		}
+
+		position = PROF_Append(line, 0, site->pName, 24);
+		position = PROF_AppendNumber(line, position, site->Count, 11);
+		position = PROF_AppendNumber(line, position, site->MinCycles, 11);
+		position = PROF_AppendNumber(line, position, site->MaxCycles, 11);
+		position = PROF_AppendNumber(line, position, site->TotalCycles / site->Count, 11);
+		position = PROF_Append(line, position, "\n", 0);
+		pOutput(line);
+
+		for(bucket = 0; bucket < PROF_BUCKETS; bucket++)
+		{
+			if(site->Histogram[bucket] == 0)
+			{
+				continue;
+			}
+
+			position = PROF_Append(line, 0, "    < ", 0);
+			position = PROF_AppendNumber(line, position, 2ULL << bucket, 11);
+			position = PROF_AppendNumber(line, position, site->Histogram[bucket], 11);
+			position = PROF_Append(line, position, "\n", 0);
+			pOutput(line);
+		}
+	}
+}
+
+/**************************************************************************//**
+* @brief       Appends a text padded with spaces to a width, or cut to it.
+*              Returns the new end of the line, always zero terminated.
+******************************************************************************/
+static uint32_t PROF_Append(char *pLine, uint32_t Position, const char *pText, uint32_t Width)
+{
+	uint32_t start = Position;
+
+	while((*pText != '\0') && (Position < (PROF_LINE_SIZE - 1U)) && ((Width == 0) || ((Position - start) < (Width - 1U))))
+	{
+		pLine[Position++] = *pText++;
+	}
+
+	while((Position < (PROF_LINE_SIZE - 1U)) && ((Position - start) < Width))
+	{
+		pLine[Position++] = ' ';
+	}
+
+	pLine[Position] = '\0';
+
+	return Position;
+}
+
+/**************************************************************************//**
+* @brief       Appends a decimal number padded with spaces to a width.
+******************************************************************************/
+static uint32_t PROF_AppendNumber(char *pLine, uint32_t Position, uint64_t Value, uint32_t Width)
+{
+	char digits[21];
+	uint8_t index = sizeof(digits) - 1U;
+
+	digits[index] = '\0';
+	do
+	{
+		digits[--index] = (char)('0' + (Value % 10U));
+		Value /= 10U;
+	}while(Value != 0);
+
+	return PROF_Append(pLine, Position, &digits[index], Width);
+}
@@ -0,0 +1,282 @@
+/**************************************************************************//**
+ * @file    tickless_idle.c
+ * @brief   This file contains the tickless idle with LPTIM1 wakeup for the
+ *          STM32L475VG microcontroller.
+ *
+ * This file has 5 functions definitions (input parameters omitted):
+ *      <br>1) TLI_Init()               - Starts LPTIM1 and its wakeup line. </br>
+ *      <br>2) TLI_SetTimebase()        - Sets the functions giving and skipping idle ticks. </br>
+ *      <br>3) TLI_Idle()               - Sleeps in Stop 2 until the next deadline. </br>
+ *      <br>4) TLI_GetStats()           - Returns the tickless idle statistics. </br>
+ *      <br>5) TLI_LPTIMHandler()       - LPTIM1 compare match handler. </br>
+ *
+ * The timebase is described by two functions of the application: one
+ * returning in how many ticks something is due (the minimum of
+ * KRN_GetIdleTicks() and TMW_GetIdleTicks() for example), one skipping
+ * ticks without processing them (KRN_Advance() and TMW_Advance()). The
+ * deadline tick itself is not skipped: SysTick_Handler() is called for it
+ * right after the wakeup, so its work runs on time.
+ *
+ * With LSI at 32 kHz and no prescaler a count is 31.25 us and a sleep lasts
+ * up to 2 s; longer idle periods are cut in several sleeps.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+#include <stm32l475xx_rcc_driver.h>
+#include <stm32l475xx_nvic_driver.h>
+#include <stm32l475xx_systick_driver.h>
+#include <low_power.h>
+
+/* Here go the own includes */
+#include <tickless_idle.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static uint32_t (*tli_get_idle_ticks)(void) = 0;
+static void (*tli_advance)(uint32_t Ticks) = 0;
+static uint32_t tli_carry = 0;		/* Counts slept but not yet accounted as a tick */
+static TLI_Stats_t tli_stats;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function starts LPTIM1 from LSI or LSE, installs
+*              TLI_LPTIMHandler() in its vector and unmasks EXTI line 32 as
+*              wakeup source. LSI is turned on here, LSE must already run.
+*              Needs NVIC_RelocateVectorTable() and LPM_Init() first.
+*
+* @param       ClockSource  LPTIM_CLOCK_LSI or LPTIM_CLOCK_LSE.
+*
+* @return      TLI_STATUS_OK or TLI_STATUS_ERROR.
+******************************************************************************/
+TLI_STATUS TLI_Init(uint8_t ClockSource)
+{
+	if((ClockSource != LPTIM_CLOCK_LSI) && (ClockSource != LPTIM_CLOCK_LSE))
+	{
+		return TLI_STATUS_ERROR;
+	}
+
+	if(ClockSource == LPTIM_CLOCK_LSI)
+	{
+		(void)RCC_Config_LSI(SET);
+	}
+
+	if(LPTIM_Init(ClockSource, LPTIM_PRESCALER_DIV1) != LPTIM_STATUS_OK)
+	{
+		return TLI_STATUS_ERROR;
+	}
+
+	if(NVIC_SetVector(IRQ_NO_LPTIM1, TLI_LPTIMHandler) != NVIC_STATUS_OK)
+	{
+		return TLI_STATUS_ERROR;
+	}
+
+	(void)NVIC_SetPriority(IRQ_NO_LPTIM1, NVIC_PRIORITY_MAX);
+	(void)NVIC_ClearPending(IRQ_NO_LPTIM1);
+	(void)NVIC_IRQConfig(IRQ_NO_LPTIM1, ENABLE);
+
+	if(LPM_EnableWakeupLine(LPM_EXTI_LINE_LPTIM1, LPM_EDGE_KEEP, ENABLE) != LPM_STATUS_OK)
+	{
+		return TLI_STATUS_ERROR;
+	}
+
+	tli_carry = 0;
+	tli_stats.Sleeps = 0;
+	tli_stats.SleptTicks = 0;
+	tli_stats.EarlyWakeups = 0;
+	tli_stats.LatencyCounts = 0;
+	tli_stats.MaxLateCounts = 0;
+
+	return TLI_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function sets the functions describing the timebase.
+*
+* @param       pGetIdleTicks    Returns in how many ticks something is due:
+*                               1 for the next tick, 0 if work is ready now.
+* @param       pAdvance         Skips ticks with nothing due, fewer than the
+*                               value pGetIdleTicks returned.
+******************************************************************************/
+void TLI_SetTimebase(uint32_t (*pGetIdleTicks)(void), void (*pAdvance)(uint32_t Ticks))
+{
+	tli_get_idle_ticks = pGetIdleTicks;
+	tli_advance = pAdvance;
+}
+
+/**************************************************************************//**
+* @brief       This function sleeps until the next deadline or any wakeup
+*              event, and corrects the timebase. Call it from the idle loop,
+*              for example as the kernel idle hook. Falls back to WFI when
+*              the next deadline is too close for Stop 2.
+******************************************************************************/
+void TLI_Idle(void)
+{
+	uint32_t primask;
+	uint32_t tick_hz = SYSTICK_GetTickHz();
+	uint32_t lptim_hz = LPTIM_GetFrequency();
+	uint32_t idle;
+	uint32_t max_ticks;
+	uint32_t sleep;
+	uint32_t partial;
+	uint32_t elapsed;
+	uint32_t late;
+	uint32_t total;
+	uint32_t ticks;
+	uint32_t consumed;
+	uint32_t skip;
+	uint16_t start;
+	uint16_t compare;
+	uint16_t now;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	idle = (tli_get_idle_ticks != 0) ? tli_get_idle_ticks() : 0;
+
+	/* Not worth it, or a tick is already waiting to be processed */
+	if((tli_advance == 0) || (tick_hz == 0) || (lptim_hz == 0) || (idle < TLI_MIN_IDLE_TICKS) ||
+	   (READ_REG_BIT(*SCB_ICSR, SCB_ICSR_PENDSTSET) != 0))
+	{
+		__DSB();
+		__WFI();
+		__set_PRIMASK(primask);
+		return;
+	}
+
+	max_ticks = (uint32_t)(((uint64_t)TLI_MAX_SLEEP_COUNTS * tick_hz) / lptim_hz);
+	if(idle > max_ticks)
+	{
+		idle = max_ticks;
+	}
+
+	/* Counts from now to the boundary of the deadline tick */
+	partial = (uint32_t)(((uint64_t)SYSTICK_Suspend() * lptim_hz) / RCC_GetHCLKCached());
+
+	/* A wrap between the check above and the suspend: that tick is counted
+	 * in partial and processed below, not by the pending exception */
+	if(READ_REG_BIT(*SCB_ICSR, SCB_ICSR_PENDSTSET) != 0)
+	{
+		*SCB_ICSR = (1UL << SCB_ICSR_PENDSTCLR);
+		partial += (uint32_t)(((uint64_t)lptim_hz + (tick_hz / 2U)) / tick_hz);
+	}
+	sleep = (uint32_t)(((uint64_t)idle * lptim_hz) / tick_hz);
+	sleep = (sleep > (partial + tli_carry)) ? (sleep - partial - tli_carry) : 0;
+
+	if(sleep > (tli_stats.LatencyCounts + 1U))
+	{
+		start = LPTIM_GetCounter();
+		compare = (uint16_t)(start + sleep - tli_stats.LatencyCounts);
+		LPTIM_SetCompare(compare);
+
+		(void)LPM_Enter(LPM_MODE_STOP2);
+
+		now = LPTIM_GetCounter();
+		elapsed = (uint16_t)(now - start);
+		tli_stats.Sleeps++;
+
+		if(READ_REG_BIT(LPTIM_GetFlags(), LPTIM_ISR_CMPM) != 0)
+		{
+			/* Match to resume: Stop 2 exit plus clock restoration */
+			late = (uint16_t)(now - compare);
+			if(late > tli_stats.MaxLateCounts)
+			{
+				tli_stats.MaxLateCounts = late;
+			}
+			tli_stats.LatencyCounts = ((3U * tli_stats.LatencyCounts) + late + 2U) / 4U;
+		}
+		else
+		{
+			tli_stats.EarlyWakeups++;
+		}
+	}
+	else
+	{
+		/* Latency eats the whole sleep */
+		elapsed = 0;
+	}
+
+	/* One count of tolerance, the rest carries to the next sleep */
+	total = partial + elapsed + tli_carry;
+	ticks = (uint32_t)(((uint64_t)(total + 1U) * tick_hz) / lptim_hz);
+	consumed = (uint32_t)(((uint64_t)ticks * lptim_hz) / tick_hz);
+	tli_carry = (total > consumed) ? (total - consumed) : 0;
+
+	skip = (ticks < idle) ? ticks : (idle - 1U);
+	tli_advance(skip);
+	SYSTICK_Resume(skip);
+	tli_stats.SleptTicks += ticks;
+
+	/* The deadline tick, and any overshoot, are processed normally */
+	for(; skip < ticks; skip++)
+	{
+		SysTick_Handler();
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function returns the tickless idle statistics.
+*
+* @param [out] pStats       Structure to fill.
+******************************************************************************/
+void TLI_GetStats(TLI_Stats_t *pStats)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	*pStats = tli_stats;
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       LPTIM1 handler, installed by TLI_Init(). The wakeup itself is
+*              the work: only the match flag is cleared.
+******************************************************************************/
+void TLI_LPTIMHandler(void)
+{
+	LPTIM_ClearFlags(1UL << LPTIM_ISR_CMPM);
+}
@@ -0,0 +1,394 @@
+/**************************************************************************//**
+ * @file    timer_wheel.c
+ * @brief   This file contains a hierarchical timing wheel of software timers
+ *          for the STM32L475VG microcontroller.
+ *
+ * This file has 8 functions definitions (input parameters omitted):
+ *      <br>1) TMW_Init()               - Empties the wheels and resets the time. </br>
+ *      <br>2) TMW_Start()              - Starts or restarts a one-shot or periodic timer. </br>
+ *      <br>3) TMW_Stop()               - Stops a timer. </br>
+ *      <br>4) TMW_IsActive()           - Tells if a timer is running. </br>
+ *      <br>5) TMW_Tick()               - Advances the time, from the tick interrupt. </br>
+ *      <br>6) TMW_GetTicks()           - Returns the time of the wheels. </br>
+ *      <br>7) TMW_GetIdleTicks()       - Ticks until the next tick with work. </br>
+ *      <br>8) TMW_Advance()            - Skips idle ticks after a tickless sleep. </br>
+ *
+ * Each slot is a singly linked list whose nodes also keep the address of
+ * the link pointing to them (ppPrev), so a timer is unlinked without
+ * walking the slot. A stopped timer has ppPrev 0.
+ *
+ * TMW_Tick() takes the expired timers one at a time with PRIMASK set and
+ * calls them with PRIMASK restored, so more urgent interrupts are only
+ * masked for a few instructions per timer, and may start or stop any
+ * timer meanwhile, the expired ones included. A cascade moves a whole slot
+ * with PRIMASK set.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <timer_wheel.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	TMW_SLOT_MASK			(TMW_SLOTS - 1U)
+#define	TMW_RANGE			(1UL << (TMW_LEVELS * TMW_SLOT_BITS))
+#define	TMW_INDEX(Tick, Level)		(((Tick) >> ((Level) * TMW_SLOT_BITS)) & TMW_SLOT_MASK)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static TMW_Timer_t *tmw_wheels[TMW_LEVELS][TMW_SLOTS];
+static __vo uint32_t tmw_now = 0;	/* Next tick to process */
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static void TMW_Link(TMW_Timer_t **ppHead, TMW_Timer_t *pTimer);
+static void TMW_Unlink(TMW_Timer_t *pTimer);
+static void TMW_Insert(TMW_Timer_t *pTimer);
+static void TMW_Cascade(uint8_t Level);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function empties the wheels and resets the time to 0. The
+*              timers that were running are forgotten: start them again.
+******************************************************************************/
+void TMW_Init(void)
+{
+	uint8_t level;
+	uint8_t slot;
+
+	for(level = 0; level < TMW_LEVELS; level++)
+	{
+		for(slot = 0; slot < TMW_SLOTS; slot++)
+		{
+			tmw_wheels[level][slot] = 0;
+		}
+	}
+
+	tmw_now = 0;
+}
+
+/**************************************************************************//**
+* @brief       This function starts a timer, or restarts it if it is running.
+*              Callable from tasks, interrupt handlers and timer callbacks.
+*
+* @param       pTimer       Timer, static or living until it expires or stops.
+* @param       Ticks        Expiry on the Ticks-th tick from now, 0 counts as 1.
+* @param       Period       Reload after each expiry in ticks, 0 for one-shot.
+* @param       pCallback    Function called at the expiry, in the context of
+*                           TMW_Tick(). Short, it delays the other timers.
+* @param       pArg         Argument given to pCallback.
+*
+* @return      TMW_STATUS_OK or TMW_STATUS_ERROR.
+******************************************************************************/
+TMW_STATUS TMW_Start(TMW_Timer_t *pTimer, uint32_t Ticks, uint32_t Period, TMW_Callback_t pCallback, void *pArg)
+{
+	uint32_t primask;
+
+	if((pTimer == 0) || (pCallback == 0))
+	{
+		return TMW_STATUS_ERROR;
+	}
+
+	if(Ticks == 0)
+	{
+		Ticks = 1;
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if(pTimer->ppPrev != 0)
+	{
+		TMW_Unlink(pTimer);
+	}
+
+	pTimer->Expires = tmw_now + Ticks - 1U;
+	pTimer->Period = Period;
+	pTimer->pCallback = pCallback;
+	pTimer->pArg = pArg;
+	TMW_Insert(pTimer);
+
+	__set_PRIMASK(primask);
+
+	return TMW_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function stops a timer. Nothing happens if it is not
+*              running. Once it returns the callback is not called again,
+*              unless a call already in progress was interrupted.
+*
+* @param       pTimer       Timer.
+******************************************************************************/
+void TMW_Stop(TMW_Timer_t *pTimer)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if(pTimer->ppPrev != 0)
+	{
+		TMW_Unlink(pTimer);
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function tells if a timer is running. A timer must be
+*              zeroed (static storage, or memset) before its first use.
+*
+* @param       pTimer       Timer.
+*
+* @return      1 if running, 0 otherwise.
+******************************************************************************/
+uint8_t TMW_IsActive(const TMW_Timer_t *pTimer)
+{
+	return (pTimer->ppPrev != 0) ? 1U : 0U;
+}
+
+/**************************************************************************//**
+* @brief       This function processes one tick: cascades the upper wheels
+*              when wheel 0 wraps, then calls the timers expiring on this
+*              tick. Call it from the periodic tick interrupt, for example
+*              the SysTick hook.
+******************************************************************************/
+void TMW_Tick(void)
+{
+	TMW_Timer_t *expired;
+	TMW_Timer_t *timer;
+	uint32_t primask;
+	uint32_t tick;
+	uint8_t level;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	tick = tmw_now;
+
+	/* Wheel L + 1 advances when wheel L wraps */
+	for(level = 1; (level < TMW_LEVELS) && (TMW_INDEX(tick, level - 1U) == 0); level++)
+	{
+		TMW_Cascade(level);
+	}
+
+	/* Detach the expired slot, timers started from now on go elsewhere */
+	expired = tmw_wheels[0][tick & TMW_SLOT_MASK];
+	tmw_wheels[0][tick & TMW_SLOT_MASK] = 0;
+	if(expired != 0)
+	{
+		expired->ppPrev = &expired;
+	}
+	tmw_now = tick + 1U;
+
+	while(expired != 0)
+	{
+		timer = expired;
+		TMW_Unlink(timer);
+
+		if(timer->Period != 0)
+		{
+			timer->Expires += timer->Period;
+			TMW_Insert(timer);
+		}
+
+		__set_PRIMASK(primask);
+		timer->pCallback(timer->pArg);
+		primask = __get_PRIMASK();
+		__disable_irq();
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function returns the number of ticks processed since
+*              TMW_Init().
+*
+* @return      Time of the wheels, in ticks.
+******************************************************************************/
+uint32_t TMW_GetTicks(void)
+{
+	return tmw_now;
+}
+
+/**************************************************************************//**
+* @brief       This function returns in how many ticks TMW_Tick() has work:
+*              a timer expiry, or the cascade of a non-empty slot. Scans at
+*              most TMW_SLOTS slots per wheel. Used by the tickless idle to
+*              choose how long to sleep.
+*
+* @return      1 if the next tick has work, TMW_NO_DEADLINE if no timer runs.
+******************************************************************************/
+uint32_t TMW_GetIdleTicks(void)
+{
+	uint32_t primask;
+	uint32_t now;
+	uint32_t span;
+	uint32_t tick;
+	uint32_t best = TMW_NO_DEADLINE;
+	uint8_t level;
+	uint8_t k;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	now = tmw_now;
+
+	for(k = 0; k < TMW_SLOTS; k++)
+	{
+		if(tmw_wheels[0][(now + k) & TMW_SLOT_MASK] != 0)
+		{
+			best = (uint32_t)k + 1U;
+			break;
+		}
+	}
+
+	/* Wheel L cascades on the ticks multiple of 64^L */
+	for(level = 1; level < TMW_LEVELS; level++)
+	{
+		span = 1UL << (level * TMW_SLOT_BITS);
+		tick = (now + span - 1U) & ~(span - 1U);
+
+		for(k = 0; (k < TMW_SLOTS) && ((tick - now) < best); k++, tick += span)
+		{
+			if(tmw_wheels[level][TMW_INDEX(tick, level)] != 0)
+			{
+				best = (tick - now) + 1U;
+				break;
+			}
+		}
+	}
+
+	__set_PRIMASK(primask);
+
+	return best;
+}
+
+/**************************************************************************//**
+* @brief       This function moves the time forward without processing the
+*              ticks, after a sleep in which the tick was stopped. The ticks
+*              skipped must have no work: Ticks below TMW_GetIdleTicks().
+*
+* @param       Ticks        Ticks slept.
+******************************************************************************/
+void TMW_Advance(uint32_t Ticks)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	tmw_now += Ticks;
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       Pushes a timer at the head of a list.
+******************************************************************************/
+static void TMW_Link(TMW_Timer_t **ppHead, TMW_Timer_t *pTimer)
+{
+	pTimer->pNext = *ppHead;
+	if(pTimer->pNext != 0)
+	{
+		pTimer->pNext->ppPrev = &pTimer->pNext;
+	}
+	pTimer->ppPrev = ppHead;
+	*ppHead = pTimer;
+}
+
+/**************************************************************************//**
+* @brief       Removes a timer from its list and marks it stopped.
+******************************************************************************/
+static void TMW_Unlink(TMW_Timer_t *pTimer)
+{
+	*pTimer->ppPrev = pTimer->pNext;
+	if(pTimer->pNext != 0)
+	{
+		pTimer->pNext->ppPrev = pTimer->ppPrev;
+	}
+	pTimer->pNext = 0;
+	pTimer->ppPrev = 0;
+}
+
+/**************************************************************************//**
+* @brief       Links a timer in the slot of its expiry: the lowest wheel whose
+*              range covers the time left. Timers beyond the last wheel are
+*              parked in its farthest slot.
+******************************************************************************/
+static void TMW_Insert(TMW_Timer_t *pTimer)
+{
+	uint32_t delta = pTimer->Expires - tmw_now;
+	uint32_t expires = pTimer->Expires;
+	uint8_t level = 0;
+
+	if(delta >= TMW_RANGE)
+	{
+		expires = tmw_now + (TMW_RANGE - 1U);
+		delta = TMW_RANGE - 1U;
+	}
+
+	while((level < (TMW_LEVELS - 1U)) && (delta >= (1UL << ((level + 1U) * TMW_SLOT_BITS))))
+	{
+		level++;
+	}
+
+	TMW_Link(&tmw_wheels[level][TMW_INDEX(expires, level)], pTimer);
+}
+
+/**************************************************************************//**
+* @brief       Moves the timers of the current slot of a wheel to the lower
+*              wheels.
+******************************************************************************/
+static void TMW_Cascade(uint8_t Level)
+{
+	uint32_t slot = TMW_INDEX(tmw_now, Level);
+	TMW_Timer_t *timer = tmw_wheels[Level][slot];
+	TMW_Timer_t *next;
+
+	tmw_wheels[Level][slot] = 0;
+
+	while(timer != 0)
+	{
+		next = timer->pNext;
+		TMW_Insert(timer);
+		timer = next;
+	}
+}
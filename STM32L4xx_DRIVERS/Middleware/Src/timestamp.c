@@ -0,0 +1,329 @@
+/**************************************************************************//**
+ * @file    timestamp.c
+ * @brief   This file contains the 64-bit monotonic time service for the
+ *          STM32L475VG microcontroller.
+ *
+ * This file has 6 functions definitions (input parameters omitted):
+ *      <br>1) TS_Init()                - Starts the time base at 0 ns. </br>
+ *      <br>2) TS_SetReference()        - Sets the counter running in Stop modes. </br>
+ *      <br>3) TS_Now()                 - Returns the time in ns, from anywhere. </br>
+ *      <br>4) TS_Update()              - Moves the epoch to now, before CYCCNT wraps. </br>
+ *      <br>5) TS_Suspend()             - Saves the time before a Stop mode. </br>
+ *      <br>6) TS_Resync()              - Adds the time slept after a Stop mode. </br>
+ *
+ * An epoch is a (CYCCNT, ns) pair and the ns per cycle of its HCLK in Q32.
+ * A new epoch starts at the time the current one gives for that instant, so
+ * the time never goes back when the clock changes. The cycles run between
+ * the clock switch and the RCC callback are counted at the old HCLK.
+ *
+ * DWT_CYCCNT stops with the core clock. TS_Init() sets TS_Suspend() and
+ * TS_Resync() as Stop hooks of the low-power manager; with a reference
+ * counter (LPTIM1 on LSI or LSE) the sleep is measured on it, without one
+ * the time stands still during Stop modes. The reference must not wrap
+ * during a sleep: 2 s for the 16-bit LPTIM1 at 32768 Hz, which is also the
+ * longest sleep of the tickless idle.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+#include <stm32l475xx_rcc_driver.h>
+#include <low_power.h>
+
+/* Here go the own includes */
+#include <timestamp.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef struct  /* Start of a linear segment of the time */
+{
+  uint32_t      Cycles;         /* DWT_CYCCNT at the start */
+  uint64_t      Ns;             /* Time at the start */
+  uint64_t      NsPerCycleQ32;  /* 10^9 / HCLK, Q32 */
+}TS_Epoch_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static TS_Epoch_t ts_epochs[2];
+static __vo uint32_t ts_sequence = 0;   /* Active epoch in bit 0, incremented on publish */
+static uint32_t (*ts_ref_read)(void) = 0;
+static uint32_t ts_ref_hz = 0;
+static uint32_t ts_ref_mask = 0;
+static uint32_t ts_suspend_ref = 0;
+static uint64_t ts_suspend_ns = 0;
+static uint8_t ts_suspended = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static void TS_ClockChanged(uint32_t HCLK);
+static uint64_t TS_At(const TS_Epoch_t *pEpoch, uint32_t Cycles);
+static uint64_t TS_NsPerCycle(uint32_t HCLK);
+static void TS_Publish(uint32_t Cycles, uint64_t Ns, uint64_t NsPerCycleQ32);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function enables the cycle counter, starts the time at 0
+*              with the HCLK of the RCC driver and registers the clock change
+*              callback and the Stop hooks. Call it after LPM_Init().
+*
+* @return      TS_STATUS_OK, or TS_STATUS_ERROR if HCLK is unknown or the
+*              callback cannot be registered.
+******************************************************************************/
+TS_STATUS TS_Init(void)
+{
+	uint32_t primask;
+	uint32_t hclk = RCC_GetHCLKCached();
+
+	if(hclk == 0)
+	{
+		return TS_STATUS_ERROR;
+	}
+
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	ts_suspended = 0;
+	TS_Publish(*DWT_CYCCNT, 0, TS_NsPerCycle(hclk));
+
+	__set_PRIMASK(primask);
+
+	if(RCC_RegisterClockChangeCallback(TS_ClockChanged) != RCC_STATUS_OK)
+	{
+		return TS_STATUS_ERROR;
+	}
+
+	LPM_SetStopHooks(TS_Suspend, TS_Resync);
+
+	return TS_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function sets the free running counter that measures the
+*              Stop modes, for example a wrapper of LPTIM_GetCounter().
+*
+* @param       pRead        Returns the counter, 0 to measure nothing.
+* @param       Hz           Counter frequency.
+* @param       Mask         Counter range minus one, 0xFFFF for 16 bits.
+*
+* @return      TS_STATUS_OK or TS_STATUS_ERROR.
+******************************************************************************/
+TS_STATUS TS_SetReference(uint32_t (*pRead)(void), uint32_t Hz, uint32_t Mask)
+{
+	if((pRead != 0) && ((Hz == 0) || (Mask == 0)))
+	{
+		return TS_STATUS_ERROR;
+	}
+
+	ts_ref_read = pRead;
+	ts_ref_hz = Hz;
+	ts_ref_mask = Mask;
+
+	return TS_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the time since TS_Init(). Lock-free,
+*              callable from any interrupt handler.
+*
+* @return      Time in nanoseconds.
+******************************************************************************/
+__RAMFUNC uint64_t TS_Now(void)
+{
+	TS_Epoch_t epoch;
+	uint32_t sequence;
+	uint32_t cycles;
+
+	do
+	{
+		sequence = ts_sequence;
+		__DMB();
+		epoch = ts_epochs[sequence & 1U];
+		cycles = *DWT_CYCCNT;
+		__DMB();
+	}while(sequence != ts_sequence);
+
+	if((cycles - epoch.Cycles) >= TS_REBASE_CYCLES)
+	{
+		TS_Update();
+	}
+
+	return TS_At(&epoch, cycles);
+}
+
+/**************************************************************************//**
+* @brief       This function starts a new epoch now. Call it at least once per
+*              2^32 cycles if TS_Now() may not be, from a periodic timer for
+*              example.
+******************************************************************************/
+void TS_Update(void)
+{
+	uint32_t primask;
+	uint32_t cycles;
+	const TS_Epoch_t *epoch;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	epoch = &ts_epochs[ts_sequence & 1U];
+	cycles = *DWT_CYCCNT;
+	TS_Publish(cycles, TS_At(epoch, cycles), epoch->NsPerCycleQ32);
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function saves the time and the reference counter before
+*              a Stop mode. Called by LPM_Enter() once set by TS_Init().
+******************************************************************************/
+void TS_Suspend(void)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	if(ts_ref_read != 0)
+	{
+		ts_suspend_ns = TS_Now();
+		ts_suspend_ref = ts_ref_read();
+		ts_suspended = 1;
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       This function starts a new epoch after a Stop mode, at the time
+*              of TS_Suspend() plus the reference counts since, or at the
+*              cycle counter time if that is later. Called by LPM_Enter() once
+*              set by TS_Init().
+******************************************************************************/
+void TS_Resync(void)
+{
+	uint32_t primask;
+	uint32_t cycles;
+	uint32_t counts;
+	uint64_t ns;
+	uint64_t slept;
+	const TS_Epoch_t *epoch;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	epoch = &ts_epochs[ts_sequence & 1U];
+	cycles = *DWT_CYCCNT;
+	ns = TS_At(epoch, cycles);
+
+	if((ts_suspended != 0) && (ts_ref_read != 0))
+	{
+		counts = (ts_ref_read() - ts_suspend_ref) & ts_ref_mask;
+		slept = ts_suspend_ns + (((uint64_t)counts * TS_NS_PER_S) / ts_ref_hz);
+		if(slept > ns)
+		{
+			ns = slept;
+		}
+	}
+	ts_suspended = 0;
+
+	TS_Publish(cycles, ns, epoch->NsPerCycleQ32);
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       Clock change callback registered in the RCC driver. Closes the
+*              epoch at the old HCLK and starts one at the new HCLK.
+******************************************************************************/
+static void TS_ClockChanged(uint32_t HCLK)
+{
+	uint32_t primask;
+	uint32_t cycles;
+	const TS_Epoch_t *epoch;
+
+	if(HCLK == 0)
+	{
+		return;
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	epoch = &ts_epochs[ts_sequence & 1U];
+	cycles = *DWT_CYCCNT;
+	TS_Publish(cycles, TS_At(epoch, cycles), TS_NsPerCycle(HCLK));
+
+	__set_PRIMASK(primask);
+}
+
+/**************************************************************************//**
+* @brief       Time of an epoch at a counter value. Two 32x32 products: the
+*              ns per cycle in Q32 exceed 32 bits for any HCLK under 1 GHz.
+******************************************************************************/
+__RAMFUNC static uint64_t TS_At(const TS_Epoch_t *pEpoch, uint32_t Cycles)
+{
+	uint32_t delta = Cycles - pEpoch->Cycles;
+	uint64_t high = (uint64_t)delta * (uint32_t)(pEpoch->NsPerCycleQ32 >> 32);
+	uint64_t low = (uint64_t)delta * (uint32_t)pEpoch->NsPerCycleQ32;
+
+	return pEpoch->Ns + high + (low >> 32);
+}
+
+/**************************************************************************//**
+* @brief       10^9 / HCLK in Q32, rounded to nearest.
+******************************************************************************/
+static uint64_t TS_NsPerCycle(uint32_t HCLK)
+{
+	return ((TS_NS_PER_S << 32) + (HCLK / 2U)) / HCLK;
+}
+
+/**************************************************************************//**
+* @brief       Fills the inactive epoch and makes it the active one. Called
+*              with interrupts masked; readers that saw the old one read again.
+******************************************************************************/
+static void TS_Publish(uint32_t Cycles, uint64_t Ns, uint64_t NsPerCycleQ32)
+{
+	uint32_t next = ts_sequence + 1U;
+	TS_Epoch_t *epoch = &ts_epochs[next & 1U];
+
+	epoch->Cycles = Cycles;
+	epoch->Ns = Ns;
+	epoch->NsPerCycleQ32 = NsPerCycleQ32;
+
+	__DMB();
+	ts_sequence = next;
+}
@@ -0,0 +1,516 @@
+/**************************************************************************//**
+ * @file    warm_resume.c
+ * @brief   This file contains the Standby warm resume for the STM32L475VG
+ *          microcontroller.
+ *
+ * This file has 6 functions definitions (input parameters omitted):
+ *      <br>1) WARM_Save()              - Saves the clock, GPIO and application state to SRAM2. </br>
+ *      <br>2) WARM_EarlyResume()       - Restores the snapshot from Reset_Handler. </br>
+ *      <br>3) WARM_IsWarmBoot()        - Tells if the reset is a Standby wakeup with a snapshot. </br>
+ *      <br>4) WARM_Complete()          - Restores the NVIC and consumes the snapshot. </br>
+ *      <br>5) WARM_GetAppData()        - Copies the application data of the snapshot. </br>
+ *      <br>6) WARM_GetResumeCycles()   - Cycles from the reset vector to WARM_Complete(). </br>
+ *
+ * WARM_EarlyResume() runs before .data and .bss are initialized. It and its
+ * helpers only touch registers and the snapshot, which lives in the NOLOAD
+ * .sram2_noinit section, and never call the library or a .ramfunc function
+ * (not copied yet).
+ *
+ * What is restored and when:
+ *      <br>1) Reset_Handler: voltage range, flash latency and caches,
+ *             oscillators, PLL, prescalers, system clock, peripheral clocks,
+ *             GPIO ports (output data first, mode last so no pin glitches),
+ *             SYSCFG EXTI routing and the EXTI lines. </br>
+ *      <br>2) WARM_Complete(): NVIC priorities and enables. Kept until main()
+ *             so no interrupt handler runs before the C runtime is ready. </br>
+ *
+ * The PWR_CR3 settings (wakeup pins, RRS) and the backup domain survive
+ * Standby by themselves.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+#include <stm32l475xx_pwr_driver.h>
+#include <stm32l475xx_rcc_driver.h>
+
+/* Here go the own includes */
+#include <warm_resume.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+#define	WARM_MAGIC			(0x5741524DUL)	/* "WARM" */
+#define	WARM_GPIO_PORT_OFFSET		(0x400UL)
+#define	WARM_RCC_CR_MSIRANGE_MASK	(0xF8UL)	/* MSIRANGE and MSIRGSEL */
+#define	WARM_FLASH_ACR_LATENCY_MASK	(0x7UL)
+#define	WARM_PWR_CR1_VOS_MASK		(0x3UL << PWR_CR1_VOS)
+#define	WARM_NVIC_ISER_WORDS		(3UL)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef struct  /* One GPIO port */
+{
+  uint32_t      MODER;
+  uint32_t      OTYPER;
+  uint32_t      OSPEEDR;
+  uint32_t      PUPDR;
+  uint32_t      ODR;
+  uint32_t      AFRL;
+  uint32_t      AFRH;
+}WARM_Gpio_t;
+
+typedef struct  /* Snapshot kept in SRAM2, Checksum must be the last word */
+{
+  uint32_t      Magic;
+  uint32_t      Size;
+  uint32_t      PwrCr1;
+  uint32_t      FlashAcr;
+  uint32_t      RccCr;
+  uint32_t      RccIcscr;
+  uint32_t      RccCfgr;
+  uint32_t      RccPllcfgr;
+  uint32_t      RccAhb1enr;
+  uint32_t      RccAhb2enr;
+  uint32_t      RccAhb3enr;
+  uint32_t      RccApb1enr1;
+  uint32_t      RccApb1enr2;
+  uint32_t      RccApb2enr;
+  WARM_Gpio_t   Gpio[WARM_GPIO_PORTS];
+  uint32_t      SyscfgExticr[4];
+  uint32_t      ExtiImr1;
+  uint32_t      ExtiEmr1;
+  uint32_t      ExtiRtsr1;
+  uint32_t      ExtiFtsr1;
+  uint32_t      ExtiImr2;
+  uint32_t      ExtiEmr2;
+  uint32_t      ExtiRtsr2;
+  uint32_t      ExtiFtsr2;
+  uint32_t      NvicIser[WARM_NVIC_ISER_WORDS];
+  uint32_t      NvicIpr[WARM_NVIC_IPR_WORDS];
+  uint32_t      AppLength;
+  uint32_t      AppData[WARM_APP_DATA_SIZE / 4UL];
+  uint32_t      Checksum;
+}WARM_Snapshot_t;
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+__SRAM2_NOINIT static WARM_Snapshot_t warm_snapshot;
+static uint32_t warm_resume_cycles = 0;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static uint32_t WARM_Checksum(void);
+static uint8_t WARM_SnapshotValid(void);
+static void WARM_RestoreClocks(void);
+static void WARM_RestoreGpio(void);
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       This function saves the clock, GPIO and interrupt configuration
+*              and up to WARM_APP_DATA_SIZE bytes of application data to SRAM2
+*              and enables the SRAM2 retention in Standby. Call it right before
+*              entering Standby; anything changed afterwards is not restored.
+*
+* @param [in]  pAppData     Application data. Can be 0 if Length is 0.
+* @param [in]  Length       Bytes of application data.
+*
+* @return      WARM_STATUS_OK       Snapshot saved.
+* @return      WARM_STATUS_ERROR    Too much application data.
+******************************************************************************/
+WARM_STATUS WARM_Save(const void *pAppData, uint32_t Length)
+{
+	const uint8_t *src = (const uint8_t*)pAppData;
+	uint8_t *dst = (uint8_t*)warm_snapshot.AppData;
+	GPIO_RegDef_t *port;
+	uint32_t i;
+
+	if((Length > WARM_APP_DATA_SIZE) || ((Length != 0) && (pAppData == 0)))
+	{
+		return WARM_STATUS_ERROR;
+	}
+
+	warm_snapshot.Magic = 0;
+	warm_snapshot.Size = sizeof(WARM_Snapshot_t);
+
+	warm_snapshot.PwrCr1 = PWR->PWR_CR1;
+	warm_snapshot.FlashAcr = FLASH->FLASH_ACR;
+	warm_snapshot.RccCr = RCC->RCC_CR;
+	warm_snapshot.RccIcscr = RCC->RCC_ICSCR;
+	warm_snapshot.RccCfgr = RCC->RCC_CFGR;
+	warm_snapshot.RccPllcfgr = RCC->RCC_PLLCFGR;
+	warm_snapshot.RccAhb1enr = RCC->RCC_AHB1ENR;
+	warm_snapshot.RccAhb2enr = RCC->RCC_AHB2ENR;
+	warm_snapshot.RccAhb3enr = RCC->RCC_AHB3ENR;
+	warm_snapshot.RccApb1enr1 = RCC->RCC_APB1ENR1;
+	warm_snapshot.RccApb1enr2 = RCC->RCC_APB1ENR2;
+	warm_snapshot.RccApb2enr = RCC->RCC_APB2ENR;
+
+	/* Only the ports with their clock on, the others read as reset values */
+	for(i = 0; i < WARM_GPIO_PORTS; i++)
+	{
+		if(READ_REG_BIT(warm_snapshot.RccAhb2enr, i) != 0)
+		{
+			port = (GPIO_RegDef_t*)(GPIOA_BASE_ADDRESS + (i * WARM_GPIO_PORT_OFFSET));
+			warm_snapshot.Gpio[i].MODER = port->GPIO_MODER;
+			warm_snapshot.Gpio[i].OTYPER = port->GPIO_OTYPER;
+			warm_snapshot.Gpio[i].OSPEEDR = port->GPIO_OSPEEDR;
+			warm_snapshot.Gpio[i].PUPDR = port->GPIO_PUPDR;
+			warm_snapshot.Gpio[i].ODR = port->GPIO_ODR;
+			warm_snapshot.Gpio[i].AFRL = port->GPIO_AFRL;
+			warm_snapshot.Gpio[i].AFRH = port->GPIO_AFRH;
+		}
+	}
+
+	for(i = 0; i < 4UL; i++)
+	{
+		warm_snapshot.SyscfgExticr[i] = (&SYSCFG->SYSCFG_EXTICR1)[i];
+	}
+
+	warm_snapshot.ExtiImr1 = EXTI->EXTI_IMR1;
+	warm_snapshot.ExtiEmr1 = EXTI->EXTI_EMR1;
+	warm_snapshot.ExtiRtsr1 = EXTI->EXTI_RTSR1;
+	warm_snapshot.ExtiFtsr1 = EXTI->EXTI_FTSR1;
+	warm_snapshot.ExtiImr2 = EXTI->EXTI_IMR2;
+	warm_snapshot.ExtiEmr2 = EXTI->EXTI_EMR2;
+	warm_snapshot.ExtiRtsr2 = EXTI->EXTI_RTSR2;
+	warm_snapshot.ExtiFtsr2 = EXTI->EXTI_FTSR2;
+
+	for(i = 0; i < WARM_NVIC_ISER_WORDS; i++)
+	{
+		warm_snapshot.NvicIser[i] = (NVIC_ISER0)[i];
+	}
+	for(i = 0; i < WARM_NVIC_IPR_WORDS; i++)
+	{
+		warm_snapshot.NvicIpr[i] = (NVIC_PRIORITY_BASE_ADDRESS)[i];
+	}
+
+	warm_snapshot.AppLength = Length;
+	for(i = 0; i < Length; i++)
+	{
+		dst[i] = src[i];
+	}
+
+	warm_snapshot.Magic = WARM_MAGIC;
+	warm_snapshot.Checksum = WARM_Checksum();
+
+	/* Keep SRAM2 powered in Standby */
+	PWR_PCLK_EN();
+	SET_REG_BIT(PWR->PWR_CR3, PWR_CR3_RRS);
+
+	return WARM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function is called by Reset_Handler right after the stack
+*              pointer is set. After a Standby wakeup with a valid snapshot it
+*              brings the clocks, pins and EXTI back to their saved state;
+*              after any other reset it returns without changing anything.
+*              It also starts DWT_CYCCNT so WARM_GetResumeCycles() can tell
+*              how long the warm path took.
+*
+* @return      1 if the snapshot was restored, 0 otherwise. Reset_Handler
+*              skips the stack painting of a cold boot when it is 1.
+*
+* @note        Runs before .data and .bss are initialized, see the file
+*              description.
+******************************************************************************/
+uint8_t WARM_EarlyResume(void)
+{
+	uint32_t i;
+
+	PWR_PCLK_EN();
+
+	if((READ_REG_BIT(PWR->PWR_SR1, PWR_SR1_SBF) == 0) || (WARM_SnapshotValid() == 0))
+	{
+		return 0;
+	}
+
+	SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+	*DWT_CYCCNT = 0;
+	SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+	WARM_RestoreClocks();
+	WARM_RestoreGpio();
+
+	for(i = 0; i < 4UL; i++)
+	{
+		(&SYSCFG->SYSCFG_EXTICR1)[i] = warm_snapshot.SyscfgExticr[i];
+	}
+
+	EXTI->EXTI_RTSR1 = warm_snapshot.ExtiRtsr1;
+	EXTI->EXTI_FTSR1 = warm_snapshot.ExtiFtsr1;
+	EXTI->EXTI_RTSR2 = warm_snapshot.ExtiRtsr2;
+	EXTI->EXTI_FTSR2 = warm_snapshot.ExtiFtsr2;
+	EXTI->EXTI_EMR1 = warm_snapshot.ExtiEmr1;
+	EXTI->EXTI_EMR2 = warm_snapshot.ExtiEmr2;
+	EXTI->EXTI_IMR1 = warm_snapshot.ExtiImr1;
+	EXTI->EXTI_IMR2 = warm_snapshot.ExtiImr2;
+
+	return 1;
+}
+
+/**************************************************************************//**
+* @brief       This function tells if the device woke up from Standby with a
+*              valid snapshot, which means WARM_EarlyResume() restored it.
+*
+* @return      1 on a warm boot, 0 otherwise.
+******************************************************************************/
+uint8_t WARM_IsWarmBoot(void)
+{
+	if(READ_REG_BIT(PWR->PWR_SR1, PWR_SR1_SBF) == 0)
+	{
+		return 0;
+	}
+
+	return WARM_SnapshotValid();
+}
+
+/**************************************************************************//**
+* @brief       This function finishes a warm boot: it restores the NVIC
+*              priorities and enables, clears the Standby flag and invalidates
+*              the snapshot so the next reset is cold unless WARM_Save() is
+*              called again. Pending interrupts of the wakeup are not lost,
+*              the EXTI lines were restored in Reset_Handler.
+*
+* @return      WARM_STATUS_OK           NVIC restored.
+* @return      WARM_STATUS_NO_SNAPSHOT  Not a warm boot, nothing done.
+******************************************************************************/
+WARM_STATUS WARM_Complete(void)
+{
+	uint32_t i;
+
+	if(WARM_IsWarmBoot() == 0)
+	{
+		return WARM_STATUS_NO_SNAPSHOT;
+	}
+
+	for(i = 0; i < WARM_NVIC_IPR_WORDS; i++)
+	{
+		(NVIC_PRIORITY_BASE_ADDRESS)[i] = warm_snapshot.NvicIpr[i];
+	}
+	for(i = 0; i < WARM_NVIC_ISER_WORDS; i++)
+	{
+		(NVIC_ISER0)[i] = warm_snapshot.NvicIser[i];
+	}
+
+	SET_REG_BIT(PWR->PWR_SCR, PWR_SCR_CSBF);
+	warm_snapshot.Magic = 0;
+
+	warm_resume_cycles = *DWT_CYCCNT;
+
+	return WARM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function copies the application data saved by WARM_Save().
+*              Call it before WARM_Complete(), which invalidates the snapshot.
+*
+* @param [out] pBuffer      Destination buffer.
+* @param [in]  BufferSize   Size of pBuffer in bytes.
+* @param [out] pLength      Bytes of application data. Can be 0.
+*
+* @return      WARM_STATUS_OK           Data copied.
+* @return      WARM_STATUS_ERROR        pBuffer too small.
+* @return      WARM_STATUS_NO_SNAPSHOT  Not a warm boot.
+******************************************************************************/
+WARM_STATUS WARM_GetAppData(void *pBuffer, uint32_t BufferSize, uint32_t *pLength)
+{
+	const uint8_t *src = (const uint8_t*)warm_snapshot.AppData;
+	uint8_t *dst = (uint8_t*)pBuffer;
+	uint32_t i;
+
+	if(WARM_IsWarmBoot() == 0)
+	{
+		return WARM_STATUS_NO_SNAPSHOT;
+	}
+
+	if((pBuffer == 0) || (BufferSize < warm_snapshot.AppLength))
+	{
+		return WARM_STATUS_ERROR;
+	}
+
+	for(i = 0; i < warm_snapshot.AppLength; i++)
+	{
+		dst[i] = src[i];
+	}
+
+	if(pLength != 0)
+	{
+		*pLength = warm_snapshot.AppLength;
+	}
+
+	return WARM_STATUS_OK;
+}
+
+/**************************************************************************//**
+* @brief       This function returns the CPU cycles from the start of
+*              WARM_EarlyResume() to the end of the last WARM_Complete(). The
+*              count mixes the wakeup clock (MSI) and the restored clock, so
+*              for a time in microseconds measure a probe pin with a scope.
+*
+* @return      Cycles of the last warm boot, 0 if there was none.
+******************************************************************************/
+uint32_t WARM_GetResumeCycles(void)
+{
+	return warm_resume_cycles;
+}
+
+/**************************************************************************//**
+* @brief       Rotate and XOR of every word of the snapshot but the checksum.
+******************************************************************************/
+static uint32_t WARM_Checksum(void)
+{
+	const uint32_t *word = (const uint32_t*)&warm_snapshot;
+	uint32_t words = (sizeof(WARM_Snapshot_t) / 4UL) - 1UL;
+	uint32_t sum = 0x811C9DC5UL;
+	uint32_t i;
+
+	for(i = 0; i < words; i++)
+	{
+		sum = ((sum << 5) | (sum >> 27)) ^ word[i];
+	}
+
+	return sum;
+}
+
+/**************************************************************************//**
+* @brief       SRAM2 holds random data after a power-on reset, the magic, size
+*              and checksum must all match.
+******************************************************************************/
+static uint8_t WARM_SnapshotValid(void)
+{
+	if((warm_snapshot.Magic != WARM_MAGIC) || (warm_snapshot.Size != sizeof(WARM_Snapshot_t)))
+	{
+		return 0;
+	}
+
+	if(warm_snapshot.AppLength > WARM_APP_DATA_SIZE)
+	{
+		return 0;
+	}
+
+	return (WARM_Checksum() == warm_snapshot.Checksum) ? 1 : 0;
+}
+
+/**************************************************************************//**
+* @brief       Restores the clock tree. The device wakes on MSI at Range 1 with
+*              zero wait states, so the voltage range and the flash latency go
+*              first, then the sources, the prescalers and the switch.
+******************************************************************************/
+static void WARM_RestoreClocks(void)
+{
+	uint32_t sw = (warm_snapshot.RccCfgr >> RCC_CFGR_SW) & 0x3UL;
+
+	if((PWR->PWR_CR1 & WARM_PWR_CR1_VOS_MASK) != (warm_snapshot.PwrCr1 & WARM_PWR_CR1_VOS_MASK))
+	{
+		PWR->PWR_CR1 = (PWR->PWR_CR1 & ~WARM_PWR_CR1_VOS_MASK) | (warm_snapshot.PwrCr1 & WARM_PWR_CR1_VOS_MASK);
+		while(READ_REG_BIT(PWR->PWR_SR2, PWR_SR2_VOSF) != 0);
+	}
+
+	/* Latency before the caches, read back before the clock goes up */
+	FLASH->FLASH_ACR = (FLASH->FLASH_ACR & ~WARM_FLASH_ACR_LATENCY_MASK) | (warm_snapshot.FlashAcr & WARM_FLASH_ACR_LATENCY_MASK);
+	while((FLASH->FLASH_ACR & WARM_FLASH_ACR_LATENCY_MASK) != (warm_snapshot.FlashAcr & WARM_FLASH_ACR_LATENCY_MASK));
+	FLASH->FLASH_ACR = warm_snapshot.FlashAcr;
+
+	RCC->RCC_ICSCR = warm_snapshot.RccIcscr;
+
+	if(READ_REG_BIT(warm_snapshot.RccCr, RCC_CR_MSION) != 0)
+	{
+		/* MSIRANGE may only change while MSI is ready */
+		while(READ_REG_BIT(RCC->RCC_CR, RCC_CR_MSIRDY) == 0);
+		RCC->RCC_CR = (RCC->RCC_CR & ~WARM_RCC_CR_MSIRANGE_MASK) | (warm_snapshot.RccCr & WARM_RCC_CR_MSIRANGE_MASK);
+		while(READ_REG_BIT(RCC->RCC_CR, RCC_CR_MSIRDY) == 0);
+	}
+
+	if(READ_REG_BIT(warm_snapshot.RccCr, RCC_CR_HSION) != 0)
+	{
+		SET_REG_BIT(RCC->RCC_CR, RCC_CR_HSION);
+		while(READ_REG_BIT(RCC->RCC_CR, RCC_CR_HSIRDY) == 0);
+	}
+
+	if(READ_REG_BIT(warm_snapshot.RccCr, RCC_CR_HSEON) != 0)
+	{
+		SET_REG_BIT(RCC->RCC_CR, RCC_CR_HSEON);
+		while(READ_REG_BIT(RCC->RCC_CR, RCC_CR_HSERDY) == 0);
+	}
+
+	if(READ_REG_BIT(warm_snapshot.RccCr, RCC_CR_PLLON) != 0)
+	{
+		/* PLLCFGR is writable only with the PLL off, as it is after reset */
+		RCC->RCC_PLLCFGR = warm_snapshot.RccPllcfgr;
+		SET_REG_BIT(RCC->RCC_CR, RCC_CR_PLLON);
+		while(READ_REG_BIT(RCC->RCC_CR, RCC_CR_PLLRDY) == 0);
+	}
+
+	/* Prescalers, MCO and STOPWUCK with the switch still on MSI */
+	RCC->RCC_CFGR = warm_snapshot.RccCfgr & ~(0x3UL << RCC_CFGR_SW);
+
+	if(sw != RCC_CFGR_SWS_MSI)
+	{
+		RCC->RCC_CFGR |= (sw << RCC_CFGR_SW);
+		while(((RCC->RCC_CFGR >> RCC_CFGR_SWS) & 0x3UL) != sw);
+	}
+
+	RCC->RCC_AHB1ENR = warm_snapshot.RccAhb1enr;
+	RCC->RCC_AHB2ENR = warm_snapshot.RccAhb2enr;
+	RCC->RCC_AHB3ENR = warm_snapshot.RccAhb3enr;
+	RCC->RCC_APB1ENR1 = warm_snapshot.RccApb1enr1 | (1UL << 28);	/* Keep PWR on */
+	RCC->RCC_APB1ENR2 = warm_snapshot.RccApb1enr2;
+	RCC->RCC_APB2ENR = warm_snapshot.RccApb2enr;
+}
+
+/**************************************************************************//**
+* @brief       Restores the GPIO ports whose clock was on. The output level and
+*              the pin configuration are set before MODER, so an output pin
+*              drives its saved level from its first cycle.
+******************************************************************************/
+static void WARM_RestoreGpio(void)
+{
+	GPIO_RegDef_t *port;
+	uint32_t i;
+
+	for(i = 0; i < WARM_GPIO_PORTS; i++)
+	{
+		if(READ_REG_BIT(warm_snapshot.RccAhb2enr, i) != 0)
+		{
+			port = (GPIO_RegDef_t*)(GPIOA_BASE_ADDRESS + (i * WARM_GPIO_PORT_OFFSET));
+			port->GPIO_ODR = warm_snapshot.Gpio[i].ODR;
+			port->GPIO_OTYPER = warm_snapshot.Gpio[i].OTYPER;
+			port->GPIO_OSPEEDR = warm_snapshot.Gpio[i].OSPEEDR;
+			port->GPIO_PUPDR = warm_snapshot.Gpio[i].PUPDR;
+			port->GPIO_AFRL = warm_snapshot.Gpio[i].AFRL;
+			port->GPIO_AFRH = warm_snapshot.Gpio[i].AFRH;
+			port->GPIO_MODER = warm_snapshot.Gpio[i].MODER;
+		}
+	}
+}
@@ -0,0 +1,432 @@
+/**************************************************************************//**
+ * @file    driver_bench.c
+ * @brief   Benchmark application: cycles of the driver APIs on the board.
+ *
+ * This file has 5 configuration and measurement functions:
+ *      <br>1)  App_BenchInit()     - configures the cycle counter, the LED and SWO.</br>
+ *      <br>2)  App_BenchClock()    - times the driver APIs at one clock setting.</br>
+ *      <br>3)  App_BenchMeasure()  - times one API, median and worst case.</br>
+ *      <br>4)  App_BenchPrint()    - prints the table of one clock setting.</br>
+ *      <br>5)  Error_Handler()     - stops on a failed configuration.</br>
+ *
+ * A third application next to main.c and led_toggle.c, built instead of
+ * them. Every API is called BENCH_SAMPLES times at each clock setting with
+ * interrupts masked, timed with DWT_CYCCNT; the cost of reading the counter
+ * and of the indirect call is measured once and removed. The first row of a
+ * table is the switch into the setting from MSI 4 MHz. The tables go to
+ * stdout (SWO, see Tools/swo_decode.py) and stay in bench_results for the
+ * debugger. The ART prefetch is off and the caches on, their reset state.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+#include <stdint.h>
+#include <stdio.h>
+
+/* Here go the project includes */
+
+/* Here go the own includes */
+#include <stm32l475xx.h>
+#include <driver_bench.h>
+#include <stm32l475xx_gpio_driver.h>
+#include <stm32l475xx_rcc_driver.h>
+#include <stm32l475xx_flash_driver.h>
+#include <stm32l475xx_pwr_driver.h>
+#include <stm32l475xx_itm_driver.h>
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+/* SWO rate of printf, every HCLK of the settings is a multiple of it */
+#define	BENCH_SWO_BAUD			ITM_BAUD_2M
+
+/* Wait states forced at 16 MHz, to show what the latency alone costs */
+#define	BENCH_FORCED_LATENCY		(4UL)
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static void Bench_Nothing(void);
+static void Bench_ClockBase(void);
+static void Bench_ClockSwitch(void);
+static void Bench_Msi4(void);
+static void Bench_Msi16(void);
+static void Bench_Msi16Slow(void);
+static void Bench_Msi48(void);
+static void Bench_Pll80(void);
+static void Bench_ReadPin(void);
+static void Bench_WritePin(void);
+static void Bench_TogglePin(void);
+static void Bench_ReadPort(void);
+static void Bench_WritePort(void);
+static void Bench_GpioInit(void);
+static void Bench_GetSYSCLK(void);
+static void Bench_GetHCLK(void);
+static void Bench_GetHCLKCached(void);
+static void Bench_GetMSIfreq(void);
+static void Bench_LsiOff(void);
+static void Bench_ConfigLSI(void);
+static void Bench_ConfigMCO(void);
+static void Bench_VoltageScaling(void);
+static void Bench_SetLatency(void);
+
+/*****************************************************************************/
+  /* CONSTANTS */
+/*****************************************************************************/
+static const Bench_Clock_t bench_clocks[] =
+{
+  {"MSI 4 MHz, 0 WS",                   Bench_Msi4},
+  {"MSI 16 MHz, 0 WS",                  Bench_Msi16},
+  {"MSI 16 MHz, 4 WS (forced)",         Bench_Msi16Slow},
+  {"MSI 48 MHz, 2 WS",                  Bench_Msi48},
+  {"PLL 80 MHz, 4 WS",                  Bench_Pll80}
+};
+
+/* FLASH_SetLatency() last, it undoes the forced latency */
+static const Bench_Api_t bench_apis[] =
+{
+  {"RCC_Config_* (switch)",             Bench_ClockBase,        Bench_ClockSwitch},
+  {"GPIO_ReadPin",                      0,                      Bench_ReadPin},
+  {"GPIO_WritePin",                     0,                      Bench_WritePin},
+  {"GPIO_TogglePin",                    0,                      Bench_TogglePin},
+  {"GPIO_ReadPort",                     0,                      Bench_ReadPort},
+  {"GPIO_WritePort",                    0,                      Bench_WritePort},
+  {"GPIO_Init",                         0,                      Bench_GpioInit},
+  {"RCC_GetSYSCLK",                     0,                      Bench_GetSYSCLK},
+  {"RCC_GetHCLK",                       0,                      Bench_GetHCLK},
+  {"RCC_GetHCLKCached",                 0,                      Bench_GetHCLKCached},
+  {"RCC_GetMSIfreq",                    0,                      Bench_GetMSIfreq},
+  {"RCC_Config_LSI",                    Bench_LsiOff,           Bench_ConfigLSI},
+  {"RCC_Config_MCO",                    0,                      Bench_ConfigMCO},
+  {"PWR_ControlVoltageScaling",         0,                      Bench_VoltageScaling},
+  {"FLASH_SetLatency",                  0,                      Bench_SetLatency}
+};
+
+#define	BENCH_CLOCKS			(sizeof(bench_clocks) / sizeof(bench_clocks[0]))
+#define	BENCH_APIS			(sizeof(bench_apis) / sizeof(bench_apis[0]))
+
+/*****************************************************************************/
+  /* PUBLIC VARIABLES */
+/*****************************************************************************/
+/* Results of the last run, read with the debugger */
+Bench_Result_t bench_results[BENCH_CLOCKS][BENCH_APIS];
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static const Bench_Clock_t *bench_clock = 0;
+static uint32_t bench_overhead = 0;
+static __vo uint32_t bench_sink = 0;
+
+int main()
+{
+  uint32_t clock;
+
+  App_BenchInit();
+
+  for(clock = 0; clock < BENCH_CLOCKS; clock++)
+  {
+    App_BenchClock(&bench_clocks[clock], bench_results[clock]);
+    App_BenchPrint(&bench_clocks[clock], bench_results[clock]);
+  }
+
+  /* Back to the reset clock, blink when done */
+  Bench_ClockBase();
+  while(1)
+  {
+    GPIO_TogglePin(GPIOB, GPIO_PIN_14);
+    for(clock = 0; clock < 400000UL; clock++)
+    {
+      bench_sink = clock;
+    }
+  }
+}
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+ /*************************************************************************//**
+ * @brief       This function enables the cycle counter, configures the LED
+ *              used by the GPIO benchmarks and the SWO output, and measures
+ *              the cost of an empty timed call.
+ *****************************************************************************/
+void App_BenchInit(void)
+{
+  GPIO_Handle_t GPIO_LED2;
+  Bench_Api_t nothing = {"", 0, Bench_Nothing};
+  Bench_Result_t result;
+
+  SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+  *DWT_CYCCNT = 0;
+  SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+  /* Range 1 for the settings above 26 MHz */
+  PWR_PCLK_EN();
+  if(PWR_ControlVoltageScaling(PWR_VOLTAGE_RANGE_1) != PWR_STATUS_OK)
+  {
+    Error_Handler();
+  }
+
+  GPIO_LED2.pGPIOx = GPIOB;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinNumber = GPIO_PIN_14;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUTPUT;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinSpeed = GPIO_OSPEED_LOW;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinOType = GPIO_OTYPE_PP;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PUPD_NONE;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinAltFunMode = 0;
+  GPIO_PeriphClkControl(GPIOB, ENABLE);
+  GPIO_Init(&GPIO_LED2);
+
+  /* The ITM driver follows the clock switches */
+  (void)ITM_Init(BENCH_SWO_BAUD, ITM_PORT_MASK(ITM_PORT_STDOUT));
+
+  bench_overhead = 0;
+  App_BenchMeasure(&nothing, &result);
+  bench_overhead = result.Best;
+
+  printf("driver_bench: %u samples per API, %lu cycles of timing overhead removed\n",
+         BENCH_SAMPLES, (unsigned long)bench_overhead);
+}
+
+ /*************************************************************************//**
+ * @brief       This function times every API of bench_apis at one clock
+ *              setting. The setting stays applied afterwards.
+ *
+ * @param       pClock      Clock setting.
+ * @param       pResults    BENCH_APIS results to fill.
+ *****************************************************************************/
+void App_BenchClock(const Bench_Clock_t *pClock, Bench_Result_t *pResults)
+{
+  uint32_t api;
+
+  bench_clock = pClock;
+
+  /* The switch row leaves the setting applied */
+  for(api = 0; api < BENCH_APIS; api++)
+  {
+    App_BenchMeasure(&bench_apis[api], &pResults[api]);
+  }
+}
+
+ /*************************************************************************//**
+ * @brief       This function calls an API BENCH_SAMPLES times with the
+ *              interrupts masked and keeps the median, the best and the
+ *              worst number of cycles.
+ *
+ * @param       pApi        API to time.
+ * @param       pResult     Result to fill.
+ *****************************************************************************/
+void App_BenchMeasure(const Bench_Api_t *pApi, Bench_Result_t *pResult)
+{
+  uint32_t samples[BENCH_SAMPLES];
+  uint32_t primask;
+  uint32_t start;
+  uint32_t cycles;
+  uint32_t i;
+  uint32_t j;
+
+  for(i = 0; i < BENCH_SAMPLES; i++)
+  {
+    if(pApi->pPrepare != 0)
+    {
+      pApi->pPrepare();
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    start = *DWT_CYCCNT;
+    pApi->pCall();
+    cycles = *DWT_CYCCNT - start;
+    __set_PRIMASK(primask);
+
+    cycles = (cycles > bench_overhead) ? (cycles - bench_overhead) : 0;
+
+    /* Insertion, the samples stay sorted */
+    for(j = i; (j > 0) && (samples[j - 1] > cycles); j--)
+    {
+      samples[j] = samples[j - 1];
+    }
+    samples[j] = cycles;
+  }
+
+  pResult->Best = samples[0];
+  pResult->Median = samples[BENCH_SAMPLES / 2];
+  pResult->Worst = samples[BENCH_SAMPLES - 1];
+}
+
+ /*************************************************************************//**
+ * @brief       This function prints the results of one clock setting.
+ *
+ * @param       pClock      Clock setting.
+ * @param       pResults    BENCH_APIS results.
+ *****************************************************************************/
+void App_BenchPrint(const Bench_Clock_t *pClock, const Bench_Result_t *pResults)
+{
+  uint32_t api;
+
+  printf("\n%s, HCLK %lu Hz\n", pClock->pName, (unsigned long)RCC_GetHCLKCached());
+  printf("%-28s %8s %8s %8s\n", "API", "best", "median", "worst");
+  for(api = 0; api < BENCH_APIS; api++)
+  {
+    printf("%-28s %8lu %8lu %8lu\n", bench_apis[api].pName, (unsigned long)pResults[api].Best,
+           (unsigned long)pResults[api].Median, (unsigned long)pResults[api].Worst);
+  }
+}
+
+void Error_Handler(void)
+{
+  while(1){};
+}
+
+/*****************************************************************************/
+  /* CLOCK SETTINGS */
+/*****************************************************************************/
+
+static void Bench_ClockBase(void)
+{
+  if(RCC_Config_MSI(RCC_MSISPEED_4M, 0x0U, RCC_AHBPRESCALER_DIV1) != RCC_STATUS_OK)
+  {
+    Error_Handler();
+  }
+}
+
+static void Bench_ClockSwitch(void)
+{
+  bench_clock->pApply();
+}
+
+static void Bench_Msi4(void)
+{
+  Bench_ClockBase();
+}
+
+static void Bench_Msi16(void)
+{
+  (void)RCC_Config_MSI(RCC_MSISPEED_16M, 0x0U, RCC_AHBPRESCALER_DIV1);
+}
+
+static void Bench_Msi16Slow(void)
+{
+  (void)RCC_Config_MSI(RCC_MSISPEED_16M, 0x0U, RCC_AHBPRESCALER_DIV1);
+
+  /* More wait states than needed are always allowed */
+  FLASH->FLASH_ACR = (FLASH->FLASH_ACR & ~(0x7UL)) | BENCH_FORCED_LATENCY;
+  while((FLASH->FLASH_ACR & 0x7UL) != BENCH_FORCED_LATENCY);
+}
+
+static void Bench_Msi48(void)
+{
+  (void)RCC_Config_MSI(RCC_MSISPEED_48M, 0x0U, RCC_AHBPRESCALER_DIV1);
+}
+
+static void Bench_Pll80(void)
+{
+  /* 4 MHz / 1 * 40 / 2 */
+  (void)RCC_Config_PLLCLK(RCC_PLLSRC_MSI, RCC_MSISPEED_4M, RCC_PLLM_1, 40, RCC_PLLR_2, RCC_AHBPRESCALER_DIV1);
+}
+
+/*****************************************************************************/
+  /* TIMED CALLS */
+/*****************************************************************************/
+
+static void Bench_Nothing(void)
+{
+}
+
+static void Bench_ReadPin(void)
+{
+  bench_sink = GPIO_ReadPin(GPIOB, GPIO_PIN_14);
+}
+
+static void Bench_WritePin(void)
+{
+  GPIO_WritePin(GPIOB, GPIO_PIN_14, GPIO_PIN_SET);
+}
+
+static void Bench_TogglePin(void)
+{
+  GPIO_TogglePin(GPIOB, GPIO_PIN_14);
+}
+
+static void Bench_ReadPort(void)
+{
+  bench_sink = GPIO_ReadPort(GPIOB);
+}
+
+static void Bench_WritePort(void)
+{
+  GPIO_WritePort(GPIOB, (uint16_t)(1U << GPIO_PIN_14));
+}
+
+static void Bench_GpioInit(void)
+{
+  GPIO_Handle_t GPIO_LED2;
+
+  GPIO_LED2.pGPIOx = GPIOB;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinNumber = GPIO_PIN_14;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUTPUT;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinSpeed = GPIO_OSPEED_LOW;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinOType = GPIO_OTYPE_PP;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PUPD_NONE;
+  GPIO_LED2.GPIO_PinConfig.GPIO_PinAltFunMode = 0;
+  GPIO_Init(&GPIO_LED2);
+}
+
+static void Bench_GetSYSCLK(void)
+{
+  bench_sink = RCC_GetSYSCLK();
+}
+
+static void Bench_GetHCLK(void)
+{
+  bench_sink = RCC_GetHCLK();
+}
+
+static void Bench_GetHCLKCached(void)
+{
+  bench_sink = RCC_GetHCLKCached();
+}
+
+static void Bench_GetMSIfreq(void)
+{
+  bench_sink = RCC_GetMSIfreq(RCC_MSISPEED_48M);
+}
+
+static void Bench_LsiOff(void)
+{
+  (void)RCC_Config_LSI(RESET);
+}
+
+static void Bench_ConfigLSI(void)
+{
+  (void)RCC_Config_LSI(SET);
+}
+
+static void Bench_ConfigMCO(void)
+{
+  RCC_Config_MCO(RCC_MCOPRE_DIV1, RCC_MCOSEL_SYSCLK);
+}
+
+static void Bench_VoltageScaling(void)
+{
+  (void)PWR_ControlVoltageScaling(PWR_VOLTAGE_RANGE_1);
+}
+
+static void Bench_SetLatency(void)
+{
+  FLASH_SetLatency(RCC_GetHCLKCached());
+}
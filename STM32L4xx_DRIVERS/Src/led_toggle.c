@@ -10,35 +10,160 @@
 #include <stm32l475xx_gpio_driver.h>
 #include <stm32l475xx_rcc_driver.h>
 #include <stm32l475xx_pwr_driver.h>
+#include <stm32l475xx_nvic_driver.h>
+#include <stm32l475xx_systick_driver.h>
+#include <kernel.h>
+#include <timer_wheel.h>
+#include <low_power.h>
+#include <tickless_idle.h>
+#include <timestamp.h>
+
+#define	BUTTON_TASK_PRIORITY		(1U)
+#define	BLINK_TASK_PRIORITY		(2U)
+#define	TASK_STACK_WORDS		(128U)
+#define	BLINK_PERIOD_TICKS		(500U)		/* 1 kHz tick */
+#define	DEBOUNCE_TICKS			(20U)
+
+static KRN_Task_t button_task;
+static KRN_Task_t blink_task;
+static uint32_t button_stack[TASK_STACK_WORDS] __attribute__((aligned(8)));
+static uint32_t blink_stack[TASK_STACK_WORDS] __attribute__((aligned(8)));
+
+/* Given once the button is stable, taken by Button_Task */
+static KRN_Sem_t button_sem;
+static TMW_Timer_t debounce_timer;
+
+/* Give-to-run latency of the button task, read with the debugger */
+KRN_SwitchStats_t switch_stats;
+
+/* Time of the last debounced press, in ns since TS_Init() */
+uint64_t press_time_ns;
 
 int main()
 {
-	uint32_t freq_SYSCLK = 0;
-	uint32_t freq_HCLK = 0;
-	RCC_STATUS status;
+	NVIC_RelocateVectorTable();
 
 	App_RCC_Init();
 	App_GPIO_Init();
 
-	freq_SYSCLK = RCC_GetSYSCLK();
-	freq_HCLK = RCC_GetHCLK();
+	KRN_SemInit(&button_sem, 0, 1);
+
+	if(KRN_TaskCreate(&button_task, Button_Task, 0, button_stack, TASK_STACK_WORDS, BUTTON_TASK_PRIORITY) != KRN_STATUS_OK)
+	{
+		Error_Handler();
+	}
+
+	if(KRN_TaskCreate(&blink_task, Blink_Task, 0, blink_stack, TASK_STACK_WORDS, BLINK_TASK_PRIORITY) != KRN_STATUS_OK)
+	{
+		Error_Handler();
+	}
+
+	App_EXTI_Init();
+
+	/* Kernel delays and software timers share the SysTick */
+	TMW_Init();
+	SYSTICK_SetTickHook(App_Tick);
+	if(SYSTICK_Init(SYSTICK_1KHZ, NVIC_PRIORITY_MAX - 1U) != SYSTICK_STATUS_OK)
+	{
+		Error_Handler();
+	}
+
+	/* Between deadlines the idle task sleeps in Stop 2 without ticks */
+	LPM_Init();
+	if(TLI_Init(LPTIM_CLOCK_LSI) != TLI_STATUS_OK)
+	{
+		Error_Handler();
+	}
+	TLI_SetTimebase(App_IdleTicks, App_Advance);
+	KRN_SetIdleHook(TLI_Idle);
+
+	/* Timestamps keep counting in Stop 2 on the LPTIM1 counter. The core
+	 * sleeps between blinks, the cycle counter never gets near its wrap */
+	if(TS_Init() != TS_STATUS_OK)
+	{
+		Error_Handler();
+	}
+	(void)TS_SetReference(App_ReadLPTIM, LPTIM_GetFrequency(), 0xFFFFUL);
+
+	KRN_Start();
+}
+
+/* Blinks LED2, sleeping in between */
+void Blink_Task(void *pArg)
+{
+	(void)pArg;
 
 	while(1)
 	{
 		GPIO_TogglePin(GPIOB, GPIO_PIN_14);
-		delay();
-		//GPIO_TogglePin(GPIOB, GPIO_PIN_14);
-		//delay();
-		//GPIO_TogglePin(GPIOA, GPIO_PIN_5);
-		//delay();
-		//GPIO_TogglePin(GPIOA, GPIO_PIN_5);
-		//delay();
+		KRN_Delay(BLINK_PERIOD_TICKS);
 	}
 }
 
-void delay(void)
+/* Toggles LED1 on every press of the user button */
+void Button_Task(void *pArg)
 {
-	for(uint64_t i = 0 ; i < 20000 ; i++);
+	(void)pArg;
+
+	while(1)
+	{
+		(void)KRN_SemTake(&button_sem, KRN_WAIT_FOREVER);
+		press_time_ns = TS_Now();
+
+		GPIO_TogglePin(GPIOA, GPIO_PIN_5);
+		KRN_GetSwitchStats(&switch_stats);
+	}
+}
+
+/* User button (EXTI line 13), installed in the EXTI15_10 vector. Every
+ * bounce restarts the debounce timer */
+__RAMFUNC void Button_IRQHandler(void)
+{
+	GPIO_IRQHandling(GPIO_PIN_13);
+	(void)TMW_Start(&debounce_timer, DEBOUNCE_TICKS, 0, Button_Debounced, 0);
+}
+
+/* Debounce timer expiry, in the SysTick handler */
+void Button_Debounced(void *pArg)
+{
+	(void)pArg;
+
+	(void)KRN_SemGive(&button_sem);
+}
+
+/* SysTick hook */
+void App_Tick(void)
+{
+	KRN_Tick();
+	TMW_Tick();
+}
+
+/* Ticks until a task delay or a software timer is due */
+uint32_t App_IdleTicks(void)
+{
+	uint32_t kernel = KRN_GetIdleTicks();
+	uint32_t timers = TMW_GetIdleTicks();
+
+	return (kernel < timers) ? kernel : timers;
+}
+
+/* Skips the ticks slept by the tickless idle */
+void App_Advance(uint32_t Ticks)
+{
+	KRN_Advance(Ticks);
+	TMW_Advance(Ticks);
+}
+
+/* LPTIM1 counter, reference of the timestamps in Stop modes */
+uint32_t App_ReadLPTIM(void)
+{
+	return LPTIM_GetCounter();
+}
+
+void App_EXTI_Init(void)
+{
+	(void)NVIC_SetVector(IRQ_NO_EXTI15_10, Button_IRQHandler);
+	GPIO_IRQConfig(IRQ_NO_EXTI15_10, 0, ENABLE);
 }
 
 void App_RCC_Init(void)
@@ -68,6 +193,7 @@ void App_GPIO_Init(void)
 	GPIO_Handle_t GPIO_LED1;
 	GPIO_Handle_t GPIO_LED2;
 	GPIO_Handle_t GPIO_MCO;
+	GPIO_Handle_t GPIO_BUTTON;
 
 	GPIO_LED1.pGPIOx = GPIOA;
 	GPIO_LED1.GPIO_PinConfig.GPIO_PinNumber = GPIO_PIN_5;
@@ -96,6 +222,15 @@ void App_GPIO_Init(void)
 	GPIO_MCO.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PUPD_NONE;
 	GPIO_PeriphClkControl(GPIOA, ENABLE);
 	GPIO_Init(&GPIO_MCO);
+
+	GPIO_BUTTON.pGPIOx = GPIOC;
+	GPIO_BUTTON.GPIO_PinConfig.GPIO_PinNumber = GPIO_PIN_13;
+	GPIO_BUTTON.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_ITFE;
+	GPIO_BUTTON.GPIO_PinConfig.GPIO_PinSpeed = GPIO_OSPEED_HIGH;
+	GPIO_BUTTON.GPIO_PinConfig.GPIO_PinOType = GPIO_OTYPE_PP;
+	GPIO_BUTTON.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PUPD_NONE;
+	GPIO_PeriphClkControl(GPIOC, ENABLE);
+	GPIO_Init(&GPIO_BUTTON);
 }
 
 void Error_Handler(void)
@@ -34,10 +34,34 @@
 #include <stm32l475xx_gpio_driver.h>
 #include <stm32l475xx_rcc_driver.h>
 #include <stm32l475xx_pwr_driver.h>
+#include <stm32l475xx_nvic_driver.h>
+#include <stm32l475xx_itm_driver.h>
+#include <stm32l475xx_lptim_driver.h>
+#include <low_power.h>
+#include <warm_resume.h>
+#include <deferred_work.h>
+#include <event_loop.h>
+#include <delay.h>
+#include <profiler.h>
+#include <binlog.h>
+#include <irq_monitor.h>
+#include <mem_usage.h>
+#include <timestamp.h>
 
 /*****************************************************************************/
   /* DEFINES */
 /*****************************************************************************/
+/* Longest acceptable delay between the button press and its handler */
+#define	APP_WAKEUP_DEADLINE_NS		(50000UL)
+
+/* Length of delay(), about what the former 200 iteration loop took at 4 MHz */
+#define	APP_DELAY_US			(500UL)
+
+/* SWO rate of printf, HCLK must be a multiple of it */
+#define	APP_SWO_BAUD			ITM_BAUD_2M
+
+/* Longest acceptable run of the button handler, in core cycles */
+#define	APP_BUTTON_BUDGET_CYCLES	(1000UL)
 
 /*****************************************************************************/
   /* TYPEDEFS */
@@ -53,6 +77,13 @@
 /* uint32_t freq_SYSCLK = 0; */
 /* uint32_t freq_HCLK = 0; */
 
+/* Cycles from the first to the last instruction of App_ButtonHandler.
+ * Build once normally and once with NO_RAMFUNC to compare SRAM2 and flash
+ * execution; the hardware stacking and unstacking (12 cycles each with zero
+ * wait state memory) is not included. */
+__vo uint32_t isr_cycles_last = 0;
+__vo uint32_t isr_cycles_max = 0;
+
 /*****************************************************************************/
   /* STATIC VARIABLES */
 /*****************************************************************************/
@@ -63,18 +94,53 @@
 
 int main()
 {
-  App_RCC_Init();
-  App_GPIO_Init();
+  /* Vectors from SRAM1, handlers installed at runtime */
+  NVIC_RelocateVectorTable();
+
+  /* Probes compiled in with PROF_ENABLE, the table is read with the
+   * debugger or printed by PROF_Dump() */
+  PROF_Init();
+
+  /* After Standby the clocks and pins were already restored by
+   * Reset_Handler from the SRAM2 snapshot */
+  if(WARM_IsWarmBoot() != 0)
+  {
+    (void)WARM_Complete();
+  }
+  else
+  {
+    App_RCC_Init();
+    App_GPIO_Init();
+  }
   App_EXTI_Init();
+  LPM_Init();
+  App_Time_Init();
 
-  /* freq_SYSCLK = RCC_GetSYSCLK(); */
-  /* freq_HCLK = RCC_GetHCLK(); */
+  /* CPU load and handler times, reported with every LED toggle. The idle
+   * time includes Stop 2, measured by the timestamps on LPTIM1 */
+  IRQMON_Init();
+  (void)IRQMON_Attach(IRQ_NO_EXTI15_10, APP_BUTTON_BUDGET_CYCLES);
+  (void)IRQMON_Attach(DEFER_IRQ_NUMBER, IRQMON_NO_BUDGET);
 
-  while(1)
+  /* stdout and stderr on ITM ports 0 and 1, see Tools/swo_decode.py;
+   * binary log records on port 2, see Tools/binlog_decode.py. Only with a
+   * probe: the trace keeps the clocks running in Stop 2. Without it the
+   * writes to the ports are dropped */
+  if((ITM_TRACE_IN_STOP != 0U) || (ITM_IsDebuggerAttached() != 0))
   {
-    //GPIO_TogglePin(GPIOB, GPIO_PIN_14);
-    //delay();
+    (void)ITM_Init(APP_SWO_BAUD, ITM_PORT_MASK(ITM_PORT_STDOUT) | ITM_PORT_MASK(ITM_PORT_STDERR) |
+                   ITM_PORT_MASK(ITM_PORT_BINLOG));
   }
+  BLOG_Init();
+
+  /* freq_SYSCLK = RCC_GetSYSCLK(); */
+  /* freq_HCLK = RCC_GetHCLK(); */
+
+  /* Everything happens in the button interrupt, sleep as deep as the
+   * response deadline allows whenever there is nothing to dispatch */
+  (void)EVL_Init(EVL_IDLE_WFI);
+  EVL_SetIdleHook(App_Idle);
+  EVL_Run();
 }
 
 /*****************************************************************************/
@@ -84,11 +150,12 @@ int main()
  /*************************************************************************//**
  * @brief       This function gives a delay for the toggling of LEDs. The
  *              function does not receives any parameter, neither returns
- *              anything.
+ *              anything. The length no longer depends on the clock nor on
+ *              the optimization level.
  *****************************************************************************/
 void delay(void)
 {
-  for(uint64_t i = 0 ; i < 200 ; i++);
+  DELAY_Us(APP_DELAY_US);
 }
 
  /*************************************************************************//**
@@ -96,6 +163,8 @@ void delay(void)
  *****************************************************************************/
 void App_RCC_Init(void)
 {
+  RCC_STATUS status;
+
   /* Setting the dynamic voltage range to the range that gets up to 80 MHz (Range 1). */
   if(PWR_ControlVoltageScaling(PWR_VOLTAGE_RANGE_1) != PWR_STATUS_OK)
   {
@@ -103,10 +172,13 @@ void App_RCC_Init(void)
   }
 
   /* Configuring oscillator */
-  if(RCC_Config_MSI(RCC_MSISPEED_4M, 0x0U, RCC_AHBPRESCALER_DIV1) != RCC_STATUS_OK)
-  //if(RCC_Config_HSI(RCC_AHBPRESCALER_DIV1) != RCC_STATUS_OK)
-  //if(RCC_Config_PLLCLK(RCC_PLLSRC_MSI, RCC_MSISPEED_32M, RCC_PLLM_6, 13, RCC_PLLR_2, RCC_AHBPRESCALER_DIV1) != RCC_STATUS_OK)
-  //if(RCC_Config_LSI(SET) != RCC_STATUS_OK)
+  PROF_BEGIN(rcc_config);
+  status = RCC_Config_MSI(RCC_MSISPEED_4M, 0x0U, RCC_AHBPRESCALER_DIV1);
+  //status = RCC_Config_HSI(RCC_AHBPRESCALER_DIV1);
+  //status = RCC_Config_PLLCLK(RCC_PLLSRC_MSI, RCC_MSISPEED_32M, RCC_PLLM_6, 13, RCC_PLLR_2, RCC_AHBPRESCALER_DIV1);
+  //status = RCC_Config_LSI(SET);
+  PROF_END(rcc_config);
+  if(status != RCC_STATUS_OK)
   {
           Error_Handler();
   }
@@ -134,7 +206,9 @@ void App_GPIO_Init(void)
   GPIO_LED2.GPIO_PinConfig.GPIO_PinOType = GPIO_OTYPE_PP;
   GPIO_LED2.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PUPD_NONE;
   GPIO_PeriphClkControl(GPIOB, ENABLE);
+  PROF_BEGIN(gpio_init);
   GPIO_Init(&GPIO_LED2);
+  PROF_END(gpio_init);
 
   /* Configuring MCO pin */
   GPIO_MCO.pGPIOx = GPIOA;
@@ -164,21 +238,126 @@ void App_GPIO_Init(void)
  *****************************************************************************/
 void App_EXTI_Init(void)
 {
+  /* Cycle counter used to time the handler */
+  SET_REG_BIT(*COREDEBUG_DEMCR, COREDEBUG_DEMCR_TRCENA);
+  *DWT_CYCCNT = 0;
+  SET_REG_BIT(*DWT_CTRL, DWT_CTRL_CYCCNTENA);
+
+  /* Bottom halves below every other interrupt */
+  if(DEFER_Init(NVIC_PRIORITY_MAX) != DEFER_STATUS_OK)
+  {
+    Error_Handler();
+  }
+
+  (void)NVIC_SetVector(IRQ_NO_EXTI15_10, App_ButtonHandler);
+
   GPIO_IRQConfig(IRQ_NO_EXTI15_10, 0, ENABLE);
 }
 
+ /*************************************************************************//**
+ * @brief       This function starts the timestamps with LPTIM1 as reference,
+ *              so they keep counting in Stop 2. LPTIM_Init() leaves the
+ *              compare at the top of the counter: the match wakes the device
+ *              once per wrap (262 s at LSI / 128), no sleep is longer than
+ *              the counter range.
+ *****************************************************************************/
+void App_Time_Init(void)
+{
+  (void)RCC_Config_LSI(SET);
+  if(LPTIM_Init(LPTIM_CLOCK_LSI, LPTIM_PRESCALER_DIV128) != LPTIM_STATUS_OK)
+  {
+    Error_Handler();
+  }
+
+  (void)NVIC_SetVector(IRQ_NO_LPTIM1, App_LPTIMHandler);
+  (void)NVIC_ClearPending(IRQ_NO_LPTIM1);
+  (void)NVIC_IRQConfig(IRQ_NO_LPTIM1, ENABLE);
+  if(LPM_EnableWakeupLine(LPM_EXTI_LINE_LPTIM1, LPM_EDGE_KEEP, ENABLE) != LPM_STATUS_OK)
+  {
+    Error_Handler();
+  }
+
+  if(TS_Init() != TS_STATUS_OK)
+  {
+    Error_Handler();
+  }
+  (void)TS_SetReference(App_ReadLPTIM, LPTIM_GetFrequency(), LPTIM_COUNTER_MASK);
+}
+
+ /*************************************************************************//**
+ * @brief       LPTIM1 counter, reference of the timestamps in Stop modes.
+ *****************************************************************************/
+uint32_t App_ReadLPTIM(void)
+{
+  return LPTIM_GetCounter();
+}
+
+ /*************************************************************************//**
+ * @brief       Handler of LPTIM1, installed by App_Time_Init(). The wakeup
+ *              once per counter wrap is the work: only the flag is cleared.
+ *****************************************************************************/
+void App_LPTIMHandler(void)
+{
+  LPTIM_ClearFlags(1UL << LPTIM_ISR_CMPM);
+}
+
 void Error_Handler(void)
 {
   while(1){};
 }
 
-void EXTI15_10_IRQHandler(void)
+ /*************************************************************************//**
+ * @brief       Handler of the user button (EXTI line 13), installed in the
+ *              EXTI15_10 vector by App_EXTI_Init().
+ *****************************************************************************/
+__RAMFUNC void App_ButtonHandler(void)
 {
-  /* ISR code for Handling the Interrupt */
-  GPIO_TogglePin(GPIOB, GPIO_PIN_14);
+  uint32_t start = *DWT_CYCCNT;
+  uint32_t cycles;
+  PROF_BEGIN(button_isr);
 
   /* Clear the EXTI Pending Register */
   GPIO_IRQHandling(GPIO_PIN_13);
+
+  /* The LED work runs in the bottom half */
+  (void)DEFER_Post(DEFER_PRIORITY_HIGH, App_ToggleLed, 0);
+
+  PROF_END(button_isr);
+  cycles = *DWT_CYCCNT - start;
+  BLOG("button isr %u cycles", cycles);
+  isr_cycles_last = cycles;
+  if(cycles > isr_cycles_max)
+  {
+    isr_cycles_max = cycles;
+  }
+}
+
+ /*************************************************************************//**
+ * @brief       Idle hook of the event loop.
+ *****************************************************************************/
+void App_Idle(void)
+{
+  IRQMON_IdleEnter();
+  (void)LPM_EnterDeepest(APP_WAKEUP_DEADLINE_NS);
+  IRQMON_IdleExit();
+}
+
+ /*************************************************************************//**
+ * @brief       Bottom half of the button, posted by App_ButtonHandler().
+ *****************************************************************************/
+void App_ToggleLed(void *pArg)
+{
+  (void)pArg;
+
+  GPIO_TogglePin(GPIOB, GPIO_PIN_14);
+
+  /* Load since the previous toggle */
+  IRQMON_GetReport(0);
+  IRQMON_Log();
+  MEMU_Log();
+
+  /* Records of the handler, formatted by the host */
+  (void)BLOG_Flush();
 }
 
 /* Initial commit on develop */
@@ -49,34 +49,51 @@
 /* Includes */
 #include <errno.h>
 #include <stdio.h>
+#include <stdint.h>
 
 /* Variables */
 extern int errno;
 register char * stack_ptr asm("sp");
 
+/* Heap statistics, read by Middleware/Src/mem_usage.c */
+char *sbrk_heap_end = 0;	/* Current break, 0 before the first call */
+char *sbrk_heap_peak = 0;	/* Highest break */
+uint32_t sbrk_failures = 0;	/* Requests refused with ENOMEM */
+
 /* Functions */
 
 /**
  _sbrk
- Increase program data space. Malloc and related functions depend on this
+ Increase program data space. Malloc and related functions depend on this.
+ The heap stops _Min_Stack_Size below _estack, or at the live stack pointer
+ if the stack is already deeper than that.
 **/
 caddr_t _sbrk(int incr)
 {
 	extern char end asm("end");
-	static char *heap_end;
+	extern char _estack[];
+	extern char _Min_Stack_Size[];
 	char *prev_heap_end;
+	char *limit;
+
+	if (sbrk_heap_end == 0)
+		sbrk_heap_end = &end;
 
-	if (heap_end == 0)
-		heap_end = &end;
+	limit = _estack - (uint32_t)_Min_Stack_Size;
+	if (stack_ptr < limit)
+		limit = stack_ptr;
 
-	prev_heap_end = heap_end;
-	if (heap_end + incr > stack_ptr)
+	prev_heap_end = sbrk_heap_end;
+	if (sbrk_heap_end + incr > limit)
 	{
+		sbrk_failures++;
 		errno = ENOMEM;
 		return (caddr_t) -1;
 	}
 
-	heap_end += incr;
+	sbrk_heap_end += incr;
+	if (sbrk_heap_end > sbrk_heap_peak)
+		sbrk_heap_peak = sbrk_heap_end;
 
 	return (caddr_t) prev_heap_end;
 }
@@ -15,6 +15,8 @@
 
 .global g_pfnVectors
 .global Default_Handler
+.global stack_painted
+.weak WARM_EarlyResume
 
 /* start address for the initialization values of the .data section.
 defined in linker script */
@@ -27,6 +29,13 @@ defined in linker script */
 .word _sbss
 /* end address for the .bss section. defined in linker script */
 .word _ebss
+/* start address for the initialization values of the .ramfunc section.
+defined in linker script */
+.word _siramfunc
+/* start address for the .ramfunc section. defined in linker script */
+.word _sramfunc
+/* end address for the .ramfunc section. defined in linker script */
+.word _eramfunc
 
 /**
  * @brief  This is the code that gets called when the processor first
@@ -44,6 +53,18 @@ Reset_Handler:
   ldr   r0, =_estack
   mov   sp, r0          /* set stack pointer */
 
+/* Fast path after a Standby wakeup: restore clocks and pins from the SRAM2
+ * snapshot before the rest of the startup. Skipped if warm_resume.c is not
+ * linked. r5 keeps its result, 1 after a warm boot. */
+  movs  r5, #0
+  ldr   r0, =WARM_EarlyResume
+  cmp   r0, #0
+  beq   SkipWarmResume
+  blx   r0
+  mov   r5, r0
+
+SkipWarmResume:
+
 /* Copy the data segment initializers from flash to SRAM */
   ldr r0, =_sdata
   ldr r1, =_edata
@@ -61,6 +82,23 @@ LoopCopyDataInit:
   cmp r4, r1
   bcc CopyDataInit
 
+/* Copy the RAM functions from flash to SRAM2 */
+  ldr r0, =_sramfunc
+  ldr r1, =_eramfunc
+  ldr r2, =_siramfunc
+  movs r3, #0
+  b LoopCopyRamfuncInit
+
+CopyRamfuncInit:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopyRamfuncInit:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopyRamfuncInit
+
 /* Zero fill the bss segment. */
   ldr r2, =_sbss
   ldr r4, =_ebss
@@ -75,6 +113,31 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Paint the free RAM from the end of .bss to the stack pointer, the heap
+ * and stack high-water marks are read by Middleware/Src/mem_usage.c.
+ * The pattern is MEMU_PAINT_PATTERN. Not after a warm boot: tens of
+ * milliseconds at 4 MHz, stack_painted stays 0 then. */
+  cmp r5, #0
+  bne SkipPaintStack
+  ldr r2, =end
+  mov r4, sp
+  ldr r3, =0xCDCDCDCD
+  b LoopPaintStack
+
+PaintStack:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopPaintStack:
+  cmp r2, r4
+  bcc PaintStack
+
+  ldr r2, =stack_painted
+  movs r3, #1
+  str r3, [r2]
+
+SkipPaintStack:
+
 /* Call the clock system intitialization function.*/
   bl  SystemInit
 /* Call static constructors */
@@ -87,6 +150,14 @@ LoopForever:
 
   .size Reset_Handler, .-Reset_Handler
 
+/* 1 once the free RAM is painted, see Middleware/Src/mem_usage.c */
+  .section .bss.stack_painted,"aw",%nobits
+  .align 2
+  .type stack_painted, %object
+stack_painted:
+  .space 4
+  .size stack_painted, .-stack_painted
+
 /**
  * @brief  This is the code that gets called when the processor receives an
  *         unexpected interrupt.  This simply enters an infinite loop, preserving
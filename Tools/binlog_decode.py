@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""Rebuilds the text of the binary logger records of the firmware.
+
+The records (see Middleware/Inc/binlog.h) are 32-bit little endian words:
+a header with the valid bit, the argument count and the offset of the
+format string in the .binlog_fmt section of the ELF file, the DWT_CYCCNT
+value, then the arguments. They arrive on ITM stimulus port 2 of a raw SWO
+capture (--swo), or as a plain word stream (--raw), for example the file 3
+output of a host build.
+
+Examples:
+    binlog_decode.py --elf Debug/STM32L4xx_DRIVERS.elf --swo swo.bin
+    binlog_decode.py --elf Debug/STM32L4xx_DRIVERS.elf --raw log.bin --hclk 80000000
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+import itm
+
+BINLOG_PORT = 2
+HEADER_VALID = 0x80000000
+ID_MASK = 0x00FFFFFF
+ID_DROPPED = 0x00FFFFFF
+MAX_ARGS = 8
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+
+_CONVERSION = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|z|t|j)?([diouxXcspf%])")
+
+
+class Elf:
+    """Sections of an ELF file, 32 or 64-bit little endian."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[5] != 1:
+            raise ValueError("%s: not a little endian ELF file" % path)
+        if self.data[4] == 1:
+            shoff, = struct.unpack_from("<I", self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x2E)
+            fmt = "<IIIIIIIIII"
+        else:
+            shoff, = struct.unpack_from("<Q", self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x3A)
+            fmt = "<IIQQQQIIQQ"
+
+        headers = [struct.unpack_from(fmt, self.data, shoff + i * shentsize) for i in range(shnum)]
+        names = headers[shstrndx][4]
+        self.sections = []
+        for name, kind, flags, addr, offset, size, _, _, _, _ in headers:
+            self.sections.append((self._string(names + name), kind, flags, addr, offset, size))
+
+    def _string(self, offset):
+        end = self.data.index(b"\0", offset)
+        return self.data[offset:end].decode("utf-8", "replace")
+
+    def section(self, name):
+        for section in self.sections:
+            if section[0] == name:
+                return section
+        return None
+
+    def format_string(self, ident):
+        section = self.section(".binlog_fmt")
+        if section is None or ident >= section[5]:
+            return None
+        return self._string(section[4] + ident)
+
+    def target_string(self, address):
+        """String at a flash address of the target, for %s."""
+        for name, kind, flags, addr, offset, size in self.sections:
+            if kind == SHT_PROGBITS and (flags & SHF_ALLOC) and addr <= address < addr + size:
+                return self._string(offset + address - addr)
+        return "<0x%08x>" % address
+
+
+def format_record(elf, fmt, args):
+    """printf of the target with 32-bit arguments."""
+    values = list(args)
+
+    def convert(match):
+        flags, width, precision, kind = match.groups()
+        if kind == "%":
+            return "%"
+        if not values:
+            return "<missing>"
+        value = values.pop(0)
+        spec = "%" + flags + width + (("." + precision) if precision else "")
+        if kind in "di":
+            return (spec + "d") % (value - (1 << 32) if value & 0x80000000 else value)
+        if kind == "c":
+            return (spec + "c") % chr(value & 0xFF)
+        if kind == "s":
+            return (spec + "s") % elf.target_string(value)
+        if kind == "p":
+            return "0x%08x" % value
+        if kind == "f":
+            return "<float 0x%08x>" % value
+        return (spec + kind) % value
+
+    return _CONVERSION.sub(convert, fmt)
+
+
+def words(stream):
+    for i in range(0, len(stream) - 3, 4):
+        yield struct.unpack_from("<I", stream, i)[0]
+
+
+def records(word_list):
+    """Yields (ident, cycles, args), skipping words until a valid header."""
+    i = 0
+    n = len(word_list)
+    while i < n:
+        header = word_list[i]
+        count = (header >> 24) & 0x7F
+        if not (header & HEADER_VALID) or count > MAX_ARGS or i + 2 + count > n:
+            i += 1
+            continue
+        yield header & ID_MASK, word_list[i + 1], word_list[i + 2:i + 2 + count]
+        i += 2 + count
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--elf", required=True, help="firmware image with .binlog_fmt")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--swo", help="raw SWO capture, records on ITM port 2")
+    source.add_argument("--raw", help="plain stream of record words")
+    parser.add_argument("--port", type=int, default=BINLOG_PORT)
+    parser.add_argument("--hclk", type=int, help="print times in us at this HCLK")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    if elf.section(".binlog_fmt") is None:
+        sys.exit("%s has no .binlog_fmt section" % args.elf)
+
+    with open(args.swo or args.raw, "rb") as f:
+        data = f.read()
+    if args.swo:
+        stream = bytearray()
+        for port, payload in itm.stimulus_bytes(data):
+            if port == args.port:
+                stream.extend(payload)
+        data = bytes(stream)
+
+    count = 0
+    unknown = 0
+    for ident, cycles, values in records(list(words(data))):
+        if args.hclk:
+            stamp = "%14.3f" % (cycles * 1e6 / args.hclk)
+        else:
+            stamp = "%10u" % cycles
+        if ident == ID_DROPPED:
+            text = "<%u records dropped>" % (values[0] if values else 0)
+        else:
+            fmt = elf.format_string(ident)
+            if fmt is None:
+                unknown += 1
+                text = "<unknown format 0x%06x>" % ident
+            else:
+                text = format_record(elf, fmt, values)
+        sys.stdout.write("%s  %s\n" % (stamp, text.rstrip("\n")))
+        count += 1
+
+    sys.stderr.write("%d records, %d unknown formats\n" % (count, unknown))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""Builds and runs the driver scenarios on the host register simulation.
+
+The drivers are compiled for the host with STM32L475XX_HOST_SIM together
+with the simulation (Drivers/Src/stm32l475xx_host_sim.c) and the scenarios
+of Tools/host_sim/scenarios.c. The key-value store is built with
+KVS_HOST_SIM on its flash simulator and runs the power-cut fuzzer of
+Middleware/Src/kv_store_fuzz.c. Every scenario must pass.
+
+There is one benchmark per driver API. The simulation counts every register
+access of a call, through the REG_BIT macros or the register structs alike,
+so the reads, writes and simulated cycles of an API are exact. They must not
+exceed its budget in Tools/host_sim/budgets.json: a driver change that adds
+bus accesses to an API fails until the budget is raised on purpose with
+--update-baseline. An API that got cheaper is reported so its budget can be
+lowered. The key-value store benchmarks count flash programs and erases
+per write and the bytes copied per garbage collected page the same way.
+The host time (ns) is informative only.
+
+Runs on x86-64 Linux with gcc.
+
+Examples:
+    host_sim.py
+    host_sim.py --update-baseline
+    host_sim.py --baseline other.json --tolerance 5
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DRIVERS = os.path.join(ROOT, "STM32L4xx_DRIVERS", "Drivers")
+MIDDLEWARE = os.path.join(ROOT, "STM32L4xx_DRIVERS", "Middleware")
+SCENARIOS = os.path.join(ROOT, "Tools", "host_sim", "scenarios.c")
+BUDGETS = os.path.join(ROOT, "Tools", "host_sim", "budgets.json")
+
+SOURCES = ["host_sim", "rcc_driver", "flash_driver", "gpio_driver", "pwr_driver",
+           "nvic_driver", "lptim_driver", "systick_driver", "itm_driver"]
+
+KVS_SOURCES = ["kv_store", "kv_store_flash_sim", "kv_store_fuzz"]
+
+CFLAGS = ["-O2", "-DSTM32L475XX_HOST_SIM", "-Wno-int-to-pointer-cast", "-Wno-pointer-to-int-cast"]
+KVS_CFLAGS = ["-O2", "-DKVS_HOST_SIM"]
+
+METRICS = ("reads", "writes", "cycles")
+
+
+def build(args, output):
+    sources = [os.path.join(DRIVERS, "Src", "stm32l475xx_%s.c" % name) for name in SOURCES]
+    command = [args.cc] + CFLAGS + ["-I" + os.path.join(DRIVERS, "Inc"), "-o", output] + sources + [SCENARIOS]
+    subprocess.run(command, check=True)
+
+
+def build_kvs(args, output):
+    sources = [os.path.join(MIDDLEWARE, "Src", "%s.c" % name) for name in KVS_SOURCES]
+    command = [args.cc] + KVS_CFLAGS + ["-I" + os.path.join(MIDDLEWARE, "Inc"), "-o", output] + sources
+    subprocess.run(command, check=True)
+
+
+def run(binary):
+    """Returns the scenario results and the benchmarks of one run."""
+    process = subprocess.run([binary], capture_output=True, text=True, timeout=600)
+    scenarios = []
+    benches = {}
+    for line in process.stdout.splitlines():
+        kind, _, rest = line.partition(" ")
+        if kind in ("PASS", "FAIL"):
+            name, _, reason = rest.partition(": ")
+            scenarios.append({"name": name, "passed": kind == "PASS", "reason": reason})
+        elif kind == "BENCH":
+            fields = rest.split()
+            benches[fields[0]] = {key: float(value) for key, value in (f.split("=") for f in fields[1:])}
+    if process.returncode not in (0, 1) or not scenarios:
+        raise RuntimeError("simulation exited with %d\n%s" % (process.returncode, process.stdout + process.stderr))
+    return scenarios, benches
+
+
+def compare(benches, baseline, tolerance):
+    """Returns the lines of the benchmarks above and below the baseline."""
+    regressions = []
+    improvements = []
+    for name, new in benches.items():
+        if name not in baseline:
+            regressions.append("%s: no budget" % name)
+    for name, old in sorted(baseline.items()):
+        new = benches.get(name)
+        if new is None:
+            regressions.append("%s: missing" % name)
+            continue
+        for metric in sorted(old):
+            limit = old[metric] * (1.0 + tolerance / 100.0)
+            if new[metric] > limit:
+                regressions.append("%s: %s %.2f, budget %.2f" % (name, metric, new[metric], old[metric]))
+            elif new[metric] < old[metric]:
+                improvements.append("%s: %s %.2f, budget %.2f" % (name, metric, new[metric], old[metric]))
+    return regressions, improvements
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--cc", default="gcc")
+    parser.add_argument("--json", action="store_true", help="print the results as JSON")
+    parser.add_argument("--baseline", default=BUDGETS,
+                        help="fail if a benchmark costs more than in this file (default: budgets.json)")
+    parser.add_argument("--no-baseline", action="store_true", help="do not check the budgets")
+    parser.add_argument("--tolerance", type=float, default=0.0,
+                        help="allowed increase over the baseline, in percent")
+    parser.add_argument("--update-baseline", metavar="FILE", nargs="?", const=BUDGETS,
+                        help="save the benchmarks as the budgets, to FILE or budgets.json")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as directory:
+        binary = os.path.join(directory, "host_sim")
+        build(args, binary)
+        scenarios, benches = run(binary)
+        binary = os.path.join(directory, "kvs_fuzz")
+        build_kvs(args, binary)
+        kvs_scenarios, kvs_benches = run(binary)
+        scenarios += kvs_scenarios
+        benches.update(kvs_benches)
+
+    failed = [s for s in scenarios if not s["passed"]]
+    regressions = []
+    improvements = []
+    if not args.no_baseline and not args.update_baseline:
+        with open(args.baseline) as f:
+            regressions, improvements = compare(benches, json.load(f), args.tolerance)
+
+    if args.update_baseline:
+        with open(args.update_baseline, "w") as f:
+            json.dump({name: {m: v for m, v in bench.items() if m != "ns"} for name, bench in benches.items()},
+                      f, indent=2, sort_keys=True)
+            f.write("\n")
+
+    if args.json:
+        json.dump({"scenarios": scenarios, "benches": benches, "regressions": regressions,
+                   "improvements": improvements},
+                  sys.stdout, indent=2, sort_keys=True)
+        sys.stdout.write("\n")
+    else:
+        for s in scenarios:
+            print("%s %s%s" % ("PASS" if s["passed"] else "FAIL", s["name"],
+                               (": " + s["reason"]) if s["reason"] else ""))
+        print("")
+        print("%-28s %8s %8s %8s %10s" % ("call", "reads", "writes", "cycles", "host ns"))
+        for name, bench in benches.items():
+            if all(m in bench for m in METRICS):
+                print("%-28s %8.2f %8.2f %8.2f %10.0f" % (name, bench["reads"], bench["writes"],
+                                                          bench["cycles"], bench["ns"]))
+            else:
+                print("%-28s %s %10.0f" % (name, " ".join("%s=%.2f" % (m, v) for m, v in sorted(bench.items())
+                                                           if m != "ns"), bench["ns"]))
+        for line in improvements:
+            print("BELOW BUDGET " + line)
+        for line in regressions:
+            print("OVER BUDGET " + line)
+
+    return 1 if failed or regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,704 @@
+/**************************************************************************//**
+ * @file    scenarios.c
+ * @brief   Driver scenarios and benchmarks run on the register simulation.
+ *
+ * This file has 4 functions definitions (input parameters omitted):
+ *      <br>1) main()                   - Runs the scenarios, then the benchmarks. </br>
+ *      <br>2) Scenario_Run()           - Runs one scenario from reset and prints its result. </br>
+ *      <br>3) Bench_Run()              - Runs one benchmark and prints its cost per call. </br>
+ *      <br>4) Bench_Calls()            - Calls the benchmarked API, counting around each call. </br>
+ *
+ * Built and run by Tools/host_sim.py with STM32L475XX_HOST_SIM, next to the
+ * driver sources. Each scenario starts from the reset state of the registers
+ * and fails on a wrong result, on a poll that never ends, or on a violation
+ * of the simulated hardware rules (see stm32l475xx_host_sim.h) it does not
+ * expect. There is one benchmark per driver API (entries to the low-power
+ * modes excepted): the register accesses of a call are the API's cost,
+ * checked by Tools/host_sim.py against Tools/host_sim/budgets.json. A
+ * benchmark fails like a scenario on a violation or an endless poll.
+ * One line per scenario and per benchmark:
+ *      PASS <name>
+ *      FAIL <name>: <reason>
+ *      BENCH <name> reads=<n> writes=<n> cycles=<n> ns=<n>
+ * with the benchmark values per call; ns is host time, traps included.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+#include <stdio.h>
+#include <time.h>
+
+/* Here go the project includes */
+#include <stm32l475xx_host_sim.h>
+#include <stm32l475xx_rcc_driver.h>
+#include <stm32l475xx_flash_driver.h>
+#include <stm32l475xx_gpio_driver.h>
+#include <stm32l475xx_pwr_driver.h>
+#include <stm32l475xx_nvic_driver.h>
+#include <stm32l475xx_lptim_driver.h>
+#include <stm32l475xx_systick_driver.h>
+#include <stm32l475xx_itm_driver.h>
+
+/* Here go the own includes */
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/** @name Scenario checks: the first failed one is reported.
+ */
+///@{
+#define	CHECK(condition)		Scenario_Check((condition) ? 1U : 0U, #condition, __LINE__)
+#define	CHECK_EQ(value, expected)	Scenario_CheckEqual((uint64_t)(value), (uint64_t)(expected), #value, __LINE__)
+///@}
+
+#define	BENCH_CALLS			(100U)
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef struct  /**< A scenario */
+{
+  const char    *pName;
+  void          (*pFunction)(void);
+  uint8_t       ExpectViolation;        /**< The scenario checks the simulation rules */
+}Scenario_t;
+
+typedef struct  /**< A benchmark, pFunction called BENCH_CALLS times */
+{
+  const char    *pName;                 /**< Driver API, the key of its access budget */
+  void          (*pSetup)(void);        /**< Once, not counted */
+  void          (*pPrepare)(uint32_t Call);     /**< Before every call, not counted */
+  void          (*pFunction)(uint32_t Call);
+}Bench_t;
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static char scenario_failure[256];
+static const Bench_t *bench_current;
+static uint64_t bench_reads;
+static uint64_t bench_writes;
+static uint64_t bench_cycles;
+static uint64_t bench_ns;
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+static void Scenario_Check(uint8_t Passed, const char *pText, int Line);
+static void Scenario_CheckEqual(uint64_t Value, uint64_t Expected, const char *pText, int Line);
+static uint8_t Scenario_Run(const Scenario_t *pScenario);
+static uint8_t Bench_Run(const Bench_t *pBench);
+static void Bench_Calls(void);
+static void App_InitPin(GPIO_RegDef_t *pGPIOx, uint8_t Pin, uint8_t Mode, uint8_t Speed, uint8_t PuPd);
+static uint32_t App_Latency(void);
+
+/*****************************************************************************/
+  /* SCENARIOS */
+/*****************************************************************************/
+
+static void Scn_ResetClock(void)
+{
+	CHECK_EQ(RCC_GetHCLK(), 4000000U);
+	CHECK_EQ(SIM_GetHCLK(), 4000000U);
+}
+
+static void Scn_Msi48(void)
+{
+	CHECK_EQ(RCC_Config_MSI(RCC_MSISPEED_48M, 0, RCC_AHBPRESCALER_DIV1), RCC_STATUS_OK);
+	CHECK_EQ(SIM_GetHCLK(), 48000000U);
+	CHECK_EQ(RCC_GetHCLKCached(), 48000000U);
+	CHECK_EQ(App_Latency(), 2U);
+}
+
+static void Scn_MsiSteps(void)
+{
+	static const uint32_t speeds[] = {RCC_MSISPEED_24M, RCC_MSISPEED_48M, RCC_MSISPEED_16M, RCC_MSISPEED_32M, RCC_MSISPEED_4M};
+	static const uint32_t hz[] = {24000000U, 48000000U, 16000000U, 32000000U, 4000000U};
+	uint32_t index;
+
+	for(index = 0; index < (sizeof(speeds) / sizeof(speeds[0])); index++)
+	{
+		CHECK_EQ(RCC_Config_MSI(speeds[index], 0, RCC_AHBPRESCALER_DIV1), RCC_STATUS_OK);
+		CHECK_EQ(SIM_GetHCLK(), hz[index]);
+		CHECK_EQ(RCC_GetHCLKCached(), hz[index]);
+	}
+	CHECK_EQ(App_Latency(), 0U);
+}
+
+static void Scn_Hsi16(void)
+{
+	CHECK_EQ(RCC_Config_HSI(RCC_AHBPRESCALER_DIV1), RCC_STATUS_OK);
+	CHECK_EQ((RCC->RCC_CFGR >> RCC_CFGR_SWS) & 0x3U, RCC_CFGR_SWS_HSI16);
+	CHECK_EQ(SIM_GetHCLK(), 16000000U);
+	CHECK_EQ(RCC_GetHCLKCached(), 16000000U);
+}
+
+static void Scn_Pll80(void)
+{
+	/* MSI 4 MHz x 40 / 2 */
+	CHECK_EQ(RCC_Config_PLLCLK(RCC_PLLSRC_MSI, RCC_MSISPEED_4M, 0, 40, 0, RCC_AHBPRESCALER_DIV1), RCC_STATUS_OK);
+	CHECK_EQ((RCC->RCC_CFGR >> RCC_CFGR_SWS) & 0x3U, RCC_CFGR_SWS_PLL);
+	CHECK_EQ(SIM_GetHCLK(), 80000000U);
+	CHECK_EQ(RCC_GetHCLKCached(), 80000000U);
+	CHECK_EQ(App_Latency(), 4U);
+
+	/* And back, the PLL input keeps running */
+	CHECK_EQ(RCC_Config_MSI(RCC_MSISPEED_4M, 0, RCC_AHBPRESCALER_DIV1), RCC_STATUS_OK);
+	CHECK_EQ(SIM_GetHCLK(), 4000000U);
+	CHECK_EQ(App_Latency(), 0U);
+}
+
+static void Scn_Range2Overclock(void)
+{
+	SIM_Stats_t stats;
+
+	/* The drivers do not check the voltage range, the simulation does */
+	PWR_PCLK_EN();
+	CHECK_EQ(PWR_ControlVoltageScaling(PWR_VOLTAGE_RANGE_2), PWR_STATUS_OK);
+	SIM_ClearStats();
+	CHECK_EQ(RCC_Config_MSI(RCC_MSISPEED_48M, 0, RCC_AHBPRESCALER_DIV1), RCC_STATUS_OK);
+	SIM_GetStats(&stats);
+	CHECK(stats.Violations != 0);
+}
+
+static void Scn_FlashLock(void)
+{
+	CHECK(READ_REG_BIT(FLASH->FLASH_CR, FLASH_CR_LOCK) != 0);
+	CHECK_EQ(FLASH_Unlock(), FLASH_STATUS_OK);
+	CHECK(READ_REG_BIT(FLASH->FLASH_CR, FLASH_CR_LOCK) == 0);
+	FLASH_Lock();
+	CHECK(READ_REG_BIT(FLASH->FLASH_CR, FLASH_CR_LOCK) != 0);
+	CHECK_EQ(FLASH_Unlock(), FLASH_STATUS_OK);
+}
+
+static void Scn_GpioOutput(void)
+{
+	/* LED2 */
+	App_InitPin(GPIOB, GPIO_PIN_14, GPIO_MODE_OUTPUT, GPIO_OSPEED_LOW, GPIO_PUPD_NONE);
+	CHECK_EQ((GPIOB->GPIO_MODER >> 28) & 0x3U, GPIO_MODE_OUTPUT);
+
+	GPIO_WritePin(GPIOB, GPIO_PIN_14, GPIO_PIN_SET);
+	CHECK_EQ(GPIO_ReadPort(GPIOB) & (1U << 14), 0U);	/* Input not driven */
+	CHECK(GPIOB->GPIO_ODR & (1U << 14));
+	GPIO_TogglePin(GPIOB, GPIO_PIN_14);
+	CHECK_EQ(GPIOB->GPIO_ODR & (1U << 14), 0U);
+}
+
+static void Scn_GpioReconfigure(void)
+{
+	App_InitPin(GPIOA, GPIO_PIN_5, GPIO_MODE_OUTPUT, GPIO_OSPEED_VERYHIGH, GPIO_PUPD_PD);
+	App_InitPin(GPIOA, GPIO_PIN_5, GPIO_MODE_OUTPUT, GPIO_OSPEED_LOW, GPIO_PUPD_PU);
+	CHECK_EQ((GPIOA->GPIO_OSPEEDR >> 10) & 0x3U, GPIO_OSPEED_LOW);
+	CHECK_EQ((GPIOA->GPIO_PUPDR >> 10) & 0x3U, GPIO_PUPD_PU);
+
+	/* The neighbours keep their reset values */
+	CHECK_EQ(GPIOA->GPIO_OSPEEDR & ~(0x3UL << 10), 0x0C000000U);
+	CHECK_EQ(GPIOA->GPIO_PUPDR & ~(0x3UL << 10), 0x64000000U);
+}
+
+static void Scn_GpioClockOff(void)
+{
+	SIM_Stats_t stats;
+
+	GPIO_WritePin(GPIOC, GPIO_PIN_5, GPIO_PIN_SET);
+	SIM_GetStats(&stats);
+	CHECK(stats.Violations != 0);
+
+	GPIO_PeriphClkControl(GPIOC, ENABLE);
+	CHECK_EQ(GPIOC->GPIO_ODR, 0U);
+}
+
+static void Scn_ExtiPending(void)
+{
+	App_InitPin(GPIOC, GPIO_PIN_13, GPIO_MODE_ITFE, GPIO_OSPEED_LOW, GPIO_PUPD_NONE);
+	App_InitPin(GPIOC, GPIO_PIN_12, GPIO_MODE_ITFE, GPIO_OSPEED_LOW, GPIO_PUPD_NONE);
+
+	SIM_SetPin(GPIOC, GPIO_PIN_13, 1);
+	CHECK_EQ(EXTI->EXTI_PR1, 0U);			/* Rising edge not selected */
+	SIM_SetPin(GPIOC, GPIO_PIN_12, 1);
+	SIM_SetPin(GPIOC, GPIO_PIN_13, 0);
+	SIM_SetPin(GPIOC, GPIO_PIN_12, 0);
+	CHECK_EQ(EXTI->EXTI_PR1, (1U << 13) | (1U << 12));
+	CHECK_EQ(NVIC_IsPending(IRQ_NO_EXTI15_10), 1U);
+
+	/* Clearing one line leaves the other pending */
+	GPIO_IRQHandling(GPIO_PIN_13);
+	CHECK_EQ(EXTI->EXTI_PR1, (1U << 12));
+	GPIO_IRQHandling(GPIO_PIN_12);
+	CHECK_EQ(EXTI->EXTI_PR1, 0U);
+}
+
+static void Scn_Nvic(void)
+{
+	CHECK_EQ(NVIC_IRQConfig(IRQ_NO_EXTI15_10, ENABLE), NVIC_STATUS_OK);
+	CHECK_EQ(NVIC_IRQConfig(IRQ_NO_LPTIM1, ENABLE), NVIC_STATUS_OK);
+	CHECK_EQ(NVIC_IsEnabled(IRQ_NO_EXTI15_10), 1U);
+	CHECK_EQ(NVIC_IRQConfig(IRQ_NO_EXTI15_10, DISABLE), NVIC_STATUS_OK);
+	CHECK_EQ(NVIC_IsEnabled(IRQ_NO_EXTI15_10), 0U);
+	CHECK_EQ(NVIC_IsEnabled(IRQ_NO_LPTIM1), 1U);
+
+	CHECK_EQ(NVIC_SetPending(IRQ_NO_FLASH), NVIC_STATUS_OK);
+	CHECK_EQ(NVIC_IsPending(IRQ_NO_FLASH), 1U);
+	CHECK_EQ(NVIC_ClearPending(IRQ_NO_FLASH), NVIC_STATUS_OK);
+	CHECK_EQ(NVIC_IsPending(IRQ_NO_FLASH), 0U);
+}
+
+static void Scn_Lptim(void)
+{
+	uint16_t start;
+
+	CHECK_EQ(RCC_Config_LSI(SET), RCC_STATUS_OK);
+	CHECK_EQ(LPTIM_Init(LPTIM_CLOCK_LSI, LPTIM_PRESCALER_DIV1), LPTIM_STATUS_OK);
+	start = LPTIM_GetCounter();
+	SIM_AddCycles(10U * SIM_LPTIM_COUNT_CYCLES);
+	CHECK((uint16_t)(LPTIM_GetCounter() - start) >= 10U);
+	LPTIM_SetCompare(100);
+}
+
+static const Scenario_t scenarios[] =
+{
+	{"reset_clock",			Scn_ResetClock,		0},
+	{"msi_48mhz",			Scn_Msi48,		0},
+	{"msi_steps",			Scn_MsiSteps,		0},
+	{"hsi16",			Scn_Hsi16,		0},
+	{"pll_80mhz",			Scn_Pll80,		0},
+	{"range2_overclock_flagged",	Scn_Range2Overclock,	1},
+	{"flash_lock",			Scn_FlashLock,		0},
+	{"gpio_output",			Scn_GpioOutput,		0},
+	{"gpio_reconfigure",		Scn_GpioReconfigure,	0},
+	{"gpio_clock_off_flagged",	Scn_GpioClockOff,	1},
+	{"exti_pending",		Scn_ExtiPending,	0},
+	{"nvic",			Scn_Nvic,		0},
+	{"lptim",			Scn_Lptim,		0}
+};
+
+/*****************************************************************************/
+  /* BENCHMARKS */
+/*****************************************************************************/
+
+static void Bch_SetupLed(void)
+{
+	App_InitPin(GPIOB, GPIO_PIN_14, GPIO_MODE_OUTPUT, GPIO_OSPEED_LOW, GPIO_PUPD_NONE);
+}
+
+static void Bch_SetupButton(void)
+{
+	App_InitPin(GPIOC, GPIO_PIN_13, GPIO_MODE_ITFE, GPIO_OSPEED_LOW, GPIO_PUPD_NONE);
+}
+
+static void Bch_SetupPwr(void)
+{
+	PWR_PCLK_EN();
+}
+
+static void Bch_SetupLowPowerRun(void)
+{
+	PWR_PCLK_EN();
+	(void)RCC_Config_MSI(RCC_MSISPEED_2M, 0, RCC_AHBPRESCALER_DIV1);
+}
+
+static void Bch_SetupLptim(void)
+{
+	(void)RCC_Config_LSI(SET);
+	(void)LPTIM_Init(LPTIM_CLOCK_LSI, LPTIM_PRESCALER_DIV1);
+}
+
+static void Bch_SetupSystick(void)
+{
+	(void)SYSTICK_Init(SYSTICK_1KHZ, 15);
+}
+
+static void Bch_SetupItm(void)
+{
+	(void)ITM_Init(2000000U, ITM_PORT_MASK(ITM_PORT_STDOUT));
+}
+
+/* Preparations, not counted */
+
+static void Prp_Msi4(uint32_t Call)
+{
+	(void)Call;
+	(void)RCC_Config_MSI(RCC_MSISPEED_4M, 0, RCC_AHBPRESCALER_DIV1);
+}
+
+static void Prp_LsiOff(uint32_t Call)
+{
+	(void)Call;
+	(void)RCC_Config_LSI(RESET);
+}
+
+static void Prp_FlashLock(uint32_t Call)
+{
+	(void)Call;
+	FLASH_Lock();
+}
+
+static void Prp_ButtonEdge(uint32_t Call)
+{
+	(void)Call;
+	SIM_SetPin(GPIOC, GPIO_PIN_13, 1);
+	SIM_SetPin(GPIOC, GPIO_PIN_13, 0);
+}
+
+static void Prp_LowPowerRun(uint32_t Call)
+{
+	(void)Call;
+	(void)PWR_EnableLowPowerRun();
+}
+
+static void Prp_LptimOff(uint32_t Call)
+{
+	(void)Call;
+	LPTIM_DeInit();
+}
+
+static void Prp_LptimOn(uint32_t Call)
+{
+	(void)Call;
+	(void)LPTIM_Init(LPTIM_CLOCK_LSI, LPTIM_PRESCALER_DIV1);
+}
+
+/* Calls */
+
+static void Bch_GpioClk(uint32_t Call)		{ GPIO_PeriphClkControl(GPIOB, (uint8_t)((Call & 1U) ^ 1U)); }
+static void Bch_GpioInit(uint32_t Call)		{ App_InitPin(GPIOB, GPIO_PIN_14, GPIO_MODE_OUTPUT, (uint8_t)(Call & 3U), GPIO_PUPD_NONE); }
+static void Bch_GpioDeInit(uint32_t Call)	{ (void)Call; GPIO_DeInit(GPIOB); }
+static void Bch_ReadPin(uint32_t Call)		{ (void)Call; (void)GPIO_ReadPin(GPIOB, GPIO_PIN_14); }
+static void Bch_ReadPort(uint32_t Call)		{ (void)Call; (void)GPIO_ReadPort(GPIOB); }
+static void Bch_WritePin(uint32_t Call)		{ GPIO_WritePin(GPIOB, GPIO_PIN_14, (uint8_t)(Call & 1U)); }
+static void Bch_WritePort(uint32_t Call)	{ GPIO_WritePort(GPIOB, (uint16_t)Call); }
+static void Bch_TogglePin(uint32_t Call)	{ (void)Call; GPIO_TogglePin(GPIOB, GPIO_PIN_14); }
+static void Bch_GpioIRQConfig(uint32_t Call)	{ GPIO_IRQConfig(IRQ_NO_EXTI15_10, 5, (uint8_t)(Call & 1U)); }
+static void Bch_IRQHandling(uint32_t Call)	{ (void)Call; GPIO_IRQHandling(GPIO_PIN_13); }
+
+static void Bch_ConfigMSI(uint32_t Call)	{ (void)RCC_Config_MSI(((Call & 1U) != 0) ? RCC_MSISPEED_4M : RCC_MSISPEED_48M, 0, RCC_AHBPRESCALER_DIV1); }
+static void Bch_ConfigHSI(uint32_t Call)	{ (void)Call; (void)RCC_Config_HSI(RCC_AHBPRESCALER_DIV1); }
+static void Bch_ConfigPLL(uint32_t Call)	{ (void)Call; (void)RCC_Config_PLLCLK(RCC_PLLSRC_MSI, RCC_MSISPEED_4M, 0, 40, 0, RCC_AHBPRESCALER_DIV1); }
+static void Bch_ConfigLSI(uint32_t Call)	{ (void)Call; (void)RCC_Config_LSI(SET); }
+static void Bch_ConfigMCO(uint32_t Call)	{ RCC_Config_MCO(RCC_MCOPRE_DIV1, (uint8_t)(((Call & 1U) != 0) ? RCC_MCOSEL_MSI : RCC_MCOSEL_SYSCLK)); }
+static void Bch_GetSYSCLK(uint32_t Call)	{ (void)Call; (void)RCC_GetSYSCLK(); }
+static void Bch_GetHCLK(uint32_t Call)		{ (void)Call; (void)RCC_GetHCLK(); }
+static void Bch_GetHCLKCached(uint32_t Call)	{ (void)Call; (void)RCC_GetHCLKCached(); }
+
+static void Bch_SetLatency(uint32_t Call)	{ FLASH_SetLatency(((Call & 1U) != 0) ? 4000000U : 48000000U); }
+static void Bch_FlashUnlock(uint32_t Call)	{ (void)Call; (void)FLASH_Unlock(); }
+static void Bch_FlashLock(uint32_t Call)	{ (void)Call; FLASH_Lock(); }
+static void Bch_ConfigART(uint32_t Call)	{ FLASH_ConfigART(ENABLE, ENABLE, (uint8_t)(Call & 1U)); }
+static void Bch_RunPowerDown(uint32_t Call)	{ FLASH_SetRunPowerDown((uint8_t)(Call & 1U)); }
+static void Bch_SleepPowerDown(uint32_t Call)	{ FLASH_SetSleepPowerDown((uint8_t)(Call & 1U)); }
+
+static void Bch_VoltageScaling(uint32_t Call)	{ (void)PWR_ControlVoltageScaling(((Call & 1U) != 0) ? PWR_VOLTAGE_RANGE_1 : PWR_VOLTAGE_RANGE_2); }
+static void Bch_ConfigWakeupPin(uint32_t Call)	{ (void)PWR_ConfigWakeupPin(PWR_WAKEUP_PIN2, PWR_WAKEUP_FALLING, (uint8_t)(Call & 1U)); }
+static void Bch_GetWakeupFlags(uint32_t Call)	{ (void)Call; (void)PWR_GetWakeupFlags(); }
+static void Bch_ClearWakeupFlags(uint32_t Call)	{ (void)Call; PWR_ClearWakeupFlags(); }
+static void Bch_EnableLPRun(uint32_t Call)	{ (void)Call; (void)PWR_EnableLowPowerRun(); }
+static void Bch_DisableLPRun(uint32_t Call)	{ (void)Call; PWR_DisableLowPowerRun(); }
+
+static void Bch_NvicConfig(uint32_t Call)	{ (void)NVIC_IRQConfig(IRQ_NO_EXTI15_10, (uint8_t)(Call & 1U)); }
+static void Bch_NvicIsEnabled(uint32_t Call)	{ (void)Call; (void)NVIC_IsEnabled(IRQ_NO_EXTI15_10); }
+static void Bch_NvicSetPending(uint32_t Call)	{ (void)Call; (void)NVIC_SetPending(IRQ_NO_FLASH); }
+static void Bch_NvicClearPending(uint32_t Call)	{ (void)Call; (void)NVIC_ClearPending(IRQ_NO_FLASH); }
+static void Bch_NvicIsPending(uint32_t Call)	{ (void)Call; (void)NVIC_IsPending(IRQ_NO_FLASH); }
+static void Bch_NvicIsActive(uint32_t Call)	{ (void)Call; (void)NVIC_IsActive(IRQ_NO_FLASH); }
+static void Bch_NvicTrigger(uint32_t Call)	{ (void)Call; (void)NVIC_TriggerIRQ(IRQ_NO_FLASH); }
+static void Bch_NvicSetPriority(uint32_t Call)	{ (void)NVIC_SetPriority(IRQ_NO_FLASH, (uint8_t)(Call & 15U)); }
+static void Bch_NvicGetPriority(uint32_t Call)	{ (void)Call; (void)NVIC_GetPriority(IRQ_NO_FLASH); }
+static void Bch_NvicSetGrouping(uint32_t Call)	{ (void)NVIC_SetPriorityGrouping(Call & 7U); }
+static void Bch_NvicGetGrouping(uint32_t Call)	{ (void)Call; (void)NVIC_GetPriorityGrouping(); }
+
+static void Bch_LptimClk(uint32_t Call)		{ LPTIM_PeriphClkControl((uint8_t)((Call & 1U) ^ 1U)); }
+static void Bch_LptimInit(uint32_t Call)	{ (void)Call; (void)LPTIM_Init(LPTIM_CLOCK_LSI, LPTIM_PRESCALER_DIV1); }
+static void Bch_LptimDeInit(uint32_t Call)	{ (void)Call; LPTIM_DeInit(); }
+static void Bch_LptimFrequency(uint32_t Call)	{ (void)Call; (void)LPTIM_GetFrequency(); }
+static void Bch_LptimCounter(uint32_t Call)	{ (void)Call; (void)LPTIM_GetCounter(); }
+static void Bch_LptimCompare(uint32_t Call)	{ LPTIM_SetCompare((uint16_t)(100U + Call)); }
+static void Bch_LptimGetFlags(uint32_t Call)	{ (void)Call; (void)LPTIM_GetFlags(); }
+static void Bch_LptimClearFlags(uint32_t Call)	{ (void)Call; LPTIM_ClearFlags(0x7FU); }
+
+static void Bch_SystickInit(uint32_t Call)	{ (void)Call; (void)SYSTICK_Init(SYSTICK_1KHZ, 15); }
+static void Bch_SystickTicks(uint32_t Call)	{ (void)Call; (void)SYSTICK_GetTicks(); }
+static void Bch_SystickSuspend(uint32_t Call)	{ (void)Call; SYSTICK_Resume(SYSTICK_Suspend()); }
+
+static void Bch_ItmInit(uint32_t Call)		{ (void)Call; (void)ITM_Init(2000000U, ITM_PORT_MASK(ITM_PORT_STDOUT)); }
+static void Bch_ItmIsEnabled(uint32_t Call)	{ (void)Call; (void)ITM_IsPortEnabled(ITM_PORT_STDOUT); }
+static void Bch_ItmWriteWord(uint32_t Call)	{ (void)ITM_WriteWord(ITM_PORT_STDOUT, Call); }
+static void Bch_ItmWrite(uint32_t Call)		{ (void)Call; (void)ITM_Write(ITM_PORT_STDOUT, "12345678", 8); }
+
+static const Bench_t benches[] =
+{
+	{"GPIO_PeriphClkControl",	0,			0,		Bch_GpioClk},
+	{"GPIO_Init",			0,			0,		Bch_GpioInit},
+	{"GPIO_DeInit",			Bch_SetupLed,		0,		Bch_GpioDeInit},
+	{"GPIO_ReadPin",		Bch_SetupLed,		0,		Bch_ReadPin},
+	{"GPIO_ReadPort",		Bch_SetupLed,		0,		Bch_ReadPort},
+	{"GPIO_WritePin",		Bch_SetupLed,		0,		Bch_WritePin},
+	{"GPIO_WritePort",		Bch_SetupLed,		0,		Bch_WritePort},
+	{"GPIO_TogglePin",		Bch_SetupLed,		0,		Bch_TogglePin},
+	{"GPIO_IRQConfig",		0,			0,		Bch_GpioIRQConfig},
+	{"GPIO_IRQHandling",		Bch_SetupButton,	Prp_ButtonEdge,	Bch_IRQHandling},
+	{"RCC_Config_MSI",		0,			0,		Bch_ConfigMSI},
+	{"RCC_Config_HSI",		0,			Prp_Msi4,	Bch_ConfigHSI},
+	{"RCC_Config_PLLCLK",		0,			Prp_Msi4,	Bch_ConfigPLL},
+	{"RCC_Config_LSI",		0,			Prp_LsiOff,	Bch_ConfigLSI},
+	{"RCC_Config_MCO",		0,			0,		Bch_ConfigMCO},
+	{"RCC_GetSYSCLK",		0,			0,		Bch_GetSYSCLK},
+	{"RCC_GetHCLK",			0,			0,		Bch_GetHCLK},
+	{"RCC_GetHCLKCached",		0,			0,		Bch_GetHCLKCached},
+	{"FLASH_SetLatency",		0,			0,		Bch_SetLatency},
+	{"FLASH_Unlock",		0,			Prp_FlashLock,	Bch_FlashUnlock},
+	{"FLASH_Lock",			0,			0,		Bch_FlashLock},
+	{"FLASH_ConfigART",		0,			0,		Bch_ConfigART},
+	{"FLASH_SetRunPowerDown",	0,			0,		Bch_RunPowerDown},
+	{"FLASH_SetSleepPowerDown",	0,			0,		Bch_SleepPowerDown},
+	{"PWR_ControlVoltageScaling",	Bch_SetupPwr,		0,		Bch_VoltageScaling},
+	{"PWR_ConfigWakeupPin",		Bch_SetupPwr,		0,		Bch_ConfigWakeupPin},
+	{"PWR_GetWakeupFlags",		Bch_SetupPwr,		0,		Bch_GetWakeupFlags},
+	{"PWR_ClearWakeupFlags",	Bch_SetupPwr,		0,		Bch_ClearWakeupFlags},
+	{"PWR_EnableLowPowerRun",	Bch_SetupLowPowerRun,	0,		Bch_EnableLPRun},
+	{"PWR_DisableLowPowerRun",	Bch_SetupLowPowerRun,	Prp_LowPowerRun, Bch_DisableLPRun},
+	{"NVIC_IRQConfig",		0,			0,		Bch_NvicConfig},
+	{"NVIC_IsEnabled",		0,			0,		Bch_NvicIsEnabled},
+	{"NVIC_SetPending",		0,			0,		Bch_NvicSetPending},
+	{"NVIC_ClearPending",		0,			0,		Bch_NvicClearPending},
+	{"NVIC_IsPending",		0,			0,		Bch_NvicIsPending},
+	{"NVIC_IsActive",		0,			0,		Bch_NvicIsActive},
+	{"NVIC_TriggerIRQ",		0,			0,		Bch_NvicTrigger},
+	{"NVIC_SetPriority",		0,			0,		Bch_NvicSetPriority},
+	{"NVIC_GetPriority",		0,			0,		Bch_NvicGetPriority},
+	{"NVIC_SetPriorityGrouping",	0,			0,		Bch_NvicSetGrouping},
+	{"NVIC_GetPriorityGrouping",	0,			0,		Bch_NvicGetGrouping},
+	{"LPTIM_PeriphClkControl",	0,			0,		Bch_LptimClk},
+	{"LPTIM_Init",			Bch_SetupLptim,		Prp_LptimOff,	Bch_LptimInit},
+	{"LPTIM_DeInit",		Bch_SetupLptim,		Prp_LptimOn,	Bch_LptimDeInit},
+	{"LPTIM_GetFrequency",		Bch_SetupLptim,		0,		Bch_LptimFrequency},
+	{"LPTIM_GetCounter",		Bch_SetupLptim,		0,		Bch_LptimCounter},
+	{"LPTIM_SetCompare",		Bch_SetupLptim,		0,		Bch_LptimCompare},
+	{"LPTIM_GetFlags",		Bch_SetupLptim,		0,		Bch_LptimGetFlags},
+	{"LPTIM_ClearFlags",		Bch_SetupLptim,		0,		Bch_LptimClearFlags},
+	{"SYSTICK_Init",		0,			0,		Bch_SystickInit},
+	{"SYSTICK_GetTicks",		Bch_SetupSystick,	0,		Bch_SystickTicks},
+	{"SYSTICK_Suspend+Resume",	Bch_SetupSystick,	0,		Bch_SystickSuspend},
+	{"ITM_Init",			0,			0,		Bch_ItmInit},
+	{"ITM_IsPortEnabled",		Bch_SetupItm,		0,		Bch_ItmIsEnabled},
+	{"ITM_WriteWord",		Bch_SetupItm,		0,		Bch_ItmWriteWord},
+	{"ITM_Write",			Bch_SetupItm,		0,		Bch_ItmWrite}
+};
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       Runs every scenario, then every benchmark.
+*
+* @return      0 if all the scenarios and benchmarks passed, 1 otherwise, 2
+*              without the simulation.
+******************************************************************************/
+int main(void)
+{
+	uint32_t index;
+	uint32_t failed = 0;
+
+	if(SIM_Init() != SIM_STATUS_OK)
+	{
+		printf("FAIL init: register ranges cannot be mapped\n");
+		return 2;
+	}
+
+	for(index = 0; index < (sizeof(scenarios) / sizeof(scenarios[0])); index++)
+	{
+		failed += (Scenario_Run(&scenarios[index]) == 0) ? 1U : 0U;
+	}
+
+	for(index = 0; index < (sizeof(benches) / sizeof(benches[0])); index++)
+	{
+		failed += (Bench_Run(&benches[index]) == 0) ? 1U : 0U;
+	}
+
+	return (failed == 0) ? 0 : 1;
+}
+
+/**************************************************************************//**
+* @brief       Runs one scenario from reset, in SIM_Run(), and prints its
+*              result line.
+*
+* @param       pScenario    Scenario to run.
+*
+* @return      1 if it passed.
+******************************************************************************/
+static uint8_t Scenario_Run(const Scenario_t *pScenario)
+{
+	SIM_Stats_t stats;
+	SIM_STATUS status;
+
+	SIM_Reset();
+	scenario_failure[0] = '\0';
+
+	/* Caches computed on the previous scenario's clocks */
+	RCC_NotifyClockChange();
+	SIM_ClearStats();
+
+	status = SIM_Run(pScenario->pFunction);
+	SIM_GetStats(&stats);
+
+	if(status == SIM_STATUS_STUCK)
+	{
+		snprintf(scenario_failure, sizeof(scenario_failure), "endless poll of 0x%08lX", (unsigned long)stats.StuckAddress);
+	}
+	else if((scenario_failure[0] == '\0') && (stats.Violations != 0) && (pScenario->ExpectViolation == 0))
+	{
+		snprintf(scenario_failure, sizeof(scenario_failure), "%s (0x%08lX)", stats.pLastViolation, (unsigned long)stats.LastViolationAddress);
+	}
+
+	if(scenario_failure[0] != '\0')
+	{
+		printf("FAIL %s: %s\n", pScenario->pName, scenario_failure);
+		return 0;
+	}
+
+	printf("PASS %s\n", pScenario->pName);
+	return 1;
+}
+
+/**************************************************************************//**
+* @brief       Runs one benchmark from reset, in SIM_Run(), and prints its
+*              cost per call. The setup and the preparations are not counted.
+*
+* @param       pBench       Benchmark to run.
+*
+* @return      1 if it ran without a violation.
+******************************************************************************/
+static uint8_t Bench_Run(const Bench_t *pBench)
+{
+	SIM_Stats_t stats;
+	SIM_STATUS status;
+
+	SIM_Reset();
+	RCC_NotifyClockChange();
+	bench_current = pBench;
+	bench_reads = 0;
+	bench_writes = 0;
+	bench_cycles = 0;
+	bench_ns = 0;
+	SIM_ClearStats();
+
+	status = SIM_Run(Bench_Calls);
+	SIM_GetStats(&stats);
+
+	if(status == SIM_STATUS_STUCK)
+	{
+		printf("FAIL %s: endless poll of 0x%08lX\n", pBench->pName, (unsigned long)stats.StuckAddress);
+		return 0;
+	}
+	if(stats.Violations != 0)
+	{
+		printf("FAIL %s: %s (0x%08lX)\n", pBench->pName, stats.pLastViolation, (unsigned long)stats.LastViolationAddress);
+		return 0;
+	}
+
+	printf("BENCH %s reads=%.2f writes=%.2f cycles=%.2f ns=%.0f\n", pBench->pName,
+	       (double)bench_reads / BENCH_CALLS, (double)bench_writes / BENCH_CALLS,
+	       (double)bench_cycles / BENCH_CALLS, (double)bench_ns / BENCH_CALLS);
+	return 1;
+}
+
+/**************************************************************************//**
+* @brief       Calls the function of the running benchmark BENCH_CALLS times,
+*              adding up the counters around each call only.
+******************************************************************************/
+static void Bench_Calls(void)
+{
+	SIM_Stats_t before;
+	SIM_Stats_t after;
+	struct timespec start;
+	struct timespec end;
+	uint32_t call;
+
+	if(bench_current->pSetup != 0)
+	{
+		bench_current->pSetup();
+	}
+
+	for(call = 0; call < BENCH_CALLS; call++)
+	{
+		if(bench_current->pPrepare != 0)
+		{
+			bench_current->pPrepare(call);
+		}
+
+		SIM_GetStats(&before);
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		bench_current->pFunction(call);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		SIM_GetStats(&after);
+
+		bench_reads += after.Reads - before.Reads;
+		bench_writes += after.Writes - before.Writes;
+		bench_cycles += after.Cycles - before.Cycles;
+		bench_ns += ((uint64_t)(end.tv_sec - start.tv_sec) * 1000000000ULL) + (uint64_t)end.tv_nsec - (uint64_t)start.tv_nsec;
+	}
+}
+
+/**************************************************************************//**
+* @brief       Records the first failed check of the running scenario.
+******************************************************************************/
+static void Scenario_Check(uint8_t Passed, const char *pText, int Line)
+{
+	if((Passed == 0) && (scenario_failure[0] == '\0'))
+	{
+		snprintf(scenario_failure, sizeof(scenario_failure), "line %d: %s", Line, pText);
+	}
+}
+
+/**************************************************************************//**
+* @brief       Records the first failed equality of the running scenario.
+******************************************************************************/
+static void Scenario_CheckEqual(uint64_t Value, uint64_t Expected, const char *pText, int Line)
+{
+	if((Value != Expected) && (scenario_failure[0] == '\0'))
+	{
+		snprintf(scenario_failure, sizeof(scenario_failure), "line %d: %s is %llu, expected %llu", Line, pText,
+		         (unsigned long long)Value, (unsigned long long)Expected);
+	}
+}
+
+/**************************************************************************//**
+* @brief       Enables the port clock and configures a pin.
+******************************************************************************/
+static void App_InitPin(GPIO_RegDef_t *pGPIOx, uint8_t Pin, uint8_t Mode, uint8_t Speed, uint8_t PuPd)
+{
+	GPIO_Handle_t handle;
+
+	handle.pGPIOx = pGPIOx;
+	handle.GPIO_PinConfig.GPIO_PinNumber = Pin;
+	handle.GPIO_PinConfig.GPIO_PinMode = Mode;
+	handle.GPIO_PinConfig.GPIO_PinSpeed = Speed;
+	handle.GPIO_PinConfig.GPIO_PinPuPdControl = PuPd;
+	handle.GPIO_PinConfig.GPIO_PinOType = GPIO_OTYPE_PP;
+	handle.GPIO_PinConfig.GPIO_PinAltFunMode = 0;
+
+	GPIO_PeriphClkControl(pGPIOx, ENABLE);
+	GPIO_Init(&handle);
+}
+
+/**************************************************************************//**
+* @brief       Flash wait states, read without going through the traps.
+******************************************************************************/
+static uint32_t App_Latency(void)
+{
+	return FLASH->FLASH_ACR & 0x7U;
+}
@@ -0,0 +1,85 @@
+"""ITM/DWT packet parser for SWO captures of the STM32L475VG.
+
+The input is the raw byte stream of the SWO pin (UART/NRZ mode), as saved by
+STM32CubeIDE SWV, OpenOCD ("tpiu config internal <file> uart off <hclk>")
+or any USB-UART sniffer. Only the packets used by the tools of this
+repository are decoded, the rest are skipped by their size.
+"""
+
+SYNC = "sync"
+OVERFLOW = "overflow"
+TIMESTAMP = "timestamp"
+EXTENSION = "extension"
+SOFTWARE = "software"
+HARDWARE = "hardware"
+
+# Hardware source discriminator of the periodic PC sample packets
+DWT_PC_SAMPLE_ID = 2
+
+_SIZES = {1: 1, 2: 2, 3: 4}
+
+
+def packets(data):
+    """Yields (kind, port_or_id, value, size) tuples from a byte string.
+
+    For SOFTWARE packets port_or_id is the stimulus port, for HARDWARE
+    packets it is the discriminator ID. value is the little endian payload.
+    """
+    i = 0
+    n = len(data)
+    zeros = 0
+    while i < n:
+        header = data[i]
+        i += 1
+
+        if header == 0x00:
+            zeros += 1
+            continue
+        if zeros >= 5 and header == 0x80:
+            zeros = 0
+            yield (SYNC, 0, 0, 0)
+            continue
+        zeros = 0
+
+        if header == 0x70:
+            yield (OVERFLOW, 0, 0, 0)
+            continue
+
+        size_code = header & 0x03
+        if size_code == 0:
+            # Timestamp and extension packets carry continuation bytes
+            value = 0
+            shift = 0
+            more = header & 0x80
+            while more and i < n:
+                value |= (data[i] & 0x7F) << shift
+                shift += 7
+                more = data[i] & 0x80
+                i += 1
+            if (header & 0x0F) == 0:
+                yield (TIMESTAMP, 0, value, 0)
+            else:
+                yield (EXTENSION, (header >> 4) & 0x07, value, 0)
+            continue
+
+        size = _SIZES[size_code]
+        if i + size > n:
+            break
+        value = int.from_bytes(data[i:i + size], "little")
+        i += size
+        kind = HARDWARE if (header & 0x04) else SOFTWARE
+        yield (kind, header >> 3, value, size)
+
+
+def pc_samples(data):
+    """Yields the sampled program counters, sleep samples are dropped."""
+    for kind, ident, value, size in packets(data):
+        if kind == HARDWARE and ident == DWT_PC_SAMPLE_ID and size == 4:
+            yield value
+
+
+def stimulus_bytes(data):
+    """Yields (port, payload bytes) of the software packets, in order."""
+    for kind, port, value, size in packets(data):
+        if kind == SOFTWARE:
+            yield port, value.to_bytes(size, "little")
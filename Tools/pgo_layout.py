@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""Ranks the hot functions of the firmware from a profile of it running.
+
+The profile is either a SWO capture with DWT PC samples (see
+ARTB_EnablePCSampling in Middleware/Src/art_bench.c), an emulator trace
+such as "qemu-system-arm -d exec,nochain -D trace.log", or a plain text
+file with one hexadecimal PC per line. Every PC is attributed to the
+function that contains it and the hottest functions get a rank, hottest
+first.
+
+Without --apply the ranks are only listed. With --apply the list between
+the "pgo_layout.py begin" and "pgo_layout.py end" markers of the linker
+scripts in the given directory is replaced, one input section per
+function in rank order, and the scripts are checked in with the profile
+result. The C files are not touched. The firmware has to be built with
+-ffunction-sections so that every function has its own .text.<name>
+section. A static function whose name is defined in more than one file is
+qualified with its object file, taken from the debug line information
+(nm -l); without it the function is left out.
+
+Example:
+    pgo_layout.py --elf Debug/STM32L4xx_DRIVERS.elf --swo swo.bin \\
+        --budget 4096 --apply STM32L4xx_DRIVERS
+"""
+
+import argparse
+import bisect
+import os
+import re
+import subprocess
+import sys
+
+import itm
+
+FLASH_START = 0x08000000
+FLASH_END = 0x08100000
+
+_QEMU_TRACE = re.compile(r"Trace [0-9]+: 0x[0-9a-f]+ \[[0-9a-f]+/([0-9a-f]+)/")
+_BLOCK = re.compile(r"^([ \t]*)/\* pgo_layout\.py begin \*/\n.*?^[ \t]*/\* pgo_layout\.py end \*/$",
+                    re.MULTILINE | re.DOTALL)
+
+
+def read_symbols(args):
+    """Returns a sorted list of (address, size, name, source) of the flash
+    functions. source is the C file name when nm -l found it, else None."""
+    if args.symbols:
+        with open(args.symbols) as f:
+            text = f.read()
+    else:
+        text = subprocess.run([args.nm, "-S", "-l", "--defined-only", args.elf],
+                              check=True, capture_output=True, text=True).stdout
+
+    symbols = []
+    for line in text.splitlines():
+        symbol, _, location = line.partition("\t")
+        fields = symbol.split()
+        if len(fields) != 4 or fields[2] not in "tTwW":
+            continue
+        address = int(fields[0], 16) & ~1
+        size = int(fields[1], 16)
+        source = os.path.basename(location.rsplit(":", 1)[0]) if location else None
+        if FLASH_START <= address < FLASH_END and size > 0:
+            symbols.append((address, size, fields[3], source))
+    symbols.sort()
+    return symbols
+
+
+def read_pcs(args):
+    if args.swo:
+        with open(args.swo, "rb") as f:
+            return list(itm.pc_samples(f.read()))
+
+    pcs = []
+    with open(args.qemu_trace or args.pcs) as f:
+        for line in f:
+            if args.qemu_trace:
+                match = _QEMU_TRACE.search(line)
+                if match:
+                    pcs.append(int(match.group(1), 16))
+            elif line.strip():
+                pcs.append(int(line.split()[0], 16))
+    return pcs
+
+
+def input_sections(symbols, hot):
+    """Returns the linker script lines of the hot functions, in rank order,
+    and the names left out."""
+    defined = {}
+    for symbol in symbols:
+        defined[symbol[2]] = defined.get(symbol[2], 0) + 1
+
+    lines = []
+    skipped = []
+    for name, source, _, _ in hot:
+        if defined[name] == 1:
+            lines.append("*(.text.%s)" % name)
+        elif source:
+            # Same section name in several objects, pick the right one
+            lines.append("*%s.o(.text.%s)" % (os.path.splitext(source)[0], name))
+        else:
+            skipped.append(name)
+    return lines, skipped
+
+
+def apply(directory, lines):
+    """Replaces the generated list of the linker scripts in directory.
+    Returns the scripts written."""
+    written = []
+    for name in sorted(os.listdir(directory)):
+        if not name.endswith(".ld"):
+            continue
+        path = os.path.join(directory, name)
+        with open(path) as f:
+            text = f.read()
+
+        def block(match):
+            indent = match.group(1)
+            body = "".join("%s%s\n" % (indent, line) for line in lines)
+            return "%s/* pgo_layout.py begin */\n%s%s/* pgo_layout.py end */" % (indent, body, indent)
+
+        new = _BLOCK.sub(block, text)
+        if new != text:
+            with open(path, "w") as f:
+                f.write(new)
+        if _BLOCK.search(text):
+            written.append(path)
+    return written
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--elf", help="firmware image, read with nm")
+    parser.add_argument("--symbols", help="output of 'nm -S -l' instead of --elf")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--swo", help="raw SWO capture with DWT PC samples")
+    source.add_argument("--qemu-trace", help="qemu -d exec log")
+    source.add_argument("--pcs", help="text file, one hex PC per line")
+    parser.add_argument("--budget", type=int, default=4096,
+                        help="bytes of code to move to the start of .text")
+    parser.add_argument("--apply", metavar="DIR", help="write the ranking in the linker scripts in DIR")
+    parser.add_argument("-o", "--output", default="-")
+    args = parser.parse_args()
+
+    if not args.elf and not args.symbols:
+        parser.error("--elf or --symbols is required")
+
+    symbols = read_symbols(args)
+    starts = [s[0] for s in symbols]
+    counts = {}
+    total = 0
+    unknown = 0
+
+    for pc in read_pcs(args):
+        total += 1
+        index = bisect.bisect_right(starts, pc) - 1
+        if index >= 0 and pc < symbols[index][0] + symbols[index][1]:
+            counts[index] = counts.get(index, 0) + 1
+        else:
+            # SRAM2 code, system memory or library code without a size
+            unknown += 1
+
+    ranked = sorted(counts.items(), key=lambda item: item[1], reverse=True)
+    hot = []
+    used = 0
+    covered = 0
+    for index, samples in ranked:
+        address, size, name, source = symbols[index]
+        if used + size > args.budget:
+            continue
+        used += size
+        covered += samples
+        hot.append((name, source, samples, size))
+
+    lines = ["%3d %-32s %8d samples %6d bytes" % (rank + 1, name, samples, size)
+             for rank, (name, _, samples, size) in enumerate(hot)]
+
+    percent = (100.0 * covered / total) if total else 0.0
+    text = ("%d samples (%d outside known functions), %d functions in %d bytes cover %.1f%%\n"
+            % (total, unknown, len(hot), used, percent)) + "\n".join(lines) + "\n"
+
+    if args.output == "-":
+        sys.stdout.write(text)
+    else:
+        with open(args.output, "w") as f:
+            f.write(text)
+    if args.apply:
+        sections, skipped = input_sections(symbols, hot)
+        for name in skipped:
+            sys.stderr.write("%s: defined in several files and no line information, not ranked\n" % name)
+        if not apply(args.apply, sections):
+            sys.stderr.write("%s: no linker script with the pgo_layout.py markers\n" % args.apply)
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
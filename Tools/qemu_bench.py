@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+"""Builds the driver microbenchmarks and counts their instructions under QEMU.
+
+Tools/qemu_bench/qemu_bench.c is linked with the drivers, the startup file
+and STM32L475VGTX_FLASH.ld, then booted on qemu-system-arm's b-l475e-iot01a
+machine (QEMU 9.0 or later) with -icount, one instruction per translation
+block and an exec trace. The instructions executed between each QB_Begin()
+and QB_End() of the firmware are counted from the trace, minus the cost of
+the markers (the "empty" benchmark). Under -icount shift=0 every instruction
+is one nanosecond of virtual time, so the counts are the cycles of the
+emulated core and do not depend on the host: the same firmware gives the
+same JSON on every run. QEMU has no pipeline, wait state or bus model;
+compare the numbers between builds, not with a board (see
+Middleware/Src/art_bench.c for that).
+
+Nothing is downloaded: arm-none-eabi-gcc, arm-none-eabi-nm and
+qemu-system-arm must be installed.
+
+The medians are checked against Tools/qemu_bench/thresholds.json when the
+file exists; --update-thresholds writes it from the current run.
+
+Examples:
+    qemu_bench.py
+    qemu_bench.py --json -o bench.json
+    qemu_bench.py --update-thresholds
+    qemu_bench.py --tolerance 2
+"""
+
+import argparse
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+PROJECT = os.path.join(ROOT, "STM32L4xx_DRIVERS")
+FIRMWARE = os.path.join(ROOT, "Tools", "qemu_bench", "qemu_bench.c")
+THRESHOLDS = os.path.join(ROOT, "Tools", "qemu_bench", "thresholds.json")
+
+CFLAGS = ["-mcpu=cortex-m4", "-mthumb", "-mfpu=fpv4-sp-d16", "-mfloat-abi=hard",
+          "-O2", "-ffunction-sections", "-fdata-sections"]
+LDFLAGS = ["--specs=nano.specs", "--specs=nosys.specs", "-Wl,--gc-sections"]
+
+ICOUNT_SHIFT = 0
+EMPTY = "empty"
+
+_QEMU_TRACE = re.compile(r"Trace [0-9]+: 0x[0-9a-f]+ \[[0-9a-f]+/([0-9a-f]+)/")
+
+
+def build(args, output):
+    sources = sorted(glob.glob(os.path.join(PROJECT, "Drivers", "Src", "*.c")))
+    sources += [os.path.join(PROJECT, "Startup", "startup_stm32l475vgtx.s"), FIRMWARE]
+    command = ([args.cc] + CFLAGS + ["-I" + os.path.join(PROJECT, "Drivers", "Inc")] + sources +
+               LDFLAGS + ["-T", os.path.join(PROJECT, "STM32L475VGTX_FLASH.ld"), "-o", output])
+    subprocess.run(command, check=True)
+
+
+def marker_addresses(args, elf):
+    """Returns the addresses of QB_Begin and QB_End, without the Thumb bit."""
+    text = subprocess.run([args.nm, "--defined-only", elf], check=True,
+                          capture_output=True, text=True).stdout
+    symbols = {}
+    for line in text.splitlines():
+        fields = line.split()
+        if len(fields) == 3:
+            symbols[fields[2]] = int(fields[0], 16) & ~1
+    return symbols["QB_Begin"], symbols["QB_End"]
+
+
+def run_qemu(args, elf, trace):
+    """Runs the firmware, returns the console lines."""
+    command = [args.qemu, "-M", "b-l475e-iot01a", "-nographic", "-monitor", "none", "-serial", "none",
+               "-kernel", elf,
+               "-icount", "shift=%d,align=off,sleep=off" % ICOUNT_SHIFT,
+               "-accel", "tcg,one-insn-per-tb=on",
+               "-d", "exec,nochain", "-D", trace,
+               "-semihosting-config", "enable=on,target=native"]
+    process = subprocess.run(command, capture_output=True, text=True, timeout=args.timeout)
+    lines = (process.stdout + process.stderr).splitlines()
+    if process.returncode != 0 or "DONE" not in lines:
+        raise RuntimeError("qemu exited with %d before DONE\n%s" % (process.returncode, "\n".join(lines)))
+    return lines
+
+
+def count_iterations(trace, begin, end):
+    """Returns the instruction count of every QB_Begin..QB_End span, in order."""
+    counts = []
+    instructions = 0
+    start = None
+    with open(trace) as f:
+        for line in f:
+            match = _QEMU_TRACE.search(line)
+            if not match:
+                continue
+            pc = int(match.group(1), 16)
+            if pc == begin:
+                start = instructions
+            elif pc == end and start is not None:
+                counts.append(instructions - start)
+                start = None
+            instructions += 1
+    return counts
+
+
+def median(values):
+    ordered = sorted(values)
+    middle = len(ordered) // 2
+    if len(ordered) % 2:
+        return ordered[middle]
+    return (ordered[middle - 1] + ordered[middle]) / 2.0
+
+
+def results(lines, counts):
+    """Splits the spans among the benchmarks listed by the firmware."""
+    listed = []
+    for line in lines:
+        fields = line.split()
+        if len(fields) == 3 and fields[0] == "BENCH":
+            listed.append((fields[1], int(fields[2])))
+    if sum(n for _, n in listed) != len(counts):
+        raise RuntimeError("%d spans in the trace for %d iterations" % (len(counts), sum(n for _, n in listed)))
+
+    spans = {}
+    index = 0
+    for name, iterations in listed:
+        spans[name] = counts[index:index + iterations]
+        index += iterations
+
+    overhead = min(spans[EMPTY])
+    benches = {}
+    for name, _ in listed:
+        if name == EMPTY:
+            continue
+        net = [c - overhead for c in spans[name]]
+        benches[name] = {
+            "iterations": len(net),
+            "instructions": median(net),
+            "min": min(net),
+            "max": max(net),
+            "virtual_ns": median(net) * (1 << ICOUNT_SHIFT),
+        }
+    return benches
+
+
+def compare(benches, thresholds, tolerance):
+    """Returns the lines of the benchmarks above their threshold."""
+    regressions = []
+    for name, limit in sorted(thresholds.items()):
+        bench = benches.get(name)
+        if bench is None:
+            regressions.append("%s: missing" % name)
+        elif bench["instructions"] > limit * (1.0 + tolerance / 100.0):
+            regressions.append("%s: %g instructions, threshold %g" % (name, bench["instructions"], limit))
+    return regressions
+
+
+def tool_version(command):
+    try:
+        return subprocess.run([command, "--version"], capture_output=True, text=True).stdout.splitlines()[0]
+    except (OSError, IndexError):
+        return "unknown"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--cc", default="arm-none-eabi-gcc")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--qemu", default="qemu-system-arm")
+    parser.add_argument("--timeout", type=int, default=600, help="seconds before the run is abandoned")
+    parser.add_argument("--json", action="store_true", help="print the results as JSON")
+    parser.add_argument("-o", "--output", default="-")
+    parser.add_argument("--thresholds", default=THRESHOLDS)
+    parser.add_argument("--tolerance", type=float, default=0.0,
+                        help="allowed increase over a threshold, in percent")
+    parser.add_argument("--update-thresholds", action="store_true",
+                        help="write the medians of this run as the thresholds")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as directory:
+        elf = os.path.join(directory, "qemu_bench.elf")
+        trace = os.path.join(directory, "trace.log")
+        build(args, elf)
+        begin, end = marker_addresses(args, elf)
+        lines = run_qemu(args, elf, trace)
+        benches = results(lines, count_iterations(trace, begin, end))
+
+    regressions = []
+    if args.update_thresholds:
+        with open(args.thresholds, "w") as f:
+            json.dump({name: bench["instructions"] for name, bench in benches.items()}, f, indent=2, sort_keys=True)
+            f.write("\n")
+    elif os.path.exists(args.thresholds):
+        with open(args.thresholds) as f:
+            regressions = compare(benches, json.load(f), args.tolerance)
+
+    if args.json:
+        text = json.dumps({"compiler": tool_version(args.cc), "qemu": tool_version(args.qemu),
+                           "icount_shift": ICOUNT_SHIFT, "benches": benches,
+                           "regressions": regressions}, indent=2, sort_keys=True) + "\n"
+    else:
+        rows = ["%-24s %12s %10s %10s" % ("benchmark", "instructions", "min", "max")]
+        for name, bench in benches.items():
+            rows.append("%-24s %12g %10d %10d" % (name, bench["instructions"], bench["min"], bench["max"]))
+        rows += ["REGRESSION " + line for line in regressions]
+        text = "\n".join(rows) + "\n"
+
+    if args.output == "-":
+        sys.stdout.write(text)
+    else:
+        with open(args.output, "w") as f:
+            f.write(text)
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,333 @@
+/**************************************************************************//**
+ * @file    qemu_bench.c
+ * @brief   Driver microbenchmarks for qemu-system-arm -M b-l475e-iot01a.
+ *
+ * This file has 5 functions definitions (input parameters omitted):
+ *      <br>1) main()                   - Lists the benchmarks, runs them and exits QEMU. </br>
+ *      <br>2) QB_Begin()               - Marks the start of one measured iteration. </br>
+ *      <br>3) QB_End()                 - Marks its end. </br>
+ *      <br>4) QB_Print()               - Writes a string to the QEMU console (semihosting). </br>
+ *      <br>5) EXTI15_10_IRQHandler()   - Dispatches the software triggered EXTI line. </br>
+ *
+ * Built and run by Tools/qemu_bench.py. Nothing is timed in the firmware:
+ * QEMU runs with -icount, one instruction per translation block and an exec
+ * trace, and the runner counts the instructions executed between each call
+ * of QB_Begin() and the following QB_End(). Under -icount every instruction
+ * is one tick of the virtual clock, so the counts, interrupt entries
+ * included, are the same on every run and every host.
+ *
+ * The list of benchmarks is written first, one line each:
+ *      BENCH <name> <iterations>
+ * then "DONE" once they have all run, before the semihosting exit.
+ *
+ * QEMU does not model the flash interface: FLASH_ACR reads 0, so the clock
+ * switches stay at or below 16 MHz, where the latency is 0.
+ *
+ * @version 1.0.0.0
+ *
+ * @author  Yaoctzin Serrato
+ *
+ * @date    19/October/2026
+ ******************************************************************************
+ * @section License
+ ******************************************************************************
+ *
+ *
+ *****************************************************************************/
+
+/*****************************************************************************/
+  /* INCLUDES */
+/*****************************************************************************/
+/* Here go the system header files */
+#include <stdint.h>
+#include <string.h>
+
+/* Here go the project includes */
+#include <stm32l475xx.h>
+#include <stm32l475xx_rcc_driver.h>
+#include <stm32l475xx_gpio_driver.h>
+#include <stm32l475xx_nvic_driver.h>
+
+/* Here go the own includes */
+
+/*****************************************************************************/
+  /* DEFINES */
+/*****************************************************************************/
+
+/** @name Semihosting operations (ARM semihosting specification).
+ */
+///@{
+#define	QB_SYS_WRITE0			(0x04UL)
+#define	QB_SYS_EXIT			(0x18UL)
+#define	QB_ADP_APPLICATION_EXIT		(0x20026UL)
+///@}
+
+#define	QB_ITERATIONS			(8U)		/**< Per benchmark, the runner gives min/median/max */
+#define	QB_GPIO_BURST			(64U)		/**< Pin operations per GPIO iteration */
+#define	QB_EXTI_LINE			(13U)		/**< User button line, triggered by EXTI_SWIER1 */
+
+/*****************************************************************************/
+  /* TYPEDEFS */
+/*****************************************************************************/
+typedef struct  /**< A benchmark, pFunction is one measured iteration */
+{
+  const char    *pName;
+  void          (*pFunction)(void);
+}QB_Bench_t;
+
+/*****************************************************************************/
+  /* STATIC VARIABLES */
+/*****************************************************************************/
+static __vo uint32_t qb_current = 0;            /**< Benchmark being measured, for the debugger */
+static __vo uint32_t qb_iterations = 0;
+static __vo uint32_t qb_exti_count = 0;
+static __vo uint8_t qb_pin_sink = 0;
+static uint32_t qb_source[256] __attribute__((aligned(8)));
+static uint32_t qb_destination[256 + 1] __attribute__((aligned(8)));
+
+/*****************************************************************************/
+  /* DEPENDENCIES */
+/*****************************************************************************/
+void QB_Begin(uint32_t Id);
+void QB_End(void);
+static void QB_Print(const char *pString);
+static void QB_PrintNumber(uint32_t Number);
+static void QB_Exit(void);
+static void QB_Setup(void);
+
+/*****************************************************************************/
+  /* BENCHMARKS */
+/*****************************************************************************/
+
+static void Qb_Empty(void)
+{
+	/* Calibration: the cost of the markers, subtracted by the runner */
+}
+
+static void Qb_ClockMsi(void)
+{
+	(void)RCC_Config_MSI(RCC_MSISPEED_16M, 0, RCC_AHBPRESCALER_DIV1);
+	(void)RCC_Config_MSI(RCC_MSISPEED_4M, 0, RCC_AHBPRESCALER_DIV1);
+}
+
+static void Qb_ClockHsi(void)
+{
+	(void)RCC_Config_HSI(RCC_AHBPRESCALER_DIV1);
+	(void)RCC_Config_MSI(RCC_MSISPEED_4M, 0, RCC_AHBPRESCALER_DIV1);
+}
+
+static void Qb_GetHCLK(void)
+{
+	(void)RCC_GetHCLK();
+}
+
+static void Qb_GpioToggle(void)
+{
+	uint32_t i;
+
+	for(i = 0; i < QB_GPIO_BURST; i++)
+	{
+		GPIO_TogglePin(GPIOB, GPIO_PIN_14);
+	}
+}
+
+static void Qb_GpioWrite(void)
+{
+	uint32_t i;
+
+	for(i = 0; i < QB_GPIO_BURST; i++)
+	{
+		GPIO_WritePin(GPIOB, GPIO_PIN_14, (uint8_t)(i & 1U));
+	}
+}
+
+static void Qb_GpioRead(void)
+{
+	uint32_t i;
+
+	for(i = 0; i < QB_GPIO_BURST; i++)
+	{
+		qb_pin_sink = GPIO_ReadPin(GPIOC, GPIO_PIN_13);
+	}
+}
+
+static void Qb_ExtiDispatch(void)
+{
+	uint32_t count = qb_exti_count;
+
+	/* From the trigger to the return of the handler */
+	EXTI->EXTI_SWIER1 = (1UL << QB_EXTI_LINE);
+	while(qb_exti_count == count);
+}
+
+static void Qb_Memcpy64(void)
+{
+	memcpy(qb_destination, qb_source, 64);
+}
+
+static void Qb_Memcpy1024(void)
+{
+	memcpy(qb_destination, qb_source, 1024);
+}
+
+static void Qb_Memcpy1024Unaligned(void)
+{
+	memcpy((uint8_t *)qb_destination + 1, qb_source, 1024);
+}
+
+static const QB_Bench_t qb_benches[] =
+{
+	{"empty",			Qb_Empty},
+	{"clock_msi_4_16_4",		Qb_ClockMsi},
+	{"clock_hsi16_msi4",		Qb_ClockHsi},
+	{"rcc_get_hclk",		Qb_GetHCLK},
+	{"gpio_toggle_x64",		Qb_GpioToggle},
+	{"gpio_write_x64",		Qb_GpioWrite},
+	{"gpio_read_x64",		Qb_GpioRead},
+	{"exti_dispatch",		Qb_ExtiDispatch},
+	{"memcpy_64",			Qb_Memcpy64},
+	{"memcpy_1024",			Qb_Memcpy1024},
+	{"memcpy_1024_unaligned",	Qb_Memcpy1024Unaligned}
+};
+
+/*****************************************************************************/
+  /* FUNCTION DEFINITIONS */
+/*****************************************************************************/
+
+/**************************************************************************//**
+* @brief       Lists the benchmarks, runs every iteration between the markers
+*              and exits QEMU.
+******************************************************************************/
+int main(void)
+{
+	uint32_t bench;
+	uint32_t iteration;
+
+	for(bench = 0; bench < (sizeof(qb_benches) / sizeof(qb_benches[0])); bench++)
+	{
+		QB_Print("BENCH ");
+		QB_Print(qb_benches[bench].pName);
+		QB_Print(" ");
+		QB_PrintNumber(QB_ITERATIONS);
+		QB_Print("\n");
+	}
+
+	QB_Setup();
+
+	for(bench = 0; bench < (sizeof(qb_benches) / sizeof(qb_benches[0])); bench++)
+	{
+		for(iteration = 0; iteration < QB_ITERATIONS; iteration++)
+		{
+			QB_Begin(bench);
+			qb_benches[bench].pFunction();
+			QB_End();
+		}
+	}
+
+	QB_Print("DONE\n");
+	QB_Exit();
+
+	return 0;
+}
+
+/**************************************************************************//**
+* @brief       Start marker, found by address in the trace. Not inlined so
+*              that its first instruction is executed on every iteration.
+*
+* @param       Id           Index of the benchmark.
+******************************************************************************/
+__attribute__((noinline)) void QB_Begin(uint32_t Id)
+{
+	qb_current = Id;
+}
+
+/**************************************************************************//**
+* @brief       End marker, found by address in the trace.
+******************************************************************************/
+__attribute__((noinline)) void QB_End(void)
+{
+	qb_iterations++;
+}
+
+/**************************************************************************//**
+* @brief       Handler of EXTI lines 10 to 15, counts the dispatches.
+******************************************************************************/
+void EXTI15_10_IRQHandler(void)
+{
+	GPIO_IRQHandling(QB_EXTI_LINE);
+	qb_exti_count++;
+}
+
+/**************************************************************************//**
+* @brief       Clocks and pins used by the benchmarks, not measured.
+******************************************************************************/
+static void QB_Setup(void)
+{
+	GPIO_Handle_t led;
+	uint32_t i;
+
+	/* LED2 on PB14 */
+	led.pGPIOx = GPIOB;
+	led.GPIO_PinConfig.GPIO_PinNumber = GPIO_PIN_14;
+	led.GPIO_PinConfig.GPIO_PinMode = GPIO_MODE_OUTPUT;
+	led.GPIO_PinConfig.GPIO_PinSpeed = GPIO_OSPEED_LOW;
+	led.GPIO_PinConfig.GPIO_PinPuPdControl = GPIO_PUPD_NONE;
+	led.GPIO_PinConfig.GPIO_PinOType = GPIO_OTYPE_PP;
+	led.GPIO_PinConfig.GPIO_PinAltFunMode = 0;
+	GPIO_PeriphClkControl(GPIOB, ENABLE);
+	GPIO_Init(&led);
+	GPIO_PeriphClkControl(GPIOC, ENABLE);
+
+	/* Software trigger only, no edge selected */
+	EXTI->EXTI_IMR1 |= (1UL << QB_EXTI_LINE);
+	(void)NVIC_IRQConfig(IRQ_NO_EXTI15_10, ENABLE);
+
+	for(i = 0; i < (sizeof(qb_source) / sizeof(qb_source[0])); i++)
+	{
+		qb_source[i] = i * 0x01010101UL;
+	}
+}
+
+/**************************************************************************//**
+* @brief       Writes a string to the QEMU console through semihosting.
+*
+* @param       pString      NUL terminated string.
+******************************************************************************/
+static void QB_Print(const char *pString)
+{
+	register uint32_t operation __asm("r0") = QB_SYS_WRITE0;
+	register const char *parameter __asm("r1") = pString;
+
+	__asm volatile ("bkpt 0xAB" : "+r" (operation) : "r" (parameter) : "memory");
+}
+
+/**************************************************************************//**
+* @brief       Writes a decimal number to the QEMU console.
+******************************************************************************/
+static void QB_PrintNumber(uint32_t Number)
+{
+	char text[11];
+	uint32_t index = sizeof(text) - 1;
+
+	text[index] = '\0';
+	do
+	{
+		text[--index] = (char)('0' + (Number % 10U));
+		Number /= 10U;
+	}while(Number != 0);
+
+	QB_Print(&text[index]);
+}
+
+/**************************************************************************//**
+* @brief       Ends the QEMU run with exit status 0.
+******************************************************************************/
+static void QB_Exit(void)
+{
+	register uint32_t operation __asm("r0") = QB_SYS_EXIT;
+	register uint32_t parameter __asm("r1") = QB_ADP_APPLICATION_EXIT;
+
+	__asm volatile ("bkpt 0xAB" : "+r" (operation) : "r" (parameter) : "memory");
+
+	while(1);
+}
@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+"""Reports the RAM and flash use of the firmware from its linker map.
+
+The map is the one written by "-Wl,-Map=..." (STM32CubeIDE writes
+Debug/STM32L4xx_DRIVERS.map). For every memory region of the linker script
+the report gives the bytes used and free, the output sections placed in it
+(a section with a load address counts in both regions, .data in RAM and in
+ROM) and the object files taking most of it.
+
+The stack and the heap share the RAM between the end of .bss and _estack;
+the linker only checks that _Min_Heap_Size and _Min_Stack_Size fit there.
+With the peaks measured on target by Middleware/Src/mem_usage.c, either
+given directly or read from the decoded "memu" records of
+Tools/binlog_decode.py, the report proposes both sizes with a margin and
+the RAM left over for buffers. The exit status is 1 when a peak is above
+its linker size: the RAM check of the linker no longer holds.
+
+Examples:
+    ram_report.py Debug/STM32L4xx_DRIVERS.map
+    ram_report.py Debug/STM32L4xx_DRIVERS.map --top 20 --region RAM --region SRAM2
+    binlog_decode.py --elf Debug/STM32L4xx_DRIVERS.elf --swo swo.bin > log.txt
+    ram_report.py Debug/STM32L4xx_DRIVERS.map --log log.txt --margin 25
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+_REGION = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(\S+))?\s*$")
+_SECTION = re.compile(r"^\s*(?:([^\s0]\S*)\s+)?0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)(?:\s+(.*))?$")
+_LOAD = re.compile(r"load address 0x([0-9a-fA-F]+)")
+_SYMBOL = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+(?:PROVIDE \()?(\w+) = ")
+
+_STACK_PEAK = re.compile(r"memu stack peak (\d+)")
+_HEAP_PEAK = re.compile(r"memu heap arena \d+ peak (\d+)")
+
+SYMBOLS = ("_estack", "_Min_Heap_Size", "_Min_Stack_Size", "end", "_end")
+HEAP_STACK_SECTION = "._user_heap_stack"
+
+
+def loaded(name):
+    """False for the sections ld gives a load address but never loads."""
+    return not ("bss" in name or "noinit" in name or name == HEAP_STACK_SECTION)
+
+
+class Region:
+    def __init__(self, name, origin, length):
+        self.name = name
+        self.origin = origin
+        self.length = length
+        self.used = 0
+        self.sections = []
+        self.objects = {}
+
+    def contains(self, address):
+        return self.origin <= address < self.origin + self.length
+
+
+def parse_map(path):
+    """Returns the regions, filled, and the values of SYMBOLS found."""
+    regions = []
+    symbols = {}
+    with open(path) as f:
+        lines = f.read().splitlines()
+
+    index = 0
+    while index < len(lines) and lines[index].strip() != "Memory Configuration":
+        index += 1
+    if index == len(lines):
+        raise ValueError("%s: no Memory Configuration, not a GNU ld map" % path)
+    index += 1
+    while index < len(lines) and not lines[index].startswith("Linker script and memory map"):
+        match = _REGION.match(lines[index])
+        if match and match.group(1) not in ("Name", "*default*"):
+            regions.append(Region(match.group(1), int(match.group(2), 16), int(match.group(3), 16)))
+        index += 1
+
+    def region_of(address):
+        for region in regions:
+            if region.contains(address):
+                return region
+        return None
+
+    output = None
+    pending = None
+    for line in lines[index:]:
+        symbol = _SYMBOL.match(line)
+        if symbol and symbol.group(2) in SYMBOLS:
+            symbols[symbol.group(2)] = int(symbol.group(1), 16)
+            continue
+
+        # ld puts a long section name alone on its line, the rest on the next
+        stripped = line.strip()
+        if stripped and " " not in stripped and (stripped.startswith(".") or stripped.startswith("COMMON")):
+            pending = (line.startswith(" "), stripped)
+            continue
+
+        match = _SECTION.match(line)
+        if not match:
+            pending = None
+            continue
+        name = match.group(1)
+        nested = line.startswith(" ")
+        if name is None and pending is not None:
+            nested, name = pending
+        pending = None
+        if name is None:
+            continue
+
+        address = int(match.group(2), 16)
+        size = int(match.group(3), 16)
+        rest = match.group(4) or ""
+
+        if not nested:
+            output = None
+            region = region_of(address)
+            if region is None or size == 0:
+                continue
+            load = _LOAD.search(rest)
+            places = [(region, address)]
+            if name == HEAP_STACK_SECTION:
+                symbols.setdefault("heap_stack", address)
+            if load and loaded(name):
+                load_address = int(load.group(1), 16)
+                load_region = region_of(load_address)
+                if load_region is not None and load_region is not region:
+                    places.append((load_region, load_address))
+            for place, at in places:
+                place.used += size
+                place.sections.append((name, at, size))
+            output = [place for place, _ in places]
+        elif output is not None and size != 0 and name != "*fill*":
+            obj = os.path.basename(rest.strip()) if rest.strip() else "(linker)"
+            for place in output:
+                place.objects[obj] = place.objects.get(obj, 0) + size
+
+    return regions, symbols
+
+
+def peaks_from_log(path):
+    """Returns the largest stack and heap peaks of the memu records."""
+    stack = heap = None
+    with open(path) as f:
+        for line in f:
+            match = _STACK_PEAK.search(line)
+            if match:
+                stack = max(stack or 0, int(match.group(1)))
+            match = _HEAP_PEAK.search(line)
+            if match:
+                heap = max(heap or 0, int(match.group(1)))
+    return stack, heap
+
+
+def align8(value):
+    return (value + 7) & ~7
+
+
+def proposal(symbols, stack_peak, heap_peak, margin):
+    """Returns the proposed sizes and the RAM they leave for buffers."""
+    start = symbols.get("end", symbols.get("_end"))
+    if start is None and "heap_stack" in symbols:
+        start = align8(symbols["heap_stack"])
+    if start is None:
+        raise ValueError("end and %s missing from the map" % HEAP_STACK_SECTION)
+    shared = symbols["_estack"] - start
+    result = {"shared": shared,
+              "stack_linker": symbols.get("_Min_Stack_Size"),
+              "heap_linker": symbols.get("_Min_Heap_Size")}
+    if stack_peak is not None:
+        result["stack_peak"] = stack_peak
+        result["stack_proposed"] = align8(int(stack_peak * (1.0 + margin / 100.0)))
+    if heap_peak is not None:
+        result["heap_peak"] = heap_peak
+        result["heap_proposed"] = align8(int(heap_peak * (1.0 + margin / 100.0)))
+    if stack_peak is not None and heap_peak is not None:
+        result["spare"] = shared - result["stack_proposed"] - result["heap_proposed"]
+    return result
+
+
+def text_report(regions, stack, top):
+    rows = ["%-10s %10s %10s %10s %6s" % ("region", "size", "used", "free", "use%")]
+    for region in regions:
+        rows.append("%-10s %10d %10d %10d %5.1f%%" % (region.name, region.length, region.used,
+                                                     region.length - region.used,
+                                                     100.0 * region.used / region.length))
+    for region in regions:
+        if not region.sections:
+            continue
+        rows += ["", "%s sections" % region.name]
+        for name, address, size in region.sections:
+            rows.append("  %-24s 0x%08x %10d" % (name, address, size))
+        rows.append("%s largest objects" % region.name)
+        for obj, size in sorted(region.objects.items(), key=lambda item: -item[1])[:top]:
+            rows.append("  %-36s %10d" % (obj, size))
+
+    if stack is not None:
+        rows += ["", "stack and heap, %d bytes between end and _estack" % stack["shared"]]
+        for kind in ("stack", "heap"):
+            line = "  %-6s linker %6s" % (kind, stack.get(kind + "_linker"))
+            if kind + "_peak" in stack:
+                line += "  peak %6d  proposed %6d" % (stack[kind + "_peak"], stack[kind + "_proposed"])
+                if stack.get(kind + "_linker") is not None and stack[kind + "_peak"] > stack[kind + "_linker"]:
+                    line += "  ABOVE LINKER SIZE"
+            rows.append(line)
+        if "spare" in stack:
+            rows.append("  left for buffers %d bytes" % stack["spare"])
+    return "\n".join(rows) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("map", help="linker map file")
+    parser.add_argument("--region", action="append", help="report only these regions")
+    parser.add_argument("--top", type=int, default=10, help="objects listed per region")
+    parser.add_argument("--log", help="binlog_decode.py output with the memu records")
+    parser.add_argument("--stack-peak", type=int, help="measured stack peak, bytes")
+    parser.add_argument("--heap-peak", type=int, help="measured heap peak, bytes")
+    parser.add_argument("--margin", type=float, default=25.0, help="added to the peaks, in percent")
+    parser.add_argument("--json", action="store_true", help="print the report as JSON")
+    parser.add_argument("-o", "--output", default="-")
+    args = parser.parse_args()
+
+    regions, symbols = parse_map(args.map)
+    if args.region:
+        regions = [region for region in regions if region.name in args.region]
+
+    stack_peak, heap_peak = args.stack_peak, args.heap_peak
+    if args.log:
+        logged_stack, logged_heap = peaks_from_log(args.log)
+        stack_peak = stack_peak if stack_peak is not None else logged_stack
+        heap_peak = heap_peak if heap_peak is not None else logged_heap
+
+    stack = None
+    if "_estack" in symbols:
+        stack = proposal(symbols, stack_peak, heap_peak, args.margin)
+
+    if args.json:
+        text = json.dumps({
+            "regions": {region.name: {"origin": region.origin, "length": region.length, "used": region.used,
+                                      "sections": {name: size for name, _, size in region.sections},
+                                      "objects": region.objects}
+                        for region in regions},
+            "stack_heap": stack}, indent=2, sort_keys=True) + "\n"
+    else:
+        text = text_report(regions, stack, args.top)
+
+    if args.output == "-":
+        sys.stdout.write(text)
+    else:
+        with open(args.output, "w") as f:
+            f.write(text)
+
+    above = stack is not None and any(
+        stack.get(kind + "_peak") is not None and stack.get(kind + "_linker") is not None and
+        stack[kind + "_peak"] > stack[kind + "_linker"] for kind in ("stack", "heap"))
+    return 1 if above else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
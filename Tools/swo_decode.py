@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Prints the text of the ITM stimulus ports from a SWO capture.
+
+The capture is the raw SWO stream in NRZ mode with the TPIU formatter
+bypassed, as configured by ITM_Init() in Drivers/Src/stm32l475xx_itm_driver.c
+(see Tools/itm.py for the ways to record it). Port 0 carries stdout and
+port 1 stderr through _write() in Src/syscalls.c.
+
+With one port the bytes are written as they are; with several, every line
+is prefixed with its port number. --split writes one file per port instead.
+
+Examples:
+    swo_decode.py swo.bin
+    swo_decode.py --port 0 --port 1 swo.bin
+    swo_decode.py --split out/ swo.bin
+"""
+
+import argparse
+import os
+import sys
+
+import itm
+
+
+def read_capture(path):
+    if path == "-":
+        return sys.stdin.buffer.read()
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="raw SWO capture, - for stdin")
+    parser.add_argument("--port", type=int, action="append",
+                        help="stimulus port to print, repeatable (default: all)")
+    parser.add_argument("--split", metavar="DIR",
+                        help="write port_<n>.txt files in DIR instead")
+    args = parser.parse_args()
+
+    data = read_capture(args.capture)
+    wanted = set(args.port) if args.port else None
+    streams = {}
+    overflows = 0
+
+    for kind, _, _, _ in itm.packets(data):
+        if kind == itm.OVERFLOW:
+            overflows += 1
+
+    for port, payload in itm.stimulus_bytes(data):
+        if wanted is None or port in wanted:
+            streams.setdefault(port, bytearray()).extend(payload)
+
+    if args.split:
+        os.makedirs(args.split, exist_ok=True)
+        for port, stream in sorted(streams.items()):
+            with open(os.path.join(args.split, "port_%d.txt" % port), "wb") as f:
+                f.write(stream)
+    elif len(streams) == 1 and (wanted is None or len(wanted) == 1):
+        sys.stdout.buffer.write(bytes(next(iter(streams.values()))))
+    else:
+        for port, stream in sorted(streams.items()):
+            for line in bytes(stream).splitlines():
+                sys.stdout.write("[%d] %s\n" % (port, line.decode("utf-8", "replace")))
+
+    sys.stderr.write("%d ports, %d bytes, %d overflows\n"
+                     % (len(streams), sum(len(s) for s in streams.values()), overflows))
+
+
+if __name__ == "__main__":
+    main()